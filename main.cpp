@@ -1,12 +1,18 @@
 #include<iostream>
 #include "algorithm_performance_test.h"
+#include "hash_performance_test.h"
 #include "algorithm_test.h"
 #include "vector_test.h"
+#include "dynamic_bitset_test.h"
 #include "list_test.h"
 #include "deque_test.h"
 #include "stack_test.h"
 #include "queue_test.h"
 #include "string_test.h"
+#include "rope_test.h"
+#include "string_pool_test.h"
+#include "thread_pool_test.h"
+#include "external_sort_test.h"
 #include "set_test.h"
 #include "map_test.h"
 #include "unordered_set_test.h"
@@ -20,12 +26,21 @@ int main() {
 
     RUN_ALL_TESTS();
     vector_test::vector_test();
+    dynamic_bitset_test::dynamic_bitset_test();
     list_test::list_test();
     deque_test::deque_test();
     stack_test::stack_test();
     queue_test::queue_test();
     queue_test::priority_test();
     string_test::string_test();
+    string_test::string_view_test();
+    string_test::string_conversion_test();
+    string_test::utf_test();
+    string_test::split_test();
+    rope_test::rope_test();
+    string_pool_test::string_pool_test();
+    thread_pool_test::thread_pool_test();
+    external_sort_test::external_sort_test();
     set_test::set_test();
     set_test::multiset_test();
     map_test::map_test();
@@ -34,6 +49,7 @@ int main() {
     unordered_set_test::unordered_multiset_test();
     unordered_map_test::unordered_map_test();
     unordered_map_test::unordered_multimap_test();
+    hash_performance_test::hash_performance_test();
 
     return 0;
 }
\ No newline at end of file
@@ -4,7 +4,7 @@
 
 /*
  * 本头文件只是对其他头文件的一个集合包装，导入此文件的同时会导入其他头文件
- * 这个头文件包含了 tinySTL 的所有算法，包括基本算法，数值算法，heap 算法，set 算法和其他算法
+ * 这个头文件包含了 tinySTL 的所有算法，包括基本算法，数值算法，heap 算法，set 算法，基数排序，多路归并，流式 top_k 和其他算法
  */
 
 #ifndef TINYSTL_ALGORITHM_H
@@ -15,6 +15,9 @@
 #include "set_algo.h"  /* 这个头文件包含 set 的四种算法: union, intersection, difference, symmetric_difference */
 #include "heap_algo.h"  /* 这个头文件包含 heap 的四个算法 : push_heap, pop_heap, sort_heap, make_heap */
 #include "numeric.h"  /* 这个头文件包含了 tinySTL 的数值算法 */
+#include "radix_sort.h"  /* 这个头文件包含基数排序 radix_sort，支持整数、浮点数与字符串关键字 */
+#include "multiway_merge.h"  /* 这个头文件包含多路归并 multiway_merge 与多序列选择 multiseq_partition */
+#include "top_k.h"  /* 这个头文件包含一个模板类 top_k，从数据流中保留排在最前面的 k 个元素 */
 
 /* 首先定义自己的命名空间 */
 namespace tinySTL {
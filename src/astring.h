@@ -4,12 +4,25 @@
 
 /*
  * 定义了 string, wstring, u16string, u32string 类型
+ * 以及对应的 string_view, wstring_view, u16string_view, u32string_view 类型
+ * 以及数值与 string 之间的转换函数 to_string, to_wstring, stoi, stol, stod 等
+ * UTF 编码之间的转换 utf8_to_utf16 等定义在 utf.h 中
+ * 不分配内存的切分 split、tokenize、split_n 定义在 str_split.h 中
  */
 
 #ifndef TINYSTL_ASTRING_H
 #define TINYSTL_ASTRING_H
 
+#include <cerrno>  /* errno, ERANGE */
+#include <cctype>  /* isspace */
+#include <cstdio>  /* snprintf */
+#include <cstdlib>  /* strtof, strtod, strtold */
+#include <limits>  /* numeric_limits */
 #include "basic_string.h"  /* 这个头文件包含一个模板类 basic_string,用于表示字符串类型 */
+#include "charconv.h"  /* 这个头文件包含数值与字符序列之间的转换 to_chars 与 from_chars */
+#include "utf.h"  /* 这个头文件包含 UTF-8、UTF-16 与 UTF-32 之间的校验与转换 */
+#include "str_split.h"  /* 这个头文件包含按分隔符切分字符串的惰性区间 split 与 tokenize */
+#include "exceptdef.h"  /* 此文件中定义了异常相关的宏 */
 
 /* 首先定义自己的命名空间 */
 namespace tinySTL {
@@ -22,6 +35,186 @@ namespace tinySTL {
     using u16string = tinySTL::basic_string<char16_t>;
     using u32string = tinySTL::basic_string<char32_t>;
 
+    /*
+     * 为string_view类定义一系列别名
+     */
+    using string_view = tinySTL::basic_string_view<char>;
+    using wstring_view = tinySTL::basic_string_view<wchar_t>;
+    using u16string_view = tinySTL::basic_string_view<char16_t>;
+    using u32string_view = tinySTL::basic_string_view<char32_t>;
+
+    /*
+     * 数值与 string 之间的转换
+     * to_string 先用 to_chars 写到栈上的缓冲区，再以确定的长度构造 string，整个过程只分配一次内存
+     * 浮点数输出最短往返表示(与 c++26 的 std::to_string 相同)，而不是 %f 的固定 6 位小数
+     */
+    namespace astring_detail {
+
+        /*
+         * 格式化到栈上的缓冲区，32 个字符足够容纳任何整数、float 与 double
+         */
+        template<typename Value>
+        string number_to_string(Value value) {
+            char buf[32];
+            const to_chars_result res = tinySTL::to_chars(buf, buf + sizeof(buf), value);
+            return string(buf, static_cast<size_t>(res.ptr - buf));
+        }
+
+        template<typename Value>
+        wstring number_to_wstring(Value value) {
+            char buf[32];
+            const to_chars_result res = tinySTL::to_chars(buf, buf + sizeof(buf), value);
+            const size_t n = static_cast<size_t>(res.ptr - buf);
+            wstring ws(n, L'0');
+            for (size_t i = 0; i != n; ++i) {
+                ws[i] = static_cast<wchar_t>(buf[i]);
+            }
+            return ws;
+        }
+
+        /*
+         * stoi 系列的公共实现，语义与 strtol 一致：跳过前导空白，接受正负号，
+         * base 为 0 或 16 时接受 "0x" 前缀，base 为 0 时根据前缀推断进制，
+         * 无符号类型遇到负号时与 strtoul 一样取反
+         */
+        template<typename Int>
+        Int string_to_integer(const char *name, const string &str, size_t *idx, int base) {
+            typedef typename std::make_unsigned<Int>::type unsigned_type;
+            const char *first = str.begin();
+            const char *last = str.end();
+            const char *p = first;
+            while (p != last && std::isspace(static_cast<unsigned char>(*p))) {
+                ++p;
+            }
+            bool negative = false;
+            if (p != last && (*p == '+' || *p == '-')) {
+                negative = *p == '-';
+                ++p;
+            }
+            if ((base == 0 || base == 16) && last - p >= 3 && p[0] == '0' && (p[1] == 'x' || p[1] == 'X')
+                && charconv_detail::digit_value(p[2]) < 16) {
+                p += 2;
+                base = 16;
+            } else if (base == 0) {
+                base = (p != last && *p == '0') ? 8 : 10;
+            }
+            uint64_t limit = static_cast<uint64_t>(std::numeric_limits<Int>::max());
+            if (std::is_signed<Int>::value) {
+                limit += negative;
+            }
+            uint64_t mag = 0;
+            const from_chars_result res = charconv_detail::from_chars_unsigned(p, last, mag, limit, base);
+            THROW_INVALID_ARGUMENT_IF(res.ec == std::errc::invalid_argument, name);
+            THROW_OUT_OF_RANGE_IF(res.ec == std::errc::result_out_of_range, name);
+            if (idx != nullptr) {
+                *idx = static_cast<size_t>(res.ptr - first);
+            }
+            const unsigned_type u = static_cast<unsigned_type>(mag);
+            return static_cast<Int>(negative ? static_cast<unsigned_type>(0 - u) : u);
+        }
+
+        /*
+         * stof 系列的公共实现，转发给 C 库的 strtof/strtod/strtold
+         */
+        template<typename Float, typename Conv>
+        Float string_to_float(const char *name, const string &str, size_t *idx, Conv conv) {
+            const char *first = str.c_str();
+            char *end = nullptr;
+            const int saved = errno;
+            errno = 0;
+            const Float value = conv(first, &end);
+            const bool out_of_range = errno == ERANGE;
+            if (errno == 0) {
+                errno = saved;
+            }
+            THROW_INVALID_ARGUMENT_IF(end == first, name);
+            THROW_OUT_OF_RANGE_IF(out_of_range, name);
+            if (idx != nullptr) {
+                *idx = static_cast<size_t>(end - first);
+            }
+            return value;
+        }
+
+    }  // namespace astring_detail
+
+    inline string to_string(int value) { return astring_detail::number_to_string(value); }
+
+    inline string to_string(long value) { return astring_detail::number_to_string(value); }
+
+    inline string to_string(long long value) { return astring_detail::number_to_string(value); }
+
+    inline string to_string(unsigned value) { return astring_detail::number_to_string(value); }
+
+    inline string to_string(unsigned long value) { return astring_detail::number_to_string(value); }
+
+    inline string to_string(unsigned long long value) { return astring_detail::number_to_string(value); }
+
+    inline string to_string(float value) { return astring_detail::number_to_string(value); }
+
+    inline string to_string(double value) { return astring_detail::number_to_string(value); }
+
+    /*
+     * long double 没有对应的 Ryu 表，使用 snprintf 输出足以往返的有效位数
+     */
+    inline string to_string(long double value) {
+        char buf[64];
+        const int n = std::snprintf(buf, sizeof(buf), "%.*Lg",
+                                    std::numeric_limits<long double>::max_digits10, value);
+        return string(buf, static_cast<size_t>(n));
+    }
+
+    inline wstring to_wstring(int value) { return astring_detail::number_to_wstring(value); }
+
+    inline wstring to_wstring(long value) { return astring_detail::number_to_wstring(value); }
+
+    inline wstring to_wstring(long long value) { return astring_detail::number_to_wstring(value); }
+
+    inline wstring to_wstring(unsigned value) { return astring_detail::number_to_wstring(value); }
+
+    inline wstring to_wstring(unsigned long value) { return astring_detail::number_to_wstring(value); }
+
+    inline wstring to_wstring(unsigned long long value) { return astring_detail::number_to_wstring(value); }
+
+    inline wstring to_wstring(float value) { return astring_detail::number_to_wstring(value); }
+
+    inline wstring to_wstring(double value) { return astring_detail::number_to_wstring(value); }
+
+    /*
+     * 把字符串开头的数值解析出来，idx 不为空时写入第一个未解析字符的下标
+     * 没有可解析的数字时抛出 std::invalid_argument，超出类型范围时抛出 std::out_of_range
+     */
+    inline int stoi(const string &str, size_t *idx = nullptr, int base = 10) {
+        return astring_detail::string_to_integer<int>("stoi", str, idx, base);
+    }
+
+    inline long stol(const string &str, size_t *idx = nullptr, int base = 10) {
+        return astring_detail::string_to_integer<long>("stol", str, idx, base);
+    }
+
+    inline long long stoll(const string &str, size_t *idx = nullptr, int base = 10) {
+        return astring_detail::string_to_integer<long long>("stoll", str, idx, base);
+    }
+
+    inline unsigned long stoul(const string &str, size_t *idx = nullptr, int base = 10) {
+        return astring_detail::string_to_integer<unsigned long>("stoul", str, idx, base);
+    }
+
+    inline unsigned long long stoull(const string &str, size_t *idx = nullptr, int base = 10) {
+        return astring_detail::string_to_integer<unsigned long long>("stoull", str, idx, base);
+    }
+
+    inline float stof(const string &str, size_t *idx = nullptr) {
+        return astring_detail::string_to_float<float>("stof", str, idx, std::strtof);
+    }
+
+    inline double stod(const string &str, size_t *idx = nullptr) {
+        return astring_detail::string_to_float<double>("stod", str, idx, std::strtod);
+    }
+
+    inline long double stold(const string &str, size_t *idx = nullptr) {
+        return astring_detail::string_to_float<long double>("stold", str, idx, std::strtold);
+    }
+
 }  // namespace tinySTL
 
 #endif //TINYSTL_ASTRING_H
@@ -11,11 +11,22 @@
 
 #include <cstddef>  /* 头文件cstddef与其C对应版本兼容，它是C头文件<stddef.h>较新版本，定义了常用的常量、宏、类型和函数 */
 #include <ctime>  /* 时间处理相关 */
+#include <functional>  /* std::less, std::greater，用于判断能否使用无分支划分 */
 
 #include "algobase.h"  /* 这个头文件包含了库中的一些基本算法 */
 #include "memory.h"  /* 包含一些基本函数、空间配置器、未初始化的储存空间管理，以及一个模板类 auto_ptr */
 #include "heap_algo.h"  /* 这个头文件包含 heap 的四个算法 : push_heap, pop_heap, sort_heap, make_heap */
 #include "functional.h"  /* 这个头文件包含了 tinySTL 的函数对象与哈希函数 */
+#include "simd_algo.h"  /* 这个头文件包含算术类型连续区间上的 SIMD 内核 */
+
+/*
+ * 预取 addr 所在的缓存行，编译器不支持时为空操作
+ */
+#if defined(__GNUC__) || defined(__clang__)
+#define TINYSTL_PREFETCH(addr) __builtin_prefetch(addr)
+#else
+#define TINYSTL_PREFETCH(addr) ((void) 0)
+#endif
 
 /* 首先定义自己的命名空间 */
 namespace tinySTL {
@@ -75,7 +86,7 @@ namespace tinySTL {
      * 对[first, last)区间内的元素与给定值进行比较，缺省使用 operator==，返回元素相等的个数
      */
     template<typename InputIter, typename T>
-    size_t count(InputIter first, InputIter last, const T &value) {
+    size_t count_simd_dispatch(InputIter first, InputIter last, const T &value, m_false_type) {
         size_t n = 0;
         for (; first != last; ++first) {
             if (*first == value) {
@@ -85,6 +96,17 @@ namespace tinySTL {
         return n;
     }
 
+    /* 连续的算术类型区间且 value 与元素类型相同时，使用 SIMD 内核 */
+    template<typename Ptr, typename T>
+    size_t count_simd_dispatch(Ptr first, Ptr last, const T &value, m_true_type) {
+        return simd::count_equal(first, static_cast<size_t>(last - first), value);
+    }
+
+    template<typename InputIter, typename T>
+    size_t count(InputIter first, InputIter last, const T &value) {
+        return tinySTL::count_simd_dispatch(first, last, value, simd::is_simd_range<InputIter, T>());
+    }
+
     // =========================================================================================
 
     /*
@@ -92,7 +114,7 @@ namespace tinySTL {
      * 对[first, last)区间内的每个元素都进行一元 unary_pred 操作，返回结果为 true 的个数
      */
     template<typename InputIter, typename UnaryPred>
-    size_t count_if(InputIter first, InputIter last, UnaryPred unary_pred) {
+    size_t count_if_simd_dispatch(InputIter first, InputIter last, UnaryPred unary_pred, m_false_type) {
         size_t n = 0;
         for (; first != last; ++first) {
             if (unary_pred(*first)) {
@@ -102,6 +124,17 @@ namespace tinySTL {
         return n;
     }
 
+    /* 连续的算术类型区间，按固定长度的块计数，简单的谓词可以被编译器向量化 */
+    template<typename Ptr, typename UnaryPred>
+    size_t count_if_simd_dispatch(Ptr first, Ptr last, UnaryPred unary_pred, m_true_type) {
+        return simd::count_if(first, static_cast<size_t>(last - first), unary_pred);
+    }
+
+    template<typename InputIter, typename UnaryPred>
+    size_t count_if(InputIter first, InputIter last, UnaryPred unary_pred) {
+        return tinySTL::count_if_simd_dispatch(first, last, unary_pred, simd::is_simd_range<InputIter>());
+    }
+
     // =====================================================================================
 
     /*
@@ -109,13 +142,24 @@ namespace tinySTL {
      * 在[first, last)区间内找到等于 value 的元素，返回指向该元素的迭代器
      */
     template<typename InputIter, typename T>
-    InputIter find(InputIter first, InputIter last, const T &value) {
+    InputIter find_simd_dispatch(InputIter first, InputIter last, const T &value, m_false_type) {
         while (first != last && *first != value) {
             ++first;
         }
         return first;
     }
 
+    /* 连续的算术类型区间且 value 与元素类型相同时，使用 SIMD 内核 */
+    template<typename Ptr, typename T>
+    Ptr find_simd_dispatch(Ptr first, Ptr last, const T &value, m_true_type) {
+        return first + simd::find_index(first, static_cast<size_t>(last - first), value);
+    }
+
+    template<typename InputIter, typename T>
+    InputIter find(InputIter first, InputIter last, const T &value) {
+        return tinySTL::find_simd_dispatch(first, last, value, simd::is_simd_range<InputIter, T>());
+    }
+
     // =========================================================================================
 
     /*
@@ -505,6 +549,113 @@ namespace tinySTL {
 
     // ===================================================================================
 
+    /*
+     * 随机访问迭代器上的无分支二分查找
+     * 每轮只根据比较结果决定是否前进 half 个位置，编译为条件传送而不是分支，避免了难以预测的跳转；
+     * 下一轮的中点只有两种可能，在本轮比较之前把两者都预取进缓存，使访存与比较重叠
+     */
+    namespace search_detail {
+
+        /*
+         * 异构的 < 比较，用于不带 comp 的版本，value 的类型可以与元素类型不同
+         */
+        struct less_than {
+            template<typename T1, typename T2>
+            bool operator()(const T1 &lhs, const T2 &rhs) const {
+                return lhs < rhs;
+            }
+        };
+
+        /*
+         * 只对原生指针预取，其他随机访问迭代器(如 deque)计算地址本身就需要访存
+         */
+        template<typename RandomIter, typename Distance>
+        inline void prefetch_at(RandomIter, Distance) {
+        }
+
+        template<typename T, typename Distance>
+        inline void prefetch_at(T *first, Distance offset) {
+            TINYSTL_PREFETCH(first + offset);
+        }
+
+        template<typename RandomIter, typename T, typename Compared>
+        RandomIter branchless_lower_bound(RandomIter first, RandomIter last, const T &value, Compared comp) {
+            auto len = last - first;
+            if (len == 0) {
+                return first;
+            }
+            /* 答案始终位于 [first, first + len] 中 */
+            while (len > 1) {
+                const auto half = len >> 1;
+                const auto next = (len - half) >> 1;
+                search_detail::prefetch_at(first, next);
+                search_detail::prefetch_at(first, half + next);
+                first += comp(*(first + half), value) ? half : 0;
+                len -= half;
+            }
+            return first + (comp(*first, value) ? 1 : 0);
+        }
+
+        template<typename RandomIter, typename T, typename Compared>
+        RandomIter branchless_upper_bound(RandomIter first, RandomIter last, const T &value, Compared comp) {
+            auto len = last - first;
+            if (len == 0) {
+                return first;
+            }
+            while (len > 1) {
+                const auto half = len >> 1;
+                const auto next = (len - half) >> 1;
+                search_detail::prefetch_at(first, next);
+                search_detail::prefetch_at(first, half + next);
+                first += comp(value, *(first + half)) ? 0 : half;
+                len -= half;
+            }
+            return first + (comp(value, *first) ? 0 : 1);
+        }
+
+        /*
+         * lower_bound_many 中同时推进的查询个数
+         */
+        const size_t kBatchSize = 16;
+
+        template<typename RandomIter, typename ForwardIter, typename OutputIter, typename Compared>
+        OutputIter lower_bound_many(RandomIter first, RandomIter last, ForwardIter value_first,
+                                    ForwardIter value_last, OutputIter result, Compared comp) {
+            const auto n = last - first;
+            RandomIter pos[kBatchSize];
+            ForwardIter query[kBatchSize];
+            while (value_first != value_last) {
+                size_t m = 0;
+                for (; m < kBatchSize && value_first != value_last; ++m, ++value_first) {
+                    query[m] = value_first;
+                    pos[m] = first;
+                }
+                if (n > 0) {
+                    /* 每一轮所有查询的 len 都相同，逐个推进时各自的访存互不依赖 */
+                    auto len = n;
+                    while (len > 1) {
+                        const auto half = len >> 1;
+                        const auto next = (len - half) >> 1;
+                        for (size_t i = 0; i < m; ++i) {
+                            search_detail::prefetch_at(pos[i], next);
+                            search_detail::prefetch_at(pos[i], half + next);
+                            pos[i] += comp(*(pos[i] + half), *query[i]) ? half : 0;
+                        }
+                        len -= half;
+                    }
+                    for (size_t i = 0; i < m; ++i) {
+                        pos[i] += comp(*pos[i], *query[i]) ? 1 : 0;
+                    }
+                }
+                for (size_t i = 0; i < m; ++i, ++result) {
+                    *result = pos[i];
+                }
+            }
+            return result;
+        }
+
+    }  // namespace search_detail
+
     /*
      * lower_bound 函数
      * 在[first, last)中查找第一个不小于 value 的元素，并返回指向它的迭代器，若没有则返回 last
@@ -542,20 +693,7 @@ namespace tinySTL {
     template<typename RandomIter, typename T>
     RandomIter lower_bound_dispatch(RandomIter first, RandomIter last, const T &value,
                                     tinySTL::random_access_iterator_tag) {
-        auto len = last - first;
-        auto half = len;
-        RandomIter middle;
-        while (len > 0) {
-            half = len >> 1;
-            middle = first + half;
-            if (*middle < value) {
-                first = middle + 1;
-                len = len - half - 1;
-            } else {
-                len = half;
-            }
-        }
-        return first;
+        return search_detail::branchless_lower_bound(first, last, value, search_detail::less_than());
     }
 
     /*
@@ -601,20 +739,7 @@ namespace tinySTL {
     template<typename RandomIter, typename T, typename Compared>
     RandomIter lower_bound_dispatch(RandomIter first, RandomIter last, const T &value,
                                     tinySTL::random_access_iterator_tag, Compared comp) {
-        auto len = last - first;
-        auto half = len;
-        RandomIter middle;
-        while (len > 0) {
-            half = len >> 1;
-            middle = first + half;
-            if (comp(*middle, value)) {
-                first = middle + 1;
-                len = len - half - 1;
-            } else {
-                len = half;
-            }
-        }
-        return first;
+        return search_detail::branchless_lower_bound(first, last, value, comp);
     }
 
     /*
@@ -665,20 +790,7 @@ namespace tinySTL {
     template<typename RandomIter, typename T>
     RandomIter upper_bound_dispatch(RandomIter first, RandomIter last, const T &value,
                                     tinySTL::random_access_iterator_tag) {
-        auto len = tinySTL::distance(first, last);
-        auto half = len;
-        RandomIter middle;
-        while (len > 0) {
-            half = len >> 1;
-            middle = first + half;
-            if (value < *middle) {
-                len = half;
-            } else {
-                first = middle + 1;
-                len = len - half - 1;
-            }
-        }
-        return first;
+        return search_detail::branchless_upper_bound(first, last, value, search_detail::less_than());
     }
 
     /*
@@ -724,20 +836,7 @@ namespace tinySTL {
     template<typename RandomIter, typename T, typename Compared>
     RandomIter upper_bound_dispatch(RandomIter first, RandomIter last, const T &value,
                                     tinySTL::random_access_iterator_tag, Compared comp) {
-        auto len = tinySTL::distance(first, last);
-        auto half = len;
-        RandomIter middle;
-        while (len > 0) {
-            half = len >> 1;
-            middle = first + half;
-            if (comp(value, *middle)) {
-                len = half;
-            } else {
-                first = middle + 1;
-                len = len - half - 1;
-            }
-        }
-        return first;
+        return search_detail::branchless_upper_bound(first, last, value, comp);
     }
 
     /*
@@ -773,6 +872,31 @@ namespace tinySTL {
         return pos != last && !comp(value, *pos);
     }
 
+    // =======================================================================================
+
+    /*
+     * lower_bound_many 函数
+     * 对 [value_first, value_last) 中的每个值在有序区间 [first, last) 上做 lower_bound，
+     * 把得到的迭代器依次写入 result，返回 result 的尾后位置；查询的值不需要有序
+     * 查询每 16 个一组交错推进，一个查询等待缓存未命中时其他查询的访存也在进行，适合大量查询的场景
+     */
+    template<typename RandomIter, typename ForwardIter, typename OutputIter>
+    OutputIter lower_bound_many(RandomIter first, RandomIter last, ForwardIter value_first,
+                                ForwardIter value_last, OutputIter result) {
+        return search_detail::lower_bound_many(first, last, value_first, value_last, result,
+                                               search_detail::less_than());
+    }
+
+    /*
+     * lower_bound_many 函数
+     * 重载版本使用函数对象 comp 代替比较操作
+     */
+    template<typename RandomIter, typename ForwardIter, typename OutputIter, typename Compared>
+    OutputIter lower_bound_many(RandomIter first, RandomIter last, ForwardIter value_first,
+                                ForwardIter value_last, OutputIter result, Compared comp) {
+        return search_detail::lower_bound_many(first, last, value_first, value_last, result, comp);
+    }
+
     // ============================================================================================
 
     /*
@@ -1135,7 +1259,7 @@ namespace tinySTL {
      * 返回一个迭代器，指向序列中最大的元素
      */
     template<typename ForwardIter>
-    ForwardIter max_element(ForwardIter first, ForwardIter last) {
+    ForwardIter max_element_simd_dispatch(ForwardIter first, ForwardIter last, m_false_type) {
         if (first == last) {
             return last;
         }
@@ -1148,6 +1272,21 @@ namespace tinySTL {
         return max_ite;
     }
 
+    /* 连续的算术类型区间使用 SIMD 内核，浮点数中出现 NaN 时退回普通的循环 */
+    template<typename Ptr>
+    Ptr max_element_simd_dispatch(Ptr first, Ptr last, m_true_type) {
+        if (first == last) {
+            return last;
+        }
+        const size_t i = simd::max_index(first, static_cast<size_t>(last - first));
+        return i != simd::no_index ? first + i : tinySTL::max_element_simd_dispatch(first, last, m_false_type());
+    }
+
+    template<typename ForwardIter>
+    ForwardIter max_element(ForwardIter first, ForwardIter last) {
+        return tinySTL::max_element_simd_dispatch(first, last, simd::is_simd_range<ForwardIter>());
+    }
+
     /*
      * max_element 函数
      * 重载版本使用函数对象 comp 代替比较操作
@@ -1173,7 +1312,7 @@ namespace tinySTL {
      * 返回一个迭代器，指向序列中最大的元素
      */
     template<typename ForwardIter>
-    ForwardIter min_element(ForwardIter first, ForwardIter last) {
+    ForwardIter min_element_simd_dispatch(ForwardIter first, ForwardIter last, m_false_type) {
         if (first == last) {
             return last;
         }
@@ -1186,6 +1325,21 @@ namespace tinySTL {
         return max_ite;
     }
 
+    /* 连续的算术类型区间使用 SIMD 内核，浮点数中出现 NaN 时退回普通的循环 */
+    template<typename Ptr>
+    Ptr min_element_simd_dispatch(Ptr first, Ptr last, m_true_type) {
+        if (first == last) {
+            return last;
+        }
+        const size_t i = simd::min_index(first, static_cast<size_t>(last - first));
+        return i != simd::no_index ? first + i : tinySTL::min_element_simd_dispatch(first, last, m_false_type());
+    }
+
+    template<typename ForwardIter>
+    ForwardIter min_element(ForwardIter first, ForwardIter last) {
+        return tinySTL::min_element_simd_dispatch(first, last, simd::is_simd_range<ForwardIter>());
+    }
+
     /*
      * min_element 函数
      * 重载版本使用函数对象 comp 代替比较操作
@@ -1204,6 +1358,69 @@ namespace tinySTL {
         return max_ite;
     }
 
+    // =========================================================================================
+
+    /*
+     * minmax_element 函数
+     * 一次遍历同时求最小与最大元素，返回的 pair 中 first 指向第一个最小的元素，second 指向最后一个最大的元素
+     */
+    template<typename ForwardIter, typename Compared>
+    tinySTL::pair<ForwardIter, ForwardIter>  // 返回值
+    minmax_element(ForwardIter first, ForwardIter last, Compared comp) {
+        tinySTL::pair<ForwardIter, ForwardIter> result(first, first);
+        if (first == last) {
+            return result;
+        }
+        while (++first != last) {
+            if (comp(*first, *result.first)) {
+                result.first = first;
+            }
+            if (!comp(*first, *result.second)) {
+                result.second = first;
+            }
+        }
+        return result;
+    }
+
+    template<typename ForwardIter>
+    tinySTL::pair<ForwardIter, ForwardIter>  // 返回值
+    minmax_element_simd_dispatch(ForwardIter first, ForwardIter last, m_false_type) {
+        tinySTL::pair<ForwardIter, ForwardIter> result(first, first);
+        if (first == last) {
+            return result;
+        }
+        while (++first != last) {
+            if (*first < *result.first) {
+                result.first = first;
+            }
+            if (!(*first < *result.second)) {
+                result.second = first;
+            }
+        }
+        return result;
+    }
+
+    /* 连续的算术类型区间使用 SIMD 内核，浮点数中出现 NaN 时退回普通的循环 */
+    template<typename Ptr>
+    tinySTL::pair<Ptr, Ptr>  // 返回值
+    minmax_element_simd_dispatch(Ptr first, Ptr last, m_true_type) {
+        size_t lo = 0, hi = 0;
+        if (first != last && simd::minmax_index(first, static_cast<size_t>(last - first), lo, hi)) {
+            return tinySTL::pair<Ptr, Ptr>(first + lo, first + hi);
+        }
+        return tinySTL::minmax_element_simd_dispatch(first, last, m_false_type());
+    }
+
+    /*
+     * minmax_element 函数
+     * 缺省使用 operator< 进行比较
+     */
+    template<typename ForwardIter>
+    tinySTL::pair<ForwardIter, ForwardIter>  // 返回值
+    minmax_element(ForwardIter first, ForwardIter last) {
+        return tinySTL::minmax_element_simd_dispatch(first, last, simd::is_simd_range<ForwardIter>());
+    }
+
 
     // =================================================================================
 
@@ -1850,10 +2067,11 @@ namespace tinySTL {
             } else if (first2 == last2) {
                 *result = *first1++;
             } else {
-                if (*first1 < *first2) {
-                    *result = *first1++;
-                } else {
+                /* 两者相等时先取第一个序列的元素，保证合并是稳定的 */
+                if (*first2 < *first1) {
                     *result = *first2++;
+                } else {
+                    *result = *first1++;
                 }
             }
             ++result;
@@ -1874,10 +2092,10 @@ namespace tinySTL {
             } else if (first2 == last2) {
                 *result = *first1++;
             } else {
-                if (comp(*first1, *first2)) {
-                    *result = *first1++;
-                } else {
+                if (comp(*first2, *first1)) {
                     *result = *first2++;
+                } else {
+                    *result = *first1++;
                 }
             }
             ++result;
@@ -2195,45 +2413,6 @@ namespace tinySTL {
 
     // ==================================================================================
 
-    /*
-     * partial_sort 函数
-     * 对整个序列做部分排序，保证较小的 N 个元素以递增顺序置于[first, first + N)中
-     * 使用大根堆实现
-     */
-    template<typename RandomIter>
-    void partial_sort(RandomIter first, RandomIter middle, RandomIter last) {
-        /* 首先建立一个大根堆，大小为middle-first，因为只需要对这一部分机型排序 */
-        tinySTL::make_heap(first, middle);
-        for (RandomIter i = middle; i < last; ++i) {
-            /* 每一次将后面区间的一个值与根比较，如果比根小，那么将原来的根出堆，将*i加入堆中 */
-            if (*i < *first) {
-                tinySTL::pop_heap_aux(first, middle, i, *i, tinySTL::distance_type(first));
-            }
-        }
-        /* 将大根堆转化为排序状态 */
-        tinySTL::sort_heap(first, middle);
-    }
-
-    /*
-     * partial_sort 函数重载
-     * 重载版本使用函数对象 comp 代替比较操作
-     */
-    template<typename RandomIter, typename Compared>
-    void partial_sort(RandomIter first, RandomIter middle, RandomIter last, Compared comp) {
-        /* 首先建立一个大根堆，大小为middle-first，因为只需要对这一部分机型排序 */
-        tinySTL::make_heap(first, middle, comp);
-        for (RandomIter i = middle; i < last; ++i) {
-            /* 每一次将后面区间的一个值与根比较，如果比根小，那么将原来的根出堆，将*i加入堆中 */
-            if (comp(*i, *first)) {
-                tinySTL::pop_heap_aux(first, middle, i, *i, tinySTL::distance_type(first), comp);
-            }
-        }
-        /* 将大根堆转化为排序状态 */
-        tinySTL::sort_heap(first, middle, comp);
-    }
-
-    // =======================================================================================
-
     /*
      * partial_sort_copy 函数
      * 行为与 partial_sort 类似，不同的是把排序结果复制到 result 容器中
@@ -2381,28 +2560,16 @@ namespace tinySTL {
     /*
      * sort 系列函数
      * 将[first, last)内的元素以递增的方式排序
-     * kSmallSectionSize表示小型区间的大小，在这个大小内采用插入排序
+     * 采用 pattern-defeating quicksort(pdqsort)：
+     * 1. 小区间使用插入排序；大区间用 ninther(三组三数取中再取中)选取枢轴，较小区间用三数取中
+     * 2. 划分后若区间已经有序(没有发生交换)，尝试有限步数的插入排序，对已排序、逆序后再划分等模式接近线性
+     * 3. 划分极不平衡时打乱若干元素破坏可能的恶意模式，次数超过 log2(n) 时改用堆排序，保证 O(nlogn)
+     * 4. 算术类型配合 less/greater 比较时使用分块的无分支划分，先把比较结果写入偏移量缓冲区再批量交换，避免分支预测失败
      */
-    constexpr static size_t kSmallSectionSize = 128;
-
-    /*
-     * slg2 函数
-     * 辅助函数
-     * 用于控制分割恶化的情况,找到log_2^k<=n的最大K值
-     */
-    template<typename Size>
-    Size slg2(Size n) {
-        /* 找出 lgk <= n 的 k 的最大值 */
-        Size k = 0;
-        for (; n > 1; n >>= 1) {
-            ++k;
-        }
-        return k;
-    }
 
     /*
      * unchecked_partition 函数
-     * 快排中的分割函数，按照pivot将区间划分为凉拌
+     * 快排中的分割函数，按照pivot将区间划分为两半
      */
     template<typename RandomIter, typename T>
     RandomIter unchecked_partition(RandomIter first, RandomIter last, const T &pivot) {
@@ -2422,28 +2589,6 @@ namespace tinySTL {
         }
     }
 
-    /*
-     * intro_sort 函数
-     * 可见 侯捷老师的 STL源码分析
-     * 内省式排序，先进行 quick sort，当分割行为有恶化倾向时，改用 heap sort
-     */
-    template<typename RandomIter, typename Size>
-    void intro_sort(RandomIter first, RandomIter last, Size depth_limit) {
-        while (static_cast<size_t>(last - first) > kSmallSectionSize) {
-            /* 到达最大分割深度限制 */
-            if (depth_limit == 0) {
-                /* 改用 heap_sort */
-                tinySTL::partial_sort(first, last, last);
-                return;
-            }
-            --depth_limit;
-            auto mid = tinySTL::median(*first, *(first + (last - first) / 2), *(last - 1));
-            auto cut = tinySTL::unchecked_partition(first, last, mid);
-            tinySTL::intro_sort(cut, last, depth_limit);
-            last = cut;
-        }
-    }
-
     /*
      * unchecked_linear_insert 函数
      * 插入排序辅助函数
@@ -2460,17 +2605,6 @@ namespace tinySTL {
         *last = value;
     }
 
-    /*
-     * unchecked_insertion_sort 函数
-     * 插入排序辅助函数
-     */
-    template<typename RandomIter>
-    void unchecked_insertion_sort(RandomIter first, RandomIter last) {
-        for (RandomIter i = first; i != last; ++i) {
-            tinySTL::unchecked_linear_insert(i, *i);
-        }
-    }
-
     /*
      * insertion_sort 函数
      * 插入排序函数
@@ -2493,34 +2627,6 @@ namespace tinySTL {
         }
     }
 
-    /*
-     * final_insertion_sort 函数
-     * 最终插入排序函数
-     */
-    template<typename RandomIter>
-    void final_insertion_sort(RandomIter first, RandomIter last) {
-        if (static_cast<size_t>(last - first) > kSmallSectionSize) {
-            /* 若高于设定的值，前 kSmallSectionSize 个值使用 insertion_sort，后面使用 unchecked_insertion_sort */
-            tinySTL::insertion_sort(first, first + kSmallSectionSize);
-            tinySTL::unchecked_insertion_sort(first + kSmallSectionSize, last);
-        } else {
-            /* 若低于设定的值,采用insertion_sort */
-            tinySTL::insertion_sort(first, last);
-        }
-    }
-
-    /*
-     * sort 函数
-     */
-    template<typename RandomIter>
-    void sort(RandomIter first, RandomIter last) {
-        if (first != last) {
-            /* 内省式排序，将区间分为一个个小区间，然后对整体进行插入排序 */
-            tinySTL::intro_sort(first, last, slg2(last - first) * 2);
-            tinySTL::final_insertion_sort(first, last);
-        }
-    }
-
     /*
      * unchecked_partition 重载函数
      * 重载版本使用函数对象 comp 代替比较操作
@@ -2544,28 +2650,6 @@ namespace tinySTL {
         }
     }
 
-    /*
-     * intro_sort 重载函数
-     * 重载版本使用函数对象 comp 代替比较操作
-     */
-    template<typename RandomIter, typename Size, typename Compared>
-    void intro_sort(RandomIter first, RandomIter last,
-                    Size depth_limit, Compared comp) {
-        while (static_cast<size_t>(last - first) > kSmallSectionSize) {
-            /* 到达最大分割深度限制 */
-            if (depth_limit == 0) {
-                /* 改用 heap_sort */
-                tinySTL::partial_sort(first, last, last, comp);
-                return;
-            }
-            --depth_limit;
-            auto mid = tinySTL::median(*(first), *(first + (last - first) / 2), *(last - 1));
-            auto cut = tinySTL::unchecked_partition(first, last, mid, comp);
-            tinySTL::intro_sort(cut, last, depth_limit, comp);
-            last = cut;
-        }
-    }
-
     /*
      * unchecked_linear_insert 重载函数
      * 重载版本使用函数对象 comp 代替比较操作
@@ -2582,18 +2666,6 @@ namespace tinySTL {
         *last = value;
     }
 
-    /*
-     * unchecked_insertion_sort 重载函数
-     * 重载版本使用函数对象 comp 代替比较操作
-     */
-    template<typename RandomIter, typename Compared>
-    void unchecked_insertion_sort(RandomIter first, RandomIter last,
-                                  Compared comp) {
-        for (auto i = first; i != last; ++i) {
-            tinySTL::unchecked_linear_insert(i, *i, comp);
-        }
-    }
-
     /*
      * insertion_sort 重载函数
      * 重载版本使用函数对象 comp 代替比较操作
@@ -2614,17 +2686,438 @@ namespace tinySTL {
         }
     }
 
+    namespace pdqsort_detail {
+
+        /*
+         * 小于该大小的区间使用插入排序
+         */
+        const ptrdiff_t kInsertionSortThreshold = 24;
+
+        /*
+         * 大于该大小的区间使用 ninther 选取枢轴
+         */
+        const ptrdiff_t kNintherThreshold = 128;
+
+        /*
+         * 划分后区间看起来已经有序时，尝试插入排序允许移动的元素个数上限，超过则放弃
+         */
+        const size_t kPartialInsertionSortLimit = 8;
+
+        /*
+         * 无分支划分每次处理的块大小，偏移量用 unsigned char 保存，因此不能超过 256
+         */
+        const size_t kBlockSize = 64;
+
+        /*
+         * 算术类型且比较函数为 less 或 greater 时，比较没有副作用且代价很低，适合无分支划分
+         */
+        template<typename T, typename Compared>
+        struct is_branchless : public m_bool_constant<std::is_arithmetic<T>::value && (
+                std::is_same<Compared, tinySTL::less<T>>::value || std::is_same<Compared, tinySTL::greater<T>>::value ||
+                std::is_same<Compared, std::less<T>>::value || std::is_same<Compared, std::greater<T>>::value)> {
+        };
+
+        /*
+         * 插入排序，[first, last) 之前没有哨兵
+         */
+        template<typename RandomIter, typename Compared>
+        void insertion_sort(RandomIter first, RandomIter last, Compared comp) {
+            typedef typename iterator_traits<RandomIter>::value_type value_type;
+            if (first == last) {
+                return;
+            }
+            for (RandomIter cur = first + 1; cur != last; ++cur) {
+                RandomIter sift = cur;
+                RandomIter sift_1 = cur - 1;
+                if (comp(*sift, *sift_1)) {
+                    value_type tmp = tinySTL::move(*sift);
+                    do {
+                        *sift-- = tinySTL::move(*sift_1);
+                    } while (sift != first && comp(tmp, *--sift_1));
+                    *sift = tinySTL::move(tmp);
+                }
+            }
+        }
+
+        /*
+         * 插入排序，要求 first 之前的元素不大于区间内的任何元素，省去边界检查
+         */
+        template<typename RandomIter, typename Compared>
+        void unguarded_insertion_sort(RandomIter first, RandomIter last, Compared comp) {
+            typedef typename iterator_traits<RandomIter>::value_type value_type;
+            if (first == last) {
+                return;
+            }
+            for (RandomIter cur = first + 1; cur != last; ++cur) {
+                RandomIter sift = cur;
+                RandomIter sift_1 = cur - 1;
+                if (comp(*sift, *sift_1)) {
+                    value_type tmp = tinySTL::move(*sift);
+                    do {
+                        *sift-- = tinySTL::move(*sift_1);
+                    } while (comp(tmp, *--sift_1));
+                    *sift = tinySTL::move(tmp);
+                }
+            }
+        }
+
+        /*
+         * 尝试插入排序，移动的元素超过 kPartialInsertionSortLimit 个时放弃
+         * 返回值：区间是否已经排好序
+         */
+        template<typename RandomIter, typename Compared>
+        bool partial_insertion_sort(RandomIter first, RandomIter last, Compared comp) {
+            typedef typename iterator_traits<RandomIter>::value_type value_type;
+            if (first == last) {
+                return true;
+            }
+            size_t limit = 0;
+            for (RandomIter cur = first + 1; cur != last; ++cur) {
+                RandomIter sift = cur;
+                RandomIter sift_1 = cur - 1;
+                if (comp(*sift, *sift_1)) {
+                    value_type tmp = tinySTL::move(*sift);
+                    do {
+                        *sift-- = tinySTL::move(*sift_1);
+                    } while (sift != first && comp(tmp, *--sift_1));
+                    *sift = tinySTL::move(tmp);
+                    limit += static_cast<size_t>(cur - sift);
+                }
+                if (limit > kPartialInsertionSortLimit) {
+                    return false;
+                }
+            }
+            return true;
+        }
+
+        template<typename RandomIter, typename Compared>
+        void sort2(RandomIter a, RandomIter b, Compared comp) {
+            if (comp(*b, *a)) {
+                tinySTL::iter_swap(a, b);
+            }
+        }
+
+        /*
+         * 使 *a <= *b <= *c，中位数放在 b
+         */
+        template<typename RandomIter, typename Compared>
+        void sort3(RandomIter a, RandomIter b, RandomIter c, Compared comp) {
+            sort2(a, b, comp);
+            sort2(b, c, comp);
+            sort2(a, b, comp);
+        }
+
+        /*
+         * 按偏移量交换左右两侧放错位置的元素
+         * 两侧个数相同时逐对交换，否则用轮换减少一半的赋值
+         */
+        template<typename RandomIter>
+        void swap_offsets(RandomIter first, RandomIter last, const unsigned char *offsets_l,
+                          const unsigned char *offsets_r, size_t num, bool use_swaps) {
+            typedef typename iterator_traits<RandomIter>::value_type value_type;
+            if (use_swaps) {
+                for (size_t i = 0; i < num; ++i) {
+                    tinySTL::iter_swap(first + offsets_l[i], last - offsets_r[i]);
+                }
+            } else if (num > 0) {
+                RandomIter l = first + offsets_l[0];
+                RandomIter r = last - offsets_r[0];
+                value_type tmp(tinySTL::move(*l));
+                *l = tinySTL::move(*r);
+                for (size_t i = 1; i < num; ++i) {
+                    l = first + offsets_l[i];
+                    *r = tinySTL::move(*l);
+                    r = last - offsets_r[i];
+                    *l = tinySTL::move(*r);
+                }
+                *r = tinySTL::move(tmp);
+            }
+        }
+
+        /*
+         * 以 *first 为枢轴划分区间，等于枢轴的元素放在右侧
+         * 返回值：枢轴的最终位置，以及划分前区间是否已经划分好
+         * 左右两侧各取一块，先无分支地记录放错位置的元素偏移量，再成对交换
+         */
+        template<typename RandomIter, typename Compared>
+        pair<RandomIter, bool> partition_right_branchless(RandomIter begin, RandomIter end, Compared comp) {
+            typedef typename iterator_traits<RandomIter>::value_type value_type;
+            value_type pivot(tinySTL::move(*begin));
+            RandomIter first = begin;
+            RandomIter last = end;
+            // 枢轴是三个元素的中位数，左侧一定存在不小于枢轴的元素，第一个循环不会越界
+            while (comp(*++first, pivot)) {
+            }
+            if (first - 1 == begin) {
+                while (first < last && !comp(*--last, pivot)) {
+                }
+            } else {
+                while (!comp(*--last, pivot)) {
+                }
+            }
+            const bool already_partitioned = first >= last;
+            if (!already_partitioned) {
+                tinySTL::iter_swap(first, last);
+                ++first;
+                unsigned char offsets_l[kBlockSize];
+                unsigned char offsets_r[kBlockSize];
+                RandomIter offsets_l_base = first;
+                RandomIter offsets_r_base = last;
+                size_t num_l = 0, num_r = 0, start_l = 0, start_r = 0;
+                while (first < last) {
+                    const size_t num_unknown = static_cast<size_t>(last - first);
+                    const size_t left_split = num_l == 0 ? (num_r == 0 ? num_unknown / 2 : num_unknown) : 0;
+                    const size_t right_split = num_r == 0 ? (num_unknown - left_split) : 0;
+                    // 记录左侧不小于枢轴、右侧小于枢轴的元素的偏移量，比较结果直接参与计数，没有分支
+                    if (left_split >= kBlockSize) {
+                        for (size_t i = 0; i < kBlockSize;) {
+                            offsets_l[num_l] = static_cast<unsigned char>(i++);
+                            num_l += !comp(*first, pivot);
+                            ++first;
+                            offsets_l[num_l] = static_cast<unsigned char>(i++);
+                            num_l += !comp(*first, pivot);
+                            ++first;
+                            offsets_l[num_l] = static_cast<unsigned char>(i++);
+                            num_l += !comp(*first, pivot);
+                            ++first;
+                            offsets_l[num_l] = static_cast<unsigned char>(i++);
+                            num_l += !comp(*first, pivot);
+                            ++first;
+                        }
+                    } else {
+                        for (size_t i = 0; i < left_split;) {
+                            offsets_l[num_l] = static_cast<unsigned char>(i++);
+                            num_l += !comp(*first, pivot);
+                            ++first;
+                        }
+                    }
+                    if (right_split >= kBlockSize) {
+                        for (size_t i = 0; i < kBlockSize;) {
+                            offsets_r[num_r] = static_cast<unsigned char>(++i);
+                            num_r += comp(*--last, pivot);
+                            offsets_r[num_r] = static_cast<unsigned char>(++i);
+                            num_r += comp(*--last, pivot);
+                            offsets_r[num_r] = static_cast<unsigned char>(++i);
+                            num_r += comp(*--last, pivot);
+                            offsets_r[num_r] = static_cast<unsigned char>(++i);
+                            num_r += comp(*--last, pivot);
+                        }
+                    } else {
+                        for (size_t i = 0; i < right_split;) {
+                            offsets_r[num_r] = static_cast<unsigned char>(++i);
+                            num_r += comp(*--last, pivot);
+                        }
+                    }
+                    const size_t num = num_l < num_r ? num_l : num_r;
+                    swap_offsets(offsets_l_base, offsets_r_base, offsets_l + start_l, offsets_r + start_r,
+                                 num, num_l == num_r);
+                    num_l -= num;
+                    num_r -= num;
+                    start_l += num;
+                    start_r += num;
+                    if (num_l == 0) {
+                        start_l = 0;
+                        offsets_l_base = first;
+                    }
+                    if (num_r == 0) {
+                        start_r = 0;
+                        offsets_r_base = last;
+                    }
+                }
+                // 只剩一侧还有放错位置的元素，把它们交换到中间
+                if (num_l != 0) {
+                    while (num_l--) {
+                        tinySTL::iter_swap(offsets_l_base + offsets_l[start_l + num_l], --last);
+                    }
+                    first = last;
+                }
+                if (num_r != 0) {
+                    while (num_r--) {
+                        tinySTL::iter_swap(offsets_r_base - offsets_r[start_r + num_r], first);
+                        ++first;
+                    }
+                    last = first;
+                }
+            }
+            RandomIter pivot_pos = first - 1;
+            *begin = tinySTL::move(*pivot_pos);
+            *pivot_pos = tinySTL::move(pivot);
+            return pair<RandomIter, bool>(pivot_pos, already_partitioned);
+        }
+
+        /*
+         * 以 *first 为枢轴划分区间，等于枢轴的元素放在右侧，普通的 Hoare 划分
+         */
+        template<typename RandomIter, typename Compared>
+        pair<RandomIter, bool> partition_right(RandomIter begin, RandomIter end, Compared comp) {
+            typedef typename iterator_traits<RandomIter>::value_type value_type;
+            value_type pivot(tinySTL::move(*begin));
+            RandomIter first = begin;
+            RandomIter last = end;
+            while (comp(*++first, pivot)) {
+            }
+            if (first - 1 == begin) {
+                while (first < last && !comp(*--last, pivot)) {
+                }
+            } else {
+                while (!comp(*--last, pivot)) {
+                }
+            }
+            const bool already_partitioned = first >= last;
+            while (first < last) {
+                tinySTL::iter_swap(first, last);
+                while (comp(*++first, pivot)) {
+                }
+                while (!comp(*--last, pivot)) {
+                }
+            }
+            RandomIter pivot_pos = first - 1;
+            *begin = tinySTL::move(*pivot_pos);
+            *pivot_pos = tinySTL::move(pivot);
+            return pair<RandomIter, bool>(pivot_pos, already_partitioned);
+        }
+
+        /*
+         * 以 *first 为枢轴划分区间，等于枢轴的元素放在左侧
+         * 当枢轴等于左侧相邻区间的最大值时调用，此时左侧部分全部等于枢轴，无需再排序，大量重复元素时为线性
+         */
+        template<typename RandomIter, typename Compared>
+        RandomIter partition_left(RandomIter begin, RandomIter end, Compared comp) {
+            typedef typename iterator_traits<RandomIter>::value_type value_type;
+            value_type pivot(tinySTL::move(*begin));
+            RandomIter first = begin;
+            RandomIter last = end;
+            while (comp(pivot, *--last)) {
+            }
+            if (last + 1 == end) {
+                while (first < last && !comp(pivot, *++first)) {
+                }
+            } else {
+                while (!comp(pivot, *++first)) {
+                }
+            }
+            while (first < last) {
+                tinySTL::iter_swap(first, last);
+                while (comp(pivot, *--last)) {
+                }
+                while (!comp(pivot, *++first)) {
+                }
+            }
+            RandomIter pivot_pos = last;
+            *begin = tinySTL::move(*pivot_pos);
+            *pivot_pos = tinySTL::move(pivot);
+            return pivot_pos;
+        }
+
+        template<typename RandomIter, typename Compared>
+        pair<RandomIter, bool> partition_dispatch(RandomIter begin, RandomIter end, Compared comp, m_true_type) {
+            return partition_right_branchless(begin, end, comp);
+        }
+
+        template<typename RandomIter, typename Compared>
+        pair<RandomIter, bool> partition_dispatch(RandomIter begin, RandomIter end, Compared comp, m_false_type) {
+            return partition_right(begin, end, comp);
+        }
+
+        /*
+         * pdqsort 主循环，对较短的一侧递归，较长的一侧继续循环
+         * bad_allowed 为还允许出现的不平衡划分次数，leftmost 表示区间左侧是否没有哨兵
+         */
+        template<typename RandomIter, typename Compared, typename Branchless>
+        void pdqsort_loop(RandomIter begin, RandomIter end, Compared comp, int bad_allowed,
+                          bool leftmost, Branchless branchless) {
+            while (true) {
+                const ptrdiff_t size = end - begin;
+                if (size < kInsertionSortThreshold) {
+                    if (leftmost) {
+                        pdqsort_detail::insertion_sort(begin, end, comp);
+                    } else {
+                        pdqsort_detail::unguarded_insertion_sort(begin, end, comp);
+                    }
+                    return;
+                }
+                // 选取枢轴并放到 *begin
+                const ptrdiff_t s2 = size / 2;
+                if (size > kNintherThreshold) {
+                    sort3(begin, begin + s2, end - 1, comp);
+                    sort3(begin + 1, begin + (s2 - 1), end - 2, comp);
+                    sort3(begin + 2, begin + (s2 + 1), end - 3, comp);
+                    sort3(begin + (s2 - 1), begin + s2, begin + (s2 + 1), comp);
+                    tinySTL::iter_swap(begin, begin + s2);
+                } else {
+                    sort3(begin + s2, begin, end - 1, comp);
+                }
+                // 枢轴与左侧相邻元素相等，说明区间内有大量与之相等的元素，把它们集中到左侧后跳过
+                if (!leftmost && !comp(*(begin - 1), *begin)) {
+                    begin = partition_left(begin, end, comp) + 1;
+                    continue;
+                }
+                pair<RandomIter, bool> part = partition_dispatch(begin, end, comp, branchless);
+                RandomIter pivot_pos = part.first;
+                const ptrdiff_t l_size = pivot_pos - begin;
+                const ptrdiff_t r_size = end - (pivot_pos + 1);
+                if (l_size < size / 8 || r_size < size / 8) {
+                    // 划分极不平衡，次数用完后改用堆排序
+                    if (--bad_allowed == 0) {
+                        tinySTL::make_heap(begin, end, comp);
+                        tinySTL::sort_heap(begin, end, comp);
+                        return;
+                    }
+                    // 交换若干元素打破可能导致退化的模式
+                    if (l_size >= kInsertionSortThreshold) {
+                        tinySTL::iter_swap(begin, begin + l_size / 4);
+                        tinySTL::iter_swap(pivot_pos - 1, pivot_pos - l_size / 4);
+                        if (l_size > kNintherThreshold) {
+                            tinySTL::iter_swap(begin + 1, begin + (l_size / 4 + 1));
+                            tinySTL::iter_swap(begin + 2, begin + (l_size / 4 + 2));
+                            tinySTL::iter_swap(pivot_pos - 2, pivot_pos - (l_size / 4 + 1));
+                            tinySTL::iter_swap(pivot_pos - 3, pivot_pos - (l_size / 4 + 2));
+                        }
+                    }
+                    if (r_size >= kInsertionSortThreshold) {
+                        tinySTL::iter_swap(pivot_pos + 1, pivot_pos + (1 + r_size / 4));
+                        tinySTL::iter_swap(end - 1, end - r_size / 4);
+                        if (r_size > kNintherThreshold) {
+                            tinySTL::iter_swap(pivot_pos + 2, pivot_pos + (2 + r_size / 4));
+                            tinySTL::iter_swap(pivot_pos + 3, pivot_pos + (3 + r_size / 4));
+                            tinySTL::iter_swap(end - 2, end - (1 + r_size / 4));
+                            tinySTL::iter_swap(end - 3, end - (2 + r_size / 4));
+                        }
+                    }
+                } else if (part.second && partial_insertion_sort(begin, pivot_pos, comp)
+                           && partial_insertion_sort(pivot_pos + 1, end, comp)) {
+                    // 划分时没有发生交换，并且两侧都几乎有序，说明整个区间已经有序
+                    return;
+                }
+                pdqsort_loop(begin, pivot_pos, comp, bad_allowed, leftmost, branchless);
+                begin = pivot_pos + 1;
+                leftmost = false;
+            }
+        }
+
+        /*
+         * 允许的不平衡划分次数为 log2(n)
+         */
+        template<typename Size>
+        int log2(Size n) {
+            int k = 0;
+            for (; n > 1; n >>= 1) {
+                ++k;
+            }
+            return k;
+        }
+
+    }  // namespace pdqsort_detail
+
     /*
-     * final_insertion_sort 重载函数
-     * 重载版本使用函数对象 comp 代替比较操作
+     * sort 函数
      */
-    template<typename RandomIter, typename Compared>
-    void final_insertion_sort(RandomIter first, RandomIter last, Compared comp) {
-        if (static_cast<size_t>(last - first) > kSmallSectionSize) {
-            tinySTL::insertion_sort(first, first + kSmallSectionSize, comp);
-            tinySTL::unchecked_insertion_sort(first + kSmallSectionSize, last, comp);
-        } else {
-            tinySTL::insertion_sort(first, last, comp);
+    template<typename RandomIter>
+    void sort(RandomIter first, RandomIter last) {
+        typedef typename iterator_traits<RandomIter>::value_type value_type;
+        if (last - first > 1) {
+            pdqsort_detail::pdqsort_loop(first, last, tinySTL::less<value_type>(), pdqsort_detail::log2(last - first),
+                                         true, pdqsort_detail::is_branchless<value_type, tinySTL::less<value_type>>());
         }
     }
 
@@ -2634,37 +3127,285 @@ namespace tinySTL {
      */
     template<typename RandomIter, typename Compared>
     void sort(RandomIter first, RandomIter last, Compared comp) {
-        if (first != last) {
-            // 内省式排序，将区间分为一个个小区间，然后对整体进行插入排序
-            tinySTL::intro_sort(first, last, slg2(last - first) * 2, comp);
-            tinySTL::final_insertion_sort(first, last, comp);
+        typedef typename iterator_traits<RandomIter>::value_type value_type;
+        if (last - first > 1) {
+            pdqsort_detail::pdqsort_loop(first, last, comp, pdqsort_detail::log2(last - first), true,
+                                         pdqsort_detail::is_branchless<value_type, Compared>());
         }
     }
 
     // =========================================================================================
 
     /*
-     * nth_element 函数
+     * stable_sort 函数
+     * 类似 timsort：先找出输入中已有的升序段与严格降序段(翻转为升序)，过短的段用插入排序补足到 min_run，
+     * 段压入栈中并按长度规则合并。申请到半个区间大小的缓冲区时每次合并都只需一次复制，
+     * 缓冲区不足时退化为分割递归的 merge_adaptive，申请失败时使用不需要缓冲区的 merge_without_buffer
+     */
+    namespace stable_sort_detail {
+
+        /*
+         * 段栈的最大深度，栈中段的长度至少按斐波那契数列增长，足以容纳 2^64 个元素
+         */
+        const size_t kMaxRuns = 96;
+
+        /*
+         * 最短段的长度落在 [kMinRunLimit / 2, kMinRunLimit] 中，并使 n / min_run 接近且不超过 2 的幂
+         */
+        const ptrdiff_t kMinRunLimit = 32;
+
+        template<typename Distance>
+        Distance min_run(Distance n) {
+            Distance r = 0;
+            while (n >= kMinRunLimit) {
+                r |= n & 1;
+                n >>= 1;
+            }
+            return n + r;
+        }
+
+        /*
+         * 返回从 first 开始的有序段的末尾，严格降序的段会被翻转，非严格降序不翻转以免破坏稳定性
+         */
+        template<typename RandomIter, typename Compared>
+        RandomIter count_run(RandomIter first, RandomIter last, Compared comp) {
+            RandomIter run_end = first + 1;
+            if (run_end == last) {
+                return last;
+            }
+            if (comp(*run_end, *first)) {
+                while (++run_end != last && comp(*run_end, *(run_end - 1))) {
+                }
+                tinySTL::reverse(first, run_end);
+            } else {
+                while (++run_end != last && !comp(*run_end, *(run_end - 1))) {
+                }
+            }
+            return run_end;
+        }
+
+        /*
+         * 合并相邻的两个有序段，先跳过第一段中已经位于最终位置的前缀和第二段中已经位于最终位置的后缀，
+         * 几乎有序的输入中两段往往只有很少的元素交错
+         */
+        template<typename RandomIter, typename Pointer, typename Distance, typename Compared>
+        void merge_runs(RandomIter first, RandomIter middle, RandomIter last,
+                        Pointer buffer, Distance buffer_size, Compared comp) {
+            first = tinySTL::upper_bound(first, middle, *middle, comp);
+            if (first == middle) {
+                return;
+            }
+            last = tinySTL::lower_bound(middle, last, *(middle - 1), comp);
+            const Distance len1 = middle - first;
+            const Distance len2 = last - middle;
+            if (buffer_size == 0) {
+                tinySTL::merge_without_buffer(first, middle, last, len1, len2, comp);
+            } else {
+                tinySTL::merge_adaptive(first, middle, last, len1, len2, buffer, buffer_size, comp);
+            }
+        }
+
+        template<typename RandomIter, typename Compared>
+        void timsort(RandomIter first, RandomIter last, Compared comp) {
+            typedef typename iterator_traits<RandomIter>::value_type value_type;
+            typedef typename iterator_traits<RandomIter>::difference_type Distance;
+            const Distance n = last - first;
+            if (n < 2) {
+                return;
+            }
+            /* 整个区间本身就是一个段时不需要申请缓冲区 */
+            RandomIter run_end = stable_sort_detail::count_run(first, last, comp);
+            if (run_end == last) {
+                return;
+            }
+            /* 任意一次合并中较短的段都不超过 n / 2 */
+            tinySTL::temporary_buffer<RandomIter, value_type> buf(first, first + n / 2);
+            const Distance buffer_size = buf.begin() ? static_cast<Distance>(buf.size()) : 0;
+            const Distance run_min = stable_sort_detail::min_run(n);
+            Distance run_base[kMaxRuns];
+            Distance run_len[kMaxRuns];
+            size_t runs = 0;
+            /* 合并栈中第 i 段与第 i + 1 段 */
+            auto merge_at = [&](size_t i) {
+                stable_sort_detail::merge_runs(first + run_base[i], first + run_base[i + 1],
+                                               first + run_base[i + 1] + run_len[i + 1],
+                                               buf.begin(), buffer_size, comp);
+                run_len[i] += run_len[i + 1];
+                if (i + 2 < runs) {
+                    run_base[i + 1] = run_base[i + 2];
+                    run_len[i + 1] = run_len[i + 2];
+                }
+                --runs;
+            };
+            RandomIter cur = first;
+            while (true) {
+                Distance len = run_end - cur;
+                if (len < run_min) {
+                    /* 段过短，用插入排序扩展到 run_min，已有序的前缀只会比较一次 */
+                    const Distance force = n - (cur - first) < run_min ? n - (cur - first) : run_min;
+                    pdqsort_detail::insertion_sort(cur, cur + force, comp);
+                    len = force;
+                }
+                run_base[runs] = cur - first;
+                run_len[runs] = len;
+                ++runs;
+                /*
+                 * 保持栈中自底向上 len[i - 2] > len[i - 1] + len[i] 且 len[i - 1] > len[i]，
+                 * 使合并的两段长度接近，并让栈深度只有对数级
+                 */
+                while (runs > 1) {
+                    size_t i = runs - 2;
+                    if ((i > 0 && run_len[i - 1] <= run_len[i] + run_len[i + 1])
+                        || (i > 1 && run_len[i - 2] <= run_len[i - 1] + run_len[i])) {
+                        if (run_len[i - 1] < run_len[i + 1]) {
+                            --i;
+                        }
+                    } else if (run_len[i] > run_len[i + 1]) {
+                        break;
+                    }
+                    merge_at(i);
+                }
+                cur += len;
+                if (cur == last) {
+                    break;
+                }
+                run_end = stable_sort_detail::count_run(cur, last, comp);
+            }
+            while (runs > 1) {
+                merge_at(runs - 2);
+            }
+        }
+
+    }  // namespace stable_sort_detail
+
+    /*
+     * stable_sort 函数
+     * 排序并保持相等元素的相对次序
+     */
+    template<typename RandomIter>
+    void stable_sort(RandomIter first, RandomIter last) {
+        typedef typename iterator_traits<RandomIter>::value_type value_type;
+        stable_sort_detail::timsort(first, last, tinySTL::less<value_type>());
+    }
+
+    /*
+     * stable_sort 重载函数
+     * 重载版本使用函数对象 comp 代替比较操作
+     */
+    template<typename RandomIter, typename Compared>
+    void stable_sort(RandomIter first, RandomIter last, Compared comp) {
+        stable_sort_detail::timsort(first, last, comp);
+    }
+
+    // =========================================================================================
+
+    /*
+     * nth_element 系列函数
      * 对序列重排，使得所有小于第 n 个元素的元素出现在它的前面，大于它的出现在它的后面
+     * 采用 introselect：与 pdqsort 相同的枢轴选取与划分，只在 nth 所在的一侧继续；
+     * 继续的一侧超过区间的 7/8 视为一次失败的划分，累计 kBadAllowed 次后改用中位数的中位数(median of medians)
+     * 选取枢轴。失败次数是常数，成功的划分使区间按几何级数缩小，因此最坏也是 O(n)
+     */
+    namespace select_detail {
+
+        /*
+         * 改用中位数的中位数之前允许的失败划分次数
+         */
+        const int kBadAllowed = 4;
+
+        /*
+         * 中位数的中位数：每 5 个元素一组求出中位数并依次换到区间开头，再在这些中位数中选出中位数
+         * 返回值：选出的枢轴的位置。它不小于、也不大于区间中约 3/10 的元素
+         */
+        template<typename RandomIter, typename Compared, typename Branchless>
+        RandomIter median_of_medians(RandomIter first, RandomIter last, Compared comp,
+                                     bool leftmost, Branchless branchless);
+
+        /*
+         * introselect 主循环，bad_allowed 为还允许出现的不平衡划分次数，为 0 时每次都用中位数的中位数选取枢轴
+         * leftmost 表示区间左侧是否没有哨兵，否则 *(first - 1) 不大于区间内的任何元素
+         */
+        template<typename RandomIter, typename Compared, typename Branchless>
+        void introselect(RandomIter first, RandomIter nth, RandomIter last, Compared comp, int bad_allowed,
+                         bool leftmost, Branchless branchless) {
+            while (true) {
+                const ptrdiff_t size = last - first;
+                if (size < pdqsort_detail::kInsertionSortThreshold) {
+                    if (leftmost) {
+                        pdqsort_detail::insertion_sort(first, last, comp);
+                    } else {
+                        pdqsort_detail::unguarded_insertion_sort(first, last, comp);
+                    }
+                    return;
+                }
+                // 选取枢轴并放到 *first
+                if (bad_allowed > 0) {
+                    const ptrdiff_t s2 = size / 2;
+                    if (size > pdqsort_detail::kNintherThreshold) {
+                        pdqsort_detail::sort3(first, first + s2, last - 1, comp);
+                        pdqsort_detail::sort3(first + 1, first + (s2 - 1), last - 2, comp);
+                        pdqsort_detail::sort3(first + 2, first + (s2 + 1), last - 3, comp);
+                        pdqsort_detail::sort3(first + (s2 - 1), first + s2, first + (s2 + 1), comp);
+                        tinySTL::iter_swap(first, first + s2);
+                    } else {
+                        pdqsort_detail::sort3(first + s2, first, last - 1, comp);
+                    }
+                } else {
+                    tinySTL::iter_swap(first, select_detail::median_of_medians(first, last, comp, leftmost,
+                                                                               branchless));
+                }
+                // 枢轴与左侧相邻元素相等：与之相等的元素集中到左侧，nth 落在其中时已经完成
+                if (!leftmost && !comp(*(first - 1), *first)) {
+                    RandomIter equal_end = pdqsort_detail::partition_left(first, last, comp) + 1;
+                    if (nth < equal_end) {
+                        return;
+                    }
+                    first = equal_end;
+                    continue;
+                }
+                RandomIter pivot_pos = pdqsort_detail::partition_dispatch(first, last, comp, branchless).first;
+                if (pivot_pos == nth) {
+                    return;
+                }
+                if (nth < pivot_pos) {
+                    last = pivot_pos;
+                } else {
+                    first = pivot_pos + 1;
+                    leftmost = false;
+                }
+                if (bad_allowed > 0 && last - first > size - size / 8) {
+                    --bad_allowed;
+                }
+            }
+        }
+
+        template<typename RandomIter, typename Compared, typename Branchless>
+        RandomIter median_of_medians(RandomIter first, RandomIter last, Compared comp,
+                                     bool leftmost, Branchless branchless) {
+            RandomIter store = first;
+            for (RandomIter group = first; last - group >= 5; group += 5) {
+                pdqsort_detail::insertion_sort(group, group + 5, comp);
+                tinySTL::iter_swap(store, group + 2);
+                ++store;
+            }
+            RandomIter mid = first + (store - first) / 2;
+            select_detail::introselect(first, mid, store, comp, 0, leftmost, branchless);
+            return mid;
+        }
+
+    }  // namespace select_detail
+
+    /*
+     * nth_element 函数
      */
     template<typename RandomIter>
     void nth_element(RandomIter first, RandomIter nth, RandomIter last) {
+        typedef typename iterator_traits<RandomIter>::value_type value_type;
         if (nth == last) {
             return;
         }
-        while (last - first > 3) {
-            RandomIter cut = tinySTL::unchecked_partition(first, last, tinySTL::median(*first,
-                                                                                       *(first + (last - first) / 2),
-                                                                                       *(last - 1)));
-            /* 如果 nth 位于右段,对右段进行分割 */
-            if (cut <= nth) {
-                first = cut;
-            } else {
-                /* 对左段进行分割 */
-                last = cut;
-            }
-        }
-        tinySTL::insertion_sort(first, last);
+        select_detail::introselect(first, nth, last, tinySTL::less<value_type>(), select_detail::kBadAllowed, true,
+                                   pdqsort_detail::is_branchless<value_type, tinySTL::less<value_type>>());
     }
 
     /*
@@ -2673,22 +3414,91 @@ namespace tinySTL {
      */
     template<typename RandomIter, typename Compared>
     void nth_element(RandomIter first, RandomIter nth, RandomIter last, Compared comp) {
+        typedef typename iterator_traits<RandomIter>::value_type value_type;
         if (nth == last) {
             return;
         }
-        while (last - first > 3) {
-            RandomIter cut = tinySTL::unchecked_partition(first, last, tinySTL::median(*first,
-                                                                                       *(first + (last - first) / 2),
-                                                                                       *(last - 1)), comp);
-            /* 如果 nth 位于右段,对右段进行分割 */
-            if (cut <= nth) {
-                first = cut;
-            } else {
-                /* 对左段进行分割 */
-                last = cut;
+        select_detail::introselect(first, nth, last, comp, select_detail::kBadAllowed, true,
+                                   pdqsort_detail::is_branchless<value_type, Compared>());
+    }
+
+    // ==================================================================================
+
+    /*
+     * partial_sort 函数
+     * 对整个序列做部分排序，保证较小的 N 个元素以递增顺序置于[first, first + N)中
+     * N 相对区间长度很小时使用大根堆，大部分元素只需要与堆顶比较一次；
+     * 否则(或者堆顶被替换得过于频繁，例如逆序的输入)先用 nth_element 选出较小的 N 个元素再排序，
+     * 复杂度为 O(n + NlogN)，并且是顺序访问
+     */
+    namespace partial_sort_detail {
+
+        /*
+         * 小于该长度的区间总是使用堆
+         */
+        const ptrdiff_t kHeapThreshold = 1024;
+
+        /*
+         * N 不超过区间长度的 1 / kHeapRatio 时先尝试使用堆
+         */
+        const ptrdiff_t kHeapRatio = 512;
+
+        /*
+         * 堆顶被替换的次数超过区间长度的 1 / kReplaceRatio 时放弃堆
+         */
+        const ptrdiff_t kReplaceRatio = 16;
+
+        /*
+         * 用大根堆选出较小的 N 个元素并排序，堆顶被替换超过 limit 次时放弃
+         * 返回值：是否完成。放弃时区间仍然是原来元素的一个排列
+         */
+        template<typename RandomIter, typename Distance, typename Compared>
+        bool heap_select(RandomIter first, RandomIter middle, RandomIter last, Distance limit, Compared comp) {
+            /* 首先建立一个大根堆，大小为middle-first，因为只需要对这一部分进行排序 */
+            tinySTL::make_heap(first, middle, comp);
+            for (RandomIter i = middle; i < last; ++i) {
+                /* 每一次将后面区间的一个值与根比较，如果比根小，那么将原来的根出堆，将*i加入堆中 */
+                if (comp(*i, *first)) {
+                    if (--limit < 0) {
+                        return false;
+                    }
+                    tinySTL::pop_heap_aux(first, middle, i, *i, tinySTL::distance_type(first), comp);
+                }
             }
+            /* 将大根堆转化为排序状态 */
+            tinySTL::sort_heap(first, middle, comp);
+            return true;
+        }
+
+    }  // namespace partial_sort_detail
+
+    template<typename RandomIter, typename Compared>
+    void partial_sort(RandomIter first, RandomIter middle, RandomIter last, Compared comp) {
+        const auto k = middle - first;
+        const auto n = last - first;
+        if (k == 0) {
+            return;
+        }
+        if (n < partial_sort_detail::kHeapThreshold) {
+            partial_sort_detail::heap_select(first, middle, last, n, comp);
+            return;
+        }
+        if (k <= n / partial_sort_detail::kHeapRatio
+            && partial_sort_detail::heap_select(first, middle, last, n / partial_sort_detail::kReplaceRatio, comp)) {
+            return;
         }
-        tinySTL::insertion_sort(first, last, comp);
+        tinySTL::nth_element(first, middle, last, comp);
+        tinySTL::sort(first, middle, comp);
+    }
+
+    /*
+     * partial_sort 函数重载
+     * 不带 comp 的版本使用 less
+     */
+    template<typename RandomIter>
+    void partial_sort(RandomIter first, RandomIter middle, RandomIter last) {
+        typedef typename iterator_traits<RandomIter>::value_type value_type;
+        tinySTL::partial_sort(first, middle, last, tinySTL::less<value_type>());
     }
 
     // ================================================================================
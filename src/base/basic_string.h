@@ -15,367 +15,14 @@
 #include "memory.h"  /* 这个头文件负责更高级的动态内存管理,包含一些基本函数、空间配置器、未初始化的储存空间管理，以及一个模板类 auto_ptr */
 #include "functional.h"  /* 这个头文件包含了 tinySTL 的函数对象与哈希函数 */
 #include "exceptdef.h"  /* 此文件中定义了异常相关的宏 */
+#include "char_traits.h"  /* 这个头文件包含一个模板类 char_traits，用于萃取不同字符类型的基本操作 */
+#include "str_algo.h"  /* 这个头文件包含字符串的子串查找算法 */
+#include "string_view.h"  /* 这个头文件包含一个模板类 basic_string_view，用于表示不拥有内存的字符串视图 */
+#include "stream_io.h"  /* 这个头文件包含字符串与标准流之间的批量读写 */
 
 /* 首先定义自己的命名空间 */
 namespace tinySTL {
 
-    /*
-     * 针对不同的字符类型萃取出相应的数据
-     * char_traits模板类中包含有五个静态方法
-     * length()获取长度
-     * compare()比较大小
-     * copy()赋值数据
-     * move()移动数据
-     * fill()填充数据
-     */
-    template<typename CharType>
-    struct char_traits {
-        /*
-         * 定义类型别名
-         */
-        typedef CharType char_type;
-
-        /*
-         * 计算指针所指字符串的长度
-         */
-        static size_t length(const char_type *str) {
-            size_t len = 0;
-            /* char_type(0)为类似'\0'的终止符 */
-            for (; *str != char_type(0); ++str) {
-                ++len;
-            }
-            return len;
-        }
-
-        /*
-         * 比较两个字符串的大小
-         */
-        static int compare(const char_type *s1, const char_type *s2, size_t n) {
-            for (; n != 0; --n, ++s1, ++s2) {
-                if (*s1 < *s2) {
-                    return -1;
-                }
-                if (*s2 < *s1) {
-                    return 1;
-                }
-            }
-            return 0;
-        }
-
-        /*
-         * 将源字符串复制到目的字符串,,这两个字符串不可以相交
-         */
-        static char_type *copy(char_type *dst, const char_type *src, size_t n) {
-            /* 表示这两个字符串在内存空间中不能相交 */
-            TINYSTL_DEBUG(src + n <= dst || dst + n <= src);
-            char_type *r = dst;
-            for (; n != 0; --n, ++dst, ++src) {
-                *dst = *src;
-            }
-            return r;
-        }
-
-        /*
-         * 将源字符串移动到目的字符串,这两个字符串可以相交
-         */
-        static char_type *move(char_type *dst, const char_type *src, size_t n) {
-            char_type *r = dst;
-            /* 根据在内存中的相对位置,选择如何进行移动 */
-            if (dst < src) {
-                /* 从头开始正向复制 */
-                for (; n != 0; --n, ++dst, ++src) {
-                    *dst = *src;
-                }
-            } else if (src < dst) {
-                /* 从尾开始反向复制 */
-                dst += n;
-                src += n;
-                for (; n != 0; --n) {
-                    *--dst = *--src;
-                }
-            }
-            return r;
-        }
-
-        /*
-         * 使用字符ch填充指定大小的空间
-         */
-        static char_type *fill(char_type *dst, char_type ch, size_t count) {
-            char_type *r = dst;
-            for (; count > 0; --count, ++dst) {
-                *dst = ch;
-            }
-            return r;
-        }
-    };
-
-    /*
-     * 对char类型的全特化
-     * char类型的特化中使用库函数完成
-     */
-    template<>
-    struct char_traits<char> {
-        /*
-         * 定义类中使用的类型别名
-         */
-        typedef char char_type;
-
-        /*
-         * 计算指针所指字符串的长度
-         */
-        static size_t length(const char_type *str) noexcept {
-            return std::strlen(str);
-        }
-
-        /*
-         * 比较两个字符串的大小
-         */
-        static int compare(const char_type *s1, const char_type *s2, size_t n) noexcept {
-            return std::memcmp(s1, s2, n);
-        }
-
-        /*
-         * 将源字符串复制到目的字符串,,这两个字符串不可以相交
-         */
-        static char_type *copy(char_type *dst, const char_type *src, size_t n) {
-            TINYSTL_DEBUG(src + n <= dst || dst + n <= src);
-            return static_cast<char_type *>(std::memcpy(dst, src, n));
-        }
-
-        /*
-         * 将源字符串移动到目的字符串,这两个字符串可以相交
-         */
-        static char_type *move(char_type *dst, const char_type *src, size_t n) {
-            return static_cast<char_type *>(std::memmove(dst, src, n));
-        }
-
-        /*
-         * 使用字符ch填充指定大小的空间
-         */
-        static char_type *fill(char_type *dst, char_type ch, size_t count) {
-            return static_cast<char_type *>(std::memset(dst, ch, count));
-        }
-    };
-
-    /*
-     * 对wchar_t类型的全特化
-     * wchar_t类型的特化中使用库函数完成
-     */
-    template<>
-    struct char_traits<wchar_t> {
-        /*
-         * 定义类中使用的类型别名
-         */
-        typedef wchar_t char_type;
-
-        /*
-         * 计算指针所指字符串的长度
-         */
-        static size_t length(const char_type *str) noexcept {
-            return std::wcslen(str);
-        }
-
-        /*
-         * 比较两个字符串的大小
-         */
-        static int compare(const char_type *s1, const char_type *s2, size_t n) noexcept {
-            return std::wmemcmp(s1, s2, n);
-        }
-
-        /*
-         * 将源字符串复制到目的字符串,,这两个字符串不可以相交
-         */
-        static char_type *copy(char_type *dst, const char_type *src, size_t n) {
-            TINYSTL_DEBUG(src + n <= dst || dst + n <= src);
-            return static_cast<char_type *>(std::wmemcpy(dst, src, n));
-        }
-
-        /*
-         * 将源字符串移动到目的字符串,这两个字符串可以相交
-         */
-        static char_type *move(char_type *dst, const char_type *src, size_t n) {
-            return static_cast<char_type *>(std::wmemmove(dst, src, n));
-        }
-
-        /*
-         * 使用字符ch填充指定大小的空间
-         */
-        static char_type *fill(char_type *dst, char_type ch, size_t count) {
-            return static_cast<char_type *>(std::wmemset(dst, ch, count));
-        }
-    };
-
-    /*
-     * 对char16_t类型的全特化
-     * char16_t类型的特化中使用库函数完成
-     */
-    template<>
-    struct char_traits<char16_t> {
-        /*
-         * 定义类型别名
-         */
-        typedef char16_t char_type;
-
-        /*
-         * 计算指针所指字符串的长度
-         */
-        static size_t length(const char_type *str) {
-            size_t len = 0;
-            /* char_type(0)为类似'\0'的终止符 */
-            for (; *str != char_type(0); ++str) {
-                ++len;
-            }
-            return len;
-        }
-
-        /*
-         * 比较两个字符串的大小
-         */
-        static int compare(const char_type *s1, const char_type *s2, size_t n) {
-            for (; n != 0; --n, ++s1, ++s2) {
-                if (*s1 < *s2) {
-                    return -1;
-                }
-                if (*s2 < *s1) {
-                    return 1;
-                }
-            }
-            return 0;
-        }
-
-        /*
-         * 将源字符串复制到目的字符串,,这两个字符串不可以相交
-         */
-        static char_type *copy(char_type *dst, const char_type *src, size_t n) {
-            /* 表示这两个字符串在内存空间中不能相交 */
-            TINYSTL_DEBUG(src + n <= dst || dst + n <= src);
-            char_type *r = dst;
-            for (; n != 0; --n, ++dst, ++src) {
-                *dst = *src;
-            }
-            return r;
-        }
-
-        /*
-         * 将源字符串移动到目的字符串,这两个字符串可以相交
-         */
-        static char_type *move(char_type *dst, const char_type *src, size_t n) {
-            char_type *r = dst;
-            /* 根据在内存中的相对位置,选择如何进行移动 */
-            if (dst < src) {
-                /* 从头开始正向复制 */
-                for (; n != 0; --n, ++dst, ++src) {
-                    *dst = *src;
-                }
-            } else if (src < dst) {
-                /* 从尾开始反向复制 */
-                dst += n;
-                src += n;
-                for (; n != 0; --n) {
-                    *--dst = *--src;
-                }
-            }
-            return r;
-        }
-
-        /*
-         * 使用字符ch填充指定大小的空间
-         */
-        static char_type *fill(char_type *dst, char_type ch, size_t count) {
-            char_type *r = dst;
-            for (; count > 0; --count, ++dst) {
-                *dst = ch;
-            }
-            return r;
-        }
-    };
-
-    /*
-     * 对char32_t类型的全特化
-     * char32_t类型的特化中使用库函数完成
-     */
-    template<>
-    struct char_traits<char32_t> {
-        /*
-         * 定义类型别名
-         */
-        typedef char32_t char_type;
-
-        /*
-         * 计算指针所指字符串的长度
-         */
-        static size_t length(const char_type *str) {
-            size_t len = 0;
-            /* char_type(0)为类似'\0'的终止符 */
-            for (; *str != char_type(0); ++str) {
-                ++len;
-            }
-            return len;
-        }
-
-        /*
-         * 比较两个字符串的大小
-         */
-        static int compare(const char_type *s1, const char_type *s2, size_t n) {
-            for (; n != 0; --n, ++s1, ++s2) {
-                if (*s1 < *s2) {
-                    return -1;
-                }
-                if (*s2 < *s1) {
-                    return 1;
-                }
-            }
-            return 0;
-        }
-
-        /*
-         * 将源字符串复制到目的字符串,,这两个字符串不可以相交
-         */
-        static char_type *copy(char_type *dst, const char_type *src, size_t n) {
-            /* 表示这两个字符串在内存空间中不能相交 */
-            TINYSTL_DEBUG(src + n <= dst || dst + n <= src);
-            char_type *r = dst;
-            for (; n != 0; --n, ++dst, ++src) {
-                *dst = *src;
-            }
-            return r;
-        }
-
-        /*
-         * 将源字符串移动到目的字符串,这两个字符串可以相交
-         */
-        static char_type *move(char_type *dst, const char_type *src, size_t n) {
-            char_type *r = dst;
-            /* 根据在内存中的相对位置,选择如何进行移动 */
-            if (dst < src) {
-                /* 从头开始正向复制 */
-                for (; n != 0; --n, ++dst, ++src) {
-                    *dst = *src;
-                }
-            } else if (src < dst) {
-                /* 从尾开始反向复制 */
-                dst += n;
-                src += n;
-                for (; n != 0; --n) {
-                    *--dst = *--src;
-                }
-            }
-            return r;
-        }
-
-        /*
-         * 使用字符ch填充指定大小的空间
-         */
-        static char_type *fill(char_type *dst, char_type ch, size_t count) {
-            char_type *r = dst;
-            for (; count > 0; --count, ++dst) {
-                *dst = ch;
-            }
-            return r;
-        }
-    };
-
-
     // ===========================================================================================
 /*
 * 初始化 basic_string 尝试分配的最小的 buffer 的大小,可能会被忽略,定义为32
@@ -420,6 +67,11 @@ namespace tinySTL {
         typedef tinySTL::reverse_iterator<iterator> reverse_iterator;
         typedef tinySTL::reverse_iterator<const_iterator> const_reverse_iterator;
 
+        /*
+         * 定义对应的字符串视图类型
+         */
+        typedef tinySTL::basic_string_view<CharType, CharTraits> view_type;
+
         /*
          * 获取空间配置器的类型
          */
@@ -451,7 +103,7 @@ namespace tinySTL {
          * basic_string类使用以下三个变量描述string的信息
          * buffer_: 存储字符串的起始位置
          * size_type: 字符串的大小
-         * cap_: 字符串的容量
+         * cap_: 字符串的容量，缓冲区实际多分配一个字符，用来存放 data()/c_str() 写入的结束符
          */
         iterator buffer_;
         size_type size_;
@@ -500,6 +152,13 @@ namespace tinySTL {
             init_from(str, 0, count);
         }
 
+        /*
+         * 有参构造函数,接受一个字符串视图,需要显式调用以免产生意外的内存分配
+         */
+        explicit basic_string(view_type v) : buffer_(nullptr), size_(0), cap_(0) {
+            init_from(v.data(), 0, v.size());
+        }
+
         /*
          * 有参构造函数,接收一对迭代器,使用迭代器间的数据初始化对象
          * 迭代器至少为 input_iterator_tag类型
@@ -869,6 +528,13 @@ namespace tinySTL {
          */
         basic_string &append(const_pointer s, size_type count);
 
+        /*
+         * 在末尾添加字符串视图 v 中的字符
+         */
+        basic_string &append(view_type v) {
+            return append(v.data(), v.size());
+        }
+
         /*
          * 在当前字符串后面连接上一对迭代器间的数据
          * 类成员模板
@@ -956,6 +622,20 @@ namespace tinySTL {
          */
         int compare(size_type pos1, size_type count1, const_pointer s, size_type count2) const;
 
+        /*
+         * 跟一个字符串视图比较
+         */
+        int compare(view_type v) const {
+            return compare_cstr(buffer_, size_, v.data(), v.size());
+        }
+
+        /*
+         * 从下标 pos1 开始的 count1 个字符跟一个字符串视图比较
+         */
+        int compare(size_type pos1, size_type count1, view_type v) const {
+            return compare(pos1, count1, v.data(), v.size());
+        }
+
         /*
          * 获取子串
          */
@@ -1020,6 +700,22 @@ namespace tinySTL {
             return replace_cstr(first, static_cast<size_type>(last - first), str, count);
         }
 
+        /*
+         * 将pos后count个字符替换为字符串视图 v 中的字符
+         */
+        basic_string &replace(size_type pos, size_type count, view_type v) {
+            THROW_OUT_OF_RANGE_IF(pos > size_, "basic_string<Char, Traits>::replace's pos out of range");
+            return replace_cstr(buffer_ + pos, count, v.data(), v.size());
+        }
+
+        /*
+         * 将迭代器所指区间替换为字符串视图 v 中的字符
+         */
+        basic_string &replace(const_iterator first, const_iterator last, view_type v) {
+            TINYSTL_DEBUG(begin() <= first && last <= end() && first <= last);
+            return replace_cstr(first, static_cast<size_type>(last - first), v.data(), v.size());
+        }
+
         /*
          * 将pos后count个字符替换为count2个ch字符
          */
@@ -1088,6 +784,7 @@ namespace tinySTL {
 
         /*
          * 从下标 pos 开始查找字符串 str 的前 count 个字符，若找到返回起始位置的下标，否则返回 npos
+         * 所有 find 重载对空字符串的规则相同(与 basic_string_view::find 一致)：pos <= size() 时返回 pos
          */
         size_type find(const_pointer str, size_type pos, size_type count) const noexcept;
 
@@ -1096,6 +793,13 @@ namespace tinySTL {
          */
         size_type find(const basic_string &str, size_type pos = 0) const noexcept;
 
+        /*
+         * 从下标 pos 开始查找字符串视图 v，若找到返回起始位置的下标，否则返回 npos
+         */
+        size_type find(view_type v, size_type pos = 0) const noexcept {
+            return find(v.data(), pos, v.size());
+        }
+
         /*
          * 从右往左开始查找相关函数
          */
@@ -1135,7 +839,7 @@ namespace tinySTL {
         size_type find_first_of(const_pointer s, size_type pos = 0) const noexcept;
 
         /*
-         * 从下标 pos 开始查找字符串 s
+         * 从下标 pos 开始查找字符串 s 前 count 个字符中任意一个出现的第一个位置
          */
         size_type find_first_of(const_pointer s, size_type pos, size_type count) const noexcept;
 
@@ -1247,30 +951,40 @@ namespace tinySTL {
             return append(str, str + char_traits::length(str));
         }
 
+        /*
+         * 重载 += 操作符,接收对象为字符串视图
+         */
+        basic_string &operator+=(view_type v) {
+            return append(v);
+        }
+
+        /*
+         * 转换为字符串视图,不会分配内存
+         */
+        operator view_type() const noexcept {
+            return view_type(buffer_, size_);
+        }
+
         /*
          * 添加全局操作符友元
          */
 
         /*
-         * 重载 >> 操作符
+         * 重载 >> 操作符,跳过前导空白后读入一个单词,直接从 streambuf 的读缓冲区批量追加
          */
-        friend std::istream &operator>>(std::istream &is, basic_string &str) {
-            pointer buf = new value_type[4096];
-            is >> buf;
-            basic_string temp(buf);
-            str = tinySTL::move(temp);
-            delete[]buf;
-            return is;
+        template<typename Traits>
+        friend std::basic_istream<CharType, Traits> &
+        operator>>(std::basic_istream<CharType, Traits> &is, basic_string &str) {
+            return tinySTL::stream_read_word(is, str);
         }
 
         /*
-         * 重载 << 操作符
+         * 重载 << 操作符,整个字符串通过一次 sputn 写出
          */
-        friend std::ostream &operator<<(std::ostream &os, const basic_string &str) {
-            for (size_type i = 0; i < str.size_; ++i) {
-                os << *(str.buffer_ + i);
-            }
-            return os;
+        template<typename Traits>
+        friend std::basic_ostream<CharType, Traits> &
+        operator<<(std::basic_ostream<CharType, Traits> &os, const basic_string &str) {
+            return tinySTL::stream_write(os, str.buffer_, str.size_);
         }
 
     private:
@@ -1433,7 +1147,7 @@ namespace tinySTL {
             iterator new_buffer = data_allocator::allocate(len + 1);
             data_allocator::deallocate(buffer_);
             buffer_ = new_buffer;
-            cap_ = len + 1;
+            cap_ = len;
         }
         char_traits::copy(buffer_, str, len);
         size_ = len;
@@ -1450,7 +1164,7 @@ namespace tinySTL {
             iterator new_buffer = data_allocator::allocate(2);
             data_allocator::deallocate(buffer_);
             buffer_ = new_buffer;
-            cap_ = 2;
+            cap_ = 1;
         }
         *buffer_ = ch;
         size_ = 1;
@@ -1466,7 +1180,7 @@ namespace tinySTL {
             /* 当前容量不足时申请新空间 */
             THROW_LENGTH_ERROR_IF(n > max_size(), "n can not larger than max_size()"
                                                   "in basic_string<Char,Traits>::reserve(n)");
-            iterator new_buffer = data_allocator::allocate(n);
+            iterator new_buffer = data_allocator::allocate(n + 1);
             try{
                 char_traits::move(new_buffer, buffer_, size_);
                 data_allocator::deallocate(buffer_);
@@ -1743,12 +1457,11 @@ namespace tinySTL {
     template<typename CharType, typename CharTraits>
     typename basic_string<CharType, CharTraits>::size_type  // 返回值
     basic_string<CharType, CharTraits>::find(CharType ch, size_type pos) const noexcept {
-        for (size_type i = pos; i < size_; ++i) {
-            if (*(buffer_ + i) == ch) {
-                return i;
-            }
+        if (pos >= size_) {
+            return npos;
         }
-        return npos;
+        const_pointer r = char_traits::find(buffer_ + pos, size_ - pos, ch);
+        return r == nullptr ? npos : static_cast<size_type>(r - buffer_);
     }
 
     /*
@@ -1757,28 +1470,7 @@ namespace tinySTL {
     template<typename CharType, typename CharTraits>
     typename basic_string<CharType, CharTraits>::size_type  // 返回值
     basic_string<CharType, CharTraits>::find(const_pointer str, size_type pos) const noexcept {
-        const size_type len = char_traits::length(str);
-        if (len == 0) {
-            return npos;
-        }
-        if (size_ - pos < len) {
-            return npos;
-        }
-        const size_type left = size_ - len;
-        for (size_type i = pos; i <= left; ++i) {
-            if (*(buffer_ + i) == *str) {
-                size_type j = 1;
-                for (; j < len; ++j) {
-                    if (*(buffer_ + i + j) != *(str + j)) {
-                        break;
-                    }
-                }
-                if (j == len) {
-                    return i;
-                }
-            }
-        }
-        return npos;
+        return find(str, pos, char_traits::length(str));
     }
 
     /*
@@ -1787,28 +1479,14 @@ namespace tinySTL {
     template<typename CharType, typename CharTraits>
     typename basic_string<CharType, CharTraits>::size_type  // 返回值
     basic_string<CharType, CharTraits>::find(const_pointer str, size_type pos, size_type count) const noexcept {
-        const size_type len = char_traits::length(str);
-        if (len == 0) {
-            return npos;
+        if (count == 0) {
+            return pos <= size_ ? pos : npos;
         }
-        if (size_ - pos < len) {
+        if (pos >= size_ || size_ - pos < count) {
             return npos;
         }
-        const size_type left = size_ - len;
-        for (size_type i = pos; i <= left; ++i) {
-            if (*(buffer_ + i) == *str) {
-                size_type j = 1;
-                for (; j < count; ++j) {
-                    if (*(buffer_ + i + j) != *(str + j)) {
-                        break;
-                    }
-                }
-                if (j == count) {
-                    return i;
-                }
-            }
-        }
-        return npos;
+        const_pointer r = tinySTL::string_search(buffer_ + pos, size_ - pos, str, count);
+        return r == nullptr ? npos : static_cast<size_type>(r - buffer_);
     }
 
     /*
@@ -1817,28 +1495,7 @@ namespace tinySTL {
     template<typename CharType, typename CharTraits>
     typename basic_string<CharType, CharTraits>::size_type  // 返回值
     basic_string<CharType, CharTraits>::find(const basic_string &str, size_type pos) const noexcept {
-        const size_type count = str.size_;
-        if (count == 0) {
-            return npos;
-        }
-        if (size_ - pos < count) {
-            return npos;
-        }
-        const size_type left = size_ - count;
-        for (size_type i = pos; i <= left; ++i) {
-            if (*(buffer_ + i) == str.front()) {
-                size_type j = 1;
-                for (; j < count; ++j) {
-                    if (*(buffer_ + i + j) != str[j]) {
-                        break;
-                    }
-                }
-                if (j == count) {
-                    return i;
-                }
-            }
-        }
-        return npos;
+        return find(str.buffer_, pos, str.size_);
     }
 
     /*
@@ -1847,6 +1504,9 @@ namespace tinySTL {
     template<typename CharType, typename CharTraits>
     typename basic_string<CharType, CharTraits>::size_type  // 返回值
     basic_string<CharType, CharTraits>::rfind(CharType ch, size_type pos) const noexcept {
+        if (size_ == 0) {
+            return npos;
+        }
         if (pos >= size_) {
             pos = size_ - 1;
         }
@@ -1865,39 +1525,7 @@ namespace tinySTL {
     template<typename CharType, typename CharTraits>
     typename basic_string<CharType, CharTraits>::size_type  // 返回值
     basic_string<CharType, CharTraits>::rfind(const_pointer str, size_type pos) const noexcept {
-        if (pos >= size_) {
-            pos = size_ - 1;
-        }
-        const size_type len = char_traits::length(str);
-        switch (len) {
-            case 0:
-                return pos;
-            case 1: {
-                for (size_type i = pos; i != 0; --i) {
-                    if (*(buffer_ + i) == *str) {
-                        return i;
-                    }
-                }
-                return front() == *str ? 0 : npos;
-            }
-            default: {
-                for (size_type i = pos; i >= len - 1; --i) {
-                    if (*(buffer_ + i) == *(str + len - 1)) {
-                        size_type j = 1;
-                        for (; j < len; ++j) {
-                            if (*(buffer_ + i - j) != *(str + len - j - 1)) {
-                                break;
-                            }
-                        }
-                        if (j == len) {
-                            return i - len + 1;
-                        }
-                    }
-                }
-                break;
-            }
-        }
-        return npos;
+        return rfind(str, pos, char_traits::length(str));
     }
 
     /*
@@ -1907,28 +1535,17 @@ namespace tinySTL {
     typename basic_string<CharType, CharTraits>::size_type  // 返回值
     basic_string<CharType, CharTraits>::rfind(const_pointer str, size_type pos, size_type count) const noexcept {
         if (count == 0) {
-            return pos;
+            return pos < size_ ? pos : size_;
         }
         if (pos >= size_) {
             pos = size_ - 1;
         }
-        if (pos < count - 1) {
+        /* pos 是匹配的最后一个字符所能到达的最大下标 */
+        if (size_ == 0 || pos + 1 < count) {
             return npos;
         }
-        for (size_type i = pos; i >= count - 1; --i) {
-            if (*(buffer_ + i) == *(str + count - 1)) {
-                size_type j = 1;
-                for (; j < count; ++j) {
-                    if (*(buffer_ + i - j) != *(str + count - j - 1)) {
-                        break;
-                    }
-                }
-                if (j == count) {
-                    return i - count + 1;
-                }
-            }
-        }
-        return npos;
+        const_pointer r = tinySTL::string_rsearch(buffer_, pos + 1, str, count);
+        return r == nullptr ? npos : static_cast<size_type>(r - buffer_);
     }
 
     /*
@@ -1937,30 +1554,7 @@ namespace tinySTL {
     template<typename CharType, typename CharTraits>
     typename basic_string<CharType, CharTraits>::size_type  // 返回值
     basic_string<CharType, CharTraits>::rfind(const basic_string &str, size_type pos) const noexcept {
-        const size_type count = str.size_;
-        if (count == 0) {
-            return pos;
-        }
-        if (pos >= size_) {
-            pos = size_ - 1;
-        }
-        if (pos < count - 1) {
-            return npos;
-        }
-        for (size_type i = pos; i >= count - 1; --i) {
-            if (*(buffer_ + i) == str[count - 1]) {
-                size_type j = 1;
-                for (; j < count; ++j) {
-                    if (*(buffer_ + i - j) != str[count - j - 1]) {
-                        break;
-                    }
-                }
-                if (j == count) {
-                    return i - count + 1;
-                }
-            }
-        }
-        return npos;
+        return rfind(str.buffer_, pos, str.size_);
     }
 
     /*
@@ -1978,33 +1572,21 @@ namespace tinySTL {
     template<typename CharType, typename CharTraits>
     typename basic_string<CharType, CharTraits>::size_type  // 返回值
     basic_string<CharType, CharTraits>::find_first_of(const_pointer s, size_type pos) const noexcept {
-        const size_type len = char_traits::length(s);
-        for (size_type i = pos; i < size_; ++i) {
-            value_type ch = *(buffer_ + i);
-            for (size_type j = 0; j < len; ++j) {
-                if (ch == *(s + j)) {
-                    return i;
-                }
-            }
-        }
-        return npos;
+        return find_first_of(s, pos, char_traits::length(s));
     }
 
     /*
-     * 从下标 pos 开始查找字符串 s
+     * 从下标 pos 开始查找字符串 s 前 count 个字符中任意一个出现的第一个位置
      */
     template<typename CharType, typename CharTraits>
     typename basic_string<CharType, CharTraits>::size_type  // 返回值
     basic_string<CharType, CharTraits>::find_first_of(const_pointer s, size_type pos, size_type count) const noexcept {
-        for (size_type i = pos; i < size_; ++i) {
-            value_type ch = *(buffer_ + i);
-            for (size_type j = 0; j < count; ++j) {
-                if (ch == *(s + j)) {
-                    return i;
-                }
-            }
+        if (pos >= size_) {
+            return npos;
         }
-        return npos;
+        const size_type n = size_ - pos;
+        const size_type r = tinySTL::string_find_first_of(buffer_ + pos, n, s, count);
+        return r == n ? npos : pos + r;
     }
 
     /*
@@ -2013,15 +1595,7 @@ namespace tinySTL {
     template<typename CharType, typename CharTraits>
     typename basic_string<CharType, CharTraits>::size_type  // 返回值
     basic_string<CharType, CharTraits>::find_first_of(const basic_string &str, size_type pos) const noexcept {
-        for (size_type i = pos; i < size_; ++i) {
-            value_type ch = *(buffer_ + i);
-            for (size_type j = 0; j < str.size_; ++j) {
-                if (ch == str[j]) {
-                    return i;
-                }
-            }
-        }
-        return npos;
+        return find_first_of(str.buffer_, pos, str.size_);
     }
 
     /*
@@ -2030,12 +1604,7 @@ namespace tinySTL {
     template<typename CharType, typename CharTraits>
     typename basic_string<CharType, CharTraits>::size_type  // 返回值
     basic_string<CharType, CharTraits>::find_first_not_of(CharType ch, size_type pos) const noexcept {
-        for (size_type i = pos; i < size_; ++i) {
-            if (*(buffer_ + i) != ch) {
-                return i;
-            }
-        }
-        return npos;
+        return find_first_not_of(&ch, pos, 1);
     }
 
     /*
@@ -2044,16 +1613,7 @@ namespace tinySTL {
     template<typename CharType, typename CharTraits>
     typename basic_string<CharType, CharTraits>::size_type  // 返回值
     basic_string<CharType, CharTraits>::find_first_not_of(const_pointer s, size_type pos) const noexcept {
-        const size_type len = char_traits::length(s);
-        for (size_type i = pos; i < size_; ++i) {
-            value_type ch = *(buffer_ + i);
-            for (size_type j = 0; j < len; ++j) {
-                if (ch != *(s + j)) {
-                    return i;
-                }
-            }
-        }
-        return npos;
+        return find_first_not_of(s, pos, char_traits::length(s));
     }
 
     /*
@@ -2063,15 +1623,12 @@ namespace tinySTL {
     typename basic_string<CharType, CharTraits>::size_type  // 返回值
     basic_string<CharType, CharTraits>::find_first_not_of(const_pointer s, size_type pos,
                                                           size_type count) const noexcept {
-        for (size_type i = pos; i < size_; ++i) {
-            value_type ch = *(buffer_ + i);
-            for (size_type j = 0; j < count; ++j) {
-                if (ch != *(s + j)) {
-                    return i;
-                }
-            }
+        if (pos >= size_) {
+            return npos;
         }
-        return npos;
+        const size_type n = size_ - pos;
+        const size_type r = tinySTL::string_find_first_not_of(buffer_ + pos, n, s, count);
+        return r == n ? npos : pos + r;
     }
 
     /*
@@ -2080,15 +1637,7 @@ namespace tinySTL {
     template<typename CharType, typename CharTraits>
     typename basic_string<CharType, CharTraits>::size_type  // 返回值
     basic_string<CharType, CharTraits>::find_first_not_of(const basic_string &str, size_type pos) const noexcept {
-        for (size_type i = pos; i < size_; ++i) {
-            value_type ch = *(buffer_ + i);
-            for (size_type j = 0; j < str.size_; ++j) {
-                if (ch != str[j]) {
-                    return i;
-                }
-            }
-        }
-        return npos;
+        return find_first_not_of(str.buffer_, pos, str.size_);
     }
 
     /*
@@ -2097,11 +1646,7 @@ namespace tinySTL {
     template<typename CharType, typename CharTraits>
     typename basic_string<CharType, CharTraits>::size_type  // 返回值
     basic_string<CharType, CharTraits>::find_last_of(CharType ch, size_type pos) const noexcept {
-        for (auto i = size_ - 1; i >= pos; --i) {
-            if (*(buffer_ + i) == ch)
-                return i;
-        }
-        return npos;
+        return find_last_of(&ch, pos, 1);
     }
 
     /*
@@ -2110,16 +1655,7 @@ namespace tinySTL {
     template<typename CharType, typename CharTraits>
     typename basic_string<CharType, CharTraits>::size_type  // 返回值
     basic_string<CharType, CharTraits>::find_last_of(const_pointer s, size_type pos) const noexcept {
-        const size_type len = char_traits::length(s);
-        for (size_type i = size_ - 1; i >= pos; --i) {
-            value_type ch = *(buffer_ + i);
-            for (size_type j = 0; j < len; ++j) {
-                if (ch == *(s + j)) {
-                    return i;
-                }
-            }
-        }
-        return npos;
+        return find_last_of(s, pos, char_traits::length(s));
     }
 
     /*
@@ -2128,15 +1664,12 @@ namespace tinySTL {
     template<typename CharType, typename CharTraits>
     typename basic_string<CharType, CharTraits>::size_type  // 返回值
     basic_string<CharType, CharTraits>::find_last_of(const_pointer s, size_type pos, size_type count) const noexcept {
-        for (size_type i = size_ - 1; i >= pos; --i) {
-            value_type ch = *(buffer_ + i);
-            for (size_type j = 0; j < count; ++j) {
-                if (ch == *(s + j)) {
-                    return i;
-                }
-            }
+        if (pos >= size_) {
+            return npos;
         }
-        return npos;
+        const size_type n = size_ - pos;
+        const size_type r = tinySTL::string_find_last_of(buffer_ + pos, n, s, count);
+        return r == n ? npos : pos + r;
     }
 
     /*
@@ -2145,15 +1678,7 @@ namespace tinySTL {
     template<typename CharType, typename CharTraits>
     typename basic_string<CharType, CharTraits>::size_type  // 返回值
     basic_string<CharType, CharTraits>::find_last_of(const basic_string &str, size_type pos) const noexcept {
-        for (size_type i = size_ - 1; i >= pos; --i) {
-            value_type ch = *(buffer_ + i);
-            for (size_type j = 0; j < str.size_; ++j) {
-                if (ch == str[j]) {
-                    return i;
-                }
-            }
-        }
-        return npos;
+        return find_last_of(str.buffer_, pos, str.size_);
     }
 
     /*
@@ -2162,12 +1687,7 @@ namespace tinySTL {
     template<typename CharType, typename CharTraits>
     typename basic_string<CharType, CharTraits>::size_type  // 返回值
     basic_string<CharType, CharTraits>::find_last_not_of(CharType ch, size_type pos) const noexcept {
-        for (size_type i = size_ - 1; i >= pos; --i) {
-            if (*(buffer_ + i) != ch) {
-                return i;
-            }
-        }
-        return npos;
+        return find_last_not_of(&ch, pos, 1);
     }
 
     /*
@@ -2176,16 +1696,7 @@ namespace tinySTL {
     template<typename CharType, typename CharTraits>
     typename basic_string<CharType, CharTraits>::size_type  // 返回值
     basic_string<CharType, CharTraits>::find_last_not_of(const_pointer s, size_type pos) const noexcept {
-        const size_type len = char_traits::length(s);
-        for (size_type i = size_ - 1; i >= pos; --i) {
-            value_type ch = *(buffer_ + i);
-            for (size_type j = 0; j < len; j++) {
-                if (ch != *(s + j)) {
-                    return i;
-                }
-            }
-        }
-        return npos;
+        return find_last_not_of(s, pos, char_traits::length(s));
     }
 
     /*
@@ -2195,15 +1706,12 @@ namespace tinySTL {
     typename basic_string<CharType, CharTraits>::size_type  // 返回值
     basic_string<CharType, CharTraits>::find_last_not_of(const_pointer s, size_type pos,
                                                          size_type count) const noexcept {
-        for (size_type i = size_ - 1; i >= pos; --i) {
-            value_type ch = *(buffer_ + i);
-            for (size_type j = 0; j < count; j++) {
-                if (ch != *(s + j)) {
-                    return i;
-                }
-            }
+        if (pos >= size_) {
+            return npos;
         }
-        return npos;
+        const size_type n = size_ - pos;
+        const size_type r = tinySTL::string_find_last_not_of(buffer_ + pos, n, s, count);
+        return r == n ? npos : pos + r;
     }
 
     /*
@@ -2212,15 +1720,7 @@ namespace tinySTL {
     template<typename CharType, typename CharTraits>
     typename basic_string<CharType, CharTraits>::size_type  // 返回值
     basic_string<CharType, CharTraits>::find_last_not_of(const basic_string &str, size_type pos) const noexcept {
-        for (size_type i = size_ - 1; i >= pos; --i) {
-            value_type ch = *(buffer_ + i);
-            for (size_type j = 0; j < str.size_; j++) {
-                if (ch != str[j]) {
-                    return i;
-                }
-            }
-        }
-        return npos;
+        return find_last_not_of(str.buffer_, pos, str.size_);
     }
 
     /*
@@ -2272,7 +1772,7 @@ namespace tinySTL {
     template<typename CharType, typename CharTraits>
     void basic_string<CharType, CharTraits>::fill_init(size_type n, value_type ch) noexcept {
         const size_type init_size = tinySTL::max(static_cast<size_type>(STRING_INIT_SIZE), n + 1);
-        buffer_ = data_allocator::allocate(init_size);
+        buffer_ = data_allocator::allocate(init_size + 1);
         char_traits::fill(buffer_, ch, n);
         size_ = n;
         cap_ = init_size;
@@ -2289,7 +1789,7 @@ namespace tinySTL {
         size_type n = tinySTL::distance(first, last);
         const size_type init_size = tinySTL::max(static_cast<size_type>(STRING_INIT_SIZE), n + 1);
         try {
-            buffer_ = data_allocator::allocate(init_size);
+            buffer_ = data_allocator::allocate(init_size + 1);
             size_ = n;
             cap_ = init_size;
         }
@@ -2316,7 +1816,7 @@ namespace tinySTL {
         const size_type n = tinySTL::distance(first, last);
         const auto init_size = tinySTL::max(static_cast<size_type>(STRING_INIT_SIZE), n + 1);
         try {
-            buffer_ = data_allocator::allocate(init_size);
+            buffer_ = data_allocator::allocate(init_size + 1);
             size_ = n;
             cap_ = init_size;
             tinySTL::uninitialized_copy(first, last, buffer_);
@@ -2335,7 +1835,7 @@ namespace tinySTL {
     template<typename CharType, typename CharTraits>
     void basic_string<CharType, CharTraits>::init_from(const_pointer src, size_type pos, size_type n) {
         const size_type init_size = tinySTL::max(static_cast<size_type>(STRING_INIT_SIZE), n + 1);
-        buffer_ = data_allocator::allocate(init_size);
+        buffer_ = data_allocator::allocate(init_size + 1);
         char_traits::copy(buffer_, src + pos, n);
         size_ = n;
         cap_ = init_size;
@@ -2371,7 +1871,7 @@ namespace tinySTL {
     template<typename CharType, typename CharTraits>
     void basic_string<CharType, CharTraits>::reinsert(size_type size) {
         /* 申请刚好能容纳字符个数的大小 */
-        iterator new_buffer = data_allocator::allocate(size);
+        iterator new_buffer = data_allocator::allocate(size + 1);
         try {
             char_traits::move(new_buffer, buffer_, size);
             data_allocator::deallocate(buffer_);
@@ -2528,7 +2028,7 @@ namespace tinySTL {
     void basic_string<CharType, CharTraits>::reallocate(size_type need) {
         /* 每次扩容 cap_ + need 与 cap_ + (cap_ >> 1) 的较大值*/
         const size_type new_cap = tinySTL::max(cap_ + need, cap_ + (cap_ >> 1));
-        iterator new_buffer = data_allocator::allocate(new_cap);
+        iterator new_buffer = data_allocator::allocate(new_cap + 1);
         char_traits::move(new_buffer, buffer_, size_);
         data_allocator::deallocate(buffer_);
         buffer_ = new_buffer;
@@ -2544,7 +2044,7 @@ namespace tinySTL {
         const size_type r = pos - buffer_;
         const size_type old_cap = cap_;
         const size_type new_cap = tinySTL::max(old_cap + n, old_cap + (old_cap >> 1));
-        iterator new_buffer = data_allocator::allocate(new_cap);
+        iterator new_buffer = data_allocator::allocate(new_cap + 1);
         /* 移动插入位置前的部分到新缓冲区 */
         iterator e1 = char_traits::move(new_buffer, buffer_, r) + r;
         /* 填充n个字符 */
@@ -2568,7 +2068,7 @@ namespace tinySTL {
         const size_type old_cap = cap_;
         const size_type n = tinySTL::distance(first, last);
         const size_type new_cap = tinySTL::max(old_cap + n, old_cap + (old_cap >> 1));
-        iterator new_buffer = data_allocator::allocate(new_cap);
+        iterator new_buffer = data_allocator::allocate(new_cap + 1);
         /* 移动插入位置前的部分到新缓冲区 */
         iterator e1 = char_traits::move(new_buffer, buffer_, r) + r;
         /* 填充迭代器间的字符 */
@@ -2787,6 +2287,48 @@ namespace tinySTL {
         return lhs.compare(rhs) >= 0;
     }
 
+    /*
+     * basic_string 与 basic_string_view 之间的相等比较
+     */
+    template<class CharType, class CharTraits>
+    bool operator==(const basic_string<CharType, CharTraits> &lhs, basic_string_view<CharType, CharTraits> rhs) {
+        return lhs.size() == rhs.size() && lhs.compare(rhs) == 0;
+    }
+
+    template<class CharType, class CharTraits>
+    bool operator==(basic_string_view<CharType, CharTraits> lhs, const basic_string<CharType, CharTraits> &rhs) {
+        return rhs == lhs;
+    }
+
+    template<class CharType, class CharTraits>
+    bool operator!=(const basic_string<CharType, CharTraits> &lhs, basic_string_view<CharType, CharTraits> rhs) {
+        return !(lhs == rhs);
+    }
+
+    template<class CharType, class CharTraits>
+    bool operator!=(basic_string_view<CharType, CharTraits> lhs, const basic_string<CharType, CharTraits> &rhs) {
+        return !(rhs == lhs);
+    }
+
+    /*
+     * 从输入流读入一行到 str，遇到 delim 时停止，delim 被读出但不存入 str
+     * 多次调用时复用 str 已有的容量
+     */
+    template<class CharType, class CharTraits, class Traits>
+    std::basic_istream<CharType, Traits> &  // 返回值
+    getline(std::basic_istream<CharType, Traits> &is, basic_string<CharType, CharTraits> &str, CharType delim) {
+        return tinySTL::stream_getline(is, str, delim);
+    }
+
+    /*
+     * 从输入流读入一行到 str，以换行符为分隔符
+     */
+    template<class CharType, class CharTraits, class Traits>
+    std::basic_istream<CharType, Traits> &  // 返回值
+    getline(std::basic_istream<CharType, Traits> &is, basic_string<CharType, CharTraits> &str) {
+        return tinySTL::stream_getline(is, str, is.widen('\n'));
+    }
+
     /*
      * 重载tinySTL的swap
      */
@@ -2801,12 +2343,27 @@ namespace tinySTL {
      */
     template<class CharType, class CharTraits>
     struct hash<basic_string<CharType, CharTraits>> {
-        size_t operator()(const basic_string<CharType, CharTraits> &str) {
+        size_t operator()(const basic_string<CharType, CharTraits> &str) const noexcept {
             return tinySTL::bitwise_hash((const unsigned char *) str.c_str(),
                                          str.size() * sizeof(CharType));
         }
     };
 
+    template<class CharType, class CharTraits>
+    struct hash_is_avalanching<hash<basic_string<CharType, CharTraits>>> : public tinySTL::m_true_type {
+    };
+
+    /*
+     * 为basic_string类定义 FNV-1a 的可选hash函数
+     */
+    template<class CharType, class CharTraits>
+    struct fnv1a_hash<basic_string<CharType, CharTraits>> {
+        size_t operator()(const basic_string<CharType, CharTraits> &str) const noexcept {
+            return tinySTL::fnv1a_bytes((const unsigned char *) str.c_str(),
+                                        str.size() * sizeof(CharType));
+        }
+    };
+
 }  // namespace tinySTL
 
 #endif //TINYSTL_BASIC_STRING_H
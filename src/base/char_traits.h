@@ -0,0 +1,391 @@
+//
+// Created by cqupt1811 on 2022/5/15.
+//
+
+/*
+ * 这个头文件包含一个模板类 char_traits
+ * 用于萃取不同字符类型的基本操作，wchar_t、char16_t、char32_t 的特化使用 simd.h 中的向量内核
+ */
+
+#ifndef TINYSTL_CHAR_TRAITS_H
+#define TINYSTL_CHAR_TRAITS_H
+
+#include <cstddef>  /* 定义了 size_t 等常用类型 */
+#include <cstring>  /* C风格字符串与内存操作函数 */
+#include "simd.h"  /* 这个头文件包含字符序列相关的 SIMD 内核，以及运行时的 CPU 特性检测 */
+#include "exceptdef.h"  /* 此文件中定义了异常相关的宏 */
+
+/* 首先定义自己的命名空间 */
+namespace tinySTL {
+
+    /*
+     * 针对不同的字符类型萃取出相应的数据
+     * char_traits模板类中包含有六个静态方法
+     * length()获取长度
+     * compare()比较大小
+     * copy()赋值数据
+     * move()移动数据
+     * fill()填充数据
+     * find()查找字符
+     */
+    template<typename CharType>
+    struct char_traits {
+        /*
+         * 定义类型别名
+         */
+        typedef CharType char_type;
+
+        /*
+         * 计算指针所指字符串的长度
+         */
+        static size_t length(const char_type *str) {
+            size_t len = 0;
+            /* char_type(0)为类似'\0'的终止符 */
+            for (; *str != char_type(0); ++str) {
+                ++len;
+            }
+            return len;
+        }
+
+        /*
+         * 比较两个字符串的大小
+         */
+        static int compare(const char_type *s1, const char_type *s2, size_t n) {
+            for (; n != 0; --n, ++s1, ++s2) {
+                if (*s1 < *s2) {
+                    return -1;
+                }
+                if (*s2 < *s1) {
+                    return 1;
+                }
+            }
+            return 0;
+        }
+
+        /*
+         * 将源字符串复制到目的字符串,,这两个字符串不可以相交
+         */
+        static char_type *copy(char_type *dst, const char_type *src, size_t n) {
+            /* 表示这两个字符串在内存空间中不能相交 */
+            TINYSTL_DEBUG(src + n <= dst || dst + n <= src);
+            char_type *r = dst;
+            for (; n != 0; --n, ++dst, ++src) {
+                *dst = *src;
+            }
+            return r;
+        }
+
+        /*
+         * 将源字符串移动到目的字符串,这两个字符串可以相交
+         */
+        static char_type *move(char_type *dst, const char_type *src, size_t n) {
+            char_type *r = dst;
+            /* 根据在内存中的相对位置,选择如何进行移动 */
+            if (dst < src) {
+                /* 从头开始正向复制 */
+                for (; n != 0; --n, ++dst, ++src) {
+                    *dst = *src;
+                }
+            } else if (src < dst) {
+                /* 从尾开始反向复制 */
+                dst += n;
+                src += n;
+                for (; n != 0; --n) {
+                    *--dst = *--src;
+                }
+            }
+            return r;
+        }
+
+        /*
+         * 使用字符ch填充指定大小的空间
+         */
+        static char_type *fill(char_type *dst, char_type ch, size_t count) {
+            char_type *r = dst;
+            for (; count > 0; --count, ++dst) {
+                *dst = ch;
+            }
+            return r;
+        }
+
+        /*
+         * 在前 n 个字符中查找字符ch,返回第一次出现的位置,找不到时返回 nullptr
+         */
+        static const char_type *find(const char_type *str, size_t n, char_type ch) {
+            for (; n != 0; --n, ++str) {
+                if (*str == ch) {
+                    return str;
+                }
+            }
+            return nullptr;
+        }
+    };
+
+    /*
+     * 对char类型的全特化
+     * char类型的特化中使用库函数完成,这些库函数本身已经按照 CPU 特性在运行时选择了向量化的实现
+     */
+    template<>
+    struct char_traits<char> {
+        /*
+         * 定义类中使用的类型别名
+         */
+        typedef char char_type;
+
+        /*
+         * 计算指针所指字符串的长度
+         */
+        static size_t length(const char_type *str) noexcept {
+            return std::strlen(str);
+        }
+
+        /*
+         * 比较两个字符串的大小
+         */
+        static int compare(const char_type *s1, const char_type *s2, size_t n) noexcept {
+            if (n == 0) {
+                return 0;
+            }
+            return std::memcmp(s1, s2, n);
+        }
+
+        /*
+         * 将源字符串复制到目的字符串,,这两个字符串不可以相交
+         */
+        static char_type *copy(char_type *dst, const char_type *src, size_t n) {
+            TINYSTL_DEBUG(src + n <= dst || dst + n <= src);
+            if (n == 0) {
+                return dst;
+            }
+            return static_cast<char_type *>(std::memcpy(dst, src, n));
+        }
+
+        /*
+         * 将源字符串移动到目的字符串,这两个字符串可以相交
+         */
+        static char_type *move(char_type *dst, const char_type *src, size_t n) {
+            if (n == 0) {
+                return dst;
+            }
+            return static_cast<char_type *>(std::memmove(dst, src, n));
+        }
+
+        /*
+         * 使用字符ch填充指定大小的空间
+         */
+        static char_type *fill(char_type *dst, char_type ch, size_t count) {
+            if (count == 0) {
+                return dst;
+            }
+            return static_cast<char_type *>(std::memset(dst, ch, count));
+        }
+
+        /*
+         * 在前 n 个字符中查找字符ch,返回第一次出现的位置,找不到时返回 nullptr
+         */
+        static const char_type *find(const char_type *str, size_t n, char_type ch) noexcept {
+            return n == 0 ? nullptr : static_cast<const char_type *>(std::memchr(str, ch, n));
+        }
+    };
+
+    /*
+     * 对wchar_t类型的全特化
+     * wchar_t类型的特化中使用向量内核完成
+     */
+    template<>
+    struct char_traits<wchar_t> {
+        /*
+         * 定义类中使用的类型别名
+         */
+        typedef wchar_t char_type;
+
+        /*
+         * 计算指针所指字符串的长度
+         */
+        static size_t length(const char_type *str) noexcept {
+            return simd::length(str);
+        }
+
+        /*
+         * 比较两个字符串的大小
+         * 与 wmemcmp 一致,按 wchar_t 比较
+         */
+        static int compare(const char_type *s1, const char_type *s2, size_t n) noexcept {
+            const size_t i = simd::mismatch(s1, s2, n);
+            if (i == n) {
+                return 0;
+            }
+            return static_cast<wchar_t>(s1[i]) < static_cast<wchar_t>(s2[i]) ? -1 : 1;
+        }
+
+        /*
+         * 将源字符串复制到目的字符串,,这两个字符串不可以相交
+         */
+        static char_type *copy(char_type *dst, const char_type *src, size_t n) {
+            TINYSTL_DEBUG(src + n <= dst || dst + n <= src);
+            if (n == 0) {
+                return dst;
+            }
+            return static_cast<char_type *>(std::memcpy(dst, src, n * sizeof(char_type)));
+        }
+
+        /*
+         * 将源字符串移动到目的字符串,这两个字符串可以相交
+         */
+        static char_type *move(char_type *dst, const char_type *src, size_t n) {
+            if (n == 0) {
+                return dst;
+            }
+            return static_cast<char_type *>(std::memmove(dst, src, n * sizeof(char_type)));
+        }
+
+        /*
+         * 使用字符ch填充指定大小的空间
+         */
+        static char_type *fill(char_type *dst, char_type ch, size_t count) {
+            return simd::fill(dst, ch, count);
+        }
+
+        /*
+         * 在前 n 个字符中查找字符ch,返回第一次出现的位置,找不到时返回 nullptr
+         */
+        static const char_type *find(const char_type *str, size_t n, char_type ch) noexcept {
+            return simd::find(str, n, ch);
+        }
+    };
+
+    /*
+     * 对char16_t类型的全特化
+     * char16_t类型的特化中使用向量内核完成
+     */
+    template<>
+    struct char_traits<char16_t> {
+        /*
+         * 定义类中使用的类型别名
+         */
+        typedef char16_t char_type;
+
+        /*
+         * 计算指针所指字符串的长度
+         */
+        static size_t length(const char_type *str) noexcept {
+            return simd::length(str);
+        }
+
+        /*
+         * 比较两个字符串的大小
+         * 按 char16_t 比较
+         */
+        static int compare(const char_type *s1, const char_type *s2, size_t n) noexcept {
+            const size_t i = simd::mismatch(s1, s2, n);
+            if (i == n) {
+                return 0;
+            }
+            return static_cast<char16_t>(s1[i]) < static_cast<char16_t>(s2[i]) ? -1 : 1;
+        }
+
+        /*
+         * 将源字符串复制到目的字符串,,这两个字符串不可以相交
+         */
+        static char_type *copy(char_type *dst, const char_type *src, size_t n) {
+            TINYSTL_DEBUG(src + n <= dst || dst + n <= src);
+            if (n == 0) {
+                return dst;
+            }
+            return static_cast<char_type *>(std::memcpy(dst, src, n * sizeof(char_type)));
+        }
+
+        /*
+         * 将源字符串移动到目的字符串,这两个字符串可以相交
+         */
+        static char_type *move(char_type *dst, const char_type *src, size_t n) {
+            if (n == 0) {
+                return dst;
+            }
+            return static_cast<char_type *>(std::memmove(dst, src, n * sizeof(char_type)));
+        }
+
+        /*
+         * 使用字符ch填充指定大小的空间
+         */
+        static char_type *fill(char_type *dst, char_type ch, size_t count) {
+            return simd::fill(dst, ch, count);
+        }
+
+        /*
+         * 在前 n 个字符中查找字符ch,返回第一次出现的位置,找不到时返回 nullptr
+         */
+        static const char_type *find(const char_type *str, size_t n, char_type ch) noexcept {
+            return simd::find(str, n, ch);
+        }
+    };
+
+    /*
+     * 对char32_t类型的全特化
+     * char32_t类型的特化中使用向量内核完成
+     */
+    template<>
+    struct char_traits<char32_t> {
+        /*
+         * 定义类中使用的类型别名
+         */
+        typedef char32_t char_type;
+
+        /*
+         * 计算指针所指字符串的长度
+         */
+        static size_t length(const char_type *str) noexcept {
+            return simd::length(str);
+        }
+
+        /*
+         * 比较两个字符串的大小
+         * 按 char32_t 比较
+         */
+        static int compare(const char_type *s1, const char_type *s2, size_t n) noexcept {
+            const size_t i = simd::mismatch(s1, s2, n);
+            if (i == n) {
+                return 0;
+            }
+            return static_cast<char32_t>(s1[i]) < static_cast<char32_t>(s2[i]) ? -1 : 1;
+        }
+
+        /*
+         * 将源字符串复制到目的字符串,,这两个字符串不可以相交
+         */
+        static char_type *copy(char_type *dst, const char_type *src, size_t n) {
+            TINYSTL_DEBUG(src + n <= dst || dst + n <= src);
+            if (n == 0) {
+                return dst;
+            }
+            return static_cast<char_type *>(std::memcpy(dst, src, n * sizeof(char_type)));
+        }
+
+        /*
+         * 将源字符串移动到目的字符串,这两个字符串可以相交
+         */
+        static char_type *move(char_type *dst, const char_type *src, size_t n) {
+            if (n == 0) {
+                return dst;
+            }
+            return static_cast<char_type *>(std::memmove(dst, src, n * sizeof(char_type)));
+        }
+
+        /*
+         * 使用字符ch填充指定大小的空间
+         */
+        static char_type *fill(char_type *dst, char_type ch, size_t count) {
+            return simd::fill(dst, ch, count);
+        }
+
+        /*
+         * 在前 n 个字符中查找字符ch,返回第一次出现的位置,找不到时返回 nullptr
+         */
+        static const char_type *find(const char_type *str, size_t n, char_type ch) noexcept {
+            return simd::find(str, n, ch);
+        }
+    };
+
+} // namespace tinySTL
+
+#endif //TINYSTL_CHAR_TRAITS_H
@@ -0,0 +1,541 @@
+//
+// Created by cqupt1811 on 2022/5/22.
+//
+
+/*
+ * 这个头文件包含数值与字符序列之间的转换，接口与 c++17 的 <charconv> 一致
+ * to_chars()   把整数或浮点数写入调用者提供的缓冲区，不分配内存，不依赖 locale
+ * from_chars() 从字符序列中解析整数
+ * 十进制整数每次写出两位数字(查两位数字表)，并预先算出位数，从后往前填写
+ * 浮点数使用 Ryu 算法输出能够精确往返的最短十进制表示，再在定点与科学计数法中选较短的一种
+ */
+
+#ifndef TINYSTL_CHARCONV_H
+#define TINYSTL_CHARCONV_H
+
+#include <cstddef>  /* 定义了 size_t 等常用类型 */
+#include <cstdint>  /* 定长整数类型 uint64_t 等 */
+#include <cstring>  /* memcpy, memmove */
+#include <system_error>  /* std::errc */
+#include <type_traits>  /* std::is_integral 等 */
+#include "charconv_table.h"  /* 这个头文件包含 Ryu 算法使用的 5 的幂次表 */
+
+/* 首先定义自己的命名空间 */
+namespace tinySTL {
+
+    /*
+     * to_chars 的返回值，ptr 指向写入的最后一个字符之后，缓冲区不足时 ec 为 value_too_large
+     */
+    struct to_chars_result {
+        char *ptr;
+        std::errc ec;
+    };
+
+    /*
+     * from_chars 的返回值，ptr 指向第一个未被解析的字符
+     */
+    struct from_chars_result {
+        const char *ptr;
+        std::errc ec;
+    };
+
+    namespace charconv_detail {
+
+        // 返回值：两位数字表 "00" "01" ... "99"
+        inline const char *digit_pairs() noexcept {
+            static const char table[201] =
+                    "00010203040506070809"
+                    "10111213141516171819"
+                    "20212223242526272829"
+                    "30313233343536373839"
+                    "40414243444546474849"
+                    "50515253545556575859"
+                    "60616263646566676869"
+                    "70717273747576777879"
+                    "80818283848586878889"
+                    "90919293949596979899";
+            return table;
+        }
+
+        // 返回值：v 的十进制位数，由最高位的位置估计 log10 后用一次比较修正
+        inline int count_digits(uint64_t v) noexcept {
+            static const uint64_t pow10[20] = {
+                    1ull, 10ull, 100ull, 1000ull, 10000ull, 100000ull, 1000000ull, 10000000ull,
+                    100000000ull, 1000000000ull, 10000000000ull, 100000000000ull, 1000000000000ull,
+                    10000000000000ull, 100000000000000ull, 1000000000000000ull, 10000000000000000ull,
+                    100000000000000000ull, 1000000000000000000ull, 10000000000000000000ull
+            };
+            v |= 1;  // 0 与 1 的位数相同
+#if defined(__GNUC__) || defined(__clang__)
+            const int bits = 64 - __builtin_clzll(v);
+#else
+            int bits = 1;
+            for (uint64_t t = v >> 1; t != 0; t >>= 1) ++bits;
+#endif
+            const int t = (bits * 1233) >> 12;
+            return t + 1 - (v < pow10[t]);
+        }
+
+        /*
+         * 把 v 的十进制表示写到 end 之前，共写 count_digits(v) 个字符
+         */
+        inline void write_digits(char *end, uint64_t v) noexcept {
+            const char *pairs = digit_pairs();
+            while (v >= 100) {
+                const size_t idx = static_cast<size_t>(v % 100) * 2;
+                v /= 100;
+                end -= 2;
+                std::memcpy(end, pairs + idx, 2);
+            }
+            if (v >= 10) {
+                std::memcpy(end - 2, pairs + static_cast<size_t>(v) * 2, 2);
+            } else {
+                *--end = static_cast<char>('0' + v);
+            }
+        }
+
+        // 返回值：字符 c 在 36 进制以内对应的数值，非法字符返回 36
+        inline unsigned digit_value(char c) noexcept {
+            if (c >= '0' && c <= '9') return static_cast<unsigned>(c - '0');
+            if (c >= 'a' && c <= 'z') return static_cast<unsigned>(c - 'a' + 10);
+            if (c >= 'A' && c <= 'Z') return static_cast<unsigned>(c - 'A' + 10);
+            return 36;
+        }
+
+        /*
+         * 无符号整数的转换，to_chars 与 from_chars 的有符号版本都转发到这里
+         */
+        inline to_chars_result to_chars_unsigned(char *first, char *last, uint64_t v, int base) noexcept {
+            if (base == 10) {
+                const int n = count_digits(v);
+                if (last - first < n) return {last, std::errc::value_too_large};
+                write_digits(first + n, v);
+                return {first + n, std::errc()};
+            }
+            char buf[64];
+            char *p = buf + 64;
+            const uint64_t b = static_cast<uint64_t>(base);
+            do {
+                const unsigned d = static_cast<unsigned>(v % b);
+                *--p = "0123456789abcdefghijklmnopqrstuvwxyz"[d];
+                v /= b;
+            } while (v != 0);
+            const ptrdiff_t n = buf + 64 - p;
+            if (last - first < n) return {last, std::errc::value_too_large};
+            std::memcpy(first, p, static_cast<size_t>(n));
+            return {first + n, std::errc()};
+        }
+
+        /*
+         * 解析 [first, last) 开头的数字，数值不超过 limit 时写入 value
+         * 超出范围时仍然跳过所有数字，返回 result_out_of_range
+         */
+        inline from_chars_result from_chars_unsigned(const char *first, const char *last,
+                                                     uint64_t &value, uint64_t limit, int base) noexcept {
+            const char *p = first;
+            const uint64_t b = static_cast<uint64_t>(base);
+            const uint64_t cutoff = limit / b;
+            const unsigned cutlim = static_cast<unsigned>(limit % b);
+            uint64_t acc = 0;
+            bool overflow = false;
+            for (; p != last; ++p) {
+                const unsigned d = digit_value(*p);
+                if (d >= static_cast<unsigned>(base)) break;
+                if (acc > cutoff || (acc == cutoff && d > cutlim)) {
+                    overflow = true;
+                } else {
+                    acc = acc * b + d;
+                }
+            }
+            if (p == first) return {first, std::errc::invalid_argument};
+            if (overflow) return {p, std::errc::result_out_of_range};
+            value = acc;
+            return {p, std::errc()};
+        }
+
+        // ====================================================================================
+        // Ryu 最短浮点数格式化
+
+        /*
+         * 十进制浮点数 mantissa * 10^exponent
+         */
+        struct decimal_fp {
+            uint64_t mantissa;
+            int exponent;
+        };
+
+        // 返回值：ceil(log2(5^e))，e == 0 时为 1，要求 0 <= e <= 3528
+        inline int pow5bits(int e) noexcept {
+            return static_cast<int>((static_cast<uint32_t>(e) * 1217359u) >> 19) + 1;
+        }
+
+        // 返回值：floor(log10(2^e))，要求 0 <= e <= 1650
+        inline uint32_t log10_pow2(int e) noexcept {
+            return (static_cast<uint32_t>(e) * 78913u) >> 18;
+        }
+
+        // 返回值：floor(log10(5^e))，要求 0 <= e <= 2620
+        inline uint32_t log10_pow5(int e) noexcept {
+            return (static_cast<uint32_t>(e) * 732923u) >> 20;
+        }
+
+        // 返回值：value 能否被 5^p 整除
+        inline bool multiple_of_pow5(uint64_t value, uint32_t p) noexcept {
+            uint32_t count = 0;
+            while (value % 5 == 0) {
+                value /= 5;
+                if (++count >= p) return true;
+            }
+            return count >= p;
+        }
+
+        // 返回值：value 能否被 2^p 整除
+        inline bool multiple_of_pow2(uint64_t value, uint32_t p) noexcept {
+            return (value & ((1ull << p) - 1)) == 0;
+        }
+
+        /*
+         * 计算 (m * mul) >> j，mul 是 {低 64 位, 高 64 位} 的 128 位数，要求 j >= 64
+         */
+        inline uint64_t mul_shift64(uint64_t m, const uint64_t *mul, int j) noexcept {
+#if defined(__SIZEOF_INT128__)
+            const __uint128_t b0 = static_cast<__uint128_t>(m) * mul[0];
+            const __uint128_t b2 = static_cast<__uint128_t>(m) * mul[1];
+            return static_cast<uint64_t>(((b0 >> 64) + b2) >> (j - 64));
+#else
+            // 64 位乘 64 位得到 128 位结果，返回高 64 位，低 64 位写入 lo
+            auto umul128 = [](uint64_t a, uint64_t b, uint64_t &lo) {
+                const uint64_t ha = a >> 32, hb = b >> 32, la = (uint32_t) a, lb = (uint32_t) b;
+                const uint64_t rh = ha * hb, rm0 = ha * lb, rm1 = hb * la, rl = la * lb;
+                const uint64_t t = rl + (rm0 << 32);
+                uint64_t c = t < rl;
+                lo = t + (rm1 << 32);
+                c += lo < t;
+                return rh + (rm0 >> 32) + (rm1 >> 32) + c;
+            };
+            uint64_t b0_lo, b2_lo;
+            const uint64_t b0_hi = umul128(m, mul[0], b0_lo);
+            const uint64_t b2_hi = umul128(m, mul[1], b2_lo);
+            const uint64_t lo = b0_hi + b2_lo;
+            const uint64_t hi = b2_hi + (lo < b0_hi);
+            const int dist = j - 64;
+            if (dist == 0) return lo;
+            if (dist >= 64) return hi >> (dist - 64);
+            return (hi << (64 - dist)) | (lo >> dist);
+#endif
+        }
+
+        /*
+         * Ryu 算法：求 IEEE 浮点数的最短十进制表示，结果解析回去与原值相同
+         * MantBits 为尾数位数，Bias 为指数偏移，float 与 double 共用同一张 125 位精度的表
+         * ieee_exponent 不能是全 1(无穷与 NaN 在外层处理)
+         */
+        template<int MantBits, int Bias>
+        decimal_fp ryu_shortest(uint64_t ieee_mantissa, uint32_t ieee_exponent) noexcept {
+            int e2;
+            uint64_t m2;
+            if (ieee_exponent == 0) {
+                e2 = 1 - Bias - MantBits - 2;
+                m2 = ieee_mantissa;
+            } else {
+                e2 = static_cast<int>(ieee_exponent) - Bias - MantBits - 2;
+                m2 = (1ull << MantBits) | ieee_mantissa;
+            }
+            const bool accept_bounds = (m2 & 1) == 0;
+
+            // 合法区间为 (mm, mp)，以 4 倍放大后的 mv 为中心，指数为 2 的幂次时下界更近
+            const uint64_t mv = 4 * m2;
+            const uint32_t mm_shift = ieee_mantissa != 0 || ieee_exponent <= 1;
+
+            // 把 mv, mp, mm 转换到以 10 为底，同时记录被截掉的部分是否全为 0
+            uint64_t vr, vp, vm;
+            int e10;
+            bool vm_trailing_zeros = false;
+            bool vr_trailing_zeros = false;
+            if (e2 >= 0) {
+                const uint32_t q = log10_pow2(e2) - (e2 > 3);
+                e10 = static_cast<int>(q);
+                const int k = pow5_inv_bitcount + pow5bits(static_cast<int>(q)) - 1;
+                const int i = -e2 + static_cast<int>(q) + k;
+                const uint64_t *mul = pow5_inv_table()[q];
+                vr = mul_shift64(4 * m2, mul, i);
+                vp = mul_shift64(4 * m2 + 2, mul, i);
+                vm = mul_shift64(4 * m2 - 1 - mm_shift, mul, i);
+                if (q <= 21) {
+                    // mv 至多只能被 5^21 整除，q 更大时截掉的部分一定不为 0
+                    if (mv % 5 == 0) {
+                        vr_trailing_zeros = multiple_of_pow5(mv, q);
+                    } else if (accept_bounds) {
+                        vm_trailing_zeros = multiple_of_pow5(mv - 1 - mm_shift, q);
+                    } else {
+                        vp -= multiple_of_pow5(mv + 2, q);
+                    }
+                }
+            } else {
+                const uint32_t q = log10_pow5(-e2) - (-e2 > 1);
+                e10 = static_cast<int>(q) + e2;
+                const int i = -e2 - static_cast<int>(q);
+                const int k = pow5bits(i) - pow5_bitcount;
+                const int j = static_cast<int>(q) - k;
+                const uint64_t *mul = pow5_table()[i];
+                vr = mul_shift64(4 * m2, mul, j);
+                vp = mul_shift64(4 * m2 + 2, mul, j);
+                vm = mul_shift64(4 * m2 - 1 - mm_shift, mul, j);
+                if (q <= 1) {
+                    // mv, mp, mm 末尾至少有 q 个二进制 0
+                    vr_trailing_zeros = true;
+                    if (accept_bounds) {
+                        vm_trailing_zeros = mm_shift == 1;
+                    } else {
+                        --vp;
+                    }
+                } else if (q < 63) {
+                    vr_trailing_zeros = multiple_of_pow2(mv, q);
+                }
+            }
+
+            // 在区间内尽可能多地去掉末尾数字
+            int removed = 0;
+            uint32_t last_removed = 0;
+            uint64_t output;
+            if (vm_trailing_zeros || vr_trailing_zeros) {
+                // 少见的情况：需要精确跟踪被去掉的数字来决定舍入
+                while (vp / 10 > vm / 10) {
+                    vm_trailing_zeros &= vm % 10 == 0;
+                    vr_trailing_zeros &= last_removed == 0;
+                    last_removed = static_cast<uint32_t>(vr % 10);
+                    vr /= 10;
+                    vp /= 10;
+                    vm /= 10;
+                    ++removed;
+                }
+                if (vm_trailing_zeros) {
+                    while (vm % 10 == 0) {
+                        vr_trailing_zeros &= last_removed == 0;
+                        last_removed = static_cast<uint32_t>(vr % 10);
+                        vr /= 10;
+                        vp /= 10;
+                        vm /= 10;
+                        ++removed;
+                    }
+                }
+                if (vr_trailing_zeros && last_removed == 5 && vr % 2 == 0) {
+                    // 恰好处于两个数中间时向偶数舍入
+                    last_removed = 4;
+                }
+                output = vr + ((vr == vm && (!accept_bounds || !vm_trailing_zeros)) || last_removed >= 5);
+            } else {
+                // 常见情况：先两位两位地去掉，再一位一位地去掉
+                bool round_up = false;
+                if (vp / 100 > vm / 100) {
+                    round_up = vr % 100 >= 50;
+                    vr /= 100;
+                    vp /= 100;
+                    vm /= 100;
+                    removed += 2;
+                }
+                while (vp / 10 > vm / 10) {
+                    round_up = vr % 10 >= 5;
+                    vr /= 10;
+                    vp /= 10;
+                    vm /= 10;
+                    ++removed;
+                }
+                output = vr + (vr == vm || round_up);
+            }
+            return {output, e10 + removed};
+        }
+
+        /*
+         * 定点输出大整数时写出浮点数 m2 * 2^e2 的精确值而不是补 0，与标准库的 to_chars 一致
+         * 精确值恰好有 n 位时写到 first 之后并返回 true，否则返回 false 由调用者补 0
+         * 走到这里时值不超过 10^22，double 需要 128 位整数
+         */
+        inline bool write_exact_integer(char *first, int n, uint64_t m2, int e2) noexcept {
+#if defined(__SIZEOF_INT128__)
+            const __uint128_t x = e2 >= 0 ? static_cast<__uint128_t>(m2) << e2 : m2 >> -e2;
+            const uint64_t pow19 = 10000000000000000000ull;
+            const uint64_t hi = static_cast<uint64_t>(x / pow19);
+            const uint64_t lo = static_cast<uint64_t>(x % pow19);
+            if (hi == 0) {
+                if (count_digits(lo) != n) return false;
+                write_digits(first + n, lo);
+                return true;
+            }
+            const int hi_len = count_digits(hi);
+            if (hi_len + 19 != n) return false;
+            write_digits(first + hi_len, hi);
+            std::memset(first + hi_len, '0', 19);
+            if (lo != 0) write_digits(first + n, lo);
+            return true;
+#else
+            (void) first;
+            (void) n;
+            (void) m2;
+            (void) e2;
+            return false;
+#endif
+        }
+
+        /*
+         * 把 mantissa * 10^exponent 写到 [first, last)，在定点与科学计数法中选择较短的一种，长度相同时选定点
+         * 科学计数法的指数至少有两位，与 printf 的 %e 相同
+         * m2 * 2^e2 是原浮点数的精确值，只在定点输出大整数时使用
+         */
+        inline to_chars_result write_decimal(char *first, char *last, bool negative, decimal_fp dec,
+                                             uint64_t m2, int e2) noexcept {
+            const int olength = count_digits(dec.mantissa);
+            const int e = dec.exponent;
+            const int sci_exp = e + olength - 1;
+            const int abs_exp = sci_exp < 0 ? -sci_exp : sci_exp;
+            const int sci_len = olength + (olength > 1) + 2 + (abs_exp >= 100 ? 3 : 2);
+            int fixed_len;
+            if (e >= 0) {
+                fixed_len = olength + e;
+            } else if (olength > -e) {
+                fixed_len = olength + 1;
+            } else {
+                fixed_len = 2 - e;
+            }
+            const int len = (fixed_len <= sci_len ? fixed_len : sci_len) + negative;
+            if (last - first < len) return {last, std::errc::value_too_large};
+
+            char *p = first;
+            if (negative) *p++ = '-';
+            if (fixed_len <= sci_len) {
+                if (e >= 0) {
+                    if (e == 0 || !write_exact_integer(p, olength + e, m2, e2)) {
+                        write_digits(p + olength, dec.mantissa);
+                        std::memset(p + olength, '0', static_cast<size_t>(e));
+                    }
+                } else if (olength > -e) {
+                    // 先把所有数字写在后面，再把整数部分前移一位，空出小数点的位置
+                    const int int_len = olength + e;
+                    write_digits(p + olength + 1, dec.mantissa);
+                    std::memmove(p, p + 1, static_cast<size_t>(int_len));
+                    p[int_len] = '.';
+                } else {
+                    p[0] = '0';
+                    p[1] = '.';
+                    std::memset(p + 2, '0', static_cast<size_t>(-e - olength));
+                    write_digits(p + 2 - e, dec.mantissa);
+                }
+                return {first + len, std::errc()};
+            }
+            // 科学计数法：数字写在 p + 1 之后，再把首位移到小数点之前
+            write_digits(p + olength + 1, dec.mantissa);
+            p[0] = p[1];
+            if (olength > 1) {
+                p[1] = '.';
+                p += olength + 1;
+            } else {
+                p += 1;
+            }
+            *p++ = 'e';
+            *p++ = sci_exp < 0 ? '-' : '+';
+            if (abs_exp >= 100) {
+                *p++ = static_cast<char>('0' + abs_exp / 100);
+            }
+            std::memcpy(p, digit_pairs() + (abs_exp % 100) * 2, 2);
+            return {p + 2, std::errc()};
+        }
+
+        /*
+         * 浮点数的公共入口，UInt 为与 Float 等宽的无符号整数
+         */
+        template<typename Float, typename UInt, int MantBits, int ExpBits>
+        to_chars_result to_chars_float(char *first, char *last, Float value) noexcept {
+            UInt bits;
+            std::memcpy(&bits, &value, sizeof(Float));
+            const bool negative = (bits >> (MantBits + ExpBits)) != 0;
+            const uint64_t ieee_mantissa = bits & ((static_cast<UInt>(1) << MantBits) - 1);
+            const uint32_t ieee_exponent = static_cast<uint32_t>(
+                    (bits >> MantBits) & ((static_cast<UInt>(1) << ExpBits) - 1));
+
+            const char *special = nullptr;
+            if (ieee_exponent == (1u << ExpBits) - 1) {
+                special = ieee_mantissa != 0 ? "nan" : "inf";
+            } else if (ieee_exponent == 0 && ieee_mantissa == 0) {
+                special = "0";
+            }
+            if (special != nullptr) {
+                const size_t n = std::strlen(special);
+                if (last - first < static_cast<ptrdiff_t>(n + negative)) {
+                    return {last, std::errc::value_too_large};
+                }
+                if (negative) *first++ = '-';
+                std::memcpy(first, special, n);
+                return {first + n, std::errc()};
+            }
+            const int bias = (1 << (ExpBits - 1)) - 1;
+            const decimal_fp dec = ryu_shortest<MantBits, bias>(ieee_mantissa, ieee_exponent);
+            const uint64_t m2 = ieee_exponent == 0 ? ieee_mantissa : ((1ull << MantBits) | ieee_mantissa);
+            const int e2 = (ieee_exponent == 0 ? 1 : static_cast<int>(ieee_exponent)) - bias - MantBits;
+            return write_decimal(first, last, negative, dec, m2, e2);
+        }
+
+    }  // namespace charconv_detail
+
+    // ====================================================================================
+
+    /*
+     * 把整数 value 以 base 进制(2 ~ 36)写入 [first, last)，字母使用小写
+     */
+    template<typename Int>
+    typename std::enable_if<std::is_integral<Int>::value && !std::is_same<Int, bool>::value,
+            to_chars_result>::type  // 返回值
+    to_chars(char *first, char *last, Int value, int base = 10) noexcept {
+        typedef typename std::make_unsigned<Int>::type unsigned_type;
+        unsigned_type uv = static_cast<unsigned_type>(value);
+        if (value < 0) {
+            if (first == last) return {last, std::errc::value_too_large};
+            *first++ = '-';
+            uv = static_cast<unsigned_type>(0 - uv);
+        }
+        return charconv_detail::to_chars_unsigned(first, last, static_cast<uint64_t>(uv), base);
+    }
+
+    /*
+     * 输出 value 的最短往返表示：解析回 float 时得到与 value 相同的值
+     */
+    inline to_chars_result to_chars(char *first, char *last, float value) noexcept {
+        return charconv_detail::to_chars_float<float, uint32_t, 23, 8>(first, last, value);
+    }
+
+    /*
+     * 输出 value 的最短往返表示：解析回 double 时得到与 value 相同的值
+     */
+    inline to_chars_result to_chars(char *first, char *last, double value) noexcept {
+        return charconv_detail::to_chars_float<double, uint64_t, 52, 11>(first, last, value);
+    }
+
+    /*
+     * 从 [first, last) 解析 base 进制(2 ~ 36)的整数
+     * 与 c++17 一致：不跳过空白，不接受 '+'，只有有符号类型接受 '-'，也不识别 "0x" 前缀
+     * 失败时 value 保持不变
+     */
+    template<typename Int>
+    typename std::enable_if<std::is_integral<Int>::value && !std::is_same<Int, bool>::value,
+            from_chars_result>::type  // 返回值
+    from_chars(const char *first, const char *last, Int &value, int base = 10) noexcept {
+        typedef typename std::make_unsigned<Int>::type unsigned_type;
+        const bool negative = std::is_signed<Int>::value && first != last && *first == '-';
+        const char *p = first + negative;
+        uint64_t limit = static_cast<uint64_t>(static_cast<unsigned_type>(-1));
+        if (std::is_signed<Int>::value) {
+            limit >>= 1;
+            limit += negative;  // 负数可以多表示一个值
+        }
+        uint64_t mag = 0;
+        from_chars_result res = charconv_detail::from_chars_unsigned(p, last, mag, limit, base);
+        if (res.ec == std::errc::invalid_argument) return {first, res.ec};
+        if (res.ec == std::errc()) {
+            const unsigned_type u = static_cast<unsigned_type>(mag);
+            value = static_cast<Int>(negative ? static_cast<unsigned_type>(0 - u) : u);
+        }
+        return res;
+    }
+
+}  // namespace tinySTL
+
+#endif //TINYSTL_CHARCONV_H
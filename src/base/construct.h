@@ -98,7 +98,7 @@ namespace tinySTL {
     void destroy_cat(ForwardIter first, ForwardIter last, std::false_type) {
         for (; first != last; ++first) {
             /* &*first 时为了获取迭代器所指元素的真实位置，因为*操作是由迭代器重载过的 */
-            destroy(&*first);
+            destroy_one(&*first, std::false_type());
         }
     }
 
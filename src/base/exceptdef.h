@@ -24,6 +24,9 @@ namespace tinySTL {
 #define THROW_OUT_OF_RANGE_IF(expr, what) \
   if ((expr)) throw std::out_of_range(what)
 
+#define THROW_INVALID_ARGUMENT_IF(expr, what) \
+  if ((expr)) throw std::invalid_argument(what)
+
 #define THROW_RUNTIME_ERROR_IF(expr, what) \
   if ((expr)) throw std::runtime_error(what)
 
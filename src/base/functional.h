@@ -10,6 +10,10 @@
 #define TINYSTL_FUNCTIONAL_H
 
 #include <cstddef>  /* 头文件cstddef与其C对应版本兼容，它是C头文件<stddef.h>较新版本，定义了常用的常量、宏、类型和函数 */
+#include <cstdint>  /* 定长整数类型 uint64_t 等 */
+#include <cstring>  /* memcpy */
+#include <cfloat>  /* LDBL_MANT_DIG */
+#include "type_traits.h"  /* type_traits.h文件钟引入了标准库钟的type_traits文件，同时定义了一些自己的模板方法 */
 
 /* 首先定义自己的命名空间 */
 namespace tinySTL {
@@ -318,11 +322,121 @@ template<> struct hash<Type>                    \
 #undef TINYSTL_TRIVIAL_HASH_FCN
 
     /*
-     * hash 仿函数
-     * 对于浮点数，逐位hash
-     * 辅助函数
+     * 整数 hash 的混合函数(finalizer)
+     * 上面整数类型的 hash 是恒等映射，低位分布完全取决于输入，
+     * 经过混合后输入的每一位都会影响输出的每一位
+     */
+
+    /* murmur3 的 64 位 finalizer */
+    inline uint64_t fmix64(uint64_t k) noexcept {
+        k ^= k >> 33;
+        k *= 0xff51afd7ed558ccdull;
+        k ^= k >> 33;
+        k *= 0xc4ceb9fe1a85ec53ull;
+        k ^= k >> 33;
+        return k;
+    }
+
+    /* murmur3 的 32 位 finalizer */
+    inline uint32_t fmix32(uint32_t k) noexcept {
+        k ^= k >> 16;
+        k *= 0x85ebca6bu;
+        k ^= k >> 13;
+        k *= 0xc2b2ae35u;
+        k ^= k >> 16;
+        return k;
+    }
+
+    /* splitmix64：先加上黄金分割常数再混合，0 不会映射到 0 */
+    inline uint64_t splitmix64(uint64_t x) noexcept {
+        x += 0x9e3779b97f4a7c15ull;
+        x = (x ^ (x >> 30)) * 0xbf58476d1ce4e5b9ull;
+        x = (x ^ (x >> 27)) * 0x94d049bb133111ebull;
+        return x ^ (x >> 31);
+    }
+
+    /*
+     * 按 size_t 的位宽选择对应的混合函数
      */
-    inline size_t bitwise_hash(const unsigned char *first, size_t count) {
+    inline size_t hash_mix(size_t h) noexcept {
+#if (_MSC_VER && _WIN64) || ((__GNUC__ || __clang__) && __SIZEOF_POINTER__ == 8)
+        return static_cast<size_t>(fmix64(static_cast<uint64_t>(h)));
+#else
+        return static_cast<size_t>(fmix32(static_cast<uint32_t>(h)));
+#endif
+    }
+
+    /*
+     * 萃取 hash 仿函数的输出是否已经充分混合(任意一位输入的变化都会影响输出的各个位)
+     * 默认为 false，hashtable 对这类 hash 值会先调用 hash_mix 再取低位作为 bucket 下标
+     */
+    template<typename Hash>
+    struct hash_is_avalanching : public tinySTL::m_false_type {
+    };
+
+    /*
+     * hash 仿函数适配器
+     * 在 Hash 的结果上再调用一次 hash_mix
+     */
+    template<typename Key, typename Hash = tinySTL::hash<Key>>
+    struct mixed_hash {
+        Hash hash_fcn;
+
+        size_t operator()(const Key &key) const noexcept(noexcept(hash_fcn(key))) {
+            return hash_mix(hash_fcn(key));
+        }
+    };
+
+    template<typename Key, typename Hash>
+    struct hash_is_avalanching<mixed_hash<Key, Hash>> : public tinySTL::m_true_type {
+    };
+
+    /*
+     * 将 value 的 hash 值合并到 seed 中，用于组合键
+     * 每次合并后都经过一次完整的混合，合并的顺序会影响结果
+     */
+    template<typename T>
+    inline void hash_combine(size_t &seed, const T &value) {
+        seed = hash_mix(seed + static_cast<size_t>(0x9e3779b97f4a7c15ull) + tinySTL::hash<T>()(value));
+    }
+
+    /*
+     * 依次合并区间 [first, last) 中所有元素的 hash 值
+     */
+    template<typename InputIter>
+    inline size_t hash_range(InputIter first, InputIter last) {
+        size_t seed = 0;
+        for (; first != last; ++first) {
+            hash_combine(seed, *first);
+        }
+        return seed;
+    }
+
+    /*
+     * 依次合并多个值的 hash 值，用于为聚合类型编写 hash
+     */
+    inline void hash_combine_values(size_t &) {
+    }
+
+    template<typename T, typename ...Rest>
+    inline void hash_combine_values(size_t &seed, const T &value, const Rest &...rest) {
+        hash_combine(seed, value);
+        hash_combine_values(seed, rest...);
+    }
+
+    // 返回值：所有参数合并后的 hash 值
+    template<typename ...Args>
+    inline size_t hash_values(const Args &...args) {
+        size_t seed = 0;
+        hash_combine_values(seed, args...);
+        return seed;
+    }
+
+    /*
+     * 逐字节的 hash 函数：FNV-1a
+     * 每个字节一次乘法，吞吐约 1 字节/周期，保留作为可选的 hash 算法
+     */
+    inline size_t fnv1a_bytes(const unsigned char *first, size_t count) noexcept {
 #if (_MSC_VER && _WIN64) || ((__GNUC__ || __clang__) && __SIZEOF_POINTER__ == 8)
         const size_t fnv_offset = 14695981039346656037ull;
         const size_t fnv_prime = 1099511628211ull;
@@ -338,13 +452,141 @@ template<> struct hash<Type>                    \
         return result;
     }
 
+    /*
+     * wyhash 的辅助函数
+     * 参考 wyhash (final4)，每一步处理 16 字节，长输入时三路并行处理 48 字节
+     */
+    namespace hash_detail {
+
+        /* wyhash 使用的默认密钥 */
+        constexpr uint64_t wy_secret0 = 0x2d358dccaa6c78a5ull;
+        constexpr uint64_t wy_secret1 = 0x8bb84b93962eacc9ull;
+        constexpr uint64_t wy_secret2 = 0x4b33a62ed433d4a3ull;
+        constexpr uint64_t wy_secret3 = 0x4d5a2da51de1aa47ull;
+
+        /* 64 位乘 64 位得到 128 位结果，低 64 位写回 a，高 64 位写回 b */
+        inline void wy_mum(uint64_t &a, uint64_t &b) noexcept {
+#if defined(__SIZEOF_INT128__)
+            __uint128_t r = a;
+            r *= b;
+            a = static_cast<uint64_t>(r);
+            b = static_cast<uint64_t>(r >> 64);
+#else
+            const uint64_t ha = a >> 32, hb = b >> 32, la = (uint32_t) a, lb = (uint32_t) b;
+            const uint64_t rh = ha * hb, rm0 = ha * lb, rm1 = hb * la, rl = la * lb;
+            const uint64_t t = rl + (rm0 << 32);
+            uint64_t c = t < rl;
+            const uint64_t lo = t + (rm1 << 32);
+            c += lo < t;
+            const uint64_t hi = rh + (rm0 >> 32) + (rm1 >> 32) + c;
+            a = lo;
+            b = hi;
+#endif
+        }
+
+        // 返回值：a * b 的高低 64 位异或
+        inline uint64_t wy_mix(uint64_t a, uint64_t b) noexcept {
+            wy_mum(a, b);
+            return a ^ b;
+        }
+
+        /* 以本机字节序读取 8/4 字节，memcpy 避免未对齐访问 */
+        inline uint64_t wy_r8(const unsigned char *p) noexcept {
+            uint64_t v;
+            std::memcpy(&v, p, 8);
+            return v;
+        }
+
+        inline uint64_t wy_r4(const unsigned char *p) noexcept {
+            uint32_t v;
+            std::memcpy(&v, p, 4);
+            return v;
+        }
+
+        /* 读取 1 ~ 3 字节 */
+        inline uint64_t wy_r3(const unsigned char *p, size_t k) noexcept {
+            return (((uint64_t) p[0]) << 16) | (((uint64_t) p[k >> 1]) << 8) | p[k - 1];
+        }
+
+    }  // namespace hash_detail
+
+    /*
+     * 64 位的 wyhash 风格 hash 函数
+     * 不超过 8 字节的键(整数、浮点数大小的键)装入一个 64 位整数，与长度一起只经过一次 fmix64 混合；
+     * 9 ~ 16 字节的键没有循环，长键每次迭代处理 48 字节，三条乘法链互相独立
+     */
+    inline uint64_t wyhash_bytes(const unsigned char *p, size_t len, uint64_t seed = 0) noexcept {
+        using namespace hash_detail;
+        seed ^= wy_mix(seed ^ wy_secret0, wy_secret1);
+        if (len <= 8) {
+            const uint64_t v = len >= 4 ? (wy_r4(p) << 32) | wy_r4(p + len - 4) : len > 0 ? wy_r3(p, len) : 0;
+            return fmix64(v ^ seed ^ (wy_secret2 * len));
+        }
+        uint64_t a, b;
+        if (len <= 16) {
+            // 9 ~ 16 字节：首尾各读两个可能重叠的 4 字节，16 字节时第二个 4 字节取自偏移 8
+            const size_t off = (len >> 3) << 2;
+            a = (wy_r4(p) << 32) | wy_r4(p + off);
+            b = (wy_r4(p + len - 4) << 32) | wy_r4(p + len - 4 - off);
+        } else {
+            size_t i = len;
+            if (i >= 48) {
+                uint64_t see1 = seed, see2 = seed;
+                do {
+                    seed = wy_mix(wy_r8(p) ^ wy_secret1, wy_r8(p + 8) ^ seed);
+                    see1 = wy_mix(wy_r8(p + 16) ^ wy_secret2, wy_r8(p + 24) ^ see1);
+                    see2 = wy_mix(wy_r8(p + 32) ^ wy_secret3, wy_r8(p + 40) ^ see2);
+                    p += 48;
+                    i -= 48;
+                } while (i >= 48);
+                seed ^= see1 ^ see2;
+            }
+            while (i > 16) {
+                seed = wy_mix(wy_r8(p) ^ wy_secret1, wy_r8(p + 8) ^ seed);
+                i -= 16;
+                p += 16;
+            }
+            a = wy_r8(p + i - 16);
+            b = wy_r8(p + i - 8);
+        }
+        a ^= wy_secret1;
+        b ^= seed;
+        wy_mum(a, b);
+        return wy_mix(a ^ wy_secret0 ^ len, b ^ wy_secret1);
+    }
+
+    /*
+     * hash 仿函数
+     * 对于浮点数、字符串等，逐位hash
+     * 辅助函数，默认使用 wyhash_bytes
+     */
+    inline size_t bitwise_hash(const unsigned char *first, size_t count) noexcept {
+        return static_cast<size_t>(wyhash_bytes(first, count));
+    }
+
+    /*
+     * 浮点数参与 hash 的有效字节数
+     * x87 的 80 位 long double 在 sizeof 中含有未初始化的填充字节，只取前 10 字节
+     */
+    template<typename Float>
+    struct float_hash_bytes {
+        static constexpr size_t value = sizeof(Float);
+    };
+
+#if LDBL_MANT_DIG == 64
+    template<>
+    struct float_hash_bytes<long double> {
+        static constexpr size_t value = 10;
+    };
+#endif
+
     /*
      * hash 仿函数
      * 对float类的全特化模板
      */
     template<>
     struct hash<float> {
-        size_t operator()(const float &val) {
+        size_t operator()(const float &val) const noexcept {
             return val == 0.0f ? 0 : bitwise_hash((const unsigned char *) &val, sizeof(float));
         }
     };
@@ -355,7 +597,7 @@ template<> struct hash<Type>                    \
      */
     template<>
     struct hash<double> {
-        size_t operator()(const double &val) {
+        size_t operator()(const double &val) const noexcept {
             return val == 0.0f ? 0 : bitwise_hash((const unsigned char *) &val, sizeof(double));
         }
     };
@@ -366,8 +608,49 @@ template<> struct hash<Type>                    \
      */
     template<>
     struct hash<long double> {
-        size_t operator()(const long double &val) {
-            return val == 0.0f ? 0 : bitwise_hash((const unsigned char *) &val, sizeof(long double));
+        size_t operator()(const long double &val) const noexcept {
+            return val == 0.0f ? 0 : bitwise_hash((const unsigned char *) &val, float_hash_bytes<long double>::value);
+        }
+    };
+
+    template<>
+    struct hash_is_avalanching<hash<float>> : public tinySTL::m_true_type {
+    };
+
+    template<>
+    struct hash_is_avalanching<hash<double>> : public tinySTL::m_true_type {
+    };
+
+    template<>
+    struct hash_is_avalanching<hash<long double>> : public tinySTL::m_true_type {
+    };
+
+    /*
+     * 使用 FNV-1a 的 hash 仿函数，作为 hash 的可选替代
+     * 浮点数在此处特化，basic_string/basic_string_view 在各自头文件中特化
+     */
+    template<typename Key>
+    struct fnv1a_hash {
+    };
+
+    template<>
+    struct fnv1a_hash<float> {
+        size_t operator()(const float &val) const noexcept {
+            return val == 0.0f ? 0 : fnv1a_bytes((const unsigned char *) &val, sizeof(float));
+        }
+    };
+
+    template<>
+    struct fnv1a_hash<double> {
+        size_t operator()(const double &val) const noexcept {
+            return val == 0.0 ? 0 : fnv1a_bytes((const unsigned char *) &val, sizeof(double));
+        }
+    };
+
+    template<>
+    struct fnv1a_hash<long double> {
+        size_t operator()(const long double &val) const noexcept {
+            return val == 0.0L ? 0 : fnv1a_bytes((const unsigned char *) &val, float_hash_bytes<long double>::value);
         }
     };
 
@@ -681,81 +681,43 @@ namespace tinySTL {
     };
 
 // ===========================================================================================
-/*
- * 根据不同的操作系统位数定义一些常量
- * hashtable的每一次bucket的的大小
- */
-#if (_MSC_VER && _WIN64) || ((__GNUC__ || __clang__) && __SIZEOF_POINTER__ == 8)
-#define SYSTEM_64 1
-#else
-#define SYSTEM_32 1
-#endif
-
-#ifdef SYSTEM_64
-
-#define PRIME_NUM 99
 
     /*
-     * 每个素数的计算获取规则
-     * 1. 开始于 p = 101
-     * 2. p = next_prime(p * 1.7)
-     * 3. if p < (2 << 63), go to step 2, otherwise, go to step 4
-     * 4. 结束于 p = prev_prime(2 << 63 - 1)
+     * hashtable 的 bucket 数量总是 2 的幂，由 hash 值的低位直接得到 bucket 下标，避免了取模的除法
+     * 最小为 128，最大为 size_t 能表示的最大的 2 的幂
      */
-    static constexpr size_t ht_prime_list[] = {
-            101ull, 173ull, 263ull, 397ull, 599ull, 907ull, 1361ull, 2053ull, 3083ull,
-            4637ull, 6959ull, 10453ull, 15683ull, 23531ull, 35311ull, 52967ull, 79451ull,
-            119179ull, 178781ull, 268189ull, 402299ull, 603457ull, 905189ull, 1357787ull,
-            2036687ull, 3055043ull, 4582577ull, 6873871ull, 10310819ull, 15466229ull,
-            23199347ull, 34799021ull, 52198537ull, 78297827ull, 117446801ull, 176170229ull,
-            264255353ull, 396383041ull, 594574583ull, 891861923ull, 1337792887ull,
-            2006689337ull, 3010034021ull, 4515051137ull, 6772576709ull, 10158865069ull,
-            15238297621ull, 22857446471ull, 34286169707ull, 51429254599ull, 77143881917ull,
-            115715822899ull, 173573734363ull, 260360601547ull, 390540902329ull,
-            585811353559ull, 878717030339ull, 1318075545511ull, 1977113318311ull,
-            2965669977497ull, 4448504966249ull, 6672757449409ull, 10009136174239ull,
-            15013704261371ull, 22520556392057ull, 33780834588157ull, 50671251882247ull,
-            76006877823377ull, 114010316735089ull, 171015475102649ull, 256523212653977ull,
-            384784818980971ull, 577177228471507ull, 865765842707309ull, 1298648764060979ull,
-            1947973146091477ull, 2921959719137273ull, 4382939578705967ull, 6574409368058969ull,
-            9861614052088471ull, 14792421078132871ull, 22188631617199337ull, 33282947425799017ull,
-            49924421138698549ull, 74886631708047827ull, 112329947562071807ull, 168494921343107851ull,
-            252742382014661767ull, 379113573021992729ull, 568670359532989111ull, 853005539299483657ull,
-            1279508308949225477ull, 1919262463423838231ull, 2878893695135757317ull, 4318340542703636011ull,
-            6477510814055453699ull, 9716266221083181299ull, 14574399331624771603ull, 18446744073709551557ull
-    };
-
-#else
-
-#define PRIME_NUM 44
+    static constexpr size_t ht_min_bucket_count = 128;
+    static constexpr size_t ht_max_bucket_count = (~static_cast<size_t>(0) >> 1) + 1;
 
     /*
-     * 每个素数的计算获取规则
-     * 1. 开始于 p = 101
-     * 2. p = next_prime(p * 1.7)
-     * 3. if p < (2 << 31), go to step 2, otherwise, go to step 4
-     * 4. 结束于 p = prev_prime(2 << 31 - 1)
+     * 辅助函数
+     * 找出大于等于 n 的最小的 2 的幂
      */
-    static constexpr size_t ht_prime_list[] = {
-      101u, 173u, 263u, 397u, 599u, 907u, 1361u, 2053u, 3083u, 4637u, 6959u,
-      10453u, 15683u, 23531u, 35311u, 52967u, 79451u, 119179u, 178781u, 268189u,
-      402299u, 603457u, 905189u, 1357787u, 2036687u, 3055043u, 4582577u, 6873871u,
-      10310819u, 15466229u, 23199347u, 34799021u, 52198537u, 78297827u, 117446801u,
-      176170229u, 264255353u, 396383041u, 594574583u, 891861923u, 1337792887u,
-      2006689337u, 3010034021u, 4294967291u,
-    };
-
-#endif
+    inline size_t ht_next_pow2(size_t n) {
+        if (n <= ht_min_bucket_count) {
+            return ht_min_bucket_count;
+        }
+        if (n > ht_max_bucket_count) {
+            return ht_max_bucket_count;
+        }
+        size_t p = ht_min_bucket_count;
+        while (p < n) {
+            p <<= 1;
+        }
+        return p;
+    }
 
     /*
      * 辅助函数
-     * 找出最接近并大于等于 n 的那个质数
+     * bucket 下标只取 hash 值的低位，要求低位分布均匀
+     * 对于没有充分混合的 hash 值(如整数的恒等 hash)，先经过 hash_mix
      */
-    inline size_t ht_next_prime(size_t n) {
-        const size_t *first = ht_prime_list;
-        const size_t *last = ht_prime_list + PRIME_NUM;
-        const size_t *pos = tinySTL::lower_bound(first, last, n);
-        return pos == last ? *(last - 1) : *pos;
+    inline size_t ht_bucket_hash(size_t h, tinySTL::m_true_type) noexcept {
+        return h;
+    }
+
+    inline size_t ht_bucket_hash(size_t h, tinySTL::m_false_type) noexcept {
+        return tinySTL::hash_mix(h);
     }
 
     // ======================================================================================================
@@ -1233,7 +1195,7 @@ namespace tinySTL {
          * 获取指定bucket的链表头部迭代器
          */
         local_iterator begin(size_type n) noexcept {
-            TINYSTL_DEBUG(n < size_);
+            TINYSTL_DEBUG(n < bucket_size_);
             return buckets_[n];
         }
 
@@ -1241,7 +1203,7 @@ namespace tinySTL {
          * 获取指定bucket的链表头部迭代器 const重载
          */
         const_local_iterator begin(size_type n) const noexcept {
-            TINYSTL_DEBUG(n < size_);
+            TINYSTL_DEBUG(n < bucket_size_);
             return buckets_[n];
         }
 
@@ -1249,7 +1211,7 @@ namespace tinySTL {
          * 获取指定bucket的链表尾部迭代器
          */
         local_iterator end(size_type n) noexcept {
-            TINYSTL_DEBUG(n < size_);
+            TINYSTL_DEBUG(n < bucket_size_);
             return nullptr;
         }
 
@@ -1257,7 +1219,7 @@ namespace tinySTL {
          * 获取指定bucket的链表尾迭代器 const重载
          */
         const_local_iterator end(size_type n) const noexcept {
-            TINYSTL_DEBUG(n < size_);
+            TINYSTL_DEBUG(n < bucket_size_);
             return nullptr;
         }
 
@@ -1265,7 +1227,7 @@ namespace tinySTL {
          * 获取指定bucket的链表常量头部迭代器
          */
         const_local_iterator cbegin(size_type n) const noexcept {
-            TINYSTL_DEBUG(n < size_);
+            TINYSTL_DEBUG(n < bucket_size_);
             return buckets_[n];
         }
 
@@ -1273,7 +1235,7 @@ namespace tinySTL {
          * 获取指定bucket的链表常量头部迭代器
          */
         const_local_iterator cend(size_type n) const noexcept {
-            TINYSTL_DEBUG(n < size_);
+            TINYSTL_DEBUG(n < bucket_size_);
             return nullptr;
         }
 
@@ -1288,7 +1250,7 @@ namespace tinySTL {
          * 返回最大bucket的数量
          */
         size_type max_bucket_count() const noexcept {
-            return ht_prime_list[PRIME_NUM - 1];
+            return ht_max_bucket_count;
         }
 
         /*
@@ -2071,7 +2033,7 @@ namespace tinySTL {
     template<typename T, typename HashFun, typename KeyEqual>
     typename hashtable<T, HashFun, KeyEqual>::size_type  // 返回值
     hashtable<T, HashFun, KeyEqual>::next_size(size_type n) const {
-        return ht_next_prime(n);
+        return ht_next_pow2(n);
     }
 
     /*
@@ -2080,7 +2042,7 @@ namespace tinySTL {
     template<typename T, typename HashFun, typename KeyEqual>
     typename hashtable<T, HashFun, KeyEqual>::size_type  // 返回值
     hashtable<T, HashFun, KeyEqual>::hash(const key_type &key, size_type n) const {
-        return hash_(key) % n;
+        return ht_bucket_hash(hash_(key), hash_is_avalanching<hasher>()) & (n - 1);
     }
 
     /*
@@ -2089,7 +2051,7 @@ namespace tinySTL {
     template<typename T, typename HashFun, typename KeyEqual>
     typename hashtable<T, HashFun, KeyEqual>::size_type  // 返回值
     hashtable<T, HashFun, KeyEqual>::hash(const key_type &key) const {
-        return hash_(key) % bucket_size_;
+        return ht_bucket_hash(hash_(key), hash_is_avalanching<hasher>()) & (bucket_size_ - 1);
     }
 
     /*
@@ -2226,11 +2188,16 @@ namespace tinySTL {
     void hashtable<T, HashFun, KeyEqual>::replace_bucket(size_type bucket_count) {
         /* 首先根据大小初始化一个新的bucket */
         bucket_type bucket(bucket_count);
-        /* 开始迁移，迁移后的节点就算还是在同一个hashtable位置上，但相对位置还是有可能改变 */
+        /*
+         * 开始迁移，迁移后的节点就算还是在同一个hashtable位置上，但相对位置还是有可能改变
+         * 直接把原有节点摘下挂到新的bucket上，不复制元素也不分配内存
+         */
         if (size_ != 0) {
             for (size_type i = 0; i < bucket_size_; ++i) {
-                for (node_ptr first = buckets_[i]; first; first = first->next) {
-                    node_ptr temp = create_node(first->value);
+                node_ptr next = nullptr;
+                for (node_ptr first = buckets_[i]; first; first = next) {
+                    next = first->next;
+                    node_ptr temp = first;
                     /* 计算新的位置 */
                     const size_type n = hash(value_traits::get_key(first->value), bucket_count);
                     node_ptr f = bucket[n];
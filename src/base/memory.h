@@ -171,7 +171,8 @@ namespace tinySTL {
      * temporary_buffer类构造函数
      */
     template<typename ForwardIterator, typename T>
-    temporary_buffer<ForwardIterator, T>::temporary_buffer(ForwardIterator first, ForwardIterator last) {
+    temporary_buffer<ForwardIterator, T>::temporary_buffer(ForwardIterator first, ForwardIterator last)
+            : original_len(0), len(0), buffer(nullptr) {
         try {
             len = tinySTL::distance(first, last);
             allocate_buffer();
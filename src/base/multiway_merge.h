@@ -0,0 +1,269 @@
+//
+// Created by cqupt1811 on 2022/5/30.
+//
+
+/*
+ * 这个头文件包含多路归并 multiway_merge 与多序列选择 multiseq_partition
+ * 序列以 [seqs_first, seqs_last) 给出，每个元素是一个 pair(first, last)，表示一个按 comp 有序的区间
+ * multiway_merge:     败者树(tournament tree)每输出一个元素只需 log2(k) 次比较；合并是稳定的，
+ *                     相等的元素先输出序号小的序列中的，两路时与 merge 的结果相同
+ * multiseq_partition: 求出每个序列的切分位置，使得合并结果的前 rank 个元素恰好由各序列切分位置之前的元素组成，
+ *                     用于把输出切分为互不相关的若干段并行归并(见 execution.h)
+ */
+
+#ifndef TINYSTL_MULTIWAY_MERGE_H
+#define TINYSTL_MULTIWAY_MERGE_H
+
+#include <cstddef>  /* 定义了 size_t 等常用类型 */
+#include <type_traits>  /* std::decay */
+#include <utility>  /* std::declval */
+#include "algo.h"  /* 这个头文件包含了 tinySTL 的一系列算法 */
+#include "iterator.h"  /* 这个头文件用于迭代器设计，包含了一些模板结构体与全局函数 */
+#include "vector.h"  /* 这个头文件包含一个模板类 vector */
+
+/* 首先定义自己的命名空间 */
+namespace tinySTL {
+
+    namespace multiway_detail {
+
+        /*
+         * 序列描述 pair(first, last) 中的迭代器类型
+         */
+        template<typename SeqIter>
+        struct seq_iterator {
+            typedef typename std::decay<decltype((*std::declval<SeqIter>()).first)>::type type;
+        };
+
+        /*
+         * 败者树：叶子为各个序列的当前元素，叶子数补齐为 2 的幂，补出的叶子与已经耗尽的序列视为无穷大；
+         * 每个内部结点保存该处比赛的败者，tree_[0] 保存总的胜者。取出胜者后只需沿它到根的路径重赛一遍
+         */
+        template<typename Iter, typename Compared>
+        class loser_tree {
+        public:
+            /*
+             * cur_ 与 end_ 一次构造出 k 个位置，不经过 vector 的扩容：扩容按 trivially move assignable 使用
+             * memmove，对 list_iterator 这类不可平凡复制的迭代器并不合适
+             */
+            loser_tree(size_t k, Compared comp)
+                    : k_(k), leaves_(1), added_(0), comp_(comp), cur_(k), end_(k) {
+                while (leaves_ < k_) {
+                    leaves_ <<= 1;
+                }
+            }
+
+            void add(Iter first, Iter last) {
+                cur_[added_] = first;
+                end_[added_] = last;
+                ++added_;
+            }
+
+            /*
+             * 所有序列加入后自底向上进行第一轮比赛
+             */
+            void build() {
+                tinySTL::vector<size_t> winner(2 * leaves_);
+                tree_.assign(leaves_, 0);
+                for (size_t i = 0; i < leaves_; ++i) {
+                    winner[leaves_ + i] = i;
+                }
+                for (size_t node = leaves_ - 1; node >= 1; --node) {
+                    const size_t a = winner[2 * node];
+                    const size_t b = winner[2 * node + 1];
+                    if (beats(a, b)) {
+                        winner[node] = a;
+                        tree_[node] = b;
+                    } else {
+                        winner[node] = b;
+                        tree_[node] = a;
+                    }
+                }
+                tree_[0] = winner[1];
+            }
+
+            bool empty() const {
+                return done(tree_[0]);
+            }
+
+            Iter top() const {
+                return cur_[tree_[0]];
+            }
+
+            void pop() {
+                size_t w = tree_[0];
+                ++cur_[w];
+                for (size_t node = (w + leaves_) >> 1; node >= 1; node >>= 1) {
+                    if (beats(tree_[node], w)) {
+                        tinySTL::swap(tree_[node], w);
+                    }
+                }
+                tree_[0] = w;
+            }
+
+        private:
+            bool done(size_t i) const {
+                return i >= k_ || cur_[i] == end_[i];
+            }
+
+            /*
+             * 序列 i 的当前元素是否排在序列 j 的当前元素之前，相等时序号小的在前，每次只调用一次 comp
+             */
+            bool beats(size_t i, size_t j) {
+                if (done(i)) {
+                    return false;
+                }
+                if (done(j)) {
+                    return true;
+                }
+                return i < j ? !comp_(*cur_[j], *cur_[i]) : comp_(*cur_[i], *cur_[j]);
+            }
+
+            size_t k_;
+            size_t leaves_;
+            size_t added_;  // 已经加入的序列个数
+            Compared comp_;
+            tinySTL::vector<Iter> cur_;
+            tinySTL::vector<Iter> end_;
+            tinySTL::vector<size_t> tree_;
+        };
+
+        /*
+         * 多序列选择的候选枢轴：序列 seq 中剩余窗口的中点 pos，权重为窗口的长度
+         */
+        struct candidate {
+            size_t seq;
+            size_t pos;
+            size_t weight;
+        };
+
+    }  // namespace multiway_detail
+
+    // =============================================================================================
+
+    /*
+     * multiway_merge 函数
+     * 把 [seqs_first, seqs_last) 描述的 k 个有序序列合并到以 result 为起始的区间，返回一个迭代器指向输出结果的尾部
+     */
+    template<typename SeqIter, typename OutputIter, typename Compared>
+    OutputIter multiway_merge(SeqIter seqs_first, SeqIter seqs_last, OutputIter result, Compared comp) {
+        typedef typename multiway_detail::seq_iterator<SeqIter>::type Iter;
+        size_t k = 0;
+        for (SeqIter s = seqs_first; s != seqs_last; ++s) {
+            ++k;
+        }
+        if (k == 0) {
+            return result;
+        }
+        if (k == 1) {
+            return tinySTL::copy((*seqs_first).first, (*seqs_first).second, result);
+        }
+        if (k == 2) {
+            SeqIter second = seqs_first;
+            ++second;
+            return tinySTL::merge((*seqs_first).first, (*seqs_first).second,
+                                  (*second).first, (*second).second, result, comp);
+        }
+        multiway_detail::loser_tree<Iter, Compared> tree(k, comp);
+        for (; seqs_first != seqs_last; ++seqs_first) {
+            tree.add((*seqs_first).first, (*seqs_first).second);
+        }
+        tree.build();
+        for (; !tree.empty(); tree.pop()) {
+            *result = *tree.top();
+            ++result;
+        }
+        return result;
+    }
+
+    template<typename SeqIter, typename OutputIter>
+    OutputIter multiway_merge(SeqIter seqs_first, SeqIter seqs_last, OutputIter result) {
+        return tinySTL::multiway_merge(seqs_first, seqs_last, result, search_detail::less_than());
+    }
+
+    // =============================================================================================
+
+    /*
+     * multiseq_partition 函数
+     * 序列为随机访问迭代器，把切分位置依次写入 split(共 k 个)，rank 超过元素总数时按元素总数处理。
+     * 各序列的切分位置维持在窗口 [lo, hi] 中；每轮取各窗口中点的带权中位数作为枢轴，在每个窗口中二分查找它的位置，
+     * 根据这些位置之和与 rank 的大小关系收缩所有窗口。至少一半权重的窗口被截去一半，因此只需 O(log N) 轮，
+     * 每轮 O(k log n) 次比较，与序列的长度几乎无关
+     */
+    template<typename SeqIter, typename OutputIter, typename Compared>
+    void multiseq_partition(SeqIter seqs_first, SeqIter seqs_last, size_t rank, OutputIter split, Compared comp) {
+        typedef typename multiway_detail::seq_iterator<SeqIter>::type Iter;
+        tinySTL::vector<Iter> first;
+        tinySTL::vector<size_t> lo, hi;
+        size_t sum_lo = 0, sum_hi = 0;
+        for (; seqs_first != seqs_last; ++seqs_first) {
+            first.push_back((*seqs_first).first);
+            const size_t n = static_cast<size_t>((*seqs_first).second - (*seqs_first).first);
+            lo.push_back(0);
+            hi.push_back(n);
+            sum_hi += n;
+        }
+        const size_t k = first.size();
+        tinySTL::vector<multiway_detail::candidate> cand;
+        cand.reserve(k);
+        while (sum_lo < rank && rank < sum_hi) {
+            cand.clear();
+            size_t total = 0;
+            for (size_t i = 0; i < k; ++i) {
+                if (lo[i] < hi[i]) {
+                    cand.push_back({i, lo[i] + (hi[i] - lo[i]) / 2, hi[i] - lo[i]});
+                    total += hi[i] - lo[i];
+                }
+            }
+            /* 按 (元素, 序列号) 的顺序排列候选，累计权重达到一半处即为带权中位数 */
+            tinySTL::sort(cand.begin(), cand.end(),
+                          [&](const multiway_detail::candidate &a, const multiway_detail::candidate &b) {
+                              if (comp(first[a.seq][a.pos], first[b.seq][b.pos])) {
+                                  return true;
+                              }
+                              return !comp(first[b.seq][b.pos], first[a.seq][a.pos]) && a.seq < b.seq;
+                          });
+            size_t c = 0;
+            for (size_t acc = cand[0].weight; 2 * acc < total; acc += cand[++c].weight) {}
+            const size_t j = cand[c].seq;
+            const size_t q = cand[c].pos;
+            /* 每个序列中排在枢轴之前的元素个数，限制在窗口内；相等的元素中序号小于 j 的序列排在枢轴之前 */
+            auto &&pivot = first[j][q];
+            tinySTL::vector<size_t> pos(k);
+            size_t sum = 0;
+            for (size_t i = 0; i < k; ++i) {
+                if (i == j) {
+                    pos[i] = q;
+                } else if (i < j) {
+                    pos[i] = static_cast<size_t>(tinySTL::upper_bound(first[i] + lo[i], first[i] + hi[i],
+                                                                      pivot, comp) - first[i]);
+                } else {
+                    pos[i] = static_cast<size_t>(tinySTL::lower_bound(first[i] + lo[i], first[i] + hi[i],
+                                                                      pivot, comp) - first[i]);
+                }
+                sum += pos[i];
+            }
+            if (sum < rank) {
+                /* 枢轴在第 rank 个元素之前，它以及它之前的元素都属于前 rank 个 */
+                pos[j] = q + 1;
+                lo.swap(pos);
+                sum_lo = sum + 1;
+            } else {
+                hi.swap(pos);
+                sum_hi = sum;
+            }
+        }
+        const tinySTL::vector<size_t> &result = sum_lo >= rank ? lo : hi;
+        for (size_t i = 0; i < k; ++i) {
+            *split = result[i];
+            ++split;
+        }
+    }
+
+    template<typename SeqIter, typename OutputIter>
+    void multiseq_partition(SeqIter seqs_first, SeqIter seqs_last, size_t rank, OutputIter split) {
+        tinySTL::multiseq_partition(seqs_first, seqs_last, rank, split, search_detail::less_than());
+    }
+
+}  // namespace tinySTL
+
+#endif //TINYSTL_MULTIWAY_MERGE_H
@@ -4,12 +4,16 @@
 
 /*
  * 这个头文件包含了 tinySTL 的数值算法
+ * accumulate, reduce, adjacent_difference, inner_product, transform_reduce, iota, partial_sum,
+ * inclusive_scan, exclusive_scan
  */
 
 #ifndef TINYSTL_NUMERIC_H
 #define TINYSTL_NUMERIC_H
 
 #include "iterator.h"  /* 这个头文件用于迭代器设计，包含了一些模板结构体与全局函数 */
+#include "functional.h"  /* 这个头文件包含了 tinySTL 的函数对象与哈希函数 */
+#include "simd_algo.h"  /* 这个头文件包含算术类型连续区间上的 SIMD 内核 */
 
 
 namespace tinySTL {
@@ -25,13 +29,26 @@ namespace tinySTL {
      * 以初值 init 对每个元素进行累加
      */
     template<typename InputIter, typename T>
-    T accumulate(InputIter first, InputIter last, T init) {
+    T accumulate_simd_dispatch(InputIter first, InputIter last, T init, m_false_type) {
         for (; first != last; ++first) {
             init += *first;
         }
         return init;
     }
 
+    /* 整数的加法满足结合律，连续的整数区间使用 SIMD 内核；浮点数保持从左到右的累加顺序 */
+    template<typename Ptr, typename T>
+    T accumulate_simd_dispatch(Ptr first, Ptr last, T init, m_true_type) {
+        return simd::sum(first, static_cast<size_t>(last - first), init);
+    }
+
+    template<typename InputIter, typename T>
+    T accumulate(InputIter first, InputIter last, T init) {
+        return tinySTL::accumulate_simd_dispatch(first, last, init,
+                                                 m_bool_constant<simd::is_simd_range<InputIter, T>::value
+                                                                 && std::is_integral<T>::value>());
+    }
+
     /*
      * accumulate 函数 重载版本
      * 以初值 init 对每个元素进行二元操作
@@ -46,6 +63,30 @@ namespace tinySTL {
 
     // ======================================================================================
 
+    /*
+     * reduce 归约函数
+     * 串行版本按从左到右的顺序归约，与 accumulate 相同，结果可以复现；
+     * 允许改变运算顺序的并行与向量化版本见 execution.h
+     */
+
+    template<typename InputIter, typename T, typename BinaryOp>
+    T reduce(InputIter first, InputIter last, T init, BinaryOp binary_op) {
+        return tinySTL::accumulate(first, last, init, binary_op);
+    }
+
+    template<typename InputIter, typename T>
+    T reduce(InputIter first, InputIter last, T init) {
+        return tinySTL::accumulate(first, last, init);
+    }
+
+    template<typename InputIter>
+    typename iterator_traits<InputIter>::value_type  // 返回值
+    reduce(InputIter first, InputIter last) {
+        return tinySTL::accumulate(first, last, typename iterator_traits<InputIter>::value_type());
+    }
+
+    // ======================================================================================
+
     /*
      * adjacent_difference 计算相邻元素的差值
      */
@@ -97,13 +138,27 @@ namespace tinySTL {
      * 以 init 为初值，计算两个区间的内积
      */
     template<typename InputIter1, typename InputIter2, typename T>
-    T inner_product(InputIter1 first1, InputIter1 last1, InputIter2 first2, T init) {
+    T inner_product_simd_dispatch(InputIter1 first1, InputIter1 last1, InputIter2 first2, T init, m_false_type) {
         for (; first1 != last1; ++first1, ++first2) {
             init += *first1 * *first2;
         }
         return init;
     }
 
+    /* 两个区间都是连续的同类型整数区间时使用 SIMD 内核 */
+    template<typename Ptr1, typename Ptr2, typename T>
+    T inner_product_simd_dispatch(Ptr1 first1, Ptr1 last1, Ptr2 first2, T init, m_true_type) {
+        return simd::dot(first1, first2, static_cast<size_t>(last1 - first1), init);
+    }
+
+    template<typename InputIter1, typename InputIter2, typename T>
+    T inner_product(InputIter1 first1, InputIter1 last1, InputIter2 first2, T init) {
+        return tinySTL::inner_product_simd_dispatch(first1, last1, first2, init,
+                                                    m_bool_constant<simd::is_simd_range<InputIter1, T>::value
+                                                                    && simd::is_simd_range<InputIter2, T>::value
+                                                                    && std::is_integral<T>::value>());
+    }
+
     /*
      * inner_product 内积 重载版本
      * 自定义 operator+ 和 operator*
@@ -119,6 +174,43 @@ namespace tinySTL {
 
     // ===========================================================================================
 
+    /*
+     * transform_reduce 函数
+     */
+
+    /*
+     * transform_reduce 函数
+     * 对两个区间对应的元素做 transform_op，再以 init 为初值用 reduce_op 归约
+     */
+    template<typename InputIter1, typename InputIter2, typename T, typename BinaryOp1, typename BinaryOp2>
+    T transform_reduce(InputIter1 first1, InputIter1 last1, InputIter2 first2, T init,
+                       BinaryOp1 reduce_op, BinaryOp2 transform_op) {
+        return tinySTL::inner_product(first1, last1, first2, init, reduce_op, transform_op);
+    }
+
+    /*
+     * transform_reduce 函数 重载版本
+     * 缺省为内积
+     */
+    template<typename InputIter1, typename InputIter2, typename T>
+    T transform_reduce(InputIter1 first1, InputIter1 last1, InputIter2 first2, T init) {
+        return tinySTL::inner_product(first1, last1, first2, init);
+    }
+
+    /*
+     * transform_reduce 函数 重载版本
+     * 对每个元素做一元的 transform_op，再以 init 为初值用 reduce_op 归约
+     */
+    template<typename InputIter, typename T, typename BinaryOp, typename UnaryOp>
+    T transform_reduce(InputIter first, InputIter last, T init, BinaryOp reduce_op, UnaryOp transform_op) {
+        for (; first != last; ++first) {
+            init = reduce_op(init, transform_op(*first));
+        }
+        return init;
+    }
+
+    // ===========================================================================================
+
     /*
      * iota 函数
      * 填充[first, last)，以 value 为初值开始递增
@@ -173,6 +265,103 @@ namespace tinySTL {
         return ++result;
     }
 
+    // ==============================================================================================
+
+    /*
+     * inclusive_scan, exclusive_scan 前缀和
+     * 与 partial_sum 相同，第 i 个结果包含(inclusive)或不包含(exclusive)第 i 个元素；
+     * result 可以等于 first。连续的同类型整数区间求和时使用 SIMD 内核，浮点数保持从左到右的顺序
+     */
+
+    template<typename InputIter, typename OutputIter, typename T, typename BinaryOp>
+    OutputIter inclusive_scan_simd_dispatch(InputIter first, InputIter last, OutputIter result,
+                                            BinaryOp binary_op, T init, m_false_type) {
+        for (; first != last; ++first, ++result) {
+            init = binary_op(init, *first);
+            *result = init;
+        }
+        return result;
+    }
+
+    template<typename Ptr, typename T, typename BinaryOp>
+    T *inclusive_scan_simd_dispatch(Ptr first, Ptr last, T *result, BinaryOp, T init, m_true_type) {
+        return simd::inclusive_scan(first, static_cast<size_t>(last - first), result, init);
+    }
+
+    template<typename InputIter, typename OutputIter, typename T, typename BinaryOp>
+    OutputIter exclusive_scan_simd_dispatch(InputIter first, InputIter last, OutputIter result,
+                                            T init, BinaryOp binary_op, m_false_type) {
+        for (; first != last; ++first, ++result) {
+            T value = *first;
+            *result = init;
+            init = binary_op(init, value);
+        }
+        return result;
+    }
+
+    template<typename Ptr, typename T, typename BinaryOp>
+    T *exclusive_scan_simd_dispatch(Ptr first, Ptr last, T *result, T init, BinaryOp, m_true_type) {
+        return simd::exclusive_scan(first, static_cast<size_t>(last - first), result, init);
+    }
+
+    namespace numeric_detail {
+
+        /*
+         * 输入与输出都是连续的 T 区间，T 为整数并且二元操作为 tinySTL::plus<T> 时可以使用 SIMD 内核
+         */
+        template<typename InputIter, typename OutputIter, typename T, typename BinaryOp>
+        struct use_simd_scan : public m_bool_constant<
+                simd::is_simd_range<InputIter, T>::value && simd::is_simd_range<OutputIter, T>::value
+                && std::is_integral<T>::value && std::is_same<BinaryOp, tinySTL::plus<T>>::value> {
+        };
+
+    }  // namespace numeric_detail
+
+    /*
+     * inclusive_scan 函数
+     * 以 init 为初值，result[i] = init op first[0] op ... op first[i]
+     */
+    template<typename InputIter, typename OutputIter, typename BinaryOp, typename T>
+    OutputIter inclusive_scan(InputIter first, InputIter last, OutputIter result, BinaryOp binary_op, T init) {
+        return tinySTL::inclusive_scan_simd_dispatch(first, last, result, binary_op, init,
+                numeric_detail::use_simd_scan<InputIter, OutputIter, T, BinaryOp>());
+    }
+
+    /*
+     * inclusive_scan 函数 重载版本
+     * 没有初值，以第一个元素作为初值
+     */
+    template<typename InputIter, typename OutputIter, typename BinaryOp>
+    OutputIter inclusive_scan(InputIter first, InputIter last, OutputIter result, BinaryOp binary_op) {
+        if (first == last) {
+            return result;
+        }
+        typename iterator_traits<InputIter>::value_type init = *first;
+        *result = init;
+        return tinySTL::inclusive_scan(++first, last, ++result, binary_op, init);
+    }
+
+    template<typename InputIter, typename OutputIter>
+    OutputIter inclusive_scan(InputIter first, InputIter last, OutputIter result) {
+        return tinySTL::inclusive_scan(first, last, result,
+                                       tinySTL::plus<typename iterator_traits<InputIter>::value_type>());
+    }
+
+    /*
+     * exclusive_scan 函数
+     * 以 init 为初值，result[i] = init op first[0] op ... op first[i - 1]
+     */
+    template<typename InputIter, typename OutputIter, typename T, typename BinaryOp>
+    OutputIter exclusive_scan(InputIter first, InputIter last, OutputIter result, T init, BinaryOp binary_op) {
+        return tinySTL::exclusive_scan_simd_dispatch(first, last, result, init, binary_op,
+                numeric_detail::use_simd_scan<InputIter, OutputIter, T, BinaryOp>());
+    }
+
+    template<typename InputIter, typename OutputIter, typename T>
+    OutputIter exclusive_scan(InputIter first, InputIter last, OutputIter result, T init) {
+        return tinySTL::exclusive_scan(first, last, result, init, tinySTL::plus<T>());
+    }
+
 }  // namepsace tinySTL
 
 #endif //TINYSTL_NUMERIC_H
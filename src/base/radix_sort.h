@@ -0,0 +1,392 @@
+//
+// Created by cqupt1811 on 2022/5/27.
+//
+
+/*
+ * 这个头文件包含基数排序 radix_sort，按 key(*it) 的值对 [first, last) 排序
+ * key 为算术类型时使用 LSD(低位优先)基数排序，结果是稳定的：
+ *   整数与浮点数先编码为无符号整数，使无符号比较的顺序与原类型一致
+ *   有符号整数翻转符号位；浮点数为负时翻转所有位，否则翻转符号位(-0.0 排在 +0.0 之前，NaN 按位模式排在两端)
+ *   8、16 位的 key 每趟处理 8 位，更宽的 key 每趟处理 11 位，32 位 key 只需 3 趟，64 位 key 需要 6 趟
+ *   一次扫描同时统计所有趟的直方图，所有元素在某一位上都相同时跳过该趟
+ *   数据较多时先按高位做 MSD 分配，直到桶能放入缓存，再在每个桶内完成其余各趟，减少对内存的完整读写
+ * key 为字符串(basic_string、basic_string_view 等)时使用 MSD(高位优先)的原地基数排序(American flag sort)，结果不稳定：
+ *   每一层按第 depth 个字符分为 257 个桶(已结束的字符串在最前)，在原区间内通过交换归位，再递归处理各个桶
+ *   元素较少的桶改用 tinySTL::sort，字符类型宽于 1 字节时直接使用 tinySTL::sort
+ *   key 最好返回引用，避免每次取字符时复制字符串
+ */
+
+#ifndef TINYSTL_RADIX_SORT_H
+#define TINYSTL_RADIX_SORT_H
+
+#include <cstddef>  /* 定义了 size_t 等常用类型 */
+#include <cstdint>  /* 定长整数类型 uint32_t 等 */
+#include <cstring>  /* memcpy */
+#include <type_traits>  /* std::is_integral, std::is_floating_point 等 */
+#include "algo.h"  /* 这个头文件包含了 tinySTL 的一系列算法 */
+#include "allocator.h"  /* 这个头文件包含一个模板类 allocator，用于管理内存的分配、释放，对象的构造、析构 */
+#include "functional.h"  /* 这个头文件包含了 tinySTL 的函数对象与哈希函数 */
+#include "iterator.h"  /* 这个头文件用于迭代器设计，包含了一些模板结构体与全局函数 */
+#include "uninitialized.h"  /* 这个头文件用于对未初始化空间构造元素 */
+#include "vector.h"  /* 这个头文件包含一个模板类 vector */
+
+/* 首先定义自己的命名空间 */
+namespace tinySTL {
+
+    namespace radix_detail {
+
+        /*
+         * 元素个数少于该值时使用插入排序
+         */
+        const size_t kLsdSmallSize = 256;
+
+        /*
+         * 元素个数不少于该值时，先按最高数位分配一趟，再在各个桶内做 LSD
+         */
+        const size_t kHybridSize = 1 << 16;
+
+        /*
+         * MSD 排序中元素个数少于该值的桶使用 tinySTL::sort
+         */
+        const size_t kMsdSmallSize = 32;
+
+        /*
+         * MSD 排序的递归层数超过该值时改用 tinySTL::sort，避免长公共前缀导致递归过深
+         */
+        const size_t kMsdMaxLevels = 512;
+
+        // =======================================================================================
+        /*
+         * 把算术类型的 key 编码为无符号整数，保持大小顺序
+         */
+        template<typename Key, typename = void>
+        struct key_encoder;
+
+        template<typename Key>
+        struct key_encoder<Key, typename std::enable_if<std::is_integral<Key>::value
+                                                        && std::is_unsigned<Key>::value>::type> {
+            typedef Key unsigned_type;
+
+            static unsigned_type encode(Key key) noexcept {
+                return key;
+            }
+        };
+
+        template<typename Key>
+        struct key_encoder<Key, typename std::enable_if<std::is_integral<Key>::value
+                                                        && std::is_signed<Key>::value>::type> {
+            typedef typename std::make_unsigned<Key>::type unsigned_type;
+
+            static unsigned_type encode(Key key) noexcept {
+                return static_cast<unsigned_type>(static_cast<unsigned_type>(key)
+                                                  ^ (static_cast<unsigned_type>(1) << (sizeof(Key) * 8 - 1)));
+            }
+        };
+
+        template<>
+        struct key_encoder<float> {
+            typedef uint32_t unsigned_type;
+
+            static unsigned_type encode(float key) noexcept {
+                uint32_t u;
+                std::memcpy(&u, &key, sizeof(u));
+                return u ^ ((u >> 31) != 0 ? 0xFFFFFFFFu : 0x80000000u);
+            }
+        };
+
+        template<>
+        struct key_encoder<double> {
+            typedef uint64_t unsigned_type;
+
+            static unsigned_type encode(double key) noexcept {
+                uint64_t u;
+                std::memcpy(&u, &key, sizeof(u));
+                return u ^ ((u >> 63) != 0 ? 0xFFFFFFFFFFFFFFFFull : 0x8000000000000000ull);
+            }
+        };
+
+        /*
+         * 编码后的 key 的比较，插入排序时使用
+         */
+        template<typename KeyOf, typename Encoder>
+        struct encoded_less {
+            KeyOf key;
+
+            template<typename T>
+            bool operator()(const T &lhs, const T &rhs) const {
+                return Encoder::encode(key(lhs)) < Encoder::encode(key(rhs));
+            }
+        };
+
+        /*
+         * 一趟分配：按 shift 处的数位把 [first, last) 的元素移动到 out 中，offsets 为各个桶的起始位置
+         */
+        template<typename InputIter, typename OutputIter, typename KeyOf, typename Encoder>
+        void scatter(InputIter first, InputIter last, OutputIter out, size_t *offsets,
+                     unsigned shift, size_t mask, KeyOf &key, Encoder) {
+            for (; first != last; ++first) {
+                const size_t digit = static_cast<size_t>(Encoder::encode(key(*first)) >> shift) & mask;
+                *(out + offsets[digit]++) = tinySTL::move(*first);
+            }
+        }
+
+        /*
+         * 对一段数据按低 passes 个数位做 LSD 排序，数据在 buffer 中(in_buffer)或 [first, first + n) 中，结果放回后者
+         * hist 为 passes * radix 个计数的临时空间
+         */
+        template<typename RandomIter, typename T, typename KeyOf, typename Encoder>
+        void lsd_passes(RandomIter first, T *buffer, size_t n, KeyOf &key, Encoder, unsigned passes,
+                        unsigned digit_bits, bool in_buffer, size_t *hist) {
+            typedef typename Encoder::unsigned_type unsigned_type;
+            if (n < kLsdSmallSize) {
+                if (in_buffer) {
+                    tinySTL::move(buffer, buffer + n, first);
+                }
+                pdqsort_detail::insertion_sort(first, first + n, encoded_less<KeyOf, Encoder>{key});
+                return;
+            }
+            const size_t radix = static_cast<size_t>(1) << digit_bits;
+            const size_t mask = radix - 1;
+            // 一次扫描统计所有趟的直方图
+            for (size_t i = 0; i < passes * radix; ++i) {
+                hist[i] = 0;
+            }
+            for (size_t i = 0; i < n; ++i) {
+                const unsigned_type u = Encoder::encode(key(in_buffer ? buffer[i] : *(first + i)));
+                for (unsigned p = 0; p < passes; ++p) {
+                    ++hist[p * radix + (static_cast<size_t>(u >> (p * digit_bits)) & mask)];
+                }
+            }
+            const unsigned_type first_key = Encoder::encode(key(in_buffer ? *buffer : *first));
+            for (unsigned p = 0; p < passes; ++p) {
+                size_t *offsets = hist + p * radix;
+                const unsigned shift = p * digit_bits;
+                // 所有元素在这一位上相同，分配后顺序不变
+                if (offsets[static_cast<size_t>(first_key >> shift) & mask] == n) {
+                    continue;
+                }
+                size_t sum = 0;
+                for (size_t d = 0; d < radix; ++d) {
+                    const size_t count = offsets[d];
+                    offsets[d] = sum;
+                    sum += count;
+                }
+                if (in_buffer) {
+                    scatter(buffer, buffer + n, first, offsets, shift, mask, key, Encoder());
+                } else {
+                    scatter(first, first + n, buffer, offsets, shift, mask, key, Encoder());
+                }
+                in_buffer = !in_buffer;
+            }
+            if (in_buffer) {
+                tinySTL::move(buffer, buffer + n, first);
+            }
+        }
+
+        /*
+         * 按第 pass 个数位(从低到高编号)做一趟稳定的 MSD 分配，然后对每个桶处理更低的数位
+         * 桶仍然较大时继续按下一个数位分配，桶能放入缓存时改用 lsd_passes 完成其余各趟
+         */
+        template<typename RandomIter, typename T, typename KeyOf, typename Encoder>
+        void msd_split(RandomIter first, T *buffer, size_t n, KeyOf &key, Encoder, unsigned pass,
+                       unsigned digit_bits, bool in_buffer, size_t *hist) {
+            typedef typename Encoder::unsigned_type unsigned_type;
+            while (n >= kHybridSize && pass > 0) {
+                const unsigned shift = pass * digit_bits;
+                const unsigned bits = sizeof(unsigned_type) * 8 - shift < digit_bits
+                                      ? static_cast<unsigned>(sizeof(unsigned_type) * 8 - shift) : digit_bits;
+                const size_t radix = static_cast<size_t>(1) << bits;
+                tinySTL::vector<size_t> offsets(radix, 0);
+                for (size_t i = 0; i < n; ++i) {
+                    const unsigned_type u = Encoder::encode(key(in_buffer ? buffer[i] : *(first + i)));
+                    ++offsets[static_cast<size_t>(u >> shift) & (radix - 1)];
+                }
+                // 所有元素在这一位上相同，直接处理下一位
+                const unsigned_type first_key = Encoder::encode(key(in_buffer ? *buffer : *first));
+                if (offsets[static_cast<size_t>(first_key >> shift) & (radix - 1)] == n) {
+                    --pass;
+                    continue;
+                }
+                size_t sum = 0;
+                for (size_t d = 0; d < radix; ++d) {
+                    const size_t count = offsets[d];
+                    offsets[d] = sum;
+                    sum += count;
+                }
+                if (in_buffer) {
+                    scatter(buffer, buffer + n, first, offsets.data(), shift, radix - 1, key, Encoder());
+                } else {
+                    scatter(first, first + n, buffer, offsets.data(), shift, radix - 1, key, Encoder());
+                }
+                // 分配后 offsets[d] 为第 d 个桶的结束位置
+                size_t begin = 0;
+                for (size_t d = 0; d < radix; ++d) {
+                    const size_t end = offsets[d];
+                    if (end - begin > 1 || (end - begin == 1 && !in_buffer)) {
+                        msd_split(first + begin, buffer + begin, end - begin, key, Encoder(), pass - 1,
+                                  digit_bits, !in_buffer, hist);
+                    }
+                    begin = end;
+                }
+                return;
+            }
+            lsd_passes(first, buffer, n, key, Encoder(), pass + 1, digit_bits, in_buffer, hist);
+        }
+
+        /*
+         * LSD 基数排序，元素先整体移动到缓冲区
+         * 数据较多时先按高位做 MSD 分配(msd_split)，把数据切分为能放入缓存的桶，再在每个桶内按剩余数位做 LSD
+         * 这样只有少数几趟需要完整地读写内存，其余各趟都在缓存中完成，每一趟分配都是稳定的，因此结果仍然稳定
+         */
+        template<typename RandomIter, typename KeyOf, typename Key>
+        void lsd_sort(RandomIter first, RandomIter last, KeyOf key, Key *) {
+            typedef typename iterator_traits<RandomIter>::value_type value_type;
+            typedef typename std::remove_cv<Key>::type key_type;
+            typedef key_encoder<key_type> encoder;
+            typedef typename encoder::unsigned_type unsigned_type;
+            const size_t n = static_cast<size_t>(last - first);
+            if (n < kLsdSmallSize) {
+                pdqsort_detail::insertion_sort(first, last, encoded_less<KeyOf, encoder>{key});
+                return;
+            }
+            const unsigned key_bits = sizeof(unsigned_type) * 8;
+            const unsigned digit_bits = sizeof(unsigned_type) <= 2 ? 8 : 11;
+            const unsigned passes = (key_bits + digit_bits - 1) / digit_bits;
+            const size_t radix = static_cast<size_t>(1) << digit_bits;
+            tinySTL::vector<size_t> hist(passes * radix, 0);
+
+            value_type *buffer = allocator<value_type>::allocate(n);
+            tinySTL::uninitialized_move(first, last, buffer);
+            msd_split(first, buffer, n, key, encoder(), passes - 1, digit_bits, true, hist.data());
+            allocator<value_type>::destroy(buffer, buffer + n);
+            allocator<value_type>::deallocate(buffer, n);
+        }
+
+        // =======================================================================================
+        /*
+         * 按 key 比较元素，MSD 排序中的小桶与宽字符使用
+         */
+        template<typename KeyOf>
+        struct key_less {
+            KeyOf key;
+
+            template<typename T>
+            bool operator()(const T &lhs, const T &rhs) const {
+                return key(lhs) < key(rhs);
+            }
+        };
+
+        /*
+         * 第 depth 个字符所在的桶，长度不超过 depth 的字符串放在 0 号桶
+         */
+        template<typename String>
+        size_t msd_bucket(const String &s, size_t depth) {
+            return s.size() > depth ? 1 + static_cast<size_t>(static_cast<unsigned char>(s[depth])) : 0;
+        }
+
+        /*
+         * American flag sort：统计各桶大小后，在原区间内把每个元素交换到所属桶中
+         */
+        template<typename RandomIter, typename KeyOf>
+        void msd_sort(RandomIter first, RandomIter last, KeyOf &key, size_t depth, size_t levels) {
+            const size_t kBuckets = 257;
+            while (true) {
+                const size_t n = static_cast<size_t>(last - first);
+                if (n < kMsdSmallSize || levels > kMsdMaxLevels) {
+                    tinySTL::sort(first, last, key_less<KeyOf>{key});
+                    return;
+                }
+                size_t count[kBuckets] = {0};
+                for (RandomIter it = first; it != last; ++it) {
+                    ++count[msd_bucket(key(*it), depth)];
+                }
+                // 所有字符串在这一位上相同，直接比较下一位
+                const size_t b0 = msd_bucket(key(*first), depth);
+                if (count[b0] == n) {
+                    if (b0 == 0) {
+                        return;
+                    }
+                    ++depth;
+                    continue;
+                }
+                size_t head[kBuckets], tail[kBuckets];
+                size_t sum = 0;
+                for (size_t b = 0; b < kBuckets; ++b) {
+                    head[b] = sum;
+                    sum += count[b];
+                    tail[b] = sum;
+                }
+                for (size_t b = 0; b < kBuckets; ++b) {
+                    while (head[b] < tail[b]) {
+                        const size_t c = msd_bucket(key(*(first + head[b])), depth);
+                        if (c == b) {
+                            ++head[b];
+                        } else {
+                            tinySTL::iter_swap(first + head[b], first + head[c]);
+                            ++head[c];
+                        }
+                    }
+                }
+                // 0 号桶中的字符串已经全部相等
+                for (size_t b = 1; b < kBuckets; ++b) {
+                    if (count[b] > 1) {
+                        msd_sort(first + (tail[b] - count[b]), first + tail[b], key, depth + 1, levels + 1);
+                    }
+                }
+                return;
+            }
+        }
+
+        template<typename RandomIter, typename KeyOf>
+        void string_sort_dispatch(RandomIter first, RandomIter last, KeyOf key, m_true_type) {
+            radix_detail::msd_sort(first, last, key, 0, 0);
+        }
+
+        template<typename RandomIter, typename KeyOf>
+        void string_sort_dispatch(RandomIter first, RandomIter last, KeyOf key, m_false_type) {
+            tinySTL::sort(first, last, key_less<KeyOf>{key});
+        }
+
+        template<typename RandomIter, typename KeyOf, typename Key>
+        void radix_sort_dispatch(RandomIter first, RandomIter last, KeyOf key, Key *, m_true_type) {
+            radix_detail::lsd_sort(first, last, key, static_cast<Key *>(nullptr));
+        }
+
+        template<typename RandomIter, typename KeyOf, typename Key>
+        void radix_sort_dispatch(RandomIter first, RandomIter last, KeyOf key, Key *, m_false_type) {
+            typedef typename std::decay<decltype(std::declval<const Key &>()[0])>::type char_type;
+            string_sort_dispatch(first, last, key, m_bool_constant<sizeof(char_type) == 1>());
+        }
+
+    }  // namespace radix_detail
+
+    // ===========================================================================================
+    /*
+     * radix_sort 函数
+     * 以 key(*it) 为关键字对 [first, last) 排序，key 的返回值可以是算术类型或字符串
+     */
+    template<typename RandomIter, typename KeyOf>
+    void radix_sort(RandomIter first, RandomIter last, KeyOf key) {
+        typedef typename std::decay<decltype(key(*first))>::type key_type;
+        static_assert(!std::is_same<key_type, bool>::value && !std::is_same<key_type, long double>::value,
+                      "radix_sort does not support bool or long double keys");
+        if (last - first < 2) {
+            return;
+        }
+        radix_detail::radix_sort_dispatch(first, last, key, static_cast<key_type *>(nullptr),
+                                          m_bool_constant<std::is_arithmetic<key_type>::value>());
+    }
+
+    /*
+     * radix_sort 重载函数
+     * 以元素本身为关键字
+     */
+    template<typename RandomIter>
+    void radix_sort(RandomIter first, RandomIter last) {
+        typedef typename iterator_traits<RandomIter>::value_type value_type;
+        tinySTL::radix_sort(first, last, tinySTL::identity<value_type>());
+    }
+
+}  // namespace tinySTL
+
+#endif //TINYSTL_RADIX_SORT_H
@@ -3,21 +3,259 @@
 //
 
 /*
- * 这个头文件包含 set 的四种算法: union, intersection, difference, symmetric_difference
+ * 这个头文件包含 set 的四种算法: union, intersection, difference, symmetric_difference，
+ * 以及只计算交集元素个数的 set_intersection_size
  * 所有函数都要求序列有序
  */
 
 #ifndef TINYSTL_SET_ALGO_H
 #define TINYSTL_SET_ALGO_H
 
+#include <functional>  /* std::less，用于判断能否使用 SIMD 求交集 */
+
 #include "algobase.h"  /* 这个头文件包含了库中的一些基本算法 */
 #include "iterator.h"  /* 这个头文件用于迭代器设计，包含了一些模板结构体与全局函数 */
+#include "functional.h"  /* 这个头文件包含了 tinySTL 的函数对象与哈希函数 */
+#include "simd_algo.h"  /* 这个头文件包含算术类型连续区间上的 SIMD 内核 */
 
 /* 首先定义自己的命名空间 */
 namespace tinySTL {
 
     // =========================================================================================
 
+    /*
+     * 四种算法共用同一个归并过程，只是对三类元素的处理不同:
+     * 只在 S1 中的元素、只在 S2 中的元素、两者共有的元素(输出 S1 中的那一个)，Copy1、Copy2、CopyEqual 决定是否输出。
+     * 两个序列都是随机访问迭代器并且长度相差 kGallopRatio 倍以上时，改为指数查找(galloping)：
+     * 一次跳过另一方的头部元素之前的整段元素，比较次数从 O(n + m) 降为 O(m log(n / m))
+     */
+    namespace set_algo_detail {
+
+        const size_t kGallopRatio = 16;
+
+        /*
+         * 异构的 < 比较，用于不带 comp 的版本，两个序列的元素类型可以不同
+         */
+        struct less_than {
+            template<typename T1, typename T2>
+            bool operator()(const T1 &lhs, const T2 &rhs) const {
+                return lhs < rhs;
+            }
+        };
+
+        /*
+         * 只计数的输出迭代器，用于 set_intersection_size
+         */
+        struct count_output {
+            size_t count;
+
+            count_output &operator*() {
+                return *this;
+            }
+
+            template<typename T>
+            count_output &operator=(const T &) {
+                ++count;
+                return *this;
+            }
+
+            count_output &operator++() {
+                return *this;
+            }
+        };
+
+        template<typename InputIter, typename OutputIter>
+        OutputIter copy_run(InputIter first, InputIter last, OutputIter result, m_true_type) {
+            return tinySTL::copy(first, last, result);
+        }
+
+        template<typename InputIter, typename OutputIter>
+        OutputIter copy_run(InputIter, InputIter, OutputIter result, m_false_type) {
+            return result;
+        }
+
+        /*
+         * 已知 comp(*first, value) 为真，依次检查 first[1]、first[3]、first[7]...，越过 value 后在最后一段中二分查找，
+         * 返回第一个不小于 value 的位置。跳过的元素个数为 k 时只需 O(log k) 次比较
+         */
+        template<typename RandomIter, typename T, typename Compared>
+        RandomIter gallop_lower(RandomIter first, RandomIter last, const T &value, Compared comp) {
+            typedef typename iterator_traits<RandomIter>::difference_type diff;
+            const diff len = last - first;
+            diff lo = 0;
+            diff hi = 1;
+            while (hi < len && comp(first[hi], value)) {
+                lo = hi;
+                hi = 2 * hi + 1;
+            }
+            if (hi > len) {
+                hi = len;
+            }
+            /* first[lo] 小于 value，答案在 (lo, hi] 中 */
+            ++lo;
+            while (lo < hi) {
+                const diff mid = lo + (hi - lo) / 2;
+                if (comp(first[mid], value)) {
+                    lo = mid + 1;
+                } else {
+                    hi = mid;
+                }
+            }
+            return first + lo;
+        }
+
+        template<bool Copy1, bool Copy2, bool CopyEqual, typename InputIter1, typename InputIter2,
+                typename OutputIter, typename Compared>
+        OutputIter linear_merge(InputIter1 first1, InputIter1 last1, InputIter2 first2, InputIter2 last2,
+                                OutputIter result, Compared comp) {
+            while (first1 != last1 && first2 != last2) {
+                if (comp(*first1, *first2)) {
+                    if (Copy1) {
+                        *result = *first1;
+                        ++result;
+                    }
+                    ++first1;
+                } else if (comp(*first2, *first1)) {
+                    if (Copy2) {
+                        *result = *first2;
+                        ++result;
+                    }
+                    ++first2;
+                } else {
+                    if (CopyEqual) {
+                        *result = *first1;
+                        ++result;
+                    }
+                    ++first1, ++first2;
+                }
+            }
+            /* 将剩余元素拷贝到 result */
+            result = copy_run(first1, last1, result, m_bool_constant<Copy1>());
+            return copy_run(first2, last2, result, m_bool_constant<Copy2>());
+        }
+
+        template<bool Copy1, bool Copy2, bool CopyEqual, typename RandomIter1, typename RandomIter2,
+                typename OutputIter, typename Compared>
+        OutputIter gallop_merge(RandomIter1 first1, RandomIter1 last1, RandomIter2 first2, RandomIter2 last2,
+                                OutputIter result, Compared comp) {
+            while (first1 != last1 && first2 != last2) {
+                if (comp(*first1, *first2)) {
+                    RandomIter1 mid = gallop_lower(first1, last1, *first2, comp);
+                    result = copy_run(first1, mid, result, m_bool_constant<Copy1>());
+                    first1 = mid;
+                } else if (comp(*first2, *first1)) {
+                    RandomIter2 mid = gallop_lower(first2, last2, *first1, comp);
+                    result = copy_run(first2, mid, result, m_bool_constant<Copy2>());
+                    first2 = mid;
+                } else {
+                    if (CopyEqual) {
+                        *result = *first1;
+                        ++result;
+                    }
+                    ++first1, ++first2;
+                }
+            }
+            result = copy_run(first1, last1, result, m_bool_constant<Copy1>());
+            return copy_run(first2, last2, result, m_bool_constant<Copy2>());
+        }
+
+        template<typename RandomIter1, typename RandomIter2>
+        bool is_skewed(RandomIter1 first1, RandomIter1 last1, RandomIter2 first2, RandomIter2 last2) {
+            const size_t n = static_cast<size_t>(last1 - first1);
+            const size_t m = static_cast<size_t>(last2 - first2);
+            return n / kGallopRatio > m || m / kGallopRatio > n;
+        }
+
+        template<bool Copy1, bool Copy2, bool CopyEqual, typename InputIter1, typename InputIter2,
+                typename OutputIter, typename Compared, typename Tag1, typename Tag2>
+        OutputIter set_merge(InputIter1 first1, InputIter1 last1, InputIter2 first2, InputIter2 last2,
+                             OutputIter result, Compared comp, Tag1, Tag2) {
+            return linear_merge<Copy1, Copy2, CopyEqual>(first1, last1, first2, last2, result, comp);
+        }
+
+        template<bool Copy1, bool Copy2, bool CopyEqual, typename RandomIter1, typename RandomIter2,
+                typename OutputIter, typename Compared>
+        OutputIter set_merge(RandomIter1 first1, RandomIter1 last1, RandomIter2 first2, RandomIter2 last2,
+                             OutputIter result, Compared comp, random_access_iterator_tag, random_access_iterator_tag) {
+            if (is_skewed(first1, last1, first2, last2)) {
+                return gallop_merge<Copy1, Copy2, CopyEqual>(first1, last1, first2, last2, result, comp);
+            }
+            return linear_merge<Copy1, Copy2, CopyEqual>(first1, last1, first2, last2, result, comp);
+        }
+
+        template<bool Copy1, bool Copy2, bool CopyEqual, typename InputIter1, typename InputIter2,
+                typename OutputIter, typename Compared>
+        OutputIter set_merge(InputIter1 first1, InputIter1 last1, InputIter2 first2, InputIter2 last2,
+                             OutputIter result, Compared comp) {
+            return set_merge<Copy1, Copy2, CopyEqual>(first1, last1, first2, last2, result, comp,
+                                                      iterator_category(first1), iterator_category(first2));
+        }
+
+        /*
+         * 两个序列都是同类型的 4 字节或 8 字节整数的连续区间，并且按 < 排序时，长度相近的交集使用 SIMD 内核
+         */
+        template<typename T, bool = std::is_integral<T>::value>
+        struct is_intersect_lane : public m_false_type {
+        };
+
+        template<typename T>
+        struct is_intersect_lane<T, true> : public m_bool_constant<sizeof(T) == 4 || sizeof(T) == 8> {
+        };
+
+        template<typename Iter1, typename Iter2, typename Compared,
+                typename T = typename simd::contiguous_value<Iter1>::type>
+        struct use_simd_intersect : public m_bool_constant<
+                is_intersect_lane<T>::value && simd::is_simd_range<Iter2, T>::value
+                && (std::is_same<Compared, less_than>::value || std::is_same<Compared, tinySTL::less<T>>::value
+                    || std::is_same<Compared, std::less<T>>::value)> {
+        };
+
+        template<typename InputIter1, typename InputIter2, typename OutputIter, typename Compared>
+        OutputIter intersection_dispatch(InputIter1 first1, InputIter1 last1, InputIter2 first2, InputIter2 last2,
+                                         OutputIter result, Compared comp, m_false_type) {
+            return set_merge<false, false, true>(first1, last1, first2, last2, result, comp);
+        }
+
+        template<typename Ptr1, typename Ptr2, typename T, typename Compared>
+        T *intersection_dispatch(Ptr1 first1, Ptr1 last1, Ptr2 first2, Ptr2 last2, T *result, Compared comp,
+                                 m_true_type) {
+            if (is_skewed(first1, last1, first2, last2)) {
+                return gallop_merge<false, false, true>(first1, last1, first2, last2, result, comp);
+            }
+            return result + simd::intersect(first1, static_cast<size_t>(last1 - first1),
+                                            first2, static_cast<size_t>(last2 - first2), result);
+        }
+
+        template<typename InputIter1, typename InputIter2, typename OutputIter, typename Compared>
+        OutputIter intersection(InputIter1 first1, InputIter1 last1, InputIter2 first2, InputIter2 last2,
+                                OutputIter result, Compared comp) {
+            return intersection_dispatch(
+                    first1, last1, first2, last2, result, comp,
+                    m_bool_constant<use_simd_intersect<InputIter1, InputIter2, Compared>::value
+                                    && simd::is_simd_range<OutputIter,
+                                            typename simd::contiguous_value<InputIter1>::type>::value>());
+        }
+
+        template<typename InputIter1, typename InputIter2, typename Compared>
+        size_t intersection_size_dispatch(InputIter1 first1, InputIter1 last1, InputIter2 first2, InputIter2 last2,
+                                          Compared comp, m_false_type) {
+            return set_merge<false, false, true>(first1, last1, first2, last2, count_output{0}, comp).count;
+        }
+
+        template<typename Ptr1, typename Ptr2, typename Compared>
+        size_t intersection_size_dispatch(Ptr1 first1, Ptr1 last1, Ptr2 first2, Ptr2 last2, Compared comp,
+                                          m_true_type) {
+            if (is_skewed(first1, last1, first2, last2)) {
+                return gallop_merge<false, false, true>(first1, last1, first2, last2, count_output{0}, comp).count;
+            }
+            return simd::intersect_count(first1, static_cast<size_t>(last1 - first1),
+                                         first2, static_cast<size_t>(last2 - first2));
+        }
+
+    }  // namespace set_algo_detail
+
+    // =========================================================================================
+
     /*
      * set_union 函数
      * 计算 S1 ∪ S2 的结果并保存到 result 中，返回一个迭代器指向输出结果的尾部
@@ -26,21 +264,8 @@ namespace tinySTL {
     OutputIter set_union(InputIter1 first1, InputIter1 last1,
                          InputIter2 first2, InputIter2 last2,
                          OutputIter result) {
-        while (first1 != last1 && first2 != last2) {
-            if (*first1 < *first2) {
-                *result = *first1;
-                ++first1;
-            } else if (*first2 < *first1) {
-                *result = *first2;
-                ++first2;
-            } else {
-                *result = *first1;
-                ++first1, ++first2;
-            }
-            ++result;
-        }
-        /* 将剩余元素拷贝到 result */
-        return tinySTL::copy(first2, last2, tinySTL::copy(first1, last1, result));
+        return set_algo_detail::set_merge<true, true, true>(first1, last1, first2, last2, result,
+                                                            set_algo_detail::less_than());
     }
 
     /*
@@ -51,21 +276,7 @@ namespace tinySTL {
     OutputIter set_union(InputIter1 first1, InputIter1 last1,
                          InputIter2 first2, InputIter2 last2,
                          OutputIter result, Compared comp) {
-        while (first1 != last1 && first2 != last2) {
-            if (comp(*first1, *first2)) {
-                *result = *first1;
-                ++first1;
-            } else if (comp(*first2, *first1)) {
-                *result = *first2;
-                ++first2;
-            } else {
-                *result = *first1;
-                ++first1, ++first2;
-            }
-            ++result;
-        }
-        /* 将剩余元素拷贝到 result */
-        return tinySTL::copy(first2, last2, tinySTL::copy(first1, last1, result));
+        return set_algo_detail::set_merge<true, true, true>(first1, last1, first2, last2, result, comp);
     }
 
     // ============================================================================================
@@ -78,40 +289,43 @@ namespace tinySTL {
     OutputIter set_intersection(InputIter1 first1, InputIter1 last1,
                                 InputIter2 first2, InputIter2 last2,
                                 OutputIter result) {
-        while (first1 != last1 && first2 != last2) {
-            if (*first1 < *first2) {
-                ++first1;
-            } else if (*first2 < *first1) {
-                ++first2;
-            } else {
-                *result = *first1;
-                ++first1, ++first2;
-                ++result;
-            }
-        }
-        return result;
+        return set_algo_detail::intersection(first1, last1, first2, last2, result, set_algo_detail::less_than());
     }
 
     /*
      * set_intersection 函数
      * 计算 S1 ∩ S2 的结果并保存到 result 中，返回一个迭代器指向输出结果的尾部
+     * 输出也是同类型的连续区间时可以使用 SIMD 内核
      */
     template<typename InputIter1, typename InputIter2, typename OutputIter, typename Compared>
     OutputIter set_intersection(InputIter1 first1, InputIter1 last1,
                                 InputIter2 first2, InputIter2 last2,
                                 OutputIter result, Compared comp) {
-        while (first1 != last1 && first2 != last2) {
-            if (comp(*first1, *first2)) {
-                ++first1;
-            } else if (comp(*first2, *first1)) {
-                ++first2;
-            } else {
-                *result = *first1;
-                ++first1, ++first2;
-                ++result;
-            }
-        }
-        return result;
+        return set_algo_detail::intersection(first1, last1, first2, last2, result, comp);
+    }
+
+    /*
+     * set_intersection_size 函数
+     * 返回 S1 ∩ S2 的元素个数，不输出结果
+     */
+    template<typename InputIter1, typename InputIter2>
+    size_t set_intersection_size(InputIter1 first1, InputIter1 last1,
+                                 InputIter2 first2, InputIter2 last2) {
+        return set_algo_detail::intersection_size_dispatch(
+                first1, last1, first2, last2, set_algo_detail::less_than(),
+                set_algo_detail::use_simd_intersect<InputIter1, InputIter2, set_algo_detail::less_than>());
+    }
+
+    /*
+     * set_intersection_size 函数重载
+     * 重载版本使用函数对象 comp 代替比较操作
+     */
+    template<typename InputIter1, typename InputIter2, typename Compared>
+    size_t set_intersection_size(InputIter1 first1, InputIter1 last1,
+                                 InputIter2 first2, InputIter2 last2, Compared comp) {
+        return set_algo_detail::intersection_size_dispatch(
+                first1, last1, first2, last2, comp,
+                set_algo_detail::use_simd_intersect<InputIter1, InputIter2, Compared>());
     }
 
     // ===========================================================================================
@@ -124,18 +338,8 @@ namespace tinySTL {
     OutputIter set_difference(InputIter1 first1, InputIter1 last1,
                               InputIter2 first2, InputIter2 last2,
                               OutputIter result) {
-        while (first1 != last1 && first2 != last2) {
-            if (*first1 < *first2) {
-                *result = *first1;
-                ++first1;
-                ++result;
-            } else if (*first2 < *first1) {
-                ++first2;
-            } else {
-                ++first1, ++first2;
-            }
-        }
-        return tinySTL::copy(first1, last1, result);
+        return set_algo_detail::set_merge<true, false, false>(first1, last1, first2, last2, result,
+                                                              set_algo_detail::less_than());
     }
 
     /*
@@ -146,18 +350,7 @@ namespace tinySTL {
     OutputIter set_difference(InputIter1 first1, InputIter1 last1,
                               InputIter2 first2, InputIter2 last2,
                               OutputIter result, Compared comp) {
-        while (first1 != last1 && first2 != last2) {
-            if (comp(*first1, *first2)) {
-                *result = *first1;
-                ++first1;
-                ++result;
-            } else if (comp(*first2, *first1)) {
-                ++first2;
-            } else {
-                ++first1, ++first2;
-            }
-        }
-        return tinySTL::copy(first1, last1, result);
+        return set_algo_detail::set_merge<true, false, false>(first1, last1, first2, last2, result, comp);
     }
 
     // =======================================================================================
@@ -170,20 +363,8 @@ namespace tinySTL {
     OutputIter set_symmetric_difference(InputIter1 first1, InputIter1 last1,
                                         InputIter2 first2, InputIter2 last2,
                                         OutputIter result) {
-        while (first1 != last1 && first2 != last2) {
-            if (*first1 < *first2) {
-                *result = *first1;
-                ++first1;
-                ++result;
-            } else if (*first2 < *first1) {
-                *result = *first2;
-                ++first2;
-                ++result;
-            } else {
-                ++first1, ++first2;
-            }
-        }
-        return tinySTL::copy(first2, last2, tinySTL::copy(first1, last1, result));
+        return set_algo_detail::set_merge<true, true, false>(first1, last1, first2, last2, result,
+                                                             set_algo_detail::less_than());
     }
 
     /*
@@ -194,20 +375,7 @@ namespace tinySTL {
     OutputIter set_symmetric_difference(InputIter1 first1, InputIter1 last1,
                                         InputIter2 first2, InputIter2 last2,
                                         OutputIter result, Compared comp) {
-        while (first1 != last1 && first2 != last2) {
-            if (comp(*first1, *first2)) {
-                *result = *first1;
-                ++first1;
-                ++result;
-            } else if (comp(*first2, *first1)) {
-                *result = *first2;
-                ++first2;
-                ++result;
-            } else {
-                ++first1, ++first2;
-            }
-        }
-        return tinySTL::copy(first2, last2, tinySTL::copy(first1, last1, result));
+        return set_algo_detail::set_merge<true, true, false>(first1, last1, first2, last2, result, comp);
     }
 
 }  // namespace tinySTL
@@ -0,0 +1,452 @@
+//
+// Created by cqupt1811 on 2022/5/15.
+//
+
+/*
+ * 这个头文件包含字符序列相关的 SIMD 内核，以及运行时的 CPU 特性检测
+ * 内核按照字符的宽度(1/2/4 字节)选择对应的指令，提供以下函数:
+ * length()   求以 0 结尾的字符序列的长度
+ * find()     在前 n 个字符中查找某个字符
+ * mismatch() 求两个字符序列第一个不相同字符的下标
+ * fill()     使用某个字符填充一段空间
+ * 在 x86 平台上以 SSE2 作为基线，运行时检测到 AVX2 时使用 AVX2 版本，其他平台使用普通的循环
+ */
+
+#ifndef TINYSTL_SIMD_H
+#define TINYSTL_SIMD_H
+
+#include <cstddef>  /* 定义了 size_t 等常用类型 */
+#include <cstdint>  /* 定义了定宽整数类型与 uintptr_t */
+
+/*
+ * TINYSTL_SIMD_X86 为 1 时表示可以使用 x86 的向量指令
+ * 需要 GCC/Clang 的 target 属性来单独为某个函数开启 AVX2
+ */
+#if (defined(__x86_64__) || defined(__i386__)) && defined(__SSE2__) && defined(__GNUC__)
+#define TINYSTL_SIMD_X86 1
+#include <immintrin.h>  /* x86 的向量指令 */
+#else
+#define TINYSTL_SIMD_X86 0
+#endif
+
+/*
+ * length() 按对齐的块读取，可能读到字符串起始位置之前的字节(不会跨页)，需要关闭地址检查
+ */
+#if defined(__clang__) || defined(__GNUC__)
+#define TINYSTL_NO_SANITIZE_ADDRESS __attribute__((no_sanitize_address))
+#else
+#define TINYSTL_NO_SANITIZE_ADDRESS
+#endif
+
+namespace tinySTL {
+    namespace simd {
+
+        // ===========================================================================================
+        /*
+         * 普通循环版本，用于非 x86 平台以及向量内核处理剩余的尾部
+         */
+        template<typename T>
+        inline size_t scalar_length(const T *s) noexcept {
+            const T *p = s;
+            for (; *p != T(0); ++p) {}
+            return static_cast<size_t>(p - s);
+        }
+
+        template<typename T>
+        inline const T *scalar_find(const T *s, size_t n, T ch) noexcept {
+            for (; n != 0; --n, ++s) {
+                if (*s == ch) {
+                    return s;
+                }
+            }
+            return nullptr;
+        }
+
+        template<typename T>
+        inline size_t scalar_mismatch(const T *s1, const T *s2, size_t n) noexcept {
+            size_t i = 0;
+            for (; i != n && s1[i] == s2[i]; ++i) {}
+            return i;
+        }
+
+        template<typename T>
+        inline T *scalar_fill(T *dst, T ch, size_t n) noexcept {
+            T *r = dst;
+            for (; n != 0; --n, ++dst) {
+                *dst = ch;
+            }
+            return r;
+        }
+
+#if TINYSTL_SIMD_X86
+
+        // ===========================================================================================
+        /*
+         * CPU 特性检测，结果只计算一次
+         */
+        inline bool cpu_has_avx2() noexcept {
+            static const bool has = [] {
+                __builtin_cpu_init();
+                return __builtin_cpu_supports("avx2") != 0;
+            }();
+            return has;
+        }
+
+        /*
+         * 8/16 位整数与 64 位整数的运算需要 BW、DQ 扩展，256 位以下的掩码运算需要 VL 扩展
+         */
+        inline bool cpu_has_avx512() noexcept {
+            static const bool has = [] {
+                __builtin_cpu_init();
+                return __builtin_cpu_supports("avx512f") && __builtin_cpu_supports("avx512bw")
+                       && __builtin_cpu_supports("avx512dq") && __builtin_cpu_supports("avx512vl");
+            }();
+            return has;
+        }
+
+        /*
+         * movemask 得到的是按字节的掩码，每个字符占 sizeof(T) 位，
+         * 最低位的下标除以 sizeof(T) 即为字符下标
+         */
+        inline unsigned lowest_bit(unsigned mask) noexcept {
+            return static_cast<unsigned>(__builtin_ctz(mask));
+        }
+
+        /*
+         * 按字符宽度选择比较与广播指令
+         */
+        template<size_t Size>
+        struct sse2_ops;
+
+        template<>
+        struct sse2_ops<1> {
+            static __m128i set1(uint32_t c) noexcept { return _mm_set1_epi8(static_cast<char>(c)); }
+
+            static __m128i cmpeq(__m128i a, __m128i b) noexcept { return _mm_cmpeq_epi8(a, b); }
+        };
+
+        template<>
+        struct sse2_ops<2> {
+            static __m128i set1(uint32_t c) noexcept { return _mm_set1_epi16(static_cast<short>(c)); }
+
+            static __m128i cmpeq(__m128i a, __m128i b) noexcept { return _mm_cmpeq_epi16(a, b); }
+        };
+
+        template<>
+        struct sse2_ops<4> {
+            static __m128i set1(uint32_t c) noexcept { return _mm_set1_epi32(static_cast<int>(c)); }
+
+            static __m128i cmpeq(__m128i a, __m128i b) noexcept { return _mm_cmpeq_epi32(a, b); }
+        };
+
+        template<size_t Size>
+        struct avx2_ops;
+
+        template<>
+        struct avx2_ops<1> {
+            __attribute__((target("avx2")))
+            static __m256i set1(uint32_t c) noexcept { return _mm256_set1_epi8(static_cast<char>(c)); }
+
+            __attribute__((target("avx2")))
+            static __m256i cmpeq(__m256i a, __m256i b) noexcept { return _mm256_cmpeq_epi8(a, b); }
+        };
+
+        template<>
+        struct avx2_ops<2> {
+            __attribute__((target("avx2")))
+            static __m256i set1(uint32_t c) noexcept { return _mm256_set1_epi16(static_cast<short>(c)); }
+
+            __attribute__((target("avx2")))
+            static __m256i cmpeq(__m256i a, __m256i b) noexcept { return _mm256_cmpeq_epi16(a, b); }
+        };
+
+        template<>
+        struct avx2_ops<4> {
+            __attribute__((target("avx2")))
+            static __m256i set1(uint32_t c) noexcept { return _mm256_set1_epi32(static_cast<int>(c)); }
+
+            __attribute__((target("avx2")))
+            static __m256i cmpeq(__m256i a, __m256i b) noexcept { return _mm256_cmpeq_epi32(a, b); }
+        };
+
+        /*
+         * 把字符转换为同宽度的无符号整数，用于广播
+         */
+        template<typename T>
+        inline uint32_t to_lane(T ch) noexcept {
+            return static_cast<uint32_t>(ch) & (sizeof(T) == 4 ? 0xFFFFFFFFu : ((1u << (sizeof(T) * 8)) - 1));
+        }
+
+        // ===========================================================================================
+        /*
+         * length: 从对齐的地址开始读取整块，对齐的读取不会跨越页边界，屏蔽掉起始位置之前的字节
+         */
+        template<typename T>
+        TINYSTL_NO_SANITIZE_ADDRESS
+        inline size_t sse2_length(const T *s) noexcept {
+            typedef sse2_ops<sizeof(T)> ops;
+            const uintptr_t addr = reinterpret_cast<uintptr_t>(s);
+            const uintptr_t offset = addr & 15;
+            const char *p = reinterpret_cast<const char *>(addr - offset);
+            const __m128i zero = _mm_setzero_si128();
+            unsigned mask = static_cast<unsigned>(_mm_movemask_epi8(
+                    ops::cmpeq(_mm_load_si128(reinterpret_cast<const __m128i *>(p)), zero))) >> offset;
+            if (mask != 0) {
+                return lowest_bit(mask) / sizeof(T);
+            }
+            for (;;) {
+                p += 16;
+                mask = static_cast<unsigned>(_mm_movemask_epi8(
+                        ops::cmpeq(_mm_load_si128(reinterpret_cast<const __m128i *>(p)), zero)));
+                if (mask != 0) {
+                    return (static_cast<size_t>(p - reinterpret_cast<const char *>(s)) + lowest_bit(mask)) / sizeof(T);
+                }
+            }
+        }
+
+        template<typename T>
+        __attribute__((target("avx2"))) TINYSTL_NO_SANITIZE_ADDRESS
+        inline size_t avx2_length(const T *s) noexcept {
+            typedef avx2_ops<sizeof(T)> ops;
+            const uintptr_t addr = reinterpret_cast<uintptr_t>(s);
+            const uintptr_t offset = addr & 31;
+            const char *p = reinterpret_cast<const char *>(addr - offset);
+            const __m256i zero = _mm256_setzero_si256();
+            unsigned mask = static_cast<unsigned>(_mm256_movemask_epi8(
+                    ops::cmpeq(_mm256_load_si256(reinterpret_cast<const __m256i *>(p)), zero))) >> offset;
+            if (mask != 0) {
+                return lowest_bit(mask) / sizeof(T);
+            }
+            p += 32;
+            /* 先对齐到 64 字节，之后每次处理两个向量 */
+            if ((reinterpret_cast<uintptr_t>(p) & 63) != 0) {
+                mask = static_cast<unsigned>(_mm256_movemask_epi8(
+                        ops::cmpeq(_mm256_load_si256(reinterpret_cast<const __m256i *>(p)), zero)));
+                if (mask != 0) {
+                    return (static_cast<size_t>(p - reinterpret_cast<const char *>(s)) + lowest_bit(mask)) / sizeof(T);
+                }
+                p += 32;
+            }
+            for (;; p += 64) {
+                const __m256i a = ops::cmpeq(_mm256_load_si256(reinterpret_cast<const __m256i *>(p)), zero);
+                const __m256i b = ops::cmpeq(_mm256_load_si256(reinterpret_cast<const __m256i *>(p + 32)), zero);
+                if (_mm256_movemask_epi8(_mm256_or_si256(a, b)) != 0) {
+                    mask = static_cast<unsigned>(_mm256_movemask_epi8(a));
+                    size_t base = static_cast<size_t>(p - reinterpret_cast<const char *>(s));
+                    if (mask == 0) {
+                        mask = static_cast<unsigned>(_mm256_movemask_epi8(b));
+                        base += 32;
+                    }
+                    return (base + lowest_bit(mask)) / sizeof(T);
+                }
+            }
+        }
+
+        // ===========================================================================================
+        /*
+         * find: 每次处理两个向量，只有在命中时才计算具体位置，不足一个向量的尾部使用普通循环
+         */
+        template<typename T>
+        inline const T *sse2_find(const T *s, size_t n, T ch) noexcept {
+            typedef sse2_ops<sizeof(T)> ops;
+            const size_t step = 16 / sizeof(T);
+            const __m128i target = ops::set1(to_lane(ch));
+            size_t i = 0;
+            for (; i + 2 * step <= n; i += 2 * step) {
+                const __m128i a = ops::cmpeq(_mm_loadu_si128(reinterpret_cast<const __m128i *>(s + i)), target);
+                const __m128i b = ops::cmpeq(_mm_loadu_si128(reinterpret_cast<const __m128i *>(s + i + step)), target);
+                if (_mm_movemask_epi8(_mm_or_si128(a, b)) != 0) {
+                    const unsigned ma = static_cast<unsigned>(_mm_movemask_epi8(a));
+                    if (ma != 0) {
+                        return s + i + lowest_bit(ma) / sizeof(T);
+                    }
+                    return s + i + step + lowest_bit(static_cast<unsigned>(_mm_movemask_epi8(b))) / sizeof(T);
+                }
+            }
+            if (i + step <= n) {
+                const unsigned m = static_cast<unsigned>(_mm_movemask_epi8(
+                        ops::cmpeq(_mm_loadu_si128(reinterpret_cast<const __m128i *>(s + i)), target)));
+                if (m != 0) {
+                    return s + i + lowest_bit(m) / sizeof(T);
+                }
+                i += step;
+            }
+            return scalar_find(s + i, n - i, ch);
+        }
+
+        template<typename T>
+        __attribute__((target("avx2")))
+        inline const T *avx2_find(const T *s, size_t n, T ch) noexcept {
+            typedef avx2_ops<sizeof(T)> ops;
+            const size_t step = 32 / sizeof(T);
+            const __m256i target = ops::set1(to_lane(ch));
+            size_t i = 0;
+            /* 长序列每次处理四个向量，减少分支 */
+            for (; i + 4 * step <= n; i += 4 * step) {
+                const __m256i a = ops::cmpeq(_mm256_loadu_si256(reinterpret_cast<const __m256i *>(s + i)), target);
+                const __m256i b = ops::cmpeq(_mm256_loadu_si256(reinterpret_cast<const __m256i *>(s + i + step)),
+                                             target);
+                const __m256i c = ops::cmpeq(_mm256_loadu_si256(reinterpret_cast<const __m256i *>(s + i + 2 * step)),
+                                             target);
+                const __m256i d = ops::cmpeq(_mm256_loadu_si256(reinterpret_cast<const __m256i *>(s + i + 3 * step)),
+                                             target);
+                if (_mm256_movemask_epi8(_mm256_or_si256(_mm256_or_si256(a, b), _mm256_or_si256(c, d))) != 0) {
+                    break;
+                }
+            }
+            for (; i + 2 * step <= n; i += 2 * step) {
+                const __m256i a = ops::cmpeq(_mm256_loadu_si256(reinterpret_cast<const __m256i *>(s + i)), target);
+                const __m256i b = ops::cmpeq(_mm256_loadu_si256(reinterpret_cast<const __m256i *>(s + i + step)),
+                                             target);
+                if (_mm256_movemask_epi8(_mm256_or_si256(a, b)) != 0) {
+                    const unsigned ma = static_cast<unsigned>(_mm256_movemask_epi8(a));
+                    if (ma != 0) {
+                        return s + i + lowest_bit(ma) / sizeof(T);
+                    }
+                    return s + i + step + lowest_bit(static_cast<unsigned>(_mm256_movemask_epi8(b))) / sizeof(T);
+                }
+            }
+            if (i + step <= n) {
+                const unsigned m = static_cast<unsigned>(_mm256_movemask_epi8(
+                        ops::cmpeq(_mm256_loadu_si256(reinterpret_cast<const __m256i *>(s + i)), target)));
+                if (m != 0) {
+                    return s + i + lowest_bit(m) / sizeof(T);
+                }
+                i += step;
+            }
+            return sse2_find(s + i, n - i, ch);
+        }
+
+        // ===========================================================================================
+        /*
+         * mismatch: 比较相等得到全 1 的掩码，取反后最低位即为第一个不同的字节
+         */
+        template<typename T>
+        inline size_t sse2_mismatch(const T *s1, const T *s2, size_t n) noexcept {
+            typedef sse2_ops<sizeof(T)> ops;
+            const size_t step = 16 / sizeof(T);
+            size_t i = 0;
+            for (; i + step <= n; i += step) {
+                const __m128i a = _mm_loadu_si128(reinterpret_cast<const __m128i *>(s1 + i));
+                const __m128i b = _mm_loadu_si128(reinterpret_cast<const __m128i *>(s2 + i));
+                const unsigned m = static_cast<unsigned>(_mm_movemask_epi8(ops::cmpeq(a, b))) ^ 0xFFFFu;
+                if (m != 0) {
+                    return i + lowest_bit(m) / sizeof(T);
+                }
+            }
+            return i + scalar_mismatch(s1 + i, s2 + i, n - i);
+        }
+
+        template<typename T>
+        __attribute__((target("avx2")))
+        inline size_t avx2_mismatch(const T *s1, const T *s2, size_t n) noexcept {
+            typedef avx2_ops<sizeof(T)> ops;
+            const size_t step = 32 / sizeof(T);
+            size_t i = 0;
+            for (; i + step <= n; i += step) {
+                const __m256i a = _mm256_loadu_si256(reinterpret_cast<const __m256i *>(s1 + i));
+                const __m256i b = _mm256_loadu_si256(reinterpret_cast<const __m256i *>(s2 + i));
+                const unsigned m = ~static_cast<unsigned>(_mm256_movemask_epi8(ops::cmpeq(a, b)));
+                if (m != 0) {
+                    return i + lowest_bit(m) / sizeof(T);
+                }
+            }
+            return i + sse2_mismatch(s1 + i, s2 + i, n - i);
+        }
+
+        // ===========================================================================================
+        /*
+         * fill: 广播后整块写入
+         */
+        template<typename T>
+        inline T *sse2_fill(T *dst, T ch, size_t n) noexcept {
+            typedef sse2_ops<sizeof(T)> ops;
+            const size_t step = 16 / sizeof(T);
+            const __m128i v = ops::set1(to_lane(ch));
+            size_t i = 0;
+            for (; i + step <= n; i += step) {
+                _mm_storeu_si128(reinterpret_cast<__m128i *>(dst + i), v);
+            }
+            scalar_fill(dst + i, ch, n - i);
+            return dst;
+        }
+
+        template<typename T>
+        __attribute__((target("avx2")))
+        inline T *avx2_fill(T *dst, T ch, size_t n) noexcept {
+            typedef avx2_ops<sizeof(T)> ops;
+            const size_t step = 32 / sizeof(T);
+            const __m256i v = ops::set1(to_lane(ch));
+            size_t i = 0;
+            for (; i + 2 * step <= n; i += 2 * step) {
+                _mm256_storeu_si256(reinterpret_cast<__m256i *>(dst + i), v);
+                _mm256_storeu_si256(reinterpret_cast<__m256i *>(dst + i + step), v);
+            }
+            sse2_fill(dst + i, ch, n - i);
+            return dst;
+        }
+
+#endif // TINYSTL_SIMD_X86
+
+        // ===========================================================================================
+        /*
+         * 对外的接口，按照运行时检测到的指令集分派
+         * T 必须是宽度为 1、2、4 字节的整数字符类型
+         */
+
+        /*
+         * 求以 T(0) 结尾的字符序列的长度
+         */
+        template<typename T>
+        inline size_t length(const T *s) noexcept {
+#if TINYSTL_SIMD_X86
+            /* 地址没有按字符宽度对齐时，对齐的块读取会把一个字符拆开，只能逐个比较 */
+            if (reinterpret_cast<uintptr_t>(s) % sizeof(T) != 0) {
+                return scalar_length(s);
+            }
+            return cpu_has_avx2() ? avx2_length(s) : sse2_length(s);
+#else
+            return scalar_length(s);
+#endif
+        }
+
+        /*
+         * 在 [s, s + n) 中查找字符 ch，返回第一次出现的位置，找不到时返回 nullptr
+         */
+        template<typename T>
+        inline const T *find(const T *s, size_t n, T ch) noexcept {
+#if TINYSTL_SIMD_X86
+            return cpu_has_avx2() ? avx2_find(s, n, ch) : sse2_find(s, n, ch);
+#else
+            return scalar_find(s, n, ch);
+#endif
+        }
+
+        /*
+         * 返回 [s1, s1 + n) 与 [s2, s2 + n) 第一个不相同字符的下标，完全相同时返回 n
+         */
+        template<typename T>
+        inline size_t mismatch(const T *s1, const T *s2, size_t n) noexcept {
+#if TINYSTL_SIMD_X86
+            return cpu_has_avx2() ? avx2_mismatch(s1, s2, n) : sse2_mismatch(s1, s2, n);
+#else
+            return scalar_mismatch(s1, s2, n);
+#endif
+        }
+
+        /*
+         * 使用字符 ch 填充 [dst, dst + n)
+         */
+        template<typename T>
+        inline T *fill(T *dst, T ch, size_t n) noexcept {
+#if TINYSTL_SIMD_X86
+            return cpu_has_avx2() ? avx2_fill(dst, ch, n) : sse2_fill(dst, ch, n);
+#else
+            return scalar_fill(dst, ch, n);
+#endif
+        }
+
+    } // namespace simd
+} // namespace tinySTL
+
+#endif //TINYSTL_SIMD_H
@@ -0,0 +1,959 @@
+//
+// Created by cqupt1811 on 2022/5/29.
+//
+
+/*
+ * 这个头文件包含算术类型连续区间上的 SIMD 内核，供 algo.h 与 numeric.h 中的算法分派使用:
+ * find_index()   第一个等于 value 的元素的下标
+ * count_equal()  等于 value 的元素个数
+ * count_if()     满足一元谓词的元素个数
+ * min_index()    第一个最小元素的下标
+ * max_index()    第一个最大元素的下标
+ * minmax_index() 一次遍历求第一个最小元素与最后一个最大元素的下标
+ * sum()          区间求和
+ * dot()          两个区间的内积
+ * inclusive_scan() / exclusive_scan() 前缀和
+ * intersect() / intersect_count() 两个有序整数序列的交集与交集的元素个数
+ * 内核使用 GCC 的向量扩展编写一次，分别以 SSE2、AVX2、AVX-512 为目标实例化，运行时按照 CPU 特性选择，
+ * 其他平台使用普通的循环
+ */
+
+#ifndef TINYSTL_SIMD_ALGO_H
+#define TINYSTL_SIMD_ALGO_H
+
+#include <cstring>  /* memcpy，用于非对齐的向量读取 */
+#include <type_traits>  /* std::is_arithmetic 等类型判断 */
+
+#include "simd.h"  /* 这个头文件包含字符序列相关的 SIMD 内核，以及运行时的 CPU 特性检测 */
+#include "type_traits.h"  /* 这个头文件用于提取类型信息 */
+
+/*
+ * 内核的通用实现必须内联到带 target 属性的包装函数中，才能以对应的指令集生成代码
+ */
+#if TINYSTL_SIMD_X86
+#define TINYSTL_SIMD_INLINE inline __attribute__((always_inline))
+#define TINYSTL_TARGET_AVX2 __attribute__((target("avx2")))
+#define TINYSTL_TARGET_AVX512 __attribute__((target("avx512f,avx512bw,avx512dq,avx512vl")))
+#endif
+
+namespace tinySTL {
+    namespace simd {
+
+        // ===========================================================================================
+        /*
+         * 类型判断
+         */
+
+        /*
+         * 可以向量化的元素类型: 除 bool 以外、宽度不超过 8 字节的算术类型
+         */
+        template<typename T, bool = std::is_arithmetic<T>::value>
+        struct is_vectorizable : m_false_type {
+        };
+
+        template<typename T>
+        struct is_vectorizable<T, true>
+                : m_bool_constant<!std::is_same<T, bool>::value && sizeof(T) <= 8 && !std::is_same<T, long double>::value> {
+        };
+
+        /*
+         * 连续区间的元素类型，只有指针是连续的(vector 与 basic_string 的迭代器就是指针)
+         */
+        template<typename Iter>
+        struct contiguous_value {
+            typedef void type;
+        };
+
+        template<typename T>
+        struct contiguous_value<T *> {
+            typedef typename std::remove_cv<T>::type type;
+        };
+
+        /*
+         * [first, last) 是可以向量化的连续区间；给定 U 时还要求 U 与元素类型相同，
+         * 这样向量化的比较与累加才和逐个元素的 operator==、operator+= 的结果一致
+         */
+        template<typename Iter, typename U = typename contiguous_value<Iter>::type>
+        struct is_simd_range
+                : m_bool_constant<is_vectorizable<typename contiguous_value<Iter>::type>::value
+                                  && std::is_same<typename contiguous_value<Iter>::type, U>::value> {
+        };
+
+        /*
+         * 找不到结果或者遇到 NaN 时返回的下标，调用者应改用普通的循环
+         */
+        static const size_t no_index = static_cast<size_t>(-1);
+
+        // ===========================================================================================
+        /*
+         * 普通循环版本，用于非 x86 平台
+         */
+        template<typename T>
+        inline size_t scalar_find_index(const T *s, size_t n, T value) noexcept {
+            size_t i = 0;
+            for (; i != n && s[i] != value; ++i) {}
+            return i;
+        }
+
+        template<typename T>
+        inline size_t scalar_count_equal(const T *s, size_t n, T value) noexcept {
+            size_t r = 0;
+            for (size_t i = 0; i != n; ++i) {
+                r += s[i] == value;
+            }
+            return r;
+        }
+
+        /*
+         * 与 set_intersection 相同的归并，Write 为 false 时只计数
+         */
+        template<bool Write, typename T>
+        inline size_t scalar_intersect(const T *a, size_t n, const T *b, size_t m, T *out) noexcept {
+            size_t i = 0, j = 0, r = 0;
+            while (i != n && j != m) {
+                if (a[i] < b[j]) {
+                    ++i;
+                } else if (b[j] < a[i]) {
+                    ++j;
+                } else {
+                    if (Write) {
+                        out[r] = a[i];
+                    }
+                    ++r, ++i, ++j;
+                }
+            }
+            return r;
+        }
+
+#if TINYSTL_SIMD_X86
+
+        // ===========================================================================================
+        /*
+         * 向量类型与基本操作
+         */
+
+        template<size_t Size>
+        struct sized_int;
+
+        template<>
+        struct sized_int<1> {
+            typedef int8_t s;
+            typedef uint8_t u;
+        };
+
+        template<>
+        struct sized_int<2> {
+            typedef int16_t s;
+            typedef uint16_t u;
+        };
+
+        template<>
+        struct sized_int<4> {
+            typedef int32_t s;
+            typedef uint32_t u;
+        };
+
+        template<>
+        struct sized_int<8> {
+            typedef int64_t s;
+            typedef uint64_t u;
+        };
+
+        /*
+         * 向量的元素类型: 整数统一为同宽度、同符号的定宽整数(char、long 等也能组成向量)，浮点数不变
+         */
+        template<typename T, bool = std::is_integral<T>::value>
+        struct lane {
+            typedef T type;
+        };
+
+        template<typename T>
+        struct lane<T, true> {
+            typedef typename std::conditional<std::is_signed<T>::value,
+                    typename sized_int<sizeof(T)>::s, typename sized_int<sizeof(T)>::u>::type type;
+        };
+
+        /*
+         * Bytes 字节宽的向量，比较的结果是同宽度的整数向量，真为全 1，假为 0。
+         * 多个比较结果需要先转换为无符号整数向量(utype)再做按位运算，
+         * 否则 GCC 在 AVX-512 下会把比较结果之间的运算拆成逐个元素的标量代码
+         */
+        template<typename T, size_t Bytes>
+        struct vec {
+            typedef T type __attribute__((vector_size(Bytes)));
+            typedef typename sized_int<sizeof(T)>::u ulane;
+            typedef ulane utype __attribute__((vector_size(Bytes)));
+            static const size_t size = Bytes / sizeof(T);
+        };
+
+        /*
+         * 向量只通过引用在函数之间传递，避免不同指令集之间的调用约定问题
+         */
+        template<typename V, typename T>
+        TINYSTL_SIMD_INLINE void load(V &v, const T *p) noexcept {
+            std::memcpy(&v, p, sizeof(V));
+        }
+
+        template<typename V, typename L>
+        TINYSTL_SIMD_INLINE void broadcast(V &v, L x) noexcept {
+            for (size_t k = 0; k < sizeof(V) / sizeof(L); ++k) {
+                v[k] = x;
+            }
+        }
+
+        template<typename M>
+        TINYSTL_SIMD_INLINE bool any_lane(const M &m) noexcept {
+            typename vec<uint64_t, sizeof(M)>::type w;
+            std::memcpy(&w, &m, sizeof(M));
+            uint64_t r = 0;
+            for (size_t k = 0; k < sizeof(M) / 8; ++k) {
+                r |= w[k];
+            }
+            return r != 0;
+        }
+
+        // ===========================================================================================
+        /*
+         * find_index: 每次检查四个向量，命中后在这四个向量中逐个查找
+         */
+        template<size_t Bytes, typename T>
+        TINYSTL_SIMD_INLINE size_t find_index_impl(const T *s, size_t n, T value) noexcept {
+            typedef typename lane<T>::type L;
+            typedef vec<L, Bytes> V;
+            typedef typename V::utype U;
+            const size_t step = V::size;
+            typename V::type target;
+            broadcast(target, static_cast<L>(value));
+            size_t i = 0;
+            for (; i + 4 * step <= n; i += 4 * step) {
+                typename V::type a, b, c, d;
+                load(a, s + i);
+                load(b, s + i + step);
+                load(c, s + i + 2 * step);
+                load(d, s + i + 3 * step);
+                if (any_lane((U) (a == target) | (U) (b == target) | (U) (c == target) | (U) (d == target))) {
+                    break;
+                }
+            }
+            for (; i != n && s[i] != value; ++i) {}
+            return i;
+        }
+
+        // ===========================================================================================
+        /*
+         * count_equal: 比较结果为 -1，从无符号的计数向量中减去，计数向量在溢出之前归约到总数中
+         */
+        template<size_t Bytes, typename T>
+        TINYSTL_SIMD_INLINE size_t count_equal_impl(const T *s, size_t n, T value) noexcept {
+            typedef typename lane<T>::type L;
+            typedef vec<L, Bytes> V;
+            typedef typename V::utype U;
+            const size_t step = V::size;
+            const size_t flush = sizeof(T) == 1 ? 255 : 65535;
+            typename V::type target;
+            broadcast(target, static_cast<L>(value));
+            size_t r = 0;
+            size_t i = 0;
+            while (i + step <= n) {
+                size_t rounds = (n - i) / step;
+                if (rounds > flush) {
+                    rounds = flush;
+                }
+                U acc = {};
+                for (; rounds != 0; --rounds, i += step) {
+                    typename V::type x;
+                    load(x, s + i);
+                    acc -= (U) (x == target);
+                }
+                for (size_t k = 0; k < step; ++k) {
+                    r += acc[k];
+                }
+            }
+            for (; i != n; ++i) {
+                r += s[i] == value;
+            }
+            return r;
+        }
+
+        // ===========================================================================================
+        /*
+         * count_if: 固定长度的内层循环没有提前退出，计数的累加可以交给编译器向量化，
+         * 谓词足够简单(比较、算术)时生成与 count_equal 相同的代码，否则退化为普通循环
+         */
+        template<typename T, typename UnaryPred>
+        TINYSTL_SIMD_INLINE size_t count_if_impl(T *s, size_t n, UnaryPred &pred) {
+            const size_t block = 256;
+            size_t r = 0;
+            size_t i = 0;
+            for (; i + block <= n; i += block) {
+                unsigned c = 0;
+                for (size_t k = 0; k < block; ++k) {
+                    c += pred(s[i + k]) ? 1u : 0u;
+                }
+                r += c;
+            }
+            for (; i != n; ++i) {
+                r += pred(s[i]) ? 1 : 0;
+            }
+            return r;
+        }
+
+        // ===========================================================================================
+        /*
+         * min_index / max_index: 按块求出块内的极值，只有块的极值优于当前结果时才回到块内查找它的下标，
+         * 因此绝大多数元素只被读取一次。浮点数遇到 NaN 时 operator< 不构成严格弱序，返回 no_index
+         */
+        template<size_t Bytes, bool Max, typename T>
+        TINYSTL_SIMD_INLINE size_t extreme_index_impl(const T *s, size_t n) noexcept {
+            typedef typename lane<T>::type L;
+            typedef vec<L, Bytes> V;
+            const size_t step = V::size;
+            const size_t block = 2048;
+            const bool is_float = std::is_floating_point<T>::value;
+            if (is_float && s[0] != s[0]) {
+                return no_index;
+            }
+            L best = static_cast<L>(s[0]);
+            size_t best_i = 0;
+            size_t i = 0;
+            for (; i + block <= n; i += block) {
+                typename V::type acc;
+                broadcast(acc, best);
+                typename V::utype nan = {};
+                for (size_t k = 0; k < block; k += step) {
+                    typename V::type x;
+                    load(x, s + i + k);
+                    if (Max) {
+                        acc = x > acc ? x : acc;
+                    } else {
+                        acc = x < acc ? x : acc;
+                    }
+                    if (is_float) {
+                        nan |= (typename V::utype) (x != x);
+                    }
+                }
+                if (is_float && any_lane(nan)) {
+                    return no_index;
+                }
+                L m = acc[0];
+                for (size_t k = 1; k < step; ++k) {
+                    if (Max ? m < acc[k] : acc[k] < m) {
+                        m = acc[k];
+                    }
+                }
+                if (Max ? best < m : m < best) {
+                    best = m;
+                    best_i = i;
+                    for (; static_cast<L>(s[best_i]) != m; ++best_i) {}
+                }
+            }
+            for (; i != n; ++i) {
+                const L x = static_cast<L>(s[i]);
+                if (is_float && x != x) {
+                    return no_index;
+                }
+                if (Max ? best < x : x < best) {
+                    best = x;
+                    best_i = i;
+                }
+            }
+            return best_i;
+        }
+
+        /*
+         * minmax_index: 同时维护最小值与最大值，最大值取最后一个，与 minmax_element 的约定相同
+         */
+        template<size_t Bytes, typename T>
+        TINYSTL_SIMD_INLINE bool minmax_index_impl(const T *s, size_t n, size_t &min_i, size_t &max_i) noexcept {
+            typedef typename lane<T>::type L;
+            typedef vec<L, Bytes> V;
+            const size_t step = V::size;
+            const size_t block = 2048;
+            const bool is_float = std::is_floating_point<T>::value;
+            if (is_float && s[0] != s[0]) {
+                return false;
+            }
+            L lo = static_cast<L>(s[0]), hi = lo;
+            min_i = max_i = 0;
+            size_t i = 0;
+            for (; i + block <= n; i += block) {
+                /* 以块内的元素作为初值，块的极值一定出现在块内 */
+                typename V::type vlo, vhi;
+                broadcast(vlo, static_cast<L>(s[i]));
+                vhi = vlo;
+                typename V::utype nan = {};
+                for (size_t k = 0; k < block; k += step) {
+                    typename V::type x;
+                    load(x, s + i + k);
+                    vlo = x < vlo ? x : vlo;
+                    vhi = x > vhi ? x : vhi;
+                    if (is_float) {
+                        nan |= (typename V::utype) (x != x);
+                    }
+                }
+                if (is_float && any_lane(nan)) {
+                    return false;
+                }
+                L mlo = vlo[0], mhi = vhi[0];
+                for (size_t k = 1; k < step; ++k) {
+                    if (vlo[k] < mlo) {
+                        mlo = vlo[k];
+                    }
+                    if (mhi < vhi[k]) {
+                        mhi = vhi[k];
+                    }
+                }
+                if (mlo < lo) {
+                    lo = mlo;
+                    min_i = i;
+                    for (; static_cast<L>(s[min_i]) != mlo; ++min_i) {}
+                }
+                /* 块内的最大值等于当前最大值时，块内更靠后的位置也要取 */
+                if (!(mhi < hi)) {
+                    hi = mhi;
+                    max_i = i + block - 1;
+                    for (; static_cast<L>(s[max_i]) != mhi; --max_i) {}
+                }
+            }
+            for (; i != n; ++i) {
+                const L x = static_cast<L>(s[i]);
+                if (is_float && x != x) {
+                    return false;
+                }
+                if (x < lo) {
+                    lo = x;
+                    min_i = i;
+                }
+                if (!(x < hi)) {
+                    hi = x;
+                    max_i = i;
+                }
+            }
+            return true;
+        }
+
+        // ===========================================================================================
+        /*
+         * sum / dot: 四个独立的累加向量隐藏加法的延迟。
+         * 整数在同宽度的无符号整数上运算，溢出时按 2^n 取模回绕，结果与逐个累加后截断到 T 相同；
+         * 浮点数改变了加法的结合顺序，结果与逐个累加可能有舍入误差上的差别
+         */
+        template<size_t Bytes, typename T>
+        TINYSTL_SIMD_INLINE T sum_impl(const T *s, size_t n, T init) noexcept {
+            typedef typename std::conditional<std::is_integral<T>::value,
+                    typename sized_int<sizeof(T)>::u, T>::type L;
+            typedef vec<L, Bytes> V;
+            const size_t step = V::size;
+            typename V::type acc0 = {}, acc1 = {}, acc2 = {}, acc3 = {};
+            size_t i = 0;
+            for (; i + 4 * step <= n; i += 4 * step) {
+                typename V::type x0, x1, x2, x3;
+                load(x0, s + i);
+                load(x1, s + i + step);
+                load(x2, s + i + 2 * step);
+                load(x3, s + i + 3 * step);
+                acc0 += x0;
+                acc1 += x1;
+                acc2 += x2;
+                acc3 += x3;
+            }
+            for (; i + step <= n; i += step) {
+                typename V::type x;
+                load(x, s + i);
+                acc0 += x;
+            }
+            acc0 += acc1 + acc2 + acc3;
+            L r = L();
+            for (size_t k = 0; k < step; ++k) {
+                r += acc0[k];
+            }
+            for (; i < n; ++i) {
+                r += static_cast<L>(s[i]);
+            }
+            return static_cast<T>(static_cast<L>(init) + r);
+        }
+
+        template<size_t Bytes, typename T>
+        TINYSTL_SIMD_INLINE T dot_impl(const T *a, const T *b, size_t n, T init) noexcept {
+            typedef typename std::conditional<std::is_integral<T>::value,
+                    typename sized_int<sizeof(T)>::u, T>::type L;
+            typedef vec<L, Bytes> V;
+            const size_t step = V::size;
+            typename V::type acc0 = {}, acc1 = {};
+            size_t i = 0;
+            for (; i + 2 * step <= n; i += 2 * step) {
+                typename V::type x0, x1, y0, y1;
+                load(x0, a + i);
+                load(x1, a + i + step);
+                load(y0, b + i);
+                load(y1, b + i + step);
+                acc0 += x0 * y0;
+                acc1 += x1 * y1;
+            }
+            for (; i + step <= n; i += step) {
+                typename V::type x, y;
+                load(x, a + i);
+                load(y, b + i);
+                acc0 += x * y;
+            }
+            acc0 += acc1;
+            L r = L();
+            for (size_t k = 0; k < step; ++k) {
+                r += acc0[k];
+            }
+            for (; i < n; ++i) {
+                r += static_cast<L>(a[i]) * static_cast<L>(b[i]);
+            }
+            return static_cast<T>(static_cast<L>(init) + r);
+        }
+
+        // ===========================================================================================
+        /*
+         * inclusive_scan / exclusive_scan: 向量内的前缀和用 log2(元素个数) 次"整体右移 K 个元素再相加"求出，
+         * 再加上之前所有向量的和 carry。carry 只依赖于每个向量内前缀和的最后一个元素，相邻向量之间的依赖只有一次加法。
+         * 整数与 sum 一样在无符号整数上回绕；浮点数的加法顺序与逐个累加不同，结果还与向量的宽度有关
+         */
+        template<size_t K, typename V, typename M>
+        TINYSTL_SIMD_INLINE void shift_up(V &y, const V &x) noexcept {
+            const size_t step = sizeof(V) / sizeof(x[0]);
+            M m;
+            for (size_t j = 0; j < step; ++j) {
+                m[j] = j >= K ? j - K : step + j;
+            }
+            const V zero = {};
+            y = __builtin_shuffle(x, zero, m);
+        }
+
+        template<size_t K, size_t Step>
+        struct in_register_scan {
+            template<typename V, typename M>
+            static TINYSTL_SIMD_INLINE void apply(V &x) noexcept {
+                V t;
+                shift_up<K, V, M>(t, x);
+                x += t;
+                in_register_scan<K * 2, Step>::template apply<V, M>(x);
+            }
+        };
+
+        template<size_t Step>
+        struct in_register_scan<Step, Step> {
+            template<typename V, typename M>
+            static TINYSTL_SIMD_INLINE void apply(V &) noexcept {
+            }
+        };
+
+        template<size_t Bytes, bool Exclusive, typename T>
+        TINYSTL_SIMD_INLINE void scan_impl(const T *s, size_t n, T *out, T init) noexcept {
+            typedef typename std::conditional<std::is_integral<T>::value,
+                    typename sized_int<sizeof(T)>::u, T>::type L;
+            typedef vec<L, Bytes> V;
+            typedef typename V::type VT;
+            const size_t step = V::size;
+            VT carry;
+            broadcast(carry, static_cast<L>(init));
+            const size_t vec_end = n - n % step;
+            size_t i = 0;
+            for (; i < vec_end; i += step) {
+                VT x, r;
+                load(x, s + i);
+                in_register_scan<1, V::size>::template apply<VT, typename V::utype>(x);
+                if (Exclusive) {
+                    shift_up<1, VT, typename V::utype>(r, x);
+                    r += carry;
+                } else {
+                    r = x + carry;
+                }
+                std::memcpy(out + i, &r, sizeof(VT));
+                VT last;
+                broadcast(last, x[step - 1]);
+                carry += last;
+            }
+            L c = carry[0];
+            for (; i < n; ++i) {
+                const L x = static_cast<L>(s[i]);
+                if (Exclusive) {
+                    out[i] = static_cast<T>(c);
+                    c += x;
+                } else {
+                    c += x;
+                    out[i] = static_cast<T>(c);
+                }
+            }
+        }
+
+        // ===========================================================================================
+        /*
+         * intersect: 两个序列各取一个向量，a 的向量与 b 的向量的所有循环移位逐一比较，得到 a 的向量中同样出现在
+         * b 的向量中的元素，然后前进最后一个元素较小的一方，相等时两方都前进。这要求元素严格递增：每读入一个向量，
+         * 同时与后移一个元素的向量比较，检查它连同其后的一个元素严格递增；遇到相等的相邻元素或者剩余不足时停止，
+         * 通过 pi、pj 返回停止的位置，由调用者按多重集合的规则用普通的循环处理剩余部分
+         */
+        template<size_t K, size_t Step>
+        struct rotate_match {
+            template<typename V, typename U>
+            static TINYSTL_SIMD_INLINE void apply(U &eq, const V &a, const V &b) noexcept {
+                U m;
+                for (size_t j = 0; j < Step; ++j) {
+                    m[j] = (j + K) % Step;
+                }
+                const V r = __builtin_shuffle(b, m);
+                eq |= (U) (a == r);
+                rotate_match<K + 1, Step>::template apply<V, U>(eq, a, b);
+            }
+        };
+
+        template<size_t Step>
+        struct rotate_match<Step, Step> {
+            template<typename V, typename U>
+            static TINYSTL_SIMD_INLINE void apply(U &, const V &, const V &) noexcept {
+            }
+        };
+
+        template<typename V, typename T>
+        TINYSTL_SIMD_INLINE bool load_increasing(V &x, const T *p) noexcept {
+            V y;
+            load(x, p);
+            load(y, p + 1);
+            return !any_lane(x == y);
+        }
+
+        template<size_t Bytes, bool Write, typename T>
+        TINYSTL_SIMD_INLINE size_t intersect_impl(const T *a, size_t n, const T *b, size_t m, T *out,
+                                                  size_t &pi, size_t &pj) noexcept {
+            typedef vec<typename sized_int<sizeof(T)>::u, Bytes> V;
+            typedef typename V::type VT;
+            typedef typename V::utype U;
+            const size_t step = V::size;
+            size_t i = 0, j = 0, r = 0;
+            VT va, vb;
+            if (step < n && step < m && load_increasing(va, a) && load_increasing(vb, b)) {
+                for (;;) {
+                    U eq = (U) (va == vb);
+                    rotate_match<1, V::size>::template apply<VT, U>(eq, va, vb);
+                    if (any_lane(eq)) {
+                        unsigned bits = 0;
+                        for (size_t k = 0; k < step; ++k) {
+                            bits |= static_cast<unsigned>(eq[k] & 1) << k;
+                        }
+                        if (Write) {
+                            for (; bits != 0; bits &= bits - 1) {
+                                out[r++] = a[i + __builtin_ctz(bits)];
+                            }
+                        } else {
+                            r += static_cast<size_t>(__builtin_popcount(bits));
+                        }
+                    }
+                    const T a_last = a[i + step - 1];
+                    const T b_last = b[j + step - 1];
+                    if (!(b_last < a_last)) {
+                        i += step;
+                        if (i + step >= n || !load_increasing(va, a + i)) {
+                            break;
+                        }
+                    }
+                    if (!(a_last < b_last)) {
+                        j += step;
+                        if (j + step >= m || !load_increasing(vb, b + j)) {
+                            break;
+                        }
+                    }
+                }
+            }
+            pi = i;
+            pj = j;
+            return r;
+        }
+
+        // ===========================================================================================
+        /*
+         * 各指令集的实例: sse2 为 16 字节向量，avx2 为 32 字节向量，avx512 为 64 字节向量
+         */
+
+#define TINYSTL_SIMD_KERNELS(prefix, bytes, target)                                                        \
+        template<typename T>                                                                               \
+        target inline size_t prefix##_find_index(const T *s, size_t n, T value) noexcept {                 \
+            return find_index_impl<bytes>(s, n, value);                                                    \
+        }                                                                                                  \
+        template<typename T>                                                                               \
+        target inline size_t prefix##_count_equal(const T *s, size_t n, T value) noexcept {                \
+            return count_equal_impl<bytes>(s, n, value);                                                   \
+        }                                                                                                  \
+        template<typename T, typename UnaryPred>                                                           \
+        target inline size_t prefix##_count_if(T *s, size_t n, UnaryPred &pred) {                          \
+            return count_if_impl(s, n, pred);                                                              \
+        }                                                                                                  \
+        template<bool Max, typename T>                                                                     \
+        target inline size_t prefix##_extreme_index(const T *s, size_t n) noexcept {                       \
+            return extreme_index_impl<bytes, Max>(s, n);                                                   \
+        }                                                                                                  \
+        template<typename T>                                                                               \
+        target inline bool prefix##_minmax_index(const T *s, size_t n, size_t &lo, size_t &hi) noexcept {  \
+            return minmax_index_impl<bytes>(s, n, lo, hi);                                                 \
+        }                                                                                                  \
+        template<typename T>                                                                               \
+        target inline T prefix##_sum(const T *s, size_t n, T init) noexcept {                              \
+            return sum_impl<bytes>(s, n, init);                                                            \
+        }                                                                                                  \
+        template<typename T>                                                                               \
+        target inline T prefix##_dot(const T *a, const T *b, size_t n, T init) noexcept {                  \
+            return dot_impl<bytes>(a, b, n, init);                                                         \
+        }                                                                                                  \
+        template<bool Exclusive, typename T>                                                               \
+        target inline void prefix##_scan(const T *s, size_t n, T *out, T init) noexcept {                  \
+            scan_impl<bytes, Exclusive>(s, n, out, init);                                                  \
+        }                                                                                                  \
+        template<bool Write, typename T>                                                                   \
+        target inline size_t prefix##_intersect(const T *a, size_t n, const T *b, size_t m, T *out,        \
+                                                size_t &pi, size_t &pj) noexcept {                         \
+            return intersect_impl<bytes, Write>(a, n, b, m, out, pi, pj);                                  \
+        }
+
+        TINYSTL_SIMD_KERNELS(sse2, 16, )
+
+        TINYSTL_SIMD_KERNELS(avx2, 32, TINYSTL_TARGET_AVX2)
+
+        TINYSTL_SIMD_KERNELS(avx512, 64, TINYSTL_TARGET_AVX512)
+
+#undef TINYSTL_SIMD_KERNELS
+
+        /*
+         * 运行时可用的最高指令集: 0 为 SSE2，1 为 AVX2，2 为 AVX-512
+         */
+        inline int vector_isa() noexcept {
+            static const int isa = cpu_has_avx512() ? 2 : (cpu_has_avx2() ? 1 : 0);
+            return isa;
+        }
+
+#define TINYSTL_SIMD_DISPATCH(name, args)    \
+        switch (vector_isa()) {              \
+            case 2:                          \
+                return avx512_##name args;   \
+            case 1:                          \
+                return avx2_##name args;     \
+            default:                         \
+                return sse2_##name args;     \
+        }
+
+#endif // TINYSTL_SIMD_X86
+
+        // ===========================================================================================
+        /*
+         * 对外的接口，T 必须满足 is_vectorizable
+         */
+
+        /*
+         * 返回 s[0, n) 中第一个等于 value 的元素的下标，不存在时返回 n
+         */
+        template<typename T>
+        inline size_t find_index(const T *s, size_t n, T value) noexcept {
+#if TINYSTL_SIMD_X86
+            TINYSTL_SIMD_DISPATCH(find_index, (s, n, value))
+#else
+            return scalar_find_index(s, n, value);
+#endif
+        }
+
+        /*
+         * 返回 s[0, n) 中等于 value 的元素个数
+         */
+        template<typename T>
+        inline size_t count_equal(const T *s, size_t n, T value) noexcept {
+#if TINYSTL_SIMD_X86
+            TINYSTL_SIMD_DISPATCH(count_equal, (s, n, value))
+#else
+            return scalar_count_equal(s, n, value);
+#endif
+        }
+
+        /*
+         * 返回 s[0, n) 中满足 pred 的元素个数，T 可以带有 const，元素按原有的类型传给 pred
+         */
+        template<typename T, typename UnaryPred>
+        inline size_t count_if(T *s, size_t n, UnaryPred pred) {
+#if TINYSTL_SIMD_X86
+            TINYSTL_SIMD_DISPATCH(count_if, (s, n, pred))
+#else
+            size_t r = 0;
+            for (size_t i = 0; i != n; ++i) {
+                r += pred(s[i]) ? 1 : 0;
+            }
+            return r;
+#endif
+        }
+
+        /*
+         * 返回 s[0, n) 中第一个最小元素的下标，n 必须大于 0，遇到 NaN 时返回 no_index
+         */
+        template<typename T>
+        inline size_t min_index(const T *s, size_t n) noexcept {
+#if TINYSTL_SIMD_X86
+            TINYSTL_SIMD_DISPATCH(extreme_index<false>, (s, n))
+#else
+            (void) s;
+            (void) n;
+            return no_index;
+#endif
+        }
+
+        /*
+         * 返回 s[0, n) 中第一个最大元素的下标，n 必须大于 0，遇到 NaN 时返回 no_index
+         */
+        template<typename T>
+        inline size_t max_index(const T *s, size_t n) noexcept {
+#if TINYSTL_SIMD_X86
+            TINYSTL_SIMD_DISPATCH(extreme_index<true>, (s, n))
+#else
+            (void) s;
+            (void) n;
+            return no_index;
+#endif
+        }
+
+        /*
+         * 求 s[0, n) 中第一个最小元素与最后一个最大元素的下标，n 必须大于 0，遇到 NaN 时返回 false
+         */
+        template<typename T>
+        inline bool minmax_index(const T *s, size_t n, size_t &lo, size_t &hi) noexcept {
+#if TINYSTL_SIMD_X86
+            TINYSTL_SIMD_DISPATCH(minmax_index, (s, n, lo, hi))
+#else
+            (void) s;
+            (void) n;
+            (void) lo;
+            (void) hi;
+            return false;
+#endif
+        }
+
+        /*
+         * 返回 init 与 s[0, n) 的和，浮点数的加法顺序不确定
+         */
+        template<typename T>
+        inline T sum(const T *s, size_t n, T init) noexcept {
+#if TINYSTL_SIMD_X86
+            TINYSTL_SIMD_DISPATCH(sum, (s, n, init))
+#else
+            for (size_t i = 0; i != n; ++i) {
+                init += s[i];
+            }
+            return init;
+#endif
+        }
+
+        /*
+         * 返回 init 与 a[0, n)、b[0, n) 内积的和，浮点数的加法顺序不确定
+         */
+        template<typename T>
+        inline T dot(const T *a, const T *b, size_t n, T init) noexcept {
+#if TINYSTL_SIMD_X86
+            TINYSTL_SIMD_DISPATCH(dot, (a, b, n, init))
+#else
+            for (size_t i = 0; i != n; ++i) {
+                init += a[i] * b[i];
+            }
+            return init;
+#endif
+        }
+
+        /*
+         * out[i] = init + s[0] + ... + s[i]，返回 out + n；out 可以与 s 相同，浮点数的加法顺序不确定
+         */
+        template<typename T>
+        inline T *inclusive_scan(const T *s, size_t n, T *out, T init) noexcept {
+#if TINYSTL_SIMD_X86
+            switch (vector_isa()) {
+                case 2:
+                    avx512_scan<false>(s, n, out, init);
+                    break;
+                case 1:
+                    avx2_scan<false>(s, n, out, init);
+                    break;
+                default:
+                    sse2_scan<false>(s, n, out, init);
+                    break;
+            }
+#else
+            for (size_t i = 0; i != n; ++i) {
+                init += s[i];
+                out[i] = init;
+            }
+#endif
+            return out + n;
+        }
+
+        /*
+         * out[i] = init + s[0] + ... + s[i - 1]，返回 out + n；out 可以与 s 相同，浮点数的加法顺序不确定
+         */
+        template<typename T>
+        inline T *exclusive_scan(const T *s, size_t n, T *out, T init) noexcept {
+#if TINYSTL_SIMD_X86
+            switch (vector_isa()) {
+                case 2:
+                    avx512_scan<true>(s, n, out, init);
+                    break;
+                case 1:
+                    avx2_scan<true>(s, n, out, init);
+                    break;
+                default:
+                    sse2_scan<true>(s, n, out, init);
+                    break;
+            }
+#else
+            for (size_t i = 0; i != n; ++i) {
+                const T x = s[i];
+                out[i] = init;
+                init += x;
+            }
+#endif
+            return out + n;
+        }
+
+        /*
+         * 有序的 a[0, n) 与 b[0, m) 的交集，Write 为 false 时只计数。元素严格递增的部分向量化，
+         * 之后按 set_intersection 的规则处理，因此重复的元素也按多重集合计算
+         */
+        template<bool Write, typename T>
+        inline size_t intersect_dispatch(const T *a, size_t n, const T *b, size_t m, T *out) noexcept {
+            static_assert(std::is_integral<T>::value && (sizeof(T) == 4 || sizeof(T) == 8),
+                          "intersect requires 4-byte or 8-byte integers");
+            size_t i = 0, j = 0, r = 0;
+#if TINYSTL_SIMD_X86
+            switch (vector_isa()) {
+                case 2:
+                    r = avx512_intersect<Write>(a, n, b, m, out, i, j);
+                    break;
+                case 1:
+                    r = avx2_intersect<Write>(a, n, b, m, out, i, j);
+                    break;
+                default:
+                    r = sse2_intersect<Write>(a, n, b, m, out, i, j);
+                    break;
+            }
+#endif
+            return r + scalar_intersect<Write>(a + i, n - i, b + j, m - j, Write ? out + r : out);
+        }
+
+        /*
+         * 把有序的 a[0, n) 与 b[0, m) 的交集写入 out，返回交集的元素个数；T 必须是 4 字节或 8 字节的整数
+         */
+        template<typename T>
+        inline size_t intersect(const T *a, size_t n, const T *b, size_t m, T *out) noexcept {
+            return intersect_dispatch<true>(a, n, b, m, out);
+        }
+
+        /*
+         * 返回有序的 a[0, n) 与 b[0, m) 的交集的元素个数；T 必须是 4 字节或 8 字节的整数
+         */
+        template<typename T>
+        inline size_t intersect_count(const T *a, size_t n, const T *b, size_t m) noexcept {
+            return intersect_dispatch<false>(a, n, b, m, static_cast<T *>(nullptr));
+        }
+
+#if TINYSTL_SIMD_X86
+#undef TINYSTL_SIMD_DISPATCH
+#endif
+
+    } // namespace simd
+} // namespace tinySTL
+
+#endif //TINYSTL_SIMD_ALGO_H
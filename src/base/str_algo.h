@@ -0,0 +1,708 @@
+//
+// Created by cqupt1811 on 2022/5/15.
+//
+
+/*
+ * 这个头文件包含字符串的子串查找算法
+ * string_search()  正向查找子串第一次出现的位置
+ * string_rsearch() 反向查找子串最后一次出现的位置
+ * char_set 字符集合，以及基于它的 string_find_first_of() 等一组函数
+ * 短模式串先用 SIMD 比较首尾两个字符筛选候选位置，再逐个验证；
+ * 长模式串以及筛选效果很差(高度重复的数据)时使用 Two-Way 算法，最坏情况下也是线性时间
+ */
+
+#ifndef TINYSTL_STR_ALGO_H
+#define TINYSTL_STR_ALGO_H
+
+#include <cstddef>  /* 定义了 size_t 等常用类型 */
+#include <cstdint>  /* 定义了定宽整数类型 */
+#include <cstring>  /* memcmp */
+#include "simd.h"  /* 这个头文件包含字符序列相关的 SIMD 内核，以及运行时的 CPU 特性检测 */
+#include "iterator.h"  /* 这个头文件用于迭代器设计，包含了一些模板结构体与全局函数 */
+#include "type_traits.h"  /* 这个头文件用于提取类型信息 */
+
+/* 首先定义自己的命名空间 */
+namespace tinySTL {
+
+    namespace str_algo_detail {
+
+        /*
+         * SIMD 筛选适用的最长模式串，更长的模式串直接使用 Two-Way
+         */
+        const size_t kShortNeedleSize = 32;
+
+        /*
+         * 两个序列的前 n 个字符是否相等
+         */
+        template<typename RandomIter1, typename RandomIter2>
+        inline bool equal_n(RandomIter1 s1, RandomIter2 s2, size_t n) {
+            for (size_t i = 0; i != n; ++i) {
+                if (!(s1[i] == s2[i])) {
+                    return false;
+                }
+            }
+            return true;
+        }
+
+        /*
+         * 把字符映射到 [0, 256) 用于 Two-Way 中的坏字符跳转表
+         * 宽字符只取低 8 位，多个字符共享一项时取最靠右的出现位置，跳转距离只会变小，仍然是安全的
+         */
+        template<typename T>
+        inline size_t byte_of(T ch) {
+            return static_cast<size_t>(ch) & 0xFF;
+        }
+
+        /*
+         * Two-Way 算法(Crochemore-Perrin)，结合坏字符跳转表
+         * 在 [h, h + n) 中查找 [nd, nd + m) 第一次出现的位置，返回其下标，找不到时返回 n
+         * 使用随机访问迭代器，传入反向迭代器即可用于反向查找
+         * 要求 m >= 1
+         */
+        template<typename RandomIter1, typename RandomIter2>
+        size_t two_way_search(RandomIter1 h, size_t n, RandomIter2 nd, size_t m) {
+            if (n < m) {
+                return n;
+            }
+            bool byteset[256] = {false};
+            size_t shift[256];
+            for (size_t i = 0; i < m; ++i) {
+                const size_t b = byte_of(nd[i]);
+                byteset[b] = true;
+                shift[b] = i + 1;
+            }
+
+            /* 计算最大后缀，ip 初始值为 -1，利用无符号数的回绕 */
+            size_t ip = static_cast<size_t>(-1), jp = 0, k = 1, p = 1;
+            while (jp + k < m) {
+                if (nd[ip + k] == nd[jp + k]) {
+                    if (k == p) {
+                        jp += p;
+                        k = 1;
+                    } else {
+                        ++k;
+                    }
+                } else if (nd[jp + k] < nd[ip + k]) {
+                    jp += k;
+                    k = 1;
+                    p = jp - ip;
+                } else {
+                    ip = jp++;
+                    k = p = 1;
+                }
+            }
+            size_t ms = ip;
+            const size_t p0 = p;
+
+            /* 以相反的顺序再计算一次最大后缀，取两者中较大的作为分界点 */
+            ip = static_cast<size_t>(-1);
+            jp = 0;
+            k = p = 1;
+            while (jp + k < m) {
+                if (nd[ip + k] == nd[jp + k]) {
+                    if (k == p) {
+                        jp += p;
+                        k = 1;
+                    } else {
+                        ++k;
+                    }
+                } else if (nd[ip + k] < nd[jp + k]) {
+                    jp += k;
+                    k = 1;
+                    p = jp - ip;
+                } else {
+                    ip = jp++;
+                    k = p = 1;
+                }
+            }
+            if (ip + 1 > ms + 1) {
+                ms = ip;
+            } else {
+                p = p0;
+            }
+
+            /* 模式串是否为周期串，是周期串时可以记住已经匹配的前缀长度 mem */
+            size_t mem0;
+            if (!equal_n(nd, nd + p, ms + 1)) {
+                mem0 = 0;
+                p = (ms > m - ms - 1 ? ms : m - ms - 1) + 1;
+            } else {
+                mem0 = m - p;
+            }
+            size_t mem = 0;
+
+            size_t pos = 0;
+            while (n - pos >= m) {
+                /* 先检查窗口的最后一个字符，根据跳转表移动 */
+                const size_t b = byte_of(h[pos + m - 1]);
+                if (!byteset[b]) {
+                    pos += m;
+                    mem = 0;
+                    continue;
+                }
+                k = m - shift[b];
+                if (k != 0) {
+                    if (k < mem) {
+                        k = mem;
+                    }
+                    pos += k;
+                    mem = 0;
+                    continue;
+                }
+                /* 比较右半部分 */
+                for (k = ms + 1 > mem ? ms + 1 : mem; k < m && nd[k] == h[pos + k]; ++k) {}
+                if (k < m) {
+                    pos += k - ms;
+                    mem = 0;
+                    continue;
+                }
+                /* 比较左半部分 */
+                for (k = ms + 1; k > mem && nd[k - 1] == h[pos + k - 1]; --k) {}
+                if (k <= mem) {
+                    return pos;
+                }
+                pos += p;
+                mem = mem0;
+            }
+            return n;
+        }
+
+        /*
+         * 验证候选位置时允许的误报次数，超过后认为数据高度重复，改用 Two-Way
+         */
+        inline bool too_many_false_hits(size_t false_hits, size_t scanned) {
+            return false_hits > 64 && false_hits * 4 > scanned;
+        }
+
+#if TINYSTL_SIMD_X86
+
+        /*
+         * SIMD 筛选：同时比较窗口的首字符与尾字符，两者都相等的位置才逐个验证中间部分
+         * 在 [h, h + n) 中查找 [nd, nd + m) 第一次出现的位置，返回下标，找不到时返回 n
+         * 要求 2 <= m <= n
+         */
+        template<typename T>
+        size_t sse2_search_short(const T *h, size_t n, const T *nd, size_t m) {
+            typedef simd::sse2_ops<sizeof(T)> ops;
+            const size_t step = 16 / sizeof(T);
+            const unsigned lane_mask = (1u << sizeof(T)) - 1;
+            const __m128i first = ops::set1(simd::to_lane(nd[0]));
+            const __m128i last = ops::set1(simd::to_lane(nd[m - 1]));
+            const size_t last_start = n - m;
+            size_t false_hits = 0;
+            size_t i = 0;
+            for (; i + step - 1 <= last_start; i += step) {
+                const __m128i bf = ops::cmpeq(_mm_loadu_si128(reinterpret_cast<const __m128i *>(h + i)), first);
+                const __m128i bl = ops::cmpeq(_mm_loadu_si128(reinterpret_cast<const __m128i *>(h + i + m - 1)), last);
+                unsigned mask = static_cast<unsigned>(_mm_movemask_epi8(_mm_and_si128(bf, bl)));
+                while (mask != 0) {
+                    const unsigned bit = simd::lowest_bit(mask);
+                    const size_t idx = i + bit / sizeof(T);
+                    if (std::memcmp(h + idx + 1, nd + 1, (m - 2) * sizeof(T)) == 0) {
+                        return idx;
+                    }
+                    mask &= ~(lane_mask << bit);
+                    ++false_hits;
+                }
+                if (too_many_false_hits(false_hits, i + step)) {
+                    return i + two_way_search(h + i, n - i, nd, m);
+                }
+            }
+            for (; i <= last_start; ++i) {
+                if (h[i] == nd[0] && equal_n(h + i + 1, nd + 1, m - 1)) {
+                    return i;
+                }
+            }
+            return n;
+        }
+
+        template<typename T>
+        __attribute__((target("avx2")))
+        size_t avx2_search_short(const T *h, size_t n, const T *nd, size_t m) {
+            typedef simd::avx2_ops<sizeof(T)> ops;
+            const size_t step = 32 / sizeof(T);
+            const unsigned lane_mask = (1u << sizeof(T)) - 1;
+            const __m256i first = ops::set1(simd::to_lane(nd[0]));
+            const __m256i last = ops::set1(simd::to_lane(nd[m - 1]));
+            const size_t last_start = n - m;
+            size_t false_hits = 0;
+            size_t i = 0;
+            for (; i + step - 1 <= last_start; i += step) {
+                const __m256i bf = ops::cmpeq(_mm256_loadu_si256(reinterpret_cast<const __m256i *>(h + i)), first);
+                const __m256i bl = ops::cmpeq(_mm256_loadu_si256(reinterpret_cast<const __m256i *>(h + i + m - 1)),
+                                              last);
+                unsigned mask = static_cast<unsigned>(_mm256_movemask_epi8(_mm256_and_si256(bf, bl)));
+                while (mask != 0) {
+                    const unsigned bit = simd::lowest_bit(mask);
+                    const size_t idx = i + bit / sizeof(T);
+                    if (std::memcmp(h + idx + 1, nd + 1, (m - 2) * sizeof(T)) == 0) {
+                        return idx;
+                    }
+                    mask &= ~(lane_mask << bit);
+                    ++false_hits;
+                }
+                if (too_many_false_hits(false_hits, i + step)) {
+                    return i + two_way_search(h + i, n - i, nd, m);
+                }
+            }
+            if (i > last_start) {
+                return n;
+            }
+            return i + sse2_search_short(h + i, n - i, nd, m);
+        }
+
+        /*
+         * 反向的 SIMD 筛选，从尾部开始按块向前扫描，块内取最高的候选位置
+         * 返回最后一次出现的下标，找不到时返回 n
+         */
+        template<typename T>
+        size_t sse2_rsearch_short(const T *h, size_t n, const T *nd, size_t m) {
+            typedef simd::sse2_ops<sizeof(T)> ops;
+            const size_t step = 16 / sizeof(T);
+            const unsigned lane_mask = (1u << sizeof(T)) - 1;
+            const __m128i first = ops::set1(simd::to_lane(nd[0]));
+            const __m128i last = ops::set1(simd::to_lane(nd[m - 1]));
+            /* end 为尚未检查的起始位置的个数，即候选位置为 [0, end) */
+            size_t end = n - m + 1;
+            size_t false_hits = 0;
+            while (end >= step) {
+                const size_t i = end - step;
+                const __m128i bf = ops::cmpeq(_mm_loadu_si128(reinterpret_cast<const __m128i *>(h + i)), first);
+                const __m128i bl = ops::cmpeq(_mm_loadu_si128(reinterpret_cast<const __m128i *>(h + i + m - 1)), last);
+                unsigned mask = static_cast<unsigned>(_mm_movemask_epi8(_mm_and_si128(bf, bl)));
+                while (mask != 0) {
+                    const unsigned lane = (31u - static_cast<unsigned>(__builtin_clz(mask))) / sizeof(T);
+                    const size_t idx = i + lane;
+                    if (std::memcmp(h + idx + 1, nd + 1, (m - 2) * sizeof(T)) == 0) {
+                        return idx;
+                    }
+                    mask &= ~(lane_mask << (lane * sizeof(T)));
+                    ++false_hits;
+                }
+                if (too_many_false_hits(false_hits, n - i)) {
+                    /* 在前缀 [0, end + m - 1) 中反向查找 */
+                    typedef tinySTL::reverse_iterator<const T *> riter;
+                    const size_t len = end + m - 1;
+                    const size_t r = two_way_search(riter(h + len), len, riter(nd + m), m);
+                    return r == len ? n : len - r - m;
+                }
+                end = i;
+            }
+            while (end != 0) {
+                --end;
+                if (h[end] == nd[0] && equal_n(h + end + 1, nd + 1, m - 1)) {
+                    return end;
+                }
+            }
+            return n;
+        }
+
+        template<typename T>
+        __attribute__((target("avx2")))
+        size_t avx2_rsearch_short(const T *h, size_t n, const T *nd, size_t m) {
+            typedef simd::avx2_ops<sizeof(T)> ops;
+            const size_t step = 32 / sizeof(T);
+            const unsigned lane_mask = (1u << sizeof(T)) - 1;
+            const __m256i first = ops::set1(simd::to_lane(nd[0]));
+            const __m256i last = ops::set1(simd::to_lane(nd[m - 1]));
+            size_t end = n - m + 1;
+            size_t false_hits = 0;
+            while (end >= step) {
+                const size_t i = end - step;
+                const __m256i bf = ops::cmpeq(_mm256_loadu_si256(reinterpret_cast<const __m256i *>(h + i)), first);
+                const __m256i bl = ops::cmpeq(_mm256_loadu_si256(reinterpret_cast<const __m256i *>(h + i + m - 1)),
+                                              last);
+                unsigned mask = static_cast<unsigned>(_mm256_movemask_epi8(_mm256_and_si256(bf, bl)));
+                while (mask != 0) {
+                    const unsigned lane = (31u - static_cast<unsigned>(__builtin_clz(mask))) / sizeof(T);
+                    const size_t idx = i + lane;
+                    if (std::memcmp(h + idx + 1, nd + 1, (m - 2) * sizeof(T)) == 0) {
+                        return idx;
+                    }
+                    mask &= ~(lane_mask << (lane * sizeof(T)));
+                    ++false_hits;
+                }
+                if (too_many_false_hits(false_hits, n - i)) {
+                    typedef tinySTL::reverse_iterator<const T *> riter;
+                    const size_t len = end + m - 1;
+                    const size_t r = two_way_search(riter(h + len), len, riter(nd + m), m);
+                    return r == len ? n : len - r - m;
+                }
+                end = i;
+            }
+            /* 剩余不足一个块的部分交给 SSE2 版本，它只会看前缀 [0, end + m - 1) */
+            if (end == 0) {
+                return n;
+            }
+            const size_t r = sse2_rsearch_short(h, end + m - 1, nd, m);
+            return r == end + m - 1 ? n : r;
+        }
+
+#endif // TINYSTL_SIMD_X86
+
+        /*
+         * 是否可以使用 SIMD 筛选：字符必须是宽度为 1、2、4 字节的整数类型
+         */
+        template<typename T>
+        struct simd_searchable {
+            static constexpr bool value = std::is_integral<T>::value &&
+                                          (sizeof(T) == 1 || sizeof(T) == 2 || sizeof(T) == 4);
+        };
+
+        template<typename T>
+        inline size_t search_short(const T *h, size_t n, const T *nd, size_t m, tinySTL::m_true_type) {
+#if TINYSTL_SIMD_X86
+            return simd::cpu_has_avx2() ? avx2_search_short(h, n, nd, m) : sse2_search_short(h, n, nd, m);
+#else
+            return two_way_search(h, n, nd, m);
+#endif
+        }
+
+        template<typename T>
+        inline size_t search_short(const T *h, size_t n, const T *nd, size_t m, tinySTL::m_false_type) {
+            return two_way_search(h, n, nd, m);
+        }
+
+        template<typename T>
+        inline size_t rsearch_short(const T *h, size_t n, const T *nd, size_t m, tinySTL::m_true_type) {
+#if TINYSTL_SIMD_X86
+            return simd::cpu_has_avx2() ? avx2_rsearch_short(h, n, nd, m) : sse2_rsearch_short(h, n, nd, m);
+#else
+            typedef tinySTL::reverse_iterator<const T *> riter;
+            const size_t r = two_way_search(riter(h + n), n, riter(nd + m), m);
+            return r == n ? n : n - r - m;
+#endif
+        }
+
+        template<typename T>
+        inline size_t rsearch_short(const T *h, size_t n, const T *nd, size_t m, tinySTL::m_false_type) {
+            typedef tinySTL::reverse_iterator<const T *> riter;
+            const size_t r = two_way_search(riter(h + n), n, riter(nd + m), m);
+            return r == n ? n : n - r - m;
+        }
+
+    } // namespace str_algo_detail
+
+    // ===========================================================================================
+    /*
+     * 在 [h, h + n) 中查找子串 [nd, nd + m) 第一次出现的位置
+     * 找到时返回指向该位置的指针，找不到时返回 nullptr，空的模式串匹配 h
+     */
+    template<typename T>
+    const T *string_search(const T *h, size_t n, const T *nd, size_t m) {
+        if (m == 0) {
+            return h;
+        }
+        if (m > n) {
+            return nullptr;
+        }
+        size_t r;
+        if (m == 1) {
+            for (r = 0; r != n && !(h[r] == nd[0]); ++r) {}
+        } else if (m <= str_algo_detail::kShortNeedleSize) {
+            r = str_algo_detail::search_short(h, n, nd, m, tinySTL::m_bool_constant<
+                    str_algo_detail::simd_searchable<T>::value>());
+        } else {
+            r = str_algo_detail::two_way_search(h, n, nd, m);
+        }
+        return r == n ? nullptr : h + r;
+    }
+
+    /*
+     * 在 [h, h + n) 中查找子串 [nd, nd + m) 最后一次出现的位置
+     * 找到时返回指向该位置的指针，找不到时返回 nullptr，空的模式串匹配 h + n
+     */
+    template<typename T>
+    const T *string_rsearch(const T *h, size_t n, const T *nd, size_t m) {
+        if (m == 0) {
+            return h + n;
+        }
+        if (m > n) {
+            return nullptr;
+        }
+        size_t r;
+        if (m == 1) {
+            for (r = n; r != 0 && !(h[r - 1] == nd[0]); --r) {}
+            r = r == 0 ? n : r - 1;
+        } else if (m <= str_algo_detail::kShortNeedleSize) {
+            r = str_algo_detail::rsearch_short(h, n, nd, m, tinySTL::m_bool_constant<
+                    str_algo_detail::simd_searchable<T>::value>());
+        } else {
+            typedef tinySTL::reverse_iterator<const T *> riter;
+            r = str_algo_detail::two_way_search(riter(h + n), n, riter(nd + m), m);
+            r = r == n ? n : n - r - m;
+        }
+        return r == n ? nullptr : h + r;
+    }
+
+
+    // ===========================================================================================
+    /*
+     * 模板类 char_set
+     * 字符集合，用于 find_first_of 一类的查找以及按分隔符切分字符串
+     * 值小于 256 的字符记录在 256 位的位图中，每个字符 O(1) 判断是否属于集合；
+     * 宽字符集合中大于等于 256 的字符保留指向原集合的指针逐个比较，此时原集合需要在 char_set 的生命周期内有效
+     * 单字节字符在运行时支持 AVX2 时，使用按半字节查表(vpshufb)的方法一次判断 32 个字符
+     */
+    template<typename T>
+    class char_set {
+    public:
+        typedef typename std::make_unsigned<T>::type unsigned_type;
+
+    private:
+        uint64_t bits_[4];
+        unsigned char lo_table_[16];  // 高半字节为 0~7 时，低半字节对应的高半字节位图
+        unsigned char hi_table_[16];  // 高半字节为 8~15 时，低半字节对应的高半字节位图
+        const T *wide_;  // 原集合，仅在集合中含有大于等于 256 的字符时使用
+        size_t wide_n_;
+
+    public:
+        char_set(const T *s, size_t n) noexcept;
+
+        /*
+         * 字符 ch 是否属于集合
+         */
+        bool contains(T ch) const noexcept {
+            const unsigned_type u = static_cast<unsigned_type>(ch);
+            if (u < 256) {
+                return ((bits_[u >> 6] >> (u & 63)) & 1) != 0;
+            }
+            for (size_t i = 0; i != wide_n_; ++i) {
+                if (wide_[i] == ch) {
+                    return true;
+                }
+            }
+            return false;
+        }
+
+        /*
+         * 返回 [s, s + n) 中第一个属于(negate 为 true 时为不属于)集合的字符的下标，找不到时返回 n
+         */
+        size_t find_first(const T *s, size_t n, bool negate = false) const noexcept;
+
+        /*
+         * 返回 [s, s + n) 中最后一个属于(negate 为 true 时为不属于)集合的字符的下标，找不到时返回 n
+         */
+        size_t find_last(const T *s, size_t n, bool negate = false) const noexcept;
+
+    private:
+        size_t scalar_find_first(const T *s, size_t n, bool negate) const noexcept {
+            for (size_t i = 0; i != n; ++i) {
+                if (contains(s[i]) != negate) {
+                    return i;
+                }
+            }
+            return n;
+        }
+
+        size_t scalar_find_last(const T *s, size_t n, bool negate) const noexcept {
+            for (size_t i = n; i != 0; --i) {
+                if (contains(s[i - 1]) != negate) {
+                    return i - 1;
+                }
+            }
+            return n;
+        }
+
+        size_t vector_find_first(const T *s, size_t n, bool negate, tinySTL::m_true_type) const noexcept;
+
+        size_t vector_find_first(const T *s, size_t n, bool negate, tinySTL::m_false_type) const noexcept {
+            return scalar_find_first(s, n, negate);
+        }
+
+        size_t vector_find_last(const T *s, size_t n, bool negate, tinySTL::m_true_type) const noexcept;
+
+        size_t vector_find_last(const T *s, size_t n, bool negate, tinySTL::m_false_type) const noexcept {
+            return scalar_find_last(s, n, negate);
+        }
+
+#if TINYSTL_SIMD_X86
+
+        /*
+         * 对 32 个字节分类，返回属于集合的字节的掩码
+         * lo = x & 0xF, hi = x >> 4，位图中对应的行为 table[lo]，列为 1 << (hi & 7)，
+         * x 的最高位即 hi >= 8，用它在两张表之间选择
+         */
+        __attribute__((target("avx2")))
+        static unsigned avx2_classify(__m256i x, __m256i lo_table, __m256i hi_table, __m256i bit_table) noexcept {
+            const __m256i nibble = _mm256_set1_epi8(0x0F);
+            const __m256i lo = _mm256_and_si256(x, nibble);
+            const __m256i hi = _mm256_and_si256(_mm256_srli_epi16(x, 4), nibble);
+            const __m256i row = _mm256_blendv_epi8(_mm256_shuffle_epi8(lo_table, lo),
+                                                   _mm256_shuffle_epi8(hi_table, lo), x);
+            const __m256i bit = _mm256_shuffle_epi8(bit_table, hi);
+            return static_cast<unsigned>(_mm256_movemask_epi8(
+                    _mm256_cmpeq_epi8(_mm256_and_si256(row, bit), bit)));
+        }
+
+        __attribute__((target("avx2")))
+        size_t avx2_find_first(const T *s, size_t n, bool negate) const noexcept;
+
+        __attribute__((target("avx2")))
+        size_t avx2_find_last(const T *s, size_t n, bool negate) const noexcept;
+
+#endif // TINYSTL_SIMD_X86
+    };
+
+    template<typename T>
+    char_set<T>::char_set(const T *s, size_t n) noexcept
+            : bits_{0, 0, 0, 0}, lo_table_{}, hi_table_{}, wide_(nullptr), wide_n_(0) {
+        for (size_t i = 0; i != n; ++i) {
+            const unsigned_type u = static_cast<unsigned_type>(s[i]);
+            if (u < 256) {
+                bits_[u >> 6] |= static_cast<uint64_t>(1) << (u & 63);
+                const unsigned lo = u & 0x0F, hi = u >> 4;
+                if (hi < 8) {
+                    lo_table_[lo] |= static_cast<unsigned char>(1u << hi);
+                } else {
+                    hi_table_[lo] |= static_cast<unsigned char>(1u << (hi - 8));
+                }
+            } else {
+                wide_ = s;
+                wide_n_ = n;
+            }
+        }
+    }
+
+    template<typename T>
+    size_t char_set<T>::find_first(const T *s, size_t n, bool negate) const noexcept {
+        return vector_find_first(s, n, negate, tinySTL::m_bool_constant<
+                sizeof(T) == 1 && std::is_integral<T>::value>());
+    }
+
+    template<typename T>
+    size_t char_set<T>::find_last(const T *s, size_t n, bool negate) const noexcept {
+        return vector_find_last(s, n, negate, tinySTL::m_bool_constant<
+                sizeof(T) == 1 && std::is_integral<T>::value>());
+    }
+
+    template<typename T>
+    size_t char_set<T>::vector_find_first(const T *s, size_t n, bool negate, tinySTL::m_true_type) const noexcept {
+#if TINYSTL_SIMD_X86
+        if (n >= 32 && simd::cpu_has_avx2()) {
+            return avx2_find_first(s, n, negate);
+        }
+#endif
+        return scalar_find_first(s, n, negate);
+    }
+
+    template<typename T>
+    size_t char_set<T>::vector_find_last(const T *s, size_t n, bool negate, tinySTL::m_true_type) const noexcept {
+#if TINYSTL_SIMD_X86
+        if (n >= 32 && simd::cpu_has_avx2()) {
+            return avx2_find_last(s, n, negate);
+        }
+#endif
+        return scalar_find_last(s, n, negate);
+    }
+
+#if TINYSTL_SIMD_X86
+
+    template<typename T>
+    __attribute__((target("avx2")))
+    size_t char_set<T>::avx2_find_first(const T *s, size_t n, bool negate) const noexcept {
+        const __m128i lo128 = _mm_loadu_si128(reinterpret_cast<const __m128i *>(lo_table_));
+        const __m128i hi128 = _mm_loadu_si128(reinterpret_cast<const __m128i *>(hi_table_));
+        const __m256i lo_table = _mm256_broadcastsi128_si256(lo128);
+        const __m256i hi_table = _mm256_broadcastsi128_si256(hi128);
+        const __m256i bit_table = _mm256_setr_epi8(1, 2, 4, 8, 16, 32, 64, -128, 1, 2, 4, 8, 16, 32, 64, -128,
+                                                   1, 2, 4, 8, 16, 32, 64, -128, 1, 2, 4, 8, 16, 32, 64, -128);
+        const unsigned flip = negate ? 0xFFFFFFFFu : 0u;
+        size_t i = 0;
+        for (; i + 32 <= n; i += 32) {
+            const __m256i x = _mm256_loadu_si256(reinterpret_cast<const __m256i *>(s + i));
+            const unsigned mask = avx2_classify(x, lo_table, hi_table, bit_table) ^ flip;
+            if (mask != 0) {
+                return i + simd::lowest_bit(mask);
+            }
+        }
+        const size_t r = scalar_find_first(s + i, n - i, negate);
+        return i + r;
+    }
+
+    template<typename T>
+    __attribute__((target("avx2")))
+    size_t char_set<T>::avx2_find_last(const T *s, size_t n, bool negate) const noexcept {
+        const __m128i lo128 = _mm_loadu_si128(reinterpret_cast<const __m128i *>(lo_table_));
+        const __m128i hi128 = _mm_loadu_si128(reinterpret_cast<const __m128i *>(hi_table_));
+        const __m256i lo_table = _mm256_broadcastsi128_si256(lo128);
+        const __m256i hi_table = _mm256_broadcastsi128_si256(hi128);
+        const __m256i bit_table = _mm256_setr_epi8(1, 2, 4, 8, 16, 32, 64, -128, 1, 2, 4, 8, 16, 32, 64, -128,
+                                                   1, 2, 4, 8, 16, 32, 64, -128, 1, 2, 4, 8, 16, 32, 64, -128);
+        const unsigned flip = negate ? 0xFFFFFFFFu : 0u;
+        size_t end = n;
+        for (; end >= 32; end -= 32) {
+            const __m256i x = _mm256_loadu_si256(reinterpret_cast<const __m256i *>(s + end - 32));
+            const unsigned mask = avx2_classify(x, lo_table, hi_table, bit_table) ^ flip;
+            if (mask != 0) {
+                return end - 32 + (31u - static_cast<unsigned>(__builtin_clz(mask)));
+            }
+        }
+        const size_t r = scalar_find_last(s, end, negate);
+        return r == end ? n : r;
+    }
+
+#endif // TINYSTL_SIMD_X86
+
+    // ===========================================================================================
+    /*
+     * 在 [s, s + n) 中查找第一个属于字符集合 [set, set + m) 的字符，返回其下标，找不到时返回 n
+     */
+    template<typename T>
+    size_t string_find_first_of(const T *s, size_t n, const T *set, size_t m) {
+        if (m == 1) {
+            size_t i = 0;
+            for (; i != n && !(s[i] == set[0]); ++i) {}
+            return i;
+        }
+        return char_set<T>(set, m).find_first(s, n);
+    }
+
+    /*
+     * 在 [s, s + n) 中查找第一个不属于字符集合 [set, set + m) 的字符，返回其下标，找不到时返回 n
+     */
+    template<typename T>
+    size_t string_find_first_not_of(const T *s, size_t n, const T *set, size_t m) {
+        if (m == 1) {
+            size_t i = 0;
+            for (; i != n && s[i] == set[0]; ++i) {}
+            return i;
+        }
+        return char_set<T>(set, m).find_first(s, n, true);
+    }
+
+    /*
+     * 在 [s, s + n) 中查找最后一个属于字符集合 [set, set + m) 的字符，返回其下标，找不到时返回 n
+     */
+    template<typename T>
+    size_t string_find_last_of(const T *s, size_t n, const T *set, size_t m) {
+        if (m == 1) {
+            for (size_t i = n; i != 0; --i) {
+                if (s[i - 1] == set[0]) {
+                    return i - 1;
+                }
+            }
+            return n;
+        }
+        return char_set<T>(set, m).find_last(s, n);
+    }
+
+    /*
+     * 在 [s, s + n) 中查找最后一个不属于字符集合 [set, set + m) 的字符，返回其下标，找不到时返回 n
+     */
+    template<typename T>
+    size_t string_find_last_not_of(const T *s, size_t n, const T *set, size_t m) {
+        if (m == 1) {
+            for (size_t i = n; i != 0; --i) {
+                if (!(s[i - 1] == set[0])) {
+                    return i - 1;
+                }
+            }
+            return n;
+        }
+        return char_set<T>(set, m).find_last(s, n, true);
+    }
+
+} // namespace tinySTL
+
+#endif //TINYSTL_STR_ALGO_H
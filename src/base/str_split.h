@@ -0,0 +1,400 @@
+//
+// Created by cqupt1811 on 2022/5/24.
+//
+
+/*
+ * 这个头文件包含按分隔符切分字符串的惰性区间，切分的结果是指向原字符序列的 basic_string_view，不分配内存
+ * split()    按单个字符或一个子串切分，保留空字段："a,,b" 得到 "a"、""、"b"，空串得到一个空字段
+ * tokenize() 按字符集合切分，跳过连续的分隔符，只得到非空的单词
+ * split_n()  把最多 n 个字段写入调用者提供的数组，第 n 个字段包含剩余的全部内容
+ * 查找单个字符使用 char_traits::find，查找子串使用 string_search，字符集合使用 char_set，都带有向量化的实现
+ * 区间与迭代器都不拥有字符序列，使用者需要保证遍历期间原字符串有效且没有被修改
+ */
+
+#ifndef TINYSTL_STR_SPLIT_H
+#define TINYSTL_STR_SPLIT_H
+
+#include <cstddef>  /* 定义了 size_t 等常用类型 */
+#include "iterator.h"  /* 这个头文件用于迭代器设计，包含了一些模板结构体与全局函数 */
+#include "str_algo.h"  /* 这个头文件包含字符串的子串查找算法 */
+#include "string_view.h"  /* 这个头文件包含一个模板类 basic_string_view，用于表示不拥有内存的字符串视图 */
+#include "basic_string.h"  /* 这个头文件包含一个模板类 basic_string,用于表示字符串类型 */
+
+/* 首先定义自己的命名空间 */
+namespace tinySTL {
+
+    namespace split_detail {
+
+        /*
+         * 阻止模板参数推导，使分隔符参数可以由 const CharType * 隐式转换为 basic_string_view
+         */
+        template<typename T>
+        struct non_deduced {
+            typedef T type;
+        };
+
+        /*
+         * 单个字符的分隔符
+         */
+        template<typename CharType, typename CharTraits>
+        struct char_delimiter {
+            CharType ch;
+
+            // 返回值：[s, s + n) 中第一个分隔符的下标，找不到时返回 n
+            size_t find(const CharType *s, size_t n) const noexcept {
+                const CharType *p = CharTraits::find(s, n, ch);
+                return p == nullptr ? n : static_cast<size_t>(p - s);
+            }
+
+            // 返回值：分隔符的长度
+            size_t size() const noexcept {
+                return 1;
+            }
+        };
+
+        /*
+         * 子串分隔符，空的子串不匹配任何位置，整个字符串作为一个字段
+         */
+        template<typename CharType, typename CharTraits>
+        struct string_delimiter {
+            const CharType *str;
+            size_t len;
+
+            // 返回值：[s, s + n) 中第一个分隔符的下标，找不到时返回 n
+            size_t find(const CharType *s, size_t n) const {
+                if (len == 0) {
+                    return n;
+                }
+                const CharType *p = tinySTL::string_search(s, n, str, len);
+                return p == nullptr ? n : static_cast<size_t>(p - s);
+            }
+
+            // 返回值：分隔符的长度
+            size_t size() const noexcept {
+                return len;
+            }
+        };
+
+    }  // namespace split_detail
+
+    // ===========================================================================================
+    /*
+     * 模板类 split_range
+     * 按分隔符 Delimiter 切分字符串的惰性区间，每次递增迭代器时才查找下一个分隔符
+     * 迭代器指向所属的区间，区间需要在遍历期间有效
+     */
+    template<typename CharType, typename CharTraits, typename Delimiter>
+    class split_range {
+    public:
+        typedef tinySTL::basic_string_view<CharType, CharTraits> view_type;
+
+        class iterator {
+        public:
+            typedef tinySTL::forward_iterator_tag iterator_category;
+            typedef view_type value_type;
+            typedef ptrdiff_t difference_type;
+            typedef const view_type *pointer;
+            typedef const view_type &reference;
+
+            /* 默认构造的迭代器即 end 迭代器 */
+            iterator() : range_(nullptr), field_(), last_(true) {
+            }
+
+            explicit iterator(const split_range *range) : range_(range), field_(), last_(false) {
+                next_field(range->str_.data());
+            }
+
+            reference operator*() const {
+                TINYSTL_DEBUG(range_ != nullptr);
+                return field_;
+            }
+
+            pointer operator->() const {
+                return &field_;
+            }
+
+            iterator &operator++() {
+                TINYSTL_DEBUG(range_ != nullptr);
+                if (last_) {
+                    range_ = nullptr;
+                    field_ = view_type();
+                } else {
+                    next_field(field_.data() + field_.size() + range_->delim_.size());
+                }
+                return *this;
+            }
+
+            iterator operator++(int) {
+                iterator temp = *this;
+                ++*this;
+                return temp;
+            }
+
+            /* 分隔符长度至少为 1，不同字段的起始位置一定不同 */
+            bool operator==(const iterator &rhs) const {
+                return range_ == rhs.range_ && field_.data() == rhs.field_.data();
+            }
+
+            bool operator!=(const iterator &rhs) const {
+                return !(*this == rhs);
+            }
+
+        private:
+            /* 从 first 开始查找下一个分隔符，没有找到时这是最后一个字段 */
+            void next_field(const CharType *first) {
+                const size_t rest = static_cast<size_t>(range_->str_.data() + range_->str_.size() - first);
+                const size_t pos = range_->delim_.find(first, rest);
+                field_ = view_type(first, pos);
+                last_ = pos == rest;
+            }
+
+            const split_range *range_;
+            view_type field_;
+            bool last_;
+        };
+
+        typedef iterator const_iterator;
+
+    private:
+        view_type str_;
+        Delimiter delim_;
+
+    public:
+        split_range(view_type str, Delimiter delim) noexcept: str_(str), delim_(delim) {
+        }
+
+        iterator begin() const {
+            return iterator(this);
+        }
+
+        iterator end() const {
+            return iterator();
+        }
+    };
+
+    // ===========================================================================================
+    /*
+     * 模板类 token_range
+     * 按字符集合切分字符串的惰性区间，连续的分隔符视为一个，首尾的分隔符被忽略
+     * 集合中含有大于等于 256 的宽字符时，char_set 保留指向原集合的指针，原集合也需要在遍历期间有效
+     */
+    template<typename CharType, typename CharTraits>
+    class token_range {
+    public:
+        typedef tinySTL::basic_string_view<CharType, CharTraits> view_type;
+
+        class iterator {
+        public:
+            typedef tinySTL::forward_iterator_tag iterator_category;
+            typedef view_type value_type;
+            typedef ptrdiff_t difference_type;
+            typedef const view_type *pointer;
+            typedef const view_type &reference;
+
+            iterator() : range_(nullptr), token_() {
+            }
+
+            explicit iterator(const token_range *range) : range_(range), token_() {
+                next_token(range->str_.data());
+            }
+
+            reference operator*() const {
+                TINYSTL_DEBUG(range_ != nullptr);
+                return token_;
+            }
+
+            pointer operator->() const {
+                return &token_;
+            }
+
+            iterator &operator++() {
+                TINYSTL_DEBUG(range_ != nullptr);
+                next_token(token_.data() + token_.size());
+                return *this;
+            }
+
+            iterator operator++(int) {
+                iterator temp = *this;
+                ++*this;
+                return temp;
+            }
+
+            bool operator==(const iterator &rhs) const {
+                return range_ == rhs.range_ && token_.data() == rhs.token_.data();
+            }
+
+            bool operator!=(const iterator &rhs) const {
+                return !(*this == rhs);
+            }
+
+        private:
+            /* 先跳过分隔符，再查找单词的末尾，没有剩余的单词时成为 end 迭代器 */
+            void next_token(const CharType *first) {
+                const CharType *last = range_->str_.data() + range_->str_.size();
+                size_t rest = static_cast<size_t>(last - first);
+                const size_t skip = range_->set_.find_first(first, rest, true);
+                if (skip == rest) {
+                    range_ = nullptr;
+                    token_ = view_type();
+                    return;
+                }
+                first += skip;
+                rest -= skip;
+                token_ = view_type(first, range_->set_.find_first(first, rest));
+            }
+
+            const token_range *range_;
+            view_type token_;
+        };
+
+        typedef iterator const_iterator;
+
+    private:
+        view_type str_;
+        tinySTL::char_set<CharType> set_;
+
+    public:
+        token_range(view_type str, view_type set) noexcept: str_(str), set_(set.data(), set.size()) {
+        }
+
+        iterator begin() const {
+            return iterator(this);
+        }
+
+        iterator end() const {
+            return iterator();
+        }
+    };
+
+    // ===========================================================================================
+    // split：按单个字符或子串切分，结果指向原字符串，临时的 basic_string 不能切分
+
+    template<typename CharType, typename CharTraits>
+    split_range<CharType, CharTraits, split_detail::char_delimiter<CharType, CharTraits>>  // 返回值
+    split(basic_string_view<CharType, CharTraits> str, typename basic_string_view<CharType, CharTraits>::value_type delim) {
+        return {str, {delim}};
+    }
+
+    template<typename CharType, typename CharTraits>
+    split_range<CharType, CharTraits, split_detail::string_delimiter<CharType, CharTraits>>  // 返回值
+    split(basic_string_view<CharType, CharTraits> str,
+          typename split_detail::non_deduced<basic_string_view<CharType, CharTraits>>::type delim) {
+        return {str, {delim.data(), delim.size()}};
+    }
+
+    template<typename CharType, typename CharTraits>
+    split_range<CharType, CharTraits, split_detail::char_delimiter<CharType, CharTraits>>  // 返回值
+    split(const basic_string<CharType, CharTraits> &str, typename basic_string<CharType, CharTraits>::value_type delim) {
+        return tinySTL::split(basic_string_view<CharType, CharTraits>(str.data(), str.size()), delim);
+    }
+
+    template<typename CharType, typename CharTraits>
+    split_range<CharType, CharTraits, split_detail::string_delimiter<CharType, CharTraits>>  // 返回值
+    split(const basic_string<CharType, CharTraits> &str,
+          typename split_detail::non_deduced<basic_string_view<CharType, CharTraits>>::type delim) {
+        return tinySTL::split(basic_string_view<CharType, CharTraits>(str.data(), str.size()), delim);
+    }
+
+    template<typename CharType, typename CharTraits, typename Delim>
+    void split(basic_string<CharType, CharTraits> &&str, const Delim &delim) = delete;
+
+    // ===========================================================================================
+    // tokenize：按字符集合切分，只得到非空的单词
+
+    template<typename CharType, typename CharTraits>
+    token_range<CharType, CharTraits>  // 返回值
+    tokenize(basic_string_view<CharType, CharTraits> str,
+             typename split_detail::non_deduced<basic_string_view<CharType, CharTraits>>::type set) {
+        return {str, set};
+    }
+
+    template<typename CharType, typename CharTraits>
+    token_range<CharType, CharTraits>  // 返回值
+    tokenize(const basic_string<CharType, CharTraits> &str,
+             typename split_detail::non_deduced<basic_string_view<CharType, CharTraits>>::type set) {
+        return tinySTL::tokenize(basic_string_view<CharType, CharTraits>(str.data(), str.size()), set);
+    }
+
+    template<typename CharType, typename CharTraits, typename Set>
+    void tokenize(basic_string<CharType, CharTraits> &&str, const Set &set) = delete;
+
+    // ===========================================================================================
+    // split_n：把最多 n 个字段依次写入 out，字段多于 n 个时第 n 个字段包含剩余的全部内容(含其中的分隔符)
+    // out 可以是 basic_string_view 的数组或任意输出迭代器，整个过程不分配内存
+
+    namespace split_detail {
+
+        template<typename CharType, typename CharTraits, typename Delimiter, typename OutputIter>
+        size_t split_n(basic_string_view<CharType, CharTraits> str, const Delimiter &delim, OutputIter out, size_t n) {
+            typedef basic_string_view<CharType, CharTraits> view_type;
+            if (n == 0) {
+                return 0;
+            }
+            const CharType *first = str.data();
+            size_t rest = str.size();
+            size_t count = 1;
+            for (; count < n; ++count) {
+                const size_t pos = delim.find(first, rest);
+                if (pos == rest) {
+                    break;
+                }
+                *out = view_type(first, pos);
+                ++out;
+                first += pos + delim.size();
+                rest -= pos + delim.size();
+            }
+            *out = view_type(first, rest);
+            return count;
+        }
+
+    }  // namespace split_detail
+
+    // 返回值：写入的字段个数
+    template<typename CharType, typename CharTraits, typename OutputIter>
+    size_t split_n(basic_string_view<CharType, CharTraits> str,
+                   typename basic_string_view<CharType, CharTraits>::value_type delim, OutputIter out, size_t n) {
+        return split_detail::split_n(str, split_detail::char_delimiter<CharType, CharTraits>{delim}, out, n);
+    }
+
+    // 返回值：写入的字段个数
+    template<typename CharType, typename CharTraits, typename OutputIter>
+    size_t split_n(basic_string_view<CharType, CharTraits> str,
+                   typename split_detail::non_deduced<basic_string_view<CharType, CharTraits>>::type delim,
+                   OutputIter out, size_t n) {
+        return split_detail::split_n(str, split_detail::string_delimiter<CharType, CharTraits>{
+                delim.data(), delim.size()}, out, n);
+    }
+
+    // 返回值：写入的字段个数
+    template<typename CharType, typename CharTraits, typename OutputIter>
+    size_t split_n(const basic_string<CharType, CharTraits> &str,
+                   typename basic_string<CharType, CharTraits>::value_type delim, OutputIter out, size_t n) {
+        return tinySTL::split_n(basic_string_view<CharType, CharTraits>(str.data(), str.size()), delim, out, n);
+    }
+
+    // 返回值：写入的字段个数
+    template<typename CharType, typename CharTraits, typename OutputIter>
+    size_t split_n(const basic_string<CharType, CharTraits> &str,
+                   typename split_detail::non_deduced<basic_string_view<CharType, CharTraits>>::type delim,
+                   OutputIter out, size_t n) {
+        return tinySTL::split_n(basic_string_view<CharType, CharTraits>(str.data(), str.size()), delim, out, n);
+    }
+
+    /*
+     * 写入数组的版本，最多写入 N 个字段
+     */
+    template<typename CharType, typename CharTraits, typename Delim, size_t N>
+    size_t split_n(basic_string_view<CharType, CharTraits> str, const Delim &delim,
+                   basic_string_view<CharType, CharTraits> (&out)[N]) {
+        return tinySTL::split_n(str, delim, out + 0, N);
+    }
+
+    template<typename CharType, typename CharTraits, typename Delim, size_t N>
+    size_t split_n(const basic_string<CharType, CharTraits> &str, const Delim &delim,
+                   basic_string_view<CharType, CharTraits> (&out)[N]) {
+        return tinySTL::split_n(str, delim, out + 0, N);
+    }
+
+}  // namespace tinySTL
+
+#endif //TINYSTL_STR_SPLIT_H
@@ -0,0 +1,244 @@
+//
+// Created by cqupt1811 on 2022/5/23.
+//
+
+/*
+ * 这个头文件包含字符串与标准流之间的批量读写，供 basic_string、basic_string_view 与 rope 使用
+ * stream_write()     带宽度与填充的格式化输出，字符序列通过一次 sputn 写入 streambuf
+ * stream_read_word() 读入一个以空白分隔的单词
+ * stream_getline()   读入一行
+ * 读取时直接扫描 streambuf 的读缓冲区，一次追加一整段字符，而不是逐个字符地 sbumpc
+ */
+
+#ifndef TINYSTL_STREAM_IO_H
+#define TINYSTL_STREAM_IO_H
+
+#include <cstddef>  /* 定义了 size_t 等常用类型 */
+#include <ios>  /* ios_base */
+#include <istream>  /* basic_istream */
+#include <ostream>  /* basic_ostream */
+#include <streambuf>  /* basic_streambuf */
+#include <locale>  /* ctype */
+
+/* 首先定义自己的命名空间 */
+namespace tinySTL {
+
+    namespace stream_io_detail {
+
+        /*
+         * 读缓冲区的指针是 basic_streambuf 的保护成员，
+         * 通过派生类取得成员函数指针，再作用在任意 streambuf 上
+         */
+        template<typename CharType, typename Traits>
+        struct streambuf_access : public std::basic_streambuf<CharType, Traits> {
+            typedef std::basic_streambuf<CharType, Traits> base;
+
+            // 返回值：读缓冲区中下一个字符的位置
+            static CharType *get_ptr(base *sb) {
+                CharType *(base::*pm)() const = &streambuf_access::gptr;
+                return (sb->*pm)();
+            }
+
+            // 返回值：读缓冲区的末尾
+            static CharType *end_ptr(base *sb) {
+                CharType *(base::*pm)() const = &streambuf_access::egptr;
+                return (sb->*pm)();
+            }
+
+            /*
+             * 跳过读缓冲区中的 n 个字符
+             */
+            static void bump(base *sb, size_t n) {
+                void (base::*pm)(int) = &streambuf_access::gbump;
+                (sb->*pm)(static_cast<int>(n));
+            }
+        };
+
+    }  // namespace stream_io_detail
+
+    /*
+     * 输出 [s, s + n)，与 std::string 的 operator<< 相同：
+     * 按 os.width() 与 adjustfield 用 os.fill() 补齐，完成后把宽度重置为 0
+     */
+    template<typename CharType, typename Traits>
+    std::basic_ostream<CharType, Traits> &  // 返回值
+    stream_write(std::basic_ostream<CharType, Traits> &os, const CharType *s, size_t n) {
+        typename std::basic_ostream<CharType, Traits>::sentry guard(os);
+        if (!guard) {
+            return os;
+        }
+        std::basic_streambuf<CharType, Traits> *sb = os.rdbuf();
+        const size_t width = os.width() > 0 ? static_cast<size_t>(os.width()) : 0;
+        const size_t pad = width > n ? width - n : 0;
+        const bool left = (os.flags() & std::ios_base::adjustfield) == std::ios_base::left;
+        bool ok = true;
+        try {
+            const CharType fill = os.fill();
+            if (!left) {
+                for (size_t i = 0; ok && i < pad; ++i) {
+                    ok = !Traits::eq_int_type(sb->sputc(fill), Traits::eof());
+                }
+            }
+            ok = ok && static_cast<size_t>(sb->sputn(s, static_cast<std::streamsize>(n))) == n;
+            if (left) {
+                for (size_t i = 0; ok && i < pad; ++i) {
+                    ok = !Traits::eq_int_type(sb->sputc(fill), Traits::eof());
+                }
+            }
+        }
+        catch (...) {
+            ok = false;
+        }
+        os.width(0);
+        if (!ok) {
+            os.setstate(std::ios_base::badbit);
+        }
+        return os;
+    }
+
+    /*
+     * 跳过前导空白后读入一个单词到 str，与 std::string 的 operator>> 相同：
+     * os.width() 大于 0 时最多读入 width 个字符，没有读到任何字符时设置 failbit
+     * Str 需要提供 clear()、append(const CharType *, size_t)、push_back() 与 max_size()
+     */
+    template<typename CharType, typename Traits, typename Str>
+    std::basic_istream<CharType, Traits> &  // 返回值
+    stream_read_word(std::basic_istream<CharType, Traits> &is, Str &str) {
+        typedef stream_io_detail::streambuf_access<CharType, Traits> access;
+        typename std::basic_istream<CharType, Traits>::sentry guard(is, false);
+        if (!guard) {
+            is.setstate(std::ios_base::failbit);
+            return is;
+        }
+        str.clear();
+        const std::ctype<CharType> &ct = std::use_facet<std::ctype<CharType>>(is.getloc());
+        std::basic_streambuf<CharType, Traits> *sb = is.rdbuf();
+        const size_t limit = is.width() > 0 ? static_cast<size_t>(is.width()) : str.max_size();
+        std::ios_base::iostate state = std::ios_base::goodbit;
+        size_t extracted = 0;
+        try {
+            while (extracted < limit) {
+                CharType *g = access::get_ptr(sb);
+                CharType *e = access::end_ptr(sb);
+                if (g != e) {
+                    // 在读缓冲区中批量查找空白
+                    if (static_cast<size_t>(e - g) > limit - extracted) {
+                        e = g + (limit - extracted);
+                    }
+                    const CharType *stop = ct.scan_is(std::ctype_base::space, g, e);
+                    const size_t n = static_cast<size_t>(stop - g);
+                    str.append(g, n);
+                    access::bump(sb, n);
+                    extracted += n;
+                    if (stop != e) {
+                        break;
+                    }
+                    continue;
+                }
+                // 读缓冲区为空：补充缓冲区，没有缓冲区的 streambuf 只能逐个字符读取
+                const typename Traits::int_type c = sb->sgetc();
+                if (Traits::eq_int_type(c, Traits::eof())) {
+                    state |= std::ios_base::eofbit;
+                    break;
+                }
+                if (access::get_ptr(sb) != access::end_ptr(sb)) {
+                    continue;
+                }
+                const CharType ch = Traits::to_char_type(c);
+                if (ct.is(std::ctype_base::space, ch)) {
+                    break;
+                }
+                str.push_back(ch);
+                sb->sbumpc();
+                ++extracted;
+            }
+        }
+        catch (...) {
+            state |= std::ios_base::badbit;
+        }
+        is.width(0);
+        if (extracted == 0) {
+            state |= std::ios_base::failbit;
+        }
+        if (state != std::ios_base::goodbit) {
+            is.setstate(state);
+        }
+        return is;
+    }
+
+    /*
+     * 读入一行到 str，分隔符 delim 被读出但不存入 str
+     * 与 std::getline 相同：读到文件尾时设置 eofbit，什么都没有读到时设置 failbit，超过 max_size() 时设置 failbit
+     * 每次把读缓冲区中到分隔符为止的一整段追加到 str，str 的容量按倍数增长，多次调用时可以复用
+     */
+    template<typename CharType, typename Traits, typename Str>
+    std::basic_istream<CharType, Traits> &  // 返回值
+    stream_getline(std::basic_istream<CharType, Traits> &is, Str &str, CharType delim) {
+        typedef stream_io_detail::streambuf_access<CharType, Traits> access;
+        typename std::basic_istream<CharType, Traits>::sentry guard(is, true);
+        if (!guard) {
+            is.setstate(std::ios_base::failbit);
+            return is;
+        }
+        str.clear();
+        std::basic_streambuf<CharType, Traits> *sb = is.rdbuf();
+        const size_t limit = str.max_size();
+        std::ios_base::iostate state = std::ios_base::goodbit;
+        size_t extracted = 0;
+        try {
+            for (;;) {
+                CharType *g = access::get_ptr(sb);
+                CharType *e = access::end_ptr(sb);
+                if (g != e) {
+                    const CharType *hit = Traits::find(g, static_cast<size_t>(e - g), delim);
+                    const size_t n = static_cast<size_t>((hit != nullptr ? hit : e) - g);
+                    if (n > limit - str.size()) {
+                        state |= std::ios_base::failbit;
+                        break;
+                    }
+                    str.append(g, n);
+                    extracted += n;
+                    if (hit != nullptr) {
+                        access::bump(sb, n + 1);
+                        ++extracted;
+                        break;
+                    }
+                    access::bump(sb, n);
+                    continue;
+                }
+                const typename Traits::int_type c = sb->sgetc();
+                if (Traits::eq_int_type(c, Traits::eof())) {
+                    state |= std::ios_base::eofbit;
+                    break;
+                }
+                if (access::get_ptr(sb) != access::end_ptr(sb)) {
+                    continue;
+                }
+                sb->sbumpc();
+                ++extracted;
+                const CharType ch = Traits::to_char_type(c);
+                if (Traits::eq(ch, delim)) {
+                    break;
+                }
+                if (str.size() == limit) {
+                    state |= std::ios_base::failbit;
+                    break;
+                }
+                str.push_back(ch);
+            }
+        }
+        catch (...) {
+            state |= std::ios_base::badbit;
+        }
+        if (extracted == 0) {
+            state |= std::ios_base::failbit;
+        }
+        if (state != std::ios_base::goodbit) {
+            is.setstate(state);
+        }
+        return is;
+    }
+
+}  // namespace tinySTL
+
+#endif //TINYSTL_STREAM_IO_H
@@ -0,0 +1,486 @@
+//
+// Created by cqupt1811 on 2022/5/15.
+//
+
+/*
+ * 这个头文件包含一个模板类 basic_string_view
+ * 用于表示不拥有内存的字符串视图，只保存起始指针与长度，拷贝与 substr 都不会分配内存
+ * 查找与比较操作与 basic_string 共用 char_traits 与 str_algo.h 中的实现
+ */
+
+#ifndef TINYSTL_STRING_VIEW_H
+#define TINYSTL_STRING_VIEW_H
+
+#include <iostream>  /* c++的io库 */
+#include <cstddef>  /* 定义了 size_t 等常用类型 */
+#include "iterator.h"  /* 这个头文件用于迭代器设计，包含了一些模板结构体与全局函数 */
+#include "algobase.h"  /* 这个头文件包含了库中的一些基本算法 */
+#include "functional.h"  /* 这个头文件包含了 tinySTL 的函数对象与哈希函数 */
+#include "exceptdef.h"  /* 此文件中定义了异常相关的宏 */
+#include "char_traits.h"  /* 这个头文件包含一个模板类 char_traits，用于萃取不同字符类型的基本操作 */
+#include "str_algo.h"  /* 这个头文件包含字符串的子串查找算法 */
+#include "stream_io.h"  /* 这个头文件包含字符串与标准流之间的批量读写 */
+
+/* 首先定义自己的命名空间 */
+namespace tinySTL {
+
+    /*
+     * 模板类 basic_string_view
+     * 参数CharType代表字符类型,参数CharTraits代表萃取字符类型的方式,缺省使用tinySTL::char_traits
+     * 视图不拥有所指的字符序列，使用者需要保证视图的生命周期内字符序列有效
+     */
+    template<typename CharType, typename CharTraits=tinySTL::char_traits<CharType>>
+    class basic_string_view {
+    public:
+        /*
+         * 定义字符萃取器别名
+         */
+        typedef CharTraits traits_type;
+        typedef CharTraits char_traits;
+
+        /*
+         * 定义类中使用的类型别名
+         */
+        typedef CharType value_type;
+        typedef CharType *pointer;
+        typedef const CharType *const_pointer;
+        typedef CharType &reference;
+        typedef const CharType &const_reference;
+        typedef size_t size_type;
+        typedef ptrdiff_t difference_type;
+
+        /*
+         * 视图只能读取，iterator 与 const_iterator 相同
+         */
+        typedef const_pointer iterator;
+        typedef const_pointer const_iterator;
+        typedef tinySTL::reverse_iterator<const_iterator> reverse_iterator;
+        typedef tinySTL::reverse_iterator<const_iterator> const_reverse_iterator;
+
+        static_assert(std::is_same<CharType, typename traits_type::char_type>::value,
+                      "CharType must be same as traits_type::char_type");
+
+        static constexpr size_type npos = static_cast<size_type>(-1);
+
+    private:
+        /*
+         * data_: 字符序列的起始位置
+         * size_: 字符序列的长度
+         */
+        const_pointer data_;
+        size_type size_;
+
+    public:
+        /*
+         * 构造函数，视图可以按值传递，拷贝构造与赋值使用默认版本
+         */
+        constexpr basic_string_view() noexcept: data_(nullptr), size_(0) {}
+
+        constexpr basic_string_view(const_pointer str, size_type count) noexcept: data_(str), size_(count) {}
+
+        basic_string_view(const_pointer str) : data_(str), size_(char_traits::length(str)) {}
+
+        constexpr basic_string_view(const basic_string_view &rhs) noexcept = default;
+
+        basic_string_view &operator=(const basic_string_view &rhs) noexcept = default;
+
+    public:
+        /*
+         * 迭代器相关操作
+         */
+        constexpr const_iterator begin() const noexcept { return data_; }
+
+        constexpr const_iterator end() const noexcept { return data_ + size_; }
+
+        constexpr const_iterator cbegin() const noexcept { return data_; }
+
+        constexpr const_iterator cend() const noexcept { return data_ + size_; }
+
+        const_reverse_iterator rbegin() const noexcept { return const_reverse_iterator(end()); }
+
+        const_reverse_iterator rend() const noexcept { return const_reverse_iterator(begin()); }
+
+        /*
+         * 容量相关操作
+         */
+        constexpr size_type size() const noexcept { return size_; }
+
+        constexpr size_type length() const noexcept { return size_; }
+
+        constexpr bool empty() const noexcept { return size_ == 0; }
+
+        constexpr size_type max_size() const noexcept { return static_cast<size_type>(-1) / sizeof(CharType); }
+
+        /*
+         * 访问元素相关操作
+         */
+        const_reference operator[](size_type n) const {
+            TINYSTL_DEBUG(n < size_);
+            return data_[n];
+        }
+
+        const_reference at(size_type n) const {
+            THROW_OUT_OF_RANGE_IF(n >= size_, "basic_string_view<Char, Traits>::at() subscript out of range");
+            return data_[n];
+        }
+
+        const_reference front() const {
+            TINYSTL_DEBUG(size_ != 0);
+            return data_[0];
+        }
+
+        const_reference back() const {
+            TINYSTL_DEBUG(size_ != 0);
+            return data_[size_ - 1];
+        }
+
+        constexpr const_pointer data() const noexcept { return data_; }
+
+        /*
+         * 修改视图的范围，不会修改字符序列本身
+         */
+        void remove_prefix(size_type n) {
+            TINYSTL_DEBUG(n <= size_);
+            data_ += n;
+            size_ -= n;
+        }
+
+        void remove_suffix(size_type n) {
+            TINYSTL_DEBUG(n <= size_);
+            size_ -= n;
+        }
+
+        void swap(basic_string_view &rhs) noexcept {
+            tinySTL::swap(data_, rhs.data_);
+            tinySTL::swap(size_, rhs.size_);
+        }
+
+        /*
+         * 将下标 pos 开始的至多 count 个字符复制到 dst，返回复制的字符个数
+         */
+        size_type copy(pointer dst, size_type count, size_type pos = 0) const {
+            THROW_OUT_OF_RANGE_IF(pos > size_, "basic_string_view<Char, Traits>::copy's pos out of range");
+            const size_type n = tinySTL::min(count, size_ - pos);
+            if (n != 0) {
+                char_traits::copy(dst, data_ + pos, n);
+            }
+            return n;
+        }
+
+        /*
+         * 获取下标 pos 开始的至多 count 个字符组成的子视图，不会分配内存
+         */
+        basic_string_view substr(size_type pos = 0, size_type count = npos) const {
+            THROW_OUT_OF_RANGE_IF(pos > size_, "basic_string_view<Char, Traits>::substr's pos out of range");
+            return basic_string_view(data_ + pos, tinySTL::min(count, size_ - pos));
+        }
+
+        /*
+         * 比较操作，-1代表< 0代表= 1代表大于
+         */
+        int compare(basic_string_view v) const noexcept {
+            const size_type n = tinySTL::min(size_, v.size_);
+            /* 空视图的 data() 可能为 nullptr，不能传给 memcmp */
+            const int res = n == 0 ? 0 : char_traits::compare(data_, v.data_, n);
+            if (res != 0) {
+                return res < 0 ? -1 : 1;
+            }
+            return size_ < v.size_ ? -1 : (size_ > v.size_ ? 1 : 0);
+        }
+
+        int compare(size_type pos1, size_type count1, basic_string_view v) const {
+            return substr(pos1, count1).compare(v);
+        }
+
+        int compare(size_type pos1, size_type count1, basic_string_view v,
+                    size_type pos2, size_type count2 = npos) const {
+            return substr(pos1, count1).compare(v.substr(pos2, count2));
+        }
+
+        int compare(const_pointer s) const {
+            return compare(basic_string_view(s));
+        }
+
+        /*
+         * 是否以 v 或字符 ch 开头、结尾
+         */
+        bool starts_with(basic_string_view v) const noexcept {
+            return size_ >= v.size_ && (v.size_ == 0 || char_traits::compare(data_, v.data_, v.size_) == 0);
+        }
+
+        bool starts_with(CharType ch) const noexcept {
+            return size_ != 0 && data_[0] == ch;
+        }
+
+        bool ends_with(basic_string_view v) const noexcept {
+            return size_ >= v.size_ &&
+                   (v.size_ == 0 || char_traits::compare(data_ + size_ - v.size_, v.data_, v.size_) == 0);
+        }
+
+        bool ends_with(CharType ch) const noexcept {
+            return size_ != 0 && data_[size_ - 1] == ch;
+        }
+
+        /*
+         * 查找相关操作，语义与 std::basic_string_view 一致
+         */
+
+        /*
+         * 从下标 pos 开始查找 v，返回起始位置的下标，找不到时返回 npos，空的 v 在 pos <= size() 时返回 pos
+         */
+        size_type find(basic_string_view v, size_type pos = 0) const noexcept {
+            if (pos > size_) {
+                return npos;
+            }
+            if (v.size_ == 0) {
+                return pos;
+            }
+            const_pointer r = tinySTL::string_search(data_ + pos, size_ - pos, v.data_, v.size_);
+            return r == nullptr ? npos : static_cast<size_type>(r - data_);
+        }
+
+        size_type find(CharType ch, size_type pos = 0) const noexcept {
+            if (pos >= size_) {
+                return npos;
+            }
+            const_pointer r = char_traits::find(data_ + pos, size_ - pos, ch);
+            return r == nullptr ? npos : static_cast<size_type>(r - data_);
+        }
+
+        size_type find(const_pointer s, size_type pos, size_type count) const noexcept {
+            return find(basic_string_view(s, count), pos);
+        }
+
+        size_type find(const_pointer s, size_type pos = 0) const {
+            return find(basic_string_view(s), pos);
+        }
+
+        /*
+         * 查找起始位置不大于 pos 的最后一次出现的位置
+         */
+        size_type rfind(basic_string_view v, size_type pos = npos) const noexcept {
+            if (v.size_ > size_) {
+                return npos;
+            }
+            const size_type start = tinySTL::min(pos, size_ - v.size_);
+            if (v.size_ == 0) {
+                return start;
+            }
+            const_pointer r = tinySTL::string_rsearch(data_, start + v.size_, v.data_, v.size_);
+            return r == nullptr ? npos : static_cast<size_type>(r - data_);
+        }
+
+        size_type rfind(CharType ch, size_type pos = npos) const noexcept {
+            return rfind(basic_string_view(&ch, 1), pos);
+        }
+
+        size_type rfind(const_pointer s, size_type pos, size_type count) const noexcept {
+            return rfind(basic_string_view(s, count), pos);
+        }
+
+        size_type rfind(const_pointer s, size_type pos = npos) const {
+            return rfind(basic_string_view(s), pos);
+        }
+
+        /*
+         * 从下标 pos 开始查找第一个属于(不属于) v 中字符的位置
+         */
+        size_type find_first_of(basic_string_view v, size_type pos = 0) const noexcept {
+            if (pos >= size_) {
+                return npos;
+            }
+            const size_type r = tinySTL::string_find_first_of(data_ + pos, size_ - pos, v.data_, v.size_);
+            return r == size_ - pos ? npos : pos + r;
+        }
+
+        size_type find_first_of(CharType ch, size_type pos = 0) const noexcept {
+            return find(ch, pos);
+        }
+
+        size_type find_first_not_of(basic_string_view v, size_type pos = 0) const noexcept {
+            if (pos >= size_) {
+                return npos;
+            }
+            const size_type r = tinySTL::string_find_first_not_of(data_ + pos, size_ - pos, v.data_, v.size_);
+            return r == size_ - pos ? npos : pos + r;
+        }
+
+        size_type find_first_not_of(CharType ch, size_type pos = 0) const noexcept {
+            return find_first_not_of(basic_string_view(&ch, 1), pos);
+        }
+
+        /*
+         * 查找下标不大于 pos 的最后一个属于(不属于) v 中字符的位置
+         */
+        size_type find_last_of(basic_string_view v, size_type pos = npos) const noexcept {
+            if (size_ == 0) {
+                return npos;
+            }
+            const size_type n = tinySTL::min(pos, size_ - 1) + 1;
+            const size_type r = tinySTL::string_find_last_of(data_, n, v.data_, v.size_);
+            return r == n ? npos : r;
+        }
+
+        size_type find_last_of(CharType ch, size_type pos = npos) const noexcept {
+            return find_last_of(basic_string_view(&ch, 1), pos);
+        }
+
+        size_type find_last_not_of(basic_string_view v, size_type pos = npos) const noexcept {
+            if (size_ == 0) {
+                return npos;
+            }
+            const size_type n = tinySTL::min(pos, size_ - 1) + 1;
+            const size_type r = tinySTL::string_find_last_not_of(data_, n, v.data_, v.size_);
+            return r == n ? npos : r;
+        }
+
+        size_type find_last_not_of(CharType ch, size_type pos = npos) const noexcept {
+            return find_last_not_of(basic_string_view(&ch, 1), pos);
+        }
+
+        /*
+         * 重载 << 操作符
+         */
+        template<typename Traits>
+        friend std::basic_ostream<CharType, Traits> &
+        operator<<(std::basic_ostream<CharType, Traits> &os, basic_string_view v) {
+            return tinySTL::stream_write(os, v.data_, v.size_);
+        }
+    };
+
+    template<typename CharType, typename CharTraits>
+    constexpr typename basic_string_view<CharType, CharTraits>::size_type basic_string_view<CharType, CharTraits>::npos;
+
+    /*
+     * 重载比较操作符
+     */
+    template<class CharType, class CharTraits>
+    bool operator==(basic_string_view<CharType, CharTraits> lhs, basic_string_view<CharType, CharTraits> rhs) {
+        return lhs.size() == rhs.size() && lhs.compare(rhs) == 0;
+    }
+
+    template<class CharType, class CharTraits>
+    bool operator!=(basic_string_view<CharType, CharTraits> lhs, basic_string_view<CharType, CharTraits> rhs) {
+        return !(lhs == rhs);
+    }
+
+    template<class CharType, class CharTraits>
+    bool operator<(basic_string_view<CharType, CharTraits> lhs, basic_string_view<CharType, CharTraits> rhs) {
+        return lhs.compare(rhs) < 0;
+    }
+
+    template<class CharType, class CharTraits>
+    bool operator>(basic_string_view<CharType, CharTraits> lhs, basic_string_view<CharType, CharTraits> rhs) {
+        return lhs.compare(rhs) > 0;
+    }
+
+    template<class CharType, class CharTraits>
+    bool operator<=(basic_string_view<CharType, CharTraits> lhs, basic_string_view<CharType, CharTraits> rhs) {
+        return lhs.compare(rhs) <= 0;
+    }
+
+    template<class CharType, class CharTraits>
+    bool operator>=(basic_string_view<CharType, CharTraits> lhs, basic_string_view<CharType, CharTraits> rhs) {
+        return lhs.compare(rhs) >= 0;
+    }
+
+    /*
+     * 与 C 风格字符串比较，使 sv == "abc" 不需要先显式构造视图
+     */
+    template<class CharType, class CharTraits>
+    bool operator==(basic_string_view<CharType, CharTraits> lhs, const CharType *rhs) {
+        return lhs == basic_string_view<CharType, CharTraits>(rhs);
+    }
+
+    template<class CharType, class CharTraits>
+    bool operator==(const CharType *lhs, basic_string_view<CharType, CharTraits> rhs) {
+        return basic_string_view<CharType, CharTraits>(lhs) == rhs;
+    }
+
+    template<class CharType, class CharTraits>
+    bool operator!=(basic_string_view<CharType, CharTraits> lhs, const CharType *rhs) {
+        return !(lhs == rhs);
+    }
+
+    template<class CharType, class CharTraits>
+    bool operator!=(const CharType *lhs, basic_string_view<CharType, CharTraits> rhs) {
+        return !(lhs == rhs);
+    }
+
+    template<class CharType, class CharTraits>
+    bool operator<(basic_string_view<CharType, CharTraits> lhs, const CharType *rhs) {
+        return lhs.compare(rhs) < 0;
+    }
+
+    template<class CharType, class CharTraits>
+    bool operator<(const CharType *lhs, basic_string_view<CharType, CharTraits> rhs) {
+        return rhs.compare(lhs) > 0;
+    }
+
+    template<class CharType, class CharTraits>
+    bool operator>(basic_string_view<CharType, CharTraits> lhs, const CharType *rhs) {
+        return lhs.compare(rhs) > 0;
+    }
+
+    template<class CharType, class CharTraits>
+    bool operator>(const CharType *lhs, basic_string_view<CharType, CharTraits> rhs) {
+        return rhs.compare(lhs) < 0;
+    }
+
+    template<class CharType, class CharTraits>
+    bool operator<=(basic_string_view<CharType, CharTraits> lhs, const CharType *rhs) {
+        return lhs.compare(rhs) <= 0;
+    }
+
+    template<class CharType, class CharTraits>
+    bool operator<=(const CharType *lhs, basic_string_view<CharType, CharTraits> rhs) {
+        return rhs.compare(lhs) >= 0;
+    }
+
+    template<class CharType, class CharTraits>
+    bool operator>=(basic_string_view<CharType, CharTraits> lhs, const CharType *rhs) {
+        return lhs.compare(rhs) >= 0;
+    }
+
+    template<class CharType, class CharTraits>
+    bool operator>=(const CharType *lhs, basic_string_view<CharType, CharTraits> rhs) {
+        return rhs.compare(lhs) <= 0;
+    }
+
+    /*
+     * 重载tinySTL的swap
+     */
+    template<class CharType, class CharTraits>
+    void swap(basic_string_view<CharType, CharTraits> &lhs, basic_string_view<CharType, CharTraits> &rhs) noexcept {
+        lhs.swap(rhs);
+    }
+
+    /*
+     * 为basic_string_view类定义hash函数 模板偏特化，与内容相同的 basic_string 得到相同的值
+     */
+    template<class CharType, class CharTraits>
+    struct hash<basic_string_view<CharType, CharTraits>> {
+        size_t operator()(basic_string_view<CharType, CharTraits> v) const noexcept {
+            return tinySTL::bitwise_hash(reinterpret_cast<const unsigned char *>(v.data()),
+                                         v.size() * sizeof(CharType));
+        }
+    };
+
+    template<class CharType, class CharTraits>
+    struct hash_is_avalanching<hash<basic_string_view<CharType, CharTraits>>> : public tinySTL::m_true_type {
+    };
+
+    /*
+     * 为basic_string_view类定义 FNV-1a 的可选hash函数
+     */
+    template<class CharType, class CharTraits>
+    struct fnv1a_hash<basic_string_view<CharType, CharTraits>> {
+        size_t operator()(basic_string_view<CharType, CharTraits> v) const noexcept {
+            return tinySTL::fnv1a_bytes(reinterpret_cast<const unsigned char *>(v.data()),
+                                        v.size() * sizeof(CharType));
+        }
+    };
+
+}  // namespace tinySTL
+
+#endif //TINYSTL_STRING_VIEW_H
@@ -0,0 +1,139 @@
+//
+// Created by cqupt1811 on 2022/6/1.
+//
+
+/*
+ * 这个头文件包含一个模板类 top_k，从数据流中保留按 comp 排在最前面的 k 个元素(默认为 greater，即最大的 k 个)
+ * 最多只保存 2k 个元素：缓冲区写满时用 nth_element 留下排在前面的 k 个，并把其中最后一个作为门槛，
+ * 之后不排在门槛之前的元素只需要一次比较就被丢弃。每个元素的均摊代价为 O(1)，
+ * 与逐个调整大小为 k 的堆相比比较次数更少，对缓冲区的访问也是顺序的
+ */
+
+#ifndef TINYSTL_TOP_K_H
+#define TINYSTL_TOP_K_H
+
+#include <cstddef>  /* 定义了 size_t 等常用类型 */
+#include "algo.h"  /* 这个头文件包含了 tinySTL 的一系列算法 */
+#include "functional.h"  /* 这个头文件包含了 tinySTL 的函数对象与哈希函数 */
+#include "vector.h"  /* 这个头文件包含一个模板类 vector */
+
+/* 首先定义自己的命名空间 */
+namespace tinySTL {
+
+    /*
+     * 模板类 top_k
+     * 参数一代表元素类型，参数二代表比较方式，排在前面的元素被保留
+     * 裁剪使用不稳定的 nth_element，与第 k 个元素相等的元素中保留哪些是不确定的
+     */
+    template<typename T, typename Compared = tinySTL::greater<T>>
+    class top_k {
+    public:
+        typedef T value_type;
+        typedef size_t size_type;
+        typedef Compared value_compare;
+
+        explicit top_k(size_type k, const Compared &comp = Compared())
+                : k_(k), comp_(comp), has_threshold_(false) {
+        }
+
+        /*
+         * 加入一个元素，不排在门槛之前时只需要一次比较
+         */
+        void push(const value_type &value) {
+            if (!has_threshold_ || comp_(value, buf_[k_ - 1])) {
+                insert(value);
+            }
+        }
+
+        void push(value_type &&value) {
+            if (!has_threshold_ || comp_(value, buf_[k_ - 1])) {
+                insert(tinySTL::move(value));
+            }
+        }
+
+        /*
+         * 依次加入 [first, last) 中的元素，被门槛挡住的元素在内层循环中连续跳过
+         */
+        template<typename InputIter>
+        void push(InputIter first, InputIter last) {
+            while (first != last) {
+                if (has_threshold_) {
+                    const value_type &bound = buf_[k_ - 1];
+                    while (first != last && !comp_(*first, bound)) {
+                        ++first;
+                    }
+                    if (first == last) {
+                        break;
+                    }
+                }
+                insert(*first);
+                ++first;
+            }
+        }
+
+        size_type k() const noexcept {
+            return k_;
+        }
+
+        /*
+         * 当前结果中的元素个数，即 min(k, 已加入的元素个数)
+         */
+        size_type size() const noexcept {
+            return buf_.size() < k_ ? buf_.size() : k_;
+        }
+
+        bool empty() const noexcept {
+            return buf_.empty();
+        }
+
+        /*
+         * 返回值：按 comp 排好序的前 k 个元素。之后仍然可以继续加入元素，返回的引用在下一次修改前有效
+         */
+        const tinySTL::vector<value_type> &sorted() {
+            prune();
+            tinySTL::sort(buf_.begin(), buf_.end(), comp_);
+            return buf_;
+        }
+
+        void clear() {
+            buf_.clear();
+            has_threshold_ = false;
+        }
+
+    private:
+        /*
+         * 放入缓冲区，缓冲区满 2k 个元素时裁剪
+         */
+        template<typename U>
+        void insert(U &&value) {
+            if (k_ == 0) {
+                return;
+            }
+            buf_.push_back(tinySTL::forward<U>(value));
+            if (buf_.size() >= 2 * k_) {
+                prune();
+            }
+        }
+
+        /*
+         * 只留下排在前面的 k 个元素，第 k 个元素 buf_[k - 1] 作为新的门槛，
+         * 之后的元素只追加在它后面，直到下一次裁剪之前它都不会移动
+         */
+        void prune() {
+            if (buf_.size() <= k_) {
+                return;
+            }
+            tinySTL::nth_element(buf_.begin(), buf_.begin() + (k_ - 1), buf_.end(), comp_);
+            buf_.erase(buf_.begin() + k_, buf_.end());
+            has_threshold_ = true;
+        }
+
+        size_type k_;
+        Compared comp_;
+        tinySTL::vector<value_type> buf_;  // 候选元素，最多 2k 个
+        bool has_threshold_;  // 是否裁剪过，裁剪过时 buf_[k - 1] 为门槛
+    };
+
+}  // namespace tinySTL
+
+#endif //TINYSTL_TOP_K_H
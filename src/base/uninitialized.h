@@ -150,7 +150,6 @@ namespace tinySTL {
         }
         catch (...) {
             tinySTL::destroy(first, cur);
-            return first;
         }
     }
 
@@ -0,0 +1,737 @@
+//
+// Created by cqupt1811 on 2022/5/23.
+//
+
+/*
+ * 这个头文件包含 UTF-8、UTF-16 与 UTF-32 之间的校验与转换
+ * utfN_find_invalid()      返回第一个非法码元的下标，全部合法时返回 n
+ * utfN_validate()          判断输入是否合法
+ * utfN_length_from_utfM()  求合法输入转换后的码元个数，用于预先分配恰好的空间
+ * convert_utfM_to_utfN()   转换合法的输入，返回写出的码元个数，不做校验
+ * utfM_to_utfN()           以 basic_string_view 为输入的转换，先校验并计算长度，只分配一次内存，输入非法时抛出异常
+ * 在 x86 平台上 UTF-8 的校验使用 AVX2 的查表算法(Keiser-Lemire)，每次检查 32 个字节；
+ * 长度统计与转换以 SSE2 为基线，整块都是 ASCII 时每次处理 16 个字节，其余情况逐个码点处理
+ */
+
+#ifndef TINYSTL_UTF_H
+#define TINYSTL_UTF_H
+
+#include <cstddef>  /* 定义了 size_t 等常用类型 */
+#include <cstdint>  /* 定义了定宽整数类型 */
+#include <cstring>  /* memcpy */
+#include "simd.h"  /* 这个头文件包含字符序列相关的 SIMD 内核，以及运行时的 CPU 特性检测 */
+#include "exceptdef.h"  /* 此文件中定义了异常相关的宏 */
+#include "string_view.h"  /* 这个头文件包含一个模板类 basic_string_view */
+#include "basic_string.h"  /* 这个头文件包含一个模板类 basic_string,用于表示字符串类型 */
+
+/* 首先定义自己的命名空间 */
+namespace tinySTL {
+
+    namespace utf_detail {
+
+        // 返回值：是否为 UTF-8 的后续字节 10xxxxxx
+        inline bool is_continuation(unsigned char b) noexcept {
+            return (b & 0xC0) == 0x80;
+        }
+
+        // 返回值：8 个字节是否都是 ASCII
+        inline bool ascii_word(const unsigned char *s) noexcept {
+            uint64_t w;
+            std::memcpy(&w, s, 8);
+            return (w & 0x8080808080808080ull) == 0;
+        }
+
+        /*
+         * 逐个码点校验 UTF-8，规则见 Unicode 标准表 3-7：
+         * 拒绝孤立的后续字节、过长编码(C0, C1, E0 80..9F, F0 80..8F)、代理区(ED A0..BF)与超过 U+10FFFF 的码点
+         * 返回第一个非法序列起始字节的下标
+         */
+        inline size_t scalar_utf8_find_invalid(const unsigned char *s, size_t n) noexcept {
+            size_t i = 0;
+            while (i < n) {
+                if (i + 8 <= n && ascii_word(s + i)) {
+                    i += 8;
+                    continue;
+                }
+                const unsigned char b = s[i];
+                if (b < 0x80) {
+                    ++i;
+                } else if (b < 0xC2) {
+                    return i;
+                } else if (b < 0xE0) {
+                    if (i + 1 >= n || !is_continuation(s[i + 1])) return i;
+                    i += 2;
+                } else if (b < 0xF0) {
+                    if (i + 2 >= n) return i;
+                    const unsigned char b1 = s[i + 1];
+                    const unsigned char lo = b == 0xE0 ? 0xA0 : 0x80;
+                    const unsigned char hi = b == 0xED ? 0x9F : 0xBF;
+                    if (b1 < lo || b1 > hi || !is_continuation(s[i + 2])) return i;
+                    i += 3;
+                } else if (b < 0xF5) {
+                    if (i + 3 >= n) return i;
+                    const unsigned char b1 = s[i + 1];
+                    const unsigned char lo = b == 0xF0 ? 0x90 : 0x80;
+                    const unsigned char hi = b == 0xF4 ? 0x8F : 0xBF;
+                    if (b1 < lo || b1 > hi || !is_continuation(s[i + 2]) || !is_continuation(s[i + 3])) return i;
+                    i += 4;
+                } else {
+                    return i;
+                }
+            }
+            return n;
+        }
+
+        /*
+         * 解码一个合法的 UTF-8 序列，返回码点并把 i 移到下一个序列
+         */
+        inline uint32_t decode_utf8(const unsigned char *s, size_t &i) noexcept {
+            const uint32_t b = s[i];
+            if (b < 0x80) {
+                i += 1;
+                return b;
+            }
+            if (b < 0xE0) {
+                const uint32_t cp = ((b & 0x1F) << 6) | (s[i + 1] & 0x3Fu);
+                i += 2;
+                return cp;
+            }
+            if (b < 0xF0) {
+                const uint32_t cp = ((b & 0x0F) << 12) | ((s[i + 1] & 0x3Fu) << 6) | (s[i + 2] & 0x3Fu);
+                i += 3;
+                return cp;
+            }
+            const uint32_t cp = ((b & 0x07) << 18) | ((s[i + 1] & 0x3Fu) << 12)
+                                | ((s[i + 2] & 0x3Fu) << 6) | (s[i + 3] & 0x3Fu);
+            i += 4;
+            return cp;
+        }
+
+        /*
+         * 把码点 cp 编码为 UTF-8 写到 out，返回写出的字节数
+         */
+        inline size_t encode_utf8(uint32_t cp, char *out) noexcept {
+            if (cp < 0x80) {
+                out[0] = static_cast<char>(cp);
+                return 1;
+            }
+            if (cp < 0x800) {
+                out[0] = static_cast<char>(0xC0 | (cp >> 6));
+                out[1] = static_cast<char>(0x80 | (cp & 0x3F));
+                return 2;
+            }
+            if (cp < 0x10000) {
+                out[0] = static_cast<char>(0xE0 | (cp >> 12));
+                out[1] = static_cast<char>(0x80 | ((cp >> 6) & 0x3F));
+                out[2] = static_cast<char>(0x80 | (cp & 0x3F));
+                return 3;
+            }
+            out[0] = static_cast<char>(0xF0 | (cp >> 18));
+            out[1] = static_cast<char>(0x80 | ((cp >> 12) & 0x3F));
+            out[2] = static_cast<char>(0x80 | ((cp >> 6) & 0x3F));
+            out[3] = static_cast<char>(0x80 | (cp & 0x3F));
+            return 4;
+        }
+
+        /*
+         * 把码点 cp 编码为 UTF-16 写到 out，返回写出的码元个数
+         */
+        inline size_t encode_utf16(uint32_t cp, char16_t *out) noexcept {
+            if (cp < 0x10000) {
+                out[0] = static_cast<char16_t>(cp);
+                return 1;
+            }
+            cp -= 0x10000;
+            out[0] = static_cast<char16_t>(0xD800 + (cp >> 10));
+            out[1] = static_cast<char16_t>(0xDC00 + (cp & 0x3FF));
+            return 2;
+        }
+
+        // 返回值：c 是否在代理区 D800..DFFF
+        inline bool is_surrogate(uint32_t c) noexcept {
+            return (c & 0xFFFFF800u) == 0xD800;
+        }
+
+        /*
+         * 校验 UTF-16：高代理必须紧跟低代理，不能出现孤立的低代理
+         */
+        inline size_t scalar_utf16_find_invalid(const char16_t *s, size_t n, size_t i = 0) noexcept {
+            for (; i < n; ++i) {
+                const uint32_t c = s[i];
+                if (!is_surrogate(c)) continue;
+                if (c >= 0xDC00 || i + 1 == n || (s[i + 1] & 0xFC00) != 0xDC00) return i;
+                ++i;
+            }
+            return n;
+        }
+
+        /*
+         * 校验 UTF-32：码点不超过 U+10FFFF 且不在代理区
+         */
+        inline size_t scalar_utf32_find_invalid(const char32_t *s, size_t n, size_t i = 0) noexcept {
+            for (; i < n; ++i) {
+                const uint32_t c = s[i];
+                if (c > 0x10FFFF || is_surrogate(c)) return i;
+            }
+            return n;
+        }
+
+#if TINYSTL_SIMD_X86
+
+        // 返回值：16 位掩码中 1 的个数
+        inline size_t popcount(unsigned mask) noexcept {
+            return static_cast<size_t>(__builtin_popcount(mask));
+        }
+
+        /*
+         * AVX2 的 UTF-8 校验，查表算法：
+         * 用前一个字节的高、低 4 位与当前字节的高 4 位查三张表，三者按位与后非 0 即出现两字节范围内的错误，
+         * 第三、四个字节是否必须为后续字节由前 2、3 个字节判断
+         * 遇到错误或剩余不足一个向量时停止，返回一个字符边界，从这里开始交给普通循环继续检查
+         */
+        __attribute__((target("avx2")))
+        inline size_t avx2_utf8_valid_prefix(const unsigned char *s, size_t n) noexcept {
+            const uint8_t too_short = 1 << 0;
+            const uint8_t too_long = 1 << 1;
+            const uint8_t overlong_3 = 1 << 2;
+            const uint8_t too_large = 1 << 3;
+            const uint8_t surrogate = 1 << 4;
+            const uint8_t overlong_2 = 1 << 5;
+            const uint8_t too_large_1000 = 1 << 6;
+            const uint8_t overlong_4 = 1 << 6;
+            const uint8_t two_conts = 1 << 7;
+            const uint8_t carry = too_short | too_long | two_conts;
+            // 前一个字节的高 4 位
+            const __m256i byte_1_high = _mm256_broadcastsi128_si256(_mm_setr_epi8(
+                    too_long, too_long, too_long, too_long, too_long, too_long, too_long, too_long,
+                    two_conts, two_conts, two_conts, two_conts,
+                    too_short | overlong_2,
+                    too_short,
+                    too_short | overlong_3 | surrogate,
+                    static_cast<char>(too_short | too_large | too_large_1000 | overlong_4)));
+            // 前一个字节的低 4 位
+            const __m256i byte_1_low = _mm256_broadcastsi128_si256(_mm_setr_epi8(
+                    carry | overlong_3 | overlong_2 | overlong_4,
+                    carry | overlong_2,
+                    carry, carry,
+                    carry | too_large,
+                    static_cast<char>(carry | too_large | too_large_1000),
+                    static_cast<char>(carry | too_large | too_large_1000),
+                    static_cast<char>(carry | too_large | too_large_1000),
+                    static_cast<char>(carry | too_large | too_large_1000),
+                    static_cast<char>(carry | too_large | too_large_1000),
+                    static_cast<char>(carry | too_large | too_large_1000),
+                    static_cast<char>(carry | too_large | too_large_1000),
+                    static_cast<char>(carry | too_large | too_large_1000),
+                    static_cast<char>(carry | too_large | too_large_1000 | surrogate),
+                    static_cast<char>(carry | too_large | too_large_1000),
+                    static_cast<char>(carry | too_large | too_large_1000)));
+            // 当前字节的高 4 位
+            const __m256i byte_2_high = _mm256_broadcastsi128_si256(_mm_setr_epi8(
+                    too_short, too_short, too_short, too_short, too_short, too_short, too_short, too_short,
+                    static_cast<char>(too_long | overlong_2 | two_conts | overlong_3 | too_large_1000 | overlong_4),
+                    static_cast<char>(too_long | overlong_2 | two_conts | overlong_3 | too_large),
+                    static_cast<char>(too_long | overlong_2 | two_conts | surrogate | too_large),
+                    static_cast<char>(too_long | overlong_2 | two_conts | surrogate | too_large),
+                    too_short, too_short, too_short, too_short));
+            const __m256i low_nibble = _mm256_set1_epi8(0x0F);
+            const __m256i third_byte = _mm256_set1_epi8(static_cast<char>(0xE0 - 0x80));
+            const __m256i fourth_byte = _mm256_set1_epi8(static_cast<char>(0xF0 - 0x80));
+            const __m256i high_bit = _mm256_set1_epi8(static_cast<char>(0x80));
+            // 最后 3 个字节若是还需要后续字节的首字节，说明序列跨越了块边界，
+            // 下一块不是 ASCII 时由查表检查，是 ASCII 时即为截断的序列
+            const __m256i max_value = _mm256_setr_epi8(
+                    -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1,
+                    -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1,
+                    static_cast<char>(0xF0 - 1), static_cast<char>(0xE0 - 1), static_cast<char>(0xC0 - 1));
+            __m256i prev_input = _mm256_setzero_si256();
+            __m256i prev_incomplete = _mm256_setzero_si256();
+            size_t i = 0;
+            for (; i + 32 <= n; i += 32) {
+                const __m256i input = _mm256_loadu_si256(reinterpret_cast<const __m256i *>(s + i));
+                if (_mm256_movemask_epi8(input) == 0) {
+                    // 整块都是 ASCII，只需确认上一块没有被截断的序列
+                    if (!_mm256_testz_si256(prev_incomplete, prev_incomplete)) break;
+                    prev_input = input;
+                    continue;
+                }
+                const __m256i shifted = _mm256_permute2x128_si256(prev_input, input, 0x21);
+                const __m256i prev1 = _mm256_alignr_epi8(input, shifted, 15);
+                const __m256i prev2 = _mm256_alignr_epi8(input, shifted, 14);
+                const __m256i prev3 = _mm256_alignr_epi8(input, shifted, 13);
+                const __m256i b1h = _mm256_shuffle_epi8(
+                        byte_1_high, _mm256_and_si256(_mm256_srli_epi16(prev1, 4), low_nibble));
+                const __m256i b1l = _mm256_shuffle_epi8(byte_1_low, _mm256_and_si256(prev1, low_nibble));
+                const __m256i b2h = _mm256_shuffle_epi8(
+                        byte_2_high, _mm256_and_si256(_mm256_srli_epi16(input, 4), low_nibble));
+                const __m256i special = _mm256_and_si256(_mm256_and_si256(b1h, b1l), b2h);
+                const __m256i must23 = _mm256_or_si256(_mm256_subs_epu8(prev2, third_byte),
+                                                       _mm256_subs_epu8(prev3, fourth_byte));
+                const __m256i error = _mm256_xor_si256(_mm256_and_si256(must23, high_bit), special);
+                if (!_mm256_testz_si256(error, error)) break;
+                prev_incomplete = _mm256_subs_epu8(input, max_value);
+                prev_input = input;
+            }
+            // [0, i) 中除了末尾可能被截断的序列以外都已确认合法，回退到最后一个序列的首字节
+            size_t p = i >= 3 ? i - 3 : 0;
+            while (p < i && is_continuation(s[p])) {
+                ++p;
+            }
+            return p;
+        }
+
+        /*
+         * 统计合法 UTF-8 中首字节的个数(UTF-32 长度)以及 4 字节序列的个数
+         */
+        inline void sse2_utf8_counts(const unsigned char *s, size_t n, size_t &leads, size_t &fours) noexcept {
+            const __m128i cont_bound = _mm_set1_epi8(-64);  // 后续字节按有符号数解释小于 -64
+            const __m128i four_bound = _mm_set1_epi8(static_cast<char>(0xF0));
+            const __m128i zero = _mm_setzero_si128();
+            size_t i = 0;
+            size_t cont = 0, four = 0;
+            while (i + 16 <= n) {
+                // 比较结果为 -1，逐字节相减累加，最多 255 轮后用 sad 横向求和，避免计数溢出
+                __m128i acc_cont = zero, acc_four = zero;
+                const size_t rounds_end = n - i >= 255 * 16 ? i + 255 * 16 : i + (n - i) / 16 * 16;
+                for (; i < rounds_end; i += 16) {
+                    const __m128i x = _mm_loadu_si128(reinterpret_cast<const __m128i *>(s + i));
+                    acc_cont = _mm_sub_epi8(acc_cont, _mm_cmplt_epi8(x, cont_bound));
+                    // 无符号比较 x >= 0xF0 即 max(x, 0xF0) == x
+                    acc_four = _mm_sub_epi8(acc_four, _mm_cmpeq_epi8(_mm_max_epu8(x, four_bound), x));
+                }
+                const __m128i sc = _mm_sad_epu8(acc_cont, zero);
+                const __m128i sf = _mm_sad_epu8(acc_four, zero);
+                cont += static_cast<size_t>(_mm_cvtsi128_si32(sc)) + static_cast<size_t>(_mm_extract_epi16(sc, 4));
+                four += static_cast<size_t>(_mm_cvtsi128_si32(sf)) + static_cast<size_t>(_mm_extract_epi16(sf, 4));
+            }
+            size_t lead = i - cont;
+            for (; i < n; ++i) {
+                lead += !is_continuation(s[i]);
+                four += s[i] >= 0xF0;
+            }
+            leads = lead;
+            fours = four;
+        }
+
+        /*
+         * 整块是 ASCII 时把 16 个字节扩展为 16 个 UTF-16 码元，返回是否处理了这一块
+         */
+        inline bool sse2_widen_ascii16(const unsigned char *s, char16_t *out) noexcept {
+            const __m128i x = _mm_loadu_si128(reinterpret_cast<const __m128i *>(s));
+            if (_mm_movemask_epi8(x) != 0) return false;
+            const __m128i zero = _mm_setzero_si128();
+            _mm_storeu_si128(reinterpret_cast<__m128i *>(out), _mm_unpacklo_epi8(x, zero));
+            _mm_storeu_si128(reinterpret_cast<__m128i *>(out + 8), _mm_unpackhi_epi8(x, zero));
+            return true;
+        }
+
+        /*
+         * 整块是 ASCII 时把 16 个字节扩展为 16 个 UTF-32 码元，返回是否处理了这一块
+         */
+        inline bool sse2_widen_ascii32(const unsigned char *s, char32_t *out) noexcept {
+            const __m128i x = _mm_loadu_si128(reinterpret_cast<const __m128i *>(s));
+            if (_mm_movemask_epi8(x) != 0) return false;
+            const __m128i zero = _mm_setzero_si128();
+            const __m128i lo = _mm_unpacklo_epi8(x, zero);
+            const __m128i hi = _mm_unpackhi_epi8(x, zero);
+            _mm_storeu_si128(reinterpret_cast<__m128i *>(out), _mm_unpacklo_epi16(lo, zero));
+            _mm_storeu_si128(reinterpret_cast<__m128i *>(out + 4), _mm_unpackhi_epi16(lo, zero));
+            _mm_storeu_si128(reinterpret_cast<__m128i *>(out + 8), _mm_unpacklo_epi16(hi, zero));
+            _mm_storeu_si128(reinterpret_cast<__m128i *>(out + 12), _mm_unpackhi_epi16(hi, zero));
+            return true;
+        }
+
+#endif // TINYSTL_SIMD_X86
+
+    }  // namespace utf_detail
+
+    // ===========================================================================================
+    // 校验
+
+    /*
+     * 返回 [s, s + n) 中第一个非法 UTF-8 序列起始字节的下标，全部合法时返回 n
+     */
+    inline size_t utf8_find_invalid(const char *s, size_t n) noexcept {
+        const unsigned char *p = reinterpret_cast<const unsigned char *>(s);
+        size_t start = 0;
+#if TINYSTL_SIMD_X86
+        if (simd::cpu_has_avx2()) {
+            start = utf_detail::avx2_utf8_valid_prefix(p, n);
+        }
+#endif
+        return start + utf_detail::scalar_utf8_find_invalid(p + start, n - start);
+    }
+
+    inline bool utf8_validate(const char *s, size_t n) noexcept {
+        return utf8_find_invalid(s, n) == n;
+    }
+
+    /*
+     * 返回 [s, s + n) 中第一个非法 UTF-16 码元的下标，全部合法时返回 n
+     * 8 个码元中都没有代理时整块跳过
+     */
+    inline size_t utf16_find_invalid(const char16_t *s, size_t n) noexcept {
+        size_t i = 0;
+#if TINYSTL_SIMD_X86
+        const __m128i mask = _mm_set1_epi16(static_cast<short>(0xF800));
+        const __m128i surr = _mm_set1_epi16(static_cast<short>(0xD800));
+        while (i + 8 <= n) {
+            const __m128i x = _mm_loadu_si128(reinterpret_cast<const __m128i *>(s + i));
+            if (_mm_movemask_epi8(_mm_cmpeq_epi16(_mm_and_si128(x, mask), surr)) == 0) {
+                i += 8;
+                continue;
+            }
+            // 逐个检查这一块，代理对可能跨到下一块
+            const size_t end = i + 8;
+            while (i < end) {
+                const uint32_t c = s[i];
+                if (!utf_detail::is_surrogate(c)) {
+                    ++i;
+                    continue;
+                }
+                if (c >= 0xDC00 || i + 1 == n || (s[i + 1] & 0xFC00) != 0xDC00) return i;
+                i += 2;
+            }
+        }
+#endif
+        return utf_detail::scalar_utf16_find_invalid(s, n, i);
+    }
+
+    inline bool utf16_validate(const char16_t *s, size_t n) noexcept {
+        return utf16_find_invalid(s, n) == n;
+    }
+
+    /*
+     * 返回 [s, s + n) 中第一个非法 UTF-32 码元的下标，全部合法时返回 n
+     */
+    inline size_t utf32_find_invalid(const char32_t *s, size_t n) noexcept {
+        size_t i = 0;
+#if TINYSTL_SIMD_X86
+        // SSE2 只有有符号比较，翻转符号位后比较无符号数
+        const __m128i sign = _mm_set1_epi32(static_cast<int>(0x80000000u));
+        const __m128i max_cp = _mm_set1_epi32(static_cast<int>(0x8010FFFFu));
+        const __m128i mask = _mm_set1_epi32(static_cast<int>(0xFFFFF800u));
+        const __m128i surr = _mm_set1_epi32(0xD800);
+        for (; i + 4 <= n; i += 4) {
+            const __m128i x = _mm_loadu_si128(reinterpret_cast<const __m128i *>(s + i));
+            const __m128i bad = _mm_or_si128(_mm_cmpgt_epi32(_mm_xor_si128(x, sign), max_cp),
+                                             _mm_cmpeq_epi32(_mm_and_si128(x, mask), surr));
+            if (_mm_movemask_epi8(bad) != 0) break;
+        }
+#endif
+        return utf_detail::scalar_utf32_find_invalid(s, n, i);
+    }
+
+    inline bool utf32_validate(const char32_t *s, size_t n) noexcept {
+        return utf32_find_invalid(s, n) == n;
+    }
+
+    // ===========================================================================================
+    // 长度，要求输入合法
+
+    /*
+     * UTF-8 转为 UTF-16 后的码元个数：每个首字节一个，4 字节序列再多一个
+     */
+    inline size_t utf16_length_from_utf8(const char *s, size_t n) noexcept {
+        const unsigned char *p = reinterpret_cast<const unsigned char *>(s);
+#if TINYSTL_SIMD_X86
+        size_t leads, fours;
+        utf_detail::sse2_utf8_counts(p, n, leads, fours);
+        return leads + fours;
+#else
+        size_t count = 0;
+        for (size_t i = 0; i < n; ++i) {
+            count += !utf_detail::is_continuation(p[i]) + (p[i] >= 0xF0);
+        }
+        return count;
+#endif
+    }
+
+    /*
+     * UTF-8 转为 UTF-32 后的码元个数，即首字节的个数
+     */
+    inline size_t utf32_length_from_utf8(const char *s, size_t n) noexcept {
+        const unsigned char *p = reinterpret_cast<const unsigned char *>(s);
+#if TINYSTL_SIMD_X86
+        size_t leads, fours;
+        utf_detail::sse2_utf8_counts(p, n, leads, fours);
+        return leads;
+#else
+        size_t count = 0;
+        for (size_t i = 0; i < n; ++i) {
+            count += !utf_detail::is_continuation(p[i]);
+        }
+        return count;
+#endif
+    }
+
+    /*
+     * UTF-16 转为 UTF-8 后的字节数：每个码元至少 1 字节，>= 0x80 与 >= 0x800 各多 1 字节，
+     * 代理对的两个码元按 3 + 3 计算后多算了 2 字节
+     */
+    inline size_t utf8_length_from_utf16(const char16_t *s, size_t n) noexcept {
+        size_t count = n;
+        size_t i = 0;
+#if TINYSTL_SIMD_X86
+        const __m128i zero = _mm_setzero_si128();
+        const __m128i m80 = _mm_set1_epi16(static_cast<short>(0xFF80));
+        const __m128i m800 = _mm_set1_epi16(static_cast<short>(0xF800));
+        const __m128i surr = _mm_set1_epi16(static_cast<short>(0xD800));
+        for (; i + 8 <= n; i += 8) {
+            const __m128i x = _mm_loadu_si128(reinterpret_cast<const __m128i *>(s + i));
+            const __m128i hi800 = _mm_and_si128(x, m800);
+            const unsigned small = static_cast<unsigned>(_mm_movemask_epi8(_mm_cmpeq_epi16(_mm_and_si128(x, m80), zero)));
+            const unsigned mid = static_cast<unsigned>(_mm_movemask_epi8(_mm_cmpeq_epi16(hi800, zero)));
+            const unsigned sur = static_cast<unsigned>(_mm_movemask_epi8(_mm_cmpeq_epi16(hi800, surr)));
+            count += (16 - utf_detail::popcount(small) + 16 - utf_detail::popcount(mid)
+                      - utf_detail::popcount(sur)) / 2;
+        }
+#endif
+        for (; i < n; ++i) {
+            const uint32_t c = s[i];
+            count += (c >= 0x80) + (c >= 0x800) - utf_detail::is_surrogate(c);
+        }
+        return count;
+    }
+
+    /*
+     * UTF-16 转为 UTF-32 后的码元个数：每个低代理与前面的高代理合成一个码点
+     */
+    inline size_t utf32_length_from_utf16(const char16_t *s, size_t n) noexcept {
+        size_t count = n;
+        for (size_t i = 0; i < n; ++i) {
+            count -= (s[i] & 0xFC00) == 0xDC00;
+        }
+        return count;
+    }
+
+    /*
+     * UTF-32 转为 UTF-8 后的字节数
+     */
+    inline size_t utf8_length_from_utf32(const char32_t *s, size_t n) noexcept {
+        size_t count = n;
+        size_t i = 0;
+#if TINYSTL_SIMD_X86
+        // 合法码点不超过 0x10FFFF，可以直接使用有符号比较
+        const __m128i b1 = _mm_set1_epi32(0x7F);
+        const __m128i b2 = _mm_set1_epi32(0x7FF);
+        const __m128i b3 = _mm_set1_epi32(0xFFFF);
+        for (; i + 4 <= n; i += 4) {
+            const __m128i x = _mm_loadu_si128(reinterpret_cast<const __m128i *>(s + i));
+            const unsigned m = utf_detail::popcount(static_cast<unsigned>(_mm_movemask_epi8(_mm_cmpgt_epi32(x, b1))))
+                               + utf_detail::popcount(static_cast<unsigned>(_mm_movemask_epi8(_mm_cmpgt_epi32(x, b2))))
+                               + utf_detail::popcount(static_cast<unsigned>(_mm_movemask_epi8(_mm_cmpgt_epi32(x, b3))));
+            count += m / 4;
+        }
+#endif
+        for (; i < n; ++i) {
+            const uint32_t c = s[i];
+            count += (c >= 0x80) + (c >= 0x800) + (c >= 0x10000);
+        }
+        return count;
+    }
+
+    /*
+     * UTF-32 转为 UTF-16 后的码元个数
+     */
+    inline size_t utf16_length_from_utf32(const char32_t *s, size_t n) noexcept {
+        size_t count = n;
+        for (size_t i = 0; i < n; ++i) {
+            count += s[i] >= 0x10000;
+        }
+        return count;
+    }
+
+    // ===========================================================================================
+    // 转换，要求输入合法且 out 有足够的空间，返回写出的码元个数
+
+    inline size_t convert_utf8_to_utf16(const char *s, size_t n, char16_t *out) noexcept {
+        const unsigned char *p = reinterpret_cast<const unsigned char *>(s);
+        char16_t *o = out;
+        size_t i = 0;
+        while (i < n) {
+#if TINYSTL_SIMD_X86
+            if (i + 16 <= n && utf_detail::sse2_widen_ascii16(p + i, o)) {
+                i += 16;
+                o += 16;
+                continue;
+            }
+#endif
+            if (p[i] < 0x80) {
+                *o++ = p[i++];
+                continue;
+            }
+            o += utf_detail::encode_utf16(utf_detail::decode_utf8(p, i), o);
+        }
+        return static_cast<size_t>(o - out);
+    }
+
+    inline size_t convert_utf8_to_utf32(const char *s, size_t n, char32_t *out) noexcept {
+        const unsigned char *p = reinterpret_cast<const unsigned char *>(s);
+        char32_t *o = out;
+        size_t i = 0;
+        while (i < n) {
+#if TINYSTL_SIMD_X86
+            if (i + 16 <= n && utf_detail::sse2_widen_ascii32(p + i, o)) {
+                i += 16;
+                o += 16;
+                continue;
+            }
+#endif
+            if (p[i] < 0x80) {
+                *o++ = p[i++];
+                continue;
+            }
+            *o++ = utf_detail::decode_utf8(p, i);
+        }
+        return static_cast<size_t>(o - out);
+    }
+
+    inline size_t convert_utf16_to_utf8(const char16_t *s, size_t n, char *out) noexcept {
+        char *o = out;
+        size_t i = 0;
+#if TINYSTL_SIMD_X86
+        const __m128i m80 = _mm_set1_epi16(static_cast<short>(0xFF80));
+        const __m128i zero = _mm_setzero_si128();
+#endif
+        while (i < n) {
+#if TINYSTL_SIMD_X86
+            // 16 个码元都是 ASCII 时压缩为 16 个字节
+            if (i + 16 <= n) {
+                const __m128i a = _mm_loadu_si128(reinterpret_cast<const __m128i *>(s + i));
+                const __m128i b = _mm_loadu_si128(reinterpret_cast<const __m128i *>(s + i + 8));
+                if (_mm_movemask_epi8(_mm_cmpeq_epi16(_mm_and_si128(_mm_or_si128(a, b), m80), zero)) == 0xFFFF) {
+                    _mm_storeu_si128(reinterpret_cast<__m128i *>(o), _mm_packus_epi16(a, b));
+                    i += 16;
+                    o += 16;
+                    continue;
+                }
+            }
+#endif
+            uint32_t c = s[i++];
+            if (c >= 0xD800 && c < 0xDC00) {
+                c = 0x10000 + ((c - 0xD800) << 10) + (s[i++] - 0xDC00u);
+            }
+            o += utf_detail::encode_utf8(c, o);
+        }
+        return static_cast<size_t>(o - out);
+    }
+
+    inline size_t convert_utf16_to_utf32(const char16_t *s, size_t n, char32_t *out) noexcept {
+        char32_t *o = out;
+        size_t i = 0;
+#if TINYSTL_SIMD_X86
+        const __m128i mask = _mm_set1_epi16(static_cast<short>(0xF800));
+        const __m128i surr = _mm_set1_epi16(static_cast<short>(0xD800));
+        const __m128i zero = _mm_setzero_si128();
+#endif
+        while (i < n) {
+#if TINYSTL_SIMD_X86
+            // 8 个码元中没有代理时直接零扩展
+            if (i + 8 <= n) {
+                const __m128i x = _mm_loadu_si128(reinterpret_cast<const __m128i *>(s + i));
+                if (_mm_movemask_epi8(_mm_cmpeq_epi16(_mm_and_si128(x, mask), surr)) == 0) {
+                    _mm_storeu_si128(reinterpret_cast<__m128i *>(o), _mm_unpacklo_epi16(x, zero));
+                    _mm_storeu_si128(reinterpret_cast<__m128i *>(o + 4), _mm_unpackhi_epi16(x, zero));
+                    i += 8;
+                    o += 8;
+                    continue;
+                }
+            }
+#endif
+            uint32_t c = s[i++];
+            if (c >= 0xD800 && c < 0xDC00) {
+                c = 0x10000 + ((c - 0xD800) << 10) + (s[i++] - 0xDC00u);
+            }
+            *o++ = c;
+        }
+        return static_cast<size_t>(o - out);
+    }
+
+    inline size_t convert_utf32_to_utf8(const char32_t *s, size_t n, char *out) noexcept {
+        char *o = out;
+        size_t i = 0;
+#if TINYSTL_SIMD_X86
+        const __m128i b1 = _mm_set1_epi32(0x7F);
+#endif
+        while (i < n) {
+#if TINYSTL_SIMD_X86
+            // 16 个码元都是 ASCII 时两次压缩为 16 个字节
+            if (i + 16 <= n) {
+                const __m128i a = _mm_loadu_si128(reinterpret_cast<const __m128i *>(s + i));
+                const __m128i b = _mm_loadu_si128(reinterpret_cast<const __m128i *>(s + i + 4));
+                const __m128i c = _mm_loadu_si128(reinterpret_cast<const __m128i *>(s + i + 8));
+                const __m128i d = _mm_loadu_si128(reinterpret_cast<const __m128i *>(s + i + 12));
+                const __m128i big = _mm_or_si128(_mm_or_si128(_mm_cmpgt_epi32(a, b1), _mm_cmpgt_epi32(b, b1)),
+                                                 _mm_or_si128(_mm_cmpgt_epi32(c, b1), _mm_cmpgt_epi32(d, b1)));
+                if (_mm_movemask_epi8(big) == 0) {
+                    _mm_storeu_si128(reinterpret_cast<__m128i *>(o),
+                                     _mm_packus_epi16(_mm_packs_epi32(a, b), _mm_packs_epi32(c, d)));
+                    i += 16;
+                    o += 16;
+                    continue;
+                }
+            }
+#endif
+            o += utf_detail::encode_utf8(static_cast<uint32_t>(s[i++]), o);
+        }
+        return static_cast<size_t>(o - out);
+    }
+
+    inline size_t convert_utf32_to_utf16(const char32_t *s, size_t n, char16_t *out) noexcept {
+        char16_t *o = out;
+        for (size_t i = 0; i < n; ++i) {
+            o += utf_detail::encode_utf16(static_cast<uint32_t>(s[i]), o);
+        }
+        return static_cast<size_t>(o - out);
+    }
+
+    // ===========================================================================================
+    // basic_string 之间的转换，先校验并求出结果的长度，一次分配恰好的空间后再转换
+    // 输入非法时抛出 std::runtime_error
+
+    inline basic_string<char16_t> utf8_to_utf16(basic_string_view<char> s) {
+        THROW_RUNTIME_ERROR_IF(!utf8_validate(s.data(), s.size()), "utf8_to_utf16: invalid UTF-8 sequence");
+        basic_string<char16_t> out(utf16_length_from_utf8(s.data(), s.size()), char16_t());
+        convert_utf8_to_utf16(s.data(), s.size(), out.begin());
+        return out;
+    }
+
+    inline basic_string<char32_t> utf8_to_utf32(basic_string_view<char> s) {
+        THROW_RUNTIME_ERROR_IF(!utf8_validate(s.data(), s.size()), "utf8_to_utf32: invalid UTF-8 sequence");
+        basic_string<char32_t> out(utf32_length_from_utf8(s.data(), s.size()), char32_t());
+        convert_utf8_to_utf32(s.data(), s.size(), out.begin());
+        return out;
+    }
+
+    inline basic_string<char> utf16_to_utf8(basic_string_view<char16_t> s) {
+        THROW_RUNTIME_ERROR_IF(!utf16_validate(s.data(), s.size()), "utf16_to_utf8: invalid UTF-16 sequence");
+        basic_string<char> out(utf8_length_from_utf16(s.data(), s.size()), char());
+        convert_utf16_to_utf8(s.data(), s.size(), out.begin());
+        return out;
+    }
+
+    inline basic_string<char32_t> utf16_to_utf32(basic_string_view<char16_t> s) {
+        THROW_RUNTIME_ERROR_IF(!utf16_validate(s.data(), s.size()), "utf16_to_utf32: invalid UTF-16 sequence");
+        basic_string<char32_t> out(utf32_length_from_utf16(s.data(), s.size()), char32_t());
+        convert_utf16_to_utf32(s.data(), s.size(), out.begin());
+        return out;
+    }
+
+    inline basic_string<char> utf32_to_utf8(basic_string_view<char32_t> s) {
+        THROW_RUNTIME_ERROR_IF(!utf32_validate(s.data(), s.size()), "utf32_to_utf8: invalid UTF-32 code point");
+        basic_string<char> out(utf8_length_from_utf32(s.data(), s.size()), char());
+        convert_utf32_to_utf8(s.data(), s.size(), out.begin());
+        return out;
+    }
+
+    inline basic_string<char16_t> utf32_to_utf16(basic_string_view<char32_t> s) {
+        THROW_RUNTIME_ERROR_IF(!utf32_validate(s.data(), s.size()), "utf32_to_utf16: invalid UTF-32 code point");
+        basic_string<char16_t> out(utf16_length_from_utf32(s.data(), s.size()), char16_t());
+        convert_utf32_to_utf16(s.data(), s.size(), out.begin());
+        return out;
+    }
+
+}  // namespace tinySTL
+
+#endif //TINYSTL_UTF_H
@@ -11,6 +11,7 @@
 
 #include <cstddef>  /* 头文件cstddef与其C对应版本兼容，它是C头文件<stddef.h>较新版本，定义了常用的常量、宏、类型和函数 */
 #include "type_traits.h"  /* type_traits.h文件钟引入了标准库钟的type_traits文件，同时定义了一些自己的模板方法 */
+#include "functional.h"  /* 这个头文件包含了 tinySTL 的函数对象与哈希函数 */
 
 /* 首先定义自己的命名空间 */
 namespace tinySTL {
@@ -415,6 +416,24 @@ namespace tinySTL {
         return pair<Ty1, Ty2>(tinySTL::forward<Ty1>(first), tinySTL::forward<Ty2>(second));
     }
 
+    /*
+     * 为pair类定义hash函数 模板偏特化
+     * 依次合并 first 与 second 的 hash 值，(a, b) 与 (b, a) 得到不同的结果
+     */
+    template<typename Ty1, typename Ty2>
+    struct hash<pair<Ty1, Ty2>> {
+        size_t operator()(const pair<Ty1, Ty2> &p) const {
+            size_t seed = 0;
+            tinySTL::hash_combine(seed, p.first);
+            tinySTL::hash_combine(seed, p.second);
+            return seed;
+        }
+    };
+
+    template<typename Ty1, typename Ty2>
+    struct hash_is_avalanching<hash<pair<Ty1, Ty2>>> : public tinySTL::m_true_type {
+    };
+
 } // namespace tinySTL
 
 #endif //TINYSTL_UTILS_H
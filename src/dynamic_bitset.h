@@ -0,0 +1,901 @@
+//
+// Created by cqupt1811 on 2022/5/21.
+//
+
+/*
+ * 这个头文件包含一个类 dynamic_bitset
+ * 按位压缩存储的动态位集合，用于替代 vector<bool>
+ *
+ * 每个位只占用 1 bit，所有位以 64 位的块(block)为单位连续存放，
+ * count、find_first、find_next 以及位运算、移位操作都以块为单位进行，一次处理 64 位
+ * 最后一个块中超出 size() 的高位始终保持为 0，这样各种整块运算不需要额外处理尾部
+ */
+
+#ifndef TINYSTL_DYNAMIC_BITSET_H
+#define TINYSTL_DYNAMIC_BITSET_H
+
+#include <cstring>  /* std::memcpy, std::memset 函数 */
+#include <iostream>  /* c++的io库 */
+#include "memory.h"  /* 这个头文件负责更高级的动态内存管理,包含一些基本函数、空间配置器、未初始化的储存空间管理，以及一个模板类 auto_ptr */
+#include "utils.h"  /* 这个文件包含一些通用工具，包括 move, forward, swap 等函数，以及 pair 等 */
+#include "exceptdef.h"  /* 此文件中定义了异常相关的宏 */
+
+/* 首先定义自己的命名空间 */
+namespace tinySTL {
+
+    // ==============================================================================================
+
+    /*
+     * 类 dynamic_bitset
+     * 位集合的大小在运行期可变
+     */
+    class dynamic_bitset {
+    public:
+        /*
+         * 定义类中使用的类型别名
+         * block_type 为存储位的块类型，一个块存放 64 个位
+         */
+        typedef unsigned long long block_type;
+        typedef size_t size_type;
+        typedef bool value_type;
+        typedef bool const_reference;
+
+        /*
+         * 定义空间配置器的别名
+         */
+        typedef tinySTL::allocator<block_type> allocator_type;
+        typedef tinySTL::allocator<block_type> data_allocator;
+
+        /*
+         * 每个块中的位数
+         */
+        static constexpr size_type bits_per_block = 64;
+
+        /*
+         * 查找失败时的返回值
+         */
+        static constexpr size_type npos = static_cast<size_type>(-1);
+
+        /*
+         * 位的代理引用类型
+         * 单个位无法取地址，通过保存所在的块与掩码来模拟引用的行为
+         */
+        class reference {
+            friend class dynamic_bitset;
+
+        private:
+            block_type *block_;  // 位所在的块
+            block_type mask_;  // 位在块中的掩码
+
+            reference(block_type *block, size_type pos) : block_(block), mask_(block_type(1) << pos) {
+
+            }
+
+        public:
+            /*
+             * 转换为 bool 值
+             */
+            operator bool() const noexcept {
+                return (*block_ & mask_) != 0;
+            }
+
+            /*
+             * 取反后的值
+             */
+            bool operator~() const noexcept {
+                return (*block_ & mask_) == 0;
+            }
+
+            /*
+             * 为对应的位赋值
+             */
+            reference &operator=(bool value) noexcept {
+                if (value) {
+                    *block_ |= mask_;
+                } else {
+                    *block_ &= ~mask_;
+                }
+                return *this;
+            }
+
+            /*
+             * 用另一个位的值为对应的位赋值
+             */
+            reference &operator=(const reference &rhs) noexcept {
+                return *this = static_cast<bool>(rhs);
+            }
+
+            /*
+             * 翻转对应的位
+             */
+            reference &flip() noexcept {
+                *block_ ^= mask_;
+                return *this;
+            }
+        };
+
+    private:
+        /*
+         * dynamic_bitset 使用以下三个变量描述位集合的信息
+         * blocks_: 块数组的起始位置
+         * size_: 位的个数
+         * cap_: 已申请的块的个数
+         */
+        block_type *blocks_;
+        size_type size_;
+        size_type cap_;
+
+    public:
+        /*
+         * 默认构造函数
+         */
+        dynamic_bitset() noexcept: blocks_(nullptr), size_(0), cap_(0) {
+
+        }
+
+        /*
+         * 显式构造函数，接受位的个数以及所有位的初值
+         */
+        explicit dynamic_bitset(size_type n, bool value = false) : blocks_(nullptr), size_(0), cap_(0) {
+            init_space(n);
+            size_ = n;
+            value ? set() : reset();
+        }
+
+        /*
+         * 拷贝构造函数
+         */
+        dynamic_bitset(const dynamic_bitset &rhs) : blocks_(nullptr), size_(0), cap_(0) {
+            init_space(rhs.size_);
+            if (blocks_ != nullptr) {
+                std::memcpy(blocks_, rhs.blocks_, rhs.num_blocks() * sizeof(block_type));
+            }
+            size_ = rhs.size_;
+        }
+
+        /*
+         * 移动构造函数
+         */
+        dynamic_bitset(dynamic_bitset &&rhs) noexcept: blocks_(rhs.blocks_), size_(rhs.size_), cap_(rhs.cap_) {
+            rhs.blocks_ = nullptr;
+            rhs.size_ = 0;
+            rhs.cap_ = 0;
+        }
+
+        /*
+         * 拷贝赋值函数
+         */
+        dynamic_bitset &operator=(const dynamic_bitset &rhs) {
+            if (this != &rhs) {
+                dynamic_bitset temp(rhs);
+                swap(temp);
+            }
+            return *this;
+        }
+
+        /*
+         * 移动赋值函数
+         */
+        dynamic_bitset &operator=(dynamic_bitset &&rhs) noexcept {
+            if (this != &rhs) {
+                data_allocator::deallocate(blocks_, cap_);
+                blocks_ = rhs.blocks_;
+                size_ = rhs.size_;
+                cap_ = rhs.cap_;
+                rhs.blocks_ = nullptr;
+                rhs.size_ = 0;
+                rhs.cap_ = 0;
+            }
+            return *this;
+        }
+
+        /*
+         * 析构函数中释放申请的空间
+         */
+        ~dynamic_bitset() {
+            data_allocator::deallocate(blocks_, cap_);
+            blocks_ = nullptr;
+            size_ = 0;
+            cap_ = 0;
+        }
+
+    public:
+        /*
+         * 容量相关操作
+         */
+
+        /*
+         * 位集合是否为空
+         */
+        bool empty() const noexcept {
+            return size_ == 0;
+        }
+
+        /*
+         * 返回位的个数
+         */
+        size_type size() const noexcept {
+            return size_;
+        }
+
+        /*
+         * 返回当前使用的块的个数
+         */
+        size_type num_blocks() const noexcept {
+            return block_count(size_);
+        }
+
+        /*
+         * 返回不重新分配空间时最多能容纳的位数
+         */
+        size_type capacity() const noexcept {
+            return cap_ * bits_per_block;
+        }
+
+        /*
+         * 预留能容纳 n 个位的空间
+         */
+        void reserve(size_type n);
+
+        /*
+         * 将位的个数调整为 n，新增的位以 value 填充
+         */
+        void resize(size_type n, bool value = false);
+
+        /*
+         * 清空位集合
+         */
+        void clear() noexcept {
+            size_ = 0;
+        }
+
+        /*
+         * 在尾部添加一个位
+         */
+        void push_back(bool value);
+
+        /*
+         * 删除尾部的一个位
+         */
+        void pop_back() {
+            TINYSTL_DEBUG(!empty());
+            --size_;
+            clear_unused_bits();
+        }
+
+        /*
+         * 访问元素相关操作
+         */
+
+        /*
+         * 重载 [] 运算符
+         */
+        reference operator[](size_type pos) {
+            TINYSTL_DEBUG(pos < size_);
+            return reference(blocks_ + block_index(pos), bit_index(pos));
+        }
+
+        /*
+         * 重载 [] 运算符 常量版
+         */
+        const_reference operator[](size_type pos) const {
+            TINYSTL_DEBUG(pos < size_);
+            return (blocks_[block_index(pos)] >> bit_index(pos)) & 1;
+        }
+
+        /*
+         * 检查位置 pos 上的位是否为 1，越界时抛出异常
+         */
+        bool test(size_type pos) const {
+            THROW_OUT_OF_RANGE_IF(pos >= size_, "dynamic_bitset::test() subscript out of range");
+            return (*this)[pos];
+        }
+
+        /*
+         * 返回存储块的起始位置
+         */
+        block_type *data() noexcept {
+            return blocks_;
+        }
+
+        /*
+         * 返回存储块的起始位置 常量版
+         */
+        const block_type *data() const noexcept {
+            return blocks_;
+        }
+
+        /*
+         * 修改位的相关操作
+         */
+
+        /*
+         * 将所有位置为 1
+         */
+        dynamic_bitset &set() noexcept;
+
+        /*
+         * 将位置 pos 上的位设置为 value
+         */
+        dynamic_bitset &set(size_type pos, bool value = true) {
+            TINYSTL_DEBUG(pos < size_);
+            (*this)[pos] = value;
+            return *this;
+        }
+
+        /*
+         * 将所有位置为 0
+         */
+        dynamic_bitset &reset() noexcept {
+            if (blocks_ != nullptr) {
+                std::memset(blocks_, 0, num_blocks() * sizeof(block_type));
+            }
+            return *this;
+        }
+
+        /*
+         * 将位置 pos 上的位置为 0
+         */
+        dynamic_bitset &reset(size_type pos) {
+            TINYSTL_DEBUG(pos < size_);
+            blocks_[block_index(pos)] &= ~(block_type(1) << bit_index(pos));
+            return *this;
+        }
+
+        /*
+         * 翻转所有位
+         */
+        dynamic_bitset &flip() noexcept;
+
+        /*
+         * 翻转位置 pos 上的位
+         */
+        dynamic_bitset &flip(size_type pos) {
+            TINYSTL_DEBUG(pos < size_);
+            blocks_[block_index(pos)] ^= block_type(1) << bit_index(pos);
+            return *this;
+        }
+
+        /*
+         * 统计与查找相关操作
+         */
+
+        /*
+         * 返回值为 1 的位的个数
+         */
+        size_type count() const noexcept;
+
+        /*
+         * 是否存在值为 1 的位
+         */
+        bool any() const noexcept;
+
+        /*
+         * 是否所有位都为 0
+         */
+        bool none() const noexcept {
+            return !any();
+        }
+
+        /*
+         * 是否所有位都为 1
+         */
+        bool all() const noexcept;
+
+        /*
+         * 与另一个位集合是否存在同时为 1 的位
+         */
+        bool intersects(const dynamic_bitset &rhs) const noexcept;
+
+        /*
+         * 返回第一个值为 1 的位的下标，若没有则返回 npos
+         */
+        size_type find_first() const noexcept {
+            return find_from(0);
+        }
+
+        /*
+         * 返回下标大于 pos 的第一个值为 1 的位的下标，若没有则返回 npos
+         */
+        size_type find_next(size_type pos) const noexcept {
+            if (pos >= size_ || pos + 1 >= size_) {
+                return npos;
+            }
+            return find_from(pos + 1);
+        }
+
+        /*
+         * 位运算相关操作，要求两个位集合的大小相同
+         */
+
+        /*
+         * 按位与
+         */
+        dynamic_bitset &operator&=(const dynamic_bitset &rhs) noexcept;
+
+        /*
+         * 按位或
+         */
+        dynamic_bitset &operator|=(const dynamic_bitset &rhs) noexcept;
+
+        /*
+         * 按位异或
+         */
+        dynamic_bitset &operator^=(const dynamic_bitset &rhs) noexcept;
+
+        /*
+         * 将下标为 i 的位移动到下标 i + n 处，低位补 0
+         */
+        dynamic_bitset &operator<<=(size_type n) noexcept;
+
+        /*
+         * 将下标为 i 的位移动到下标 i - n 处，高位补 0
+         */
+        dynamic_bitset &operator>>=(size_type n) noexcept;
+
+        /*
+         * 返回左移 n 位后的位集合
+         */
+        dynamic_bitset operator<<(size_type n) const {
+            dynamic_bitset temp(*this);
+            temp <<= n;
+            return temp;
+        }
+
+        /*
+         * 返回右移 n 位后的位集合
+         */
+        dynamic_bitset operator>>(size_type n) const {
+            dynamic_bitset temp(*this);
+            temp >>= n;
+            return temp;
+        }
+
+        /*
+         * 返回所有位翻转后的位集合
+         */
+        dynamic_bitset operator~() const {
+            dynamic_bitset temp(*this);
+            temp.flip();
+            return temp;
+        }
+
+        /*
+         * 交换两个位集合
+         */
+        void swap(dynamic_bitset &rhs) noexcept {
+            tinySTL::swap(blocks_, rhs.blocks_);
+            tinySTL::swap(size_, rhs.size_);
+            tinySTL::swap(cap_, rhs.cap_);
+        }
+
+        /*
+         * 与另一个位集合是否相等
+         */
+        bool equal(const dynamic_bitset &rhs) const noexcept {
+            return size_ == rhs.size_ &&
+                   (size_ == 0 || std::memcmp(blocks_, rhs.blocks_, num_blocks() * sizeof(block_type)) == 0);
+        }
+
+        /*
+         * 重载 << 操作符，下标大的位先输出，与 std::bitset 的输出格式一致
+         */
+        friend std::ostream &operator<<(std::ostream &os, const dynamic_bitset &bs) {
+            for (size_type i = bs.size_; i > 0; --i) {
+                os << (bs[i - 1] ? '1' : '0');
+            }
+            return os;
+        }
+
+    private:
+        /*
+         * 私有的辅助函数
+         */
+
+        /*
+         * 容纳 n 个位需要的块数
+         */
+        static size_type block_count(size_type n) noexcept {
+            return (n + bits_per_block - 1) / bits_per_block;
+        }
+
+        /*
+         * 位置 pos 所在的块的下标
+         */
+        static size_type block_index(size_type pos) noexcept {
+            return pos / bits_per_block;
+        }
+
+        /*
+         * 位置 pos 在块中的下标
+         */
+        static size_type bit_index(size_type pos) noexcept {
+            return pos % bits_per_block;
+        }
+
+        /*
+         * 统计一个块中值为 1 的位数
+         */
+        static size_type popcount(block_type x) noexcept;
+
+        /*
+         * 返回一个非 0 块中最低位的 1 的下标
+         */
+        static size_type lowest_bit(block_type x) noexcept;
+
+        /*
+         * 申请能容纳 n 个位的空间
+         */
+        void init_space(size_type n);
+
+        /*
+         * 将最后一个块中超出 size_ 的高位清 0
+         */
+        void clear_unused_bits() noexcept {
+            const size_type extra = bit_index(size_);
+            if (extra != 0) {
+                blocks_[block_index(size_)] &= (block_type(1) << extra) - 1;
+            }
+        }
+
+        /*
+         * 从位置 pos 开始查找第一个值为 1 的位
+         */
+        size_type find_from(size_type pos) const noexcept;
+    };
+
+    // ==============================================================================================
+
+    /*
+     * 类成员函数
+     */
+
+    /*
+     * 预留能容纳 n 个位的空间
+     */
+    inline void dynamic_bitset::reserve(size_type n) {
+        const size_type need = block_count(n);
+        if (need > cap_) {
+            block_type *new_blocks = data_allocator::allocate(need);
+            if (blocks_ != nullptr) {
+                std::memcpy(new_blocks, blocks_, num_blocks() * sizeof(block_type));
+            }
+            data_allocator::deallocate(blocks_, cap_);
+            blocks_ = new_blocks;
+            cap_ = need;
+        }
+    }
+
+    /*
+     * 将位的个数调整为 n，新增的位以 value 填充
+     */
+    inline void dynamic_bitset::resize(size_type n, bool value) {
+        if (n > capacity()) {
+            reserve(tinySTL::max(n, capacity() * 2));
+        }
+        if (n > size_) {
+            const size_type old_blocks = num_blocks();
+            const size_type new_blocks = block_count(n);
+            /* 旧的最后一个块中 size_ 之后的位已经是 0，只有 value 为 1 时需要补齐 */
+            if (value && bit_index(size_) != 0) {
+                blocks_[old_blocks - 1] |= ~((block_type(1) << bit_index(size_)) - 1);
+            }
+            std::memset(blocks_ + old_blocks, value ? 0xff : 0, (new_blocks - old_blocks) * sizeof(block_type));
+        }
+        size_ = n;
+        clear_unused_bits();
+    }
+
+    /*
+     * 在尾部添加一个位
+     */
+    inline void dynamic_bitset::push_back(bool value) {
+        if (size_ == capacity()) {
+            reserve(tinySTL::max(static_cast<size_type>(bits_per_block), capacity() * 2));
+        }
+        if (bit_index(size_) == 0) {
+            /* 新的块需要先清 0 */
+            blocks_[block_index(size_)] = 0;
+        }
+        if (value) {
+            blocks_[block_index(size_)] |= block_type(1) << bit_index(size_);
+        }
+        ++size_;
+    }
+
+    /*
+     * 将所有位置为 1
+     */
+    inline dynamic_bitset &dynamic_bitset::set() noexcept {
+        if (blocks_ != nullptr) {
+            std::memset(blocks_, 0xff, num_blocks() * sizeof(block_type));
+            clear_unused_bits();
+        }
+        return *this;
+    }
+
+    /*
+     * 翻转所有位
+     */
+    inline dynamic_bitset &dynamic_bitset::flip() noexcept {
+        const size_type n = num_blocks();
+        for (size_type i = 0; i < n; ++i) {
+            blocks_[i] = ~blocks_[i];
+        }
+        clear_unused_bits();
+        return *this;
+    }
+
+    /*
+     * 返回值为 1 的位的个数
+     * 每次统计一个块，四路累加减少循环依赖
+     */
+    inline dynamic_bitset::size_type dynamic_bitset::count() const noexcept {
+        const size_type n = num_blocks();
+        size_type c0 = 0, c1 = 0, c2 = 0, c3 = 0;
+        size_type i = 0;
+        for (; i + 4 <= n; i += 4) {
+            c0 += popcount(blocks_[i]);
+            c1 += popcount(blocks_[i + 1]);
+            c2 += popcount(blocks_[i + 2]);
+            c3 += popcount(blocks_[i + 3]);
+        }
+        for (; i < n; ++i) {
+            c0 += popcount(blocks_[i]);
+        }
+        return c0 + c1 + c2 + c3;
+    }
+
+    /*
+     * 是否存在值为 1 的位
+     */
+    inline bool dynamic_bitset::any() const noexcept {
+        const size_type n = num_blocks();
+        for (size_type i = 0; i < n; ++i) {
+            if (blocks_[i] != 0) {
+                return true;
+            }
+        }
+        return false;
+    }
+
+    /*
+     * 是否所有位都为 1
+     */
+    inline bool dynamic_bitset::all() const noexcept {
+        const size_type full = size_ / bits_per_block;
+        for (size_type i = 0; i < full; ++i) {
+            if (blocks_[i] != ~block_type(0)) {
+                return false;
+            }
+        }
+        const size_type extra = bit_index(size_);
+        return extra == 0 || blocks_[full] == (block_type(1) << extra) - 1;
+    }
+
+    /*
+     * 与另一个位集合是否存在同时为 1 的位
+     */
+    inline bool dynamic_bitset::intersects(const dynamic_bitset &rhs) const noexcept {
+        const size_type n = tinySTL::min(num_blocks(), rhs.num_blocks());
+        for (size_type i = 0; i < n; ++i) {
+            if ((blocks_[i] & rhs.blocks_[i]) != 0) {
+                return true;
+            }
+        }
+        return false;
+    }
+
+    /*
+     * 按位与
+     */
+    inline dynamic_bitset &dynamic_bitset::operator&=(const dynamic_bitset &rhs) noexcept {
+        TINYSTL_DEBUG(size_ == rhs.size_);
+        const size_type n = num_blocks();
+        block_type *dst = blocks_;
+        const block_type *src = rhs.blocks_;
+        for (size_type i = 0; i < n; ++i) {
+            dst[i] &= src[i];
+        }
+        return *this;
+    }
+
+    /*
+     * 按位或
+     */
+    inline dynamic_bitset &dynamic_bitset::operator|=(const dynamic_bitset &rhs) noexcept {
+        TINYSTL_DEBUG(size_ == rhs.size_);
+        const size_type n = num_blocks();
+        block_type *dst = blocks_;
+        const block_type *src = rhs.blocks_;
+        for (size_type i = 0; i < n; ++i) {
+            dst[i] |= src[i];
+        }
+        return *this;
+    }
+
+    /*
+     * 按位异或
+     */
+    inline dynamic_bitset &dynamic_bitset::operator^=(const dynamic_bitset &rhs) noexcept {
+        TINYSTL_DEBUG(size_ == rhs.size_);
+        const size_type n = num_blocks();
+        block_type *dst = blocks_;
+        const block_type *src = rhs.blocks_;
+        for (size_type i = 0; i < n; ++i) {
+            dst[i] ^= src[i];
+        }
+        return *this;
+    }
+
+    /*
+     * 将下标为 i 的位移动到下标 i + n 处，低位补 0
+     * 先按整块移动，再在块之间移动剩余的位
+     */
+    inline dynamic_bitset &dynamic_bitset::operator<<=(size_type n) noexcept {
+        if (n >= size_) {
+            return reset();
+        }
+        const size_type nb = num_blocks();
+        const size_type block_shift = n / bits_per_block;
+        const size_type bit_shift = n % bits_per_block;
+        if (bit_shift == 0) {
+            for (size_type i = nb - 1; i >= block_shift; --i) {
+                blocks_[i] = blocks_[i - block_shift];
+                if (i == block_shift) {
+                    break;
+                }
+            }
+        } else {
+            const size_type rest = bits_per_block - bit_shift;
+            for (size_type i = nb - 1; i > block_shift; --i) {
+                blocks_[i] = (blocks_[i - block_shift] << bit_shift) |
+                             (blocks_[i - block_shift - 1] >> rest);
+            }
+            blocks_[block_shift] = blocks_[0] << bit_shift;
+        }
+        std::memset(blocks_, 0, block_shift * sizeof(block_type));
+        clear_unused_bits();
+        return *this;
+    }
+
+    /*
+     * 将下标为 i 的位移动到下标 i - n 处，高位补 0
+     */
+    inline dynamic_bitset &dynamic_bitset::operator>>=(size_type n) noexcept {
+        if (n >= size_) {
+            return reset();
+        }
+        const size_type nb = num_blocks();
+        const size_type block_shift = n / bits_per_block;
+        const size_type bit_shift = n % bits_per_block;
+        const size_type last = nb - block_shift - 1;
+        if (bit_shift == 0) {
+            for (size_type i = 0; i <= last; ++i) {
+                blocks_[i] = blocks_[i + block_shift];
+            }
+        } else {
+            const size_type rest = bits_per_block - bit_shift;
+            for (size_type i = 0; i < last; ++i) {
+                blocks_[i] = (blocks_[i + block_shift] >> bit_shift) |
+                             (blocks_[i + block_shift + 1] << rest);
+            }
+            blocks_[last] = blocks_[nb - 1] >> bit_shift;
+        }
+        std::memset(blocks_ + last + 1, 0, block_shift * sizeof(block_type));
+        return *this;
+    }
+
+    /*
+     * 统计一个块中值为 1 的位数
+     * 编译器支持时使用 popcnt 指令，否则使用并行计数的位运算技巧
+     */
+    inline dynamic_bitset::size_type dynamic_bitset::popcount(block_type x) noexcept {
+#if defined(__GNUC__) || defined(__clang__)
+        return static_cast<size_type>(__builtin_popcountll(x));
+#else
+        x = x - ((x >> 1) & 0x5555555555555555ull);
+        x = (x & 0x3333333333333333ull) + ((x >> 2) & 0x3333333333333333ull);
+        x = (x + (x >> 4)) & 0x0f0f0f0f0f0f0f0full;
+        return static_cast<size_type>((x * 0x0101010101010101ull) >> 56);
+#endif
+    }
+
+    /*
+     * 返回一个非 0 块中最低位的 1 的下标
+     */
+    inline dynamic_bitset::size_type dynamic_bitset::lowest_bit(block_type x) noexcept {
+#if defined(__GNUC__) || defined(__clang__)
+        return static_cast<size_type>(__builtin_ctzll(x));
+#else
+        /* 只保留最低位的 1，再统计其下方 0 的个数 */
+        return popcount((x & (0 - x)) - 1);
+#endif
+    }
+
+    /*
+     * 申请能容纳 n 个位的空间
+     */
+    inline void dynamic_bitset::init_space(size_type n) {
+        const size_type need = block_count(n);
+        blocks_ = data_allocator::allocate(need);
+        cap_ = need;
+    }
+
+    /*
+     * 从位置 pos 开始查找第一个值为 1 的位
+     * 先屏蔽起始块中 pos 之前的位，之后逐块跳过全 0 的块
+     */
+    inline dynamic_bitset::size_type dynamic_bitset::find_from(size_type pos) const noexcept {
+        if (pos >= size_) {
+            return npos;
+        }
+        const size_type nb = num_blocks();
+        size_type i = block_index(pos);
+        block_type x = blocks_[i] & (~block_type(0) << bit_index(pos));
+        while (x == 0) {
+            if (++i == nb) {
+                return npos;
+            }
+            x = blocks_[i];
+        }
+        return i * bits_per_block + lowest_bit(x);
+    }
+
+    // ==============================================================================================
+
+    /*
+     * 重载全局的操作符
+     */
+
+    /*
+     * 重载按位与运算符
+     */
+    inline dynamic_bitset operator&(const dynamic_bitset &lhs, const dynamic_bitset &rhs) {
+        dynamic_bitset temp(lhs);
+        temp &= rhs;
+        return temp;
+    }
+
+    /*
+     * 重载按位或运算符
+     */
+    inline dynamic_bitset operator|(const dynamic_bitset &lhs, const dynamic_bitset &rhs) {
+        dynamic_bitset temp(lhs);
+        temp |= rhs;
+        return temp;
+    }
+
+    /*
+     * 重载按位异或运算符
+     */
+    inline dynamic_bitset operator^(const dynamic_bitset &lhs, const dynamic_bitset &rhs) {
+        dynamic_bitset temp(lhs);
+        temp ^= rhs;
+        return temp;
+    }
+
+    /*
+     * 重载相等运算符
+     */
+    inline bool operator==(const dynamic_bitset &lhs, const dynamic_bitset &rhs) {
+        return lhs.equal(rhs);
+    }
+
+    /*
+     * 重载不相等运算符
+     */
+    inline bool operator!=(const dynamic_bitset &lhs, const dynamic_bitset &rhs) {
+        return !(lhs == rhs);
+    }
+
+    /*
+     * 重载 tinySTL 的 swap
+     */
+    inline void swap(dynamic_bitset &lhs, dynamic_bitset &rhs) noexcept {
+        lhs.swap(rhs);
+    }
+
+}  // namespace tinySTL
+
+#endif //TINYSTL_DYNAMIC_BITSET_H
@@ -0,0 +1,1072 @@
+//
+// Created by cqupt1811 on 2022/5/25.
+//
+
+/*
+ * 这个头文件包含执行策略 seq、unseq、par、par_unseq 与 deterministic(policy)，以及 algo.h、numeric.h 中部分算法的并行版本
+ * for_each, transform, reduce, accumulate, transform_reduce, inclusive_scan, exclusive_scan,
+ * count, count_if, find, find_if, fill, copy, merge, multiway_merge, sort, stable_sort, partial_sort
+ * 并行版本的第一个参数为执行策略，区间需要是随机访问迭代器(vector、deque、原生数组)，否则退化为串行版本
+ * 输入被切分为若干块，交给全局共享的工作窃取线程池(thread_pool.h)执行，调用线程也参与执行；输入较小时直接串行执行
+ * 线程数默认为 std::thread::hardware_concurrency()，可以用环境变量 TINYSTL_NUM_THREADS 指定
+ * 与标准库不同，函数对象抛出的异常不会调用 std::terminate，而是在所有块结束后把第一个异常重新抛出
+ */
+
+#ifndef TINYSTL_EXECUTION_H
+#define TINYSTL_EXECUTION_H
+
+#include <cstddef>  /* 定义了 size_t 等常用类型 */
+#include <atomic>  /* std::atomic 原子类型 */
+#include "algo.h"  /* 这个头文件包含了 tinySTL 的一系列算法 */
+#include "numeric.h"  /* 这个头文件包含了 tinySTL 的数值算法 */
+#include "multiway_merge.h"  /* 这个头文件包含多路归并 multiway_merge 与多序列选择 multiseq_partition */
+#include "functional.h"  /* 这个头文件包含了 tinySTL 的函数对象与哈希函数 */
+#include "iterator.h"  /* 这个头文件用于迭代器设计，包含了一些模板结构体与全局函数 */
+#include "type_traits.h"  /* 这个头文件用于提取类型信息 */
+#include "vector.h"  /* 这个头文件包含一个模板类 vector */
+#include "thread_pool.h"  /* 这个头文件包含工作窃取线程池 thread_pool 与 parallel_for 等并行原语 */
+
+/* 首先定义自己的命名空间 */
+namespace tinySTL {
+
+    // ===========================================================================================
+    /*
+     * 执行策略
+     * seq       串行执行
+     * unseq     串行执行，并允许向量化
+     * par       并行执行
+     * par_unseq 并行执行，并允许在块内向量化
+     * 允许向量化时，reduce、accumulate、transform_reduce 与前缀和对连续的算术类型区间会改变加法的结合顺序，
+     * 浮点数的结果可能有舍入误差上的差别；其他算法与不允许向量化时相同(串行版本已经在结果不变的前提下使用 SIMD 内核)
+     *
+     * deterministic(policy) 为确定性的版本：reduce、transform_reduce 与前缀和按只与元素个数有关的方式分块，
+     * 各块的结果按固定的顺序合并，因此对于同一个执行策略，浮点数的结果与线程数无关，可以复现
+     * (向量化时块内的加法顺序还与 CPU 支持的向量宽度有关)；其他算法的结果本来就与分块无关
+     */
+    namespace execution {
+
+        class sequenced_policy {
+        };
+
+        class unsequenced_policy {
+        };
+
+        class parallel_policy {
+        };
+
+        class parallel_unsequenced_policy {
+        };
+
+        constexpr sequenced_policy seq{};
+        constexpr unsequenced_policy unseq{};
+        constexpr parallel_policy par{};
+        constexpr parallel_unsequenced_policy par_unseq{};
+
+        template<typename ExecutionPolicy>
+        class deterministic_policy {
+        };
+
+        template<typename ExecutionPolicy>
+        constexpr deterministic_policy<typename std::decay<ExecutionPolicy>::type> deterministic(ExecutionPolicy &&) {
+            return {};
+        }
+
+    }  // namespace execution
+
+    /*
+     * 判断一个类型是否为执行策略
+     */
+    template<typename T>
+    struct is_execution_policy : public m_false_type {
+    };
+
+    template<>
+    struct is_execution_policy<execution::sequenced_policy> : public m_true_type {
+    };
+
+    template<>
+    struct is_execution_policy<execution::unsequenced_policy> : public m_true_type {
+    };
+
+    template<>
+    struct is_execution_policy<execution::parallel_policy> : public m_true_type {
+    };
+
+    template<>
+    struct is_execution_policy<execution::parallel_unsequenced_policy> : public m_true_type {
+    };
+
+    template<typename ExecutionPolicy>
+    struct is_execution_policy<execution::deterministic_policy<ExecutionPolicy>>
+            : public is_execution_policy<ExecutionPolicy> {
+    };
+
+    namespace execution_detail {
+
+        /*
+         * 只有 ExecutionPolicy 为执行策略时重载才参与决议，避免与原有的串行版本冲突
+         */
+        template<typename ExecutionPolicy, typename T>
+        using enable_if_policy_t = typename std::enable_if<
+                is_execution_policy<typename std::decay<ExecutionPolicy>::type>::value, T>::type;
+
+        /*
+         * 去掉 deterministic_policy 后的执行策略
+         */
+        template<typename ExecutionPolicy>
+        struct base_policy {
+            typedef ExecutionPolicy type;
+        };
+
+        template<typename ExecutionPolicy>
+        struct base_policy<execution::deterministic_policy<ExecutionPolicy>> {
+            typedef ExecutionPolicy type;
+        };
+
+        template<typename ExecutionPolicy>
+        using base_policy_t = typename base_policy<typename std::decay<ExecutionPolicy>::type>::type;
+
+        template<typename ExecutionPolicy>
+        struct is_deterministic : public m_bool_constant<
+                !std::is_same<typename std::decay<ExecutionPolicy>::type, base_policy_t<ExecutionPolicy>>::value> {
+        };
+
+        /*
+         * 执行策略是否允许向量化
+         */
+        template<typename ExecutionPolicy>
+        struct allow_unsequenced : public m_bool_constant<
+                std::is_same<base_policy_t<ExecutionPolicy>, execution::unsequenced_policy>::value
+                || std::is_same<base_policy_t<ExecutionPolicy>, execution::parallel_unsequenced_policy>::value> {
+        };
+
+        /*
+         * 执行策略要求并行，并且所有迭代器都是随机访问迭代器时才并行执行
+         */
+        template<typename ExecutionPolicy, typename... Iters>
+        struct use_parallel;
+
+        template<typename ExecutionPolicy>
+        struct use_parallel<ExecutionPolicy> : public m_bool_constant<
+                !std::is_same<base_policy_t<ExecutionPolicy>, execution::sequenced_policy>::value
+                && !std::is_same<base_policy_t<ExecutionPolicy>, execution::unsequenced_policy>::value> {
+        };
+
+        template<typename ExecutionPolicy, typename Iter, typename... Iters>
+        struct use_parallel<ExecutionPolicy, Iter, Iters...> : public m_bool_constant<
+                is_random_access_iterator<Iter>::value && use_parallel<ExecutionPolicy, Iters...>::value> {
+        };
+
+        /*
+         * 每块的最少元素个数，块太小时调度的开销会超过并行的收益
+         */
+        const size_t kGrainSize = 1 << 14;
+
+        /*
+         * 排序时每块的最少元素个数
+         */
+        const size_t kSortGrainSize = 1 << 15;
+
+        /*
+         * 并行算法使用全局共享的线程池
+         */
+        inline thread_pool &shared_pool() {
+            return default_thread_pool();
+        }
+
+        /*
+         * 执行 func(0) ... func(n - 1)，全部完成后返回
+         */
+        template<typename Function>
+        void run_tasks(size_t n, const Function &func) {
+            tinySTL::parallel_for(shared_pool(), static_cast<size_t>(0), n, 1, [&func](size_t begin, size_t end) {
+                for (; begin < end; ++begin) {
+                    func(begin);
+                }
+            });
+        }
+
+        /*
+         * 把 n 个元素切分为多少块：每块不少于 grain 个元素，块数为线程数的若干倍，以便在各块耗时不均时平衡负载
+         */
+        inline size_t chunk_count(size_t n, size_t grain) {
+            const size_t threads = shared_pool().concurrency();
+            if (threads == 1) {
+                return 1;
+            }
+            const size_t chunks = n / grain;
+            return chunks == 0 ? 1 : (chunks < threads * 4 ? chunks : threads * 4);
+        }
+
+        /*
+         * 确定性的执行策略下归约与前缀和的块数为 ceil(n / kDeterministicBlock)，各块均分 n 个元素，只与元素个数有关
+         */
+        const size_t kDeterministicBlock = 1 << 16;
+
+        inline size_t reduce_chunk_count(size_t n, m_false_type) {
+            return chunk_count(n, kGrainSize);
+        }
+
+        inline size_t reduce_chunk_count(size_t n, m_true_type) {
+            return n <= kDeterministicBlock ? 1 : (n + kDeterministicBlock - 1) / kDeterministicBlock;
+        }
+
+        /*
+         * 把 [0, n) 切分为若干块，并行执行 func(begin, end)
+         */
+        template<typename Function>
+        void parallel_chunks(size_t n, size_t grain, const Function &func) {
+            const size_t chunks = chunk_count(n, grain);
+            if (chunks == 1) {
+                func(static_cast<size_t>(0), n);
+                return;
+            }
+            run_tasks(chunks, [&](size_t i) {
+                func(n * i / chunks, n * (i + 1) / chunks);
+            });
+        }
+
+        // =======================================================================================
+        // 并行合并：按输出位置切分，每块用二分查找求出两个输入中对应的起点，各块独立合并
+
+        /*
+         * 合并结果的前 i 个元素中，有多少个来自 [a, a + m)
+         * 与 tinySTL::merge 相同，只有 comp(*b, *a) 为真时才先取第二个序列的元素，相等的元素保持原有次序
+         */
+        template<typename RandomIter1, typename RandomIter2, typename Compared>
+        size_t merge_split(RandomIter1 a, size_t m, RandomIter2 b, size_t n, size_t i, Compared comp) {
+            size_t lo = i > n ? i - n : 0;
+            size_t hi = i < m ? i : m;
+            while (lo < hi) {
+                const size_t j = lo + (hi - lo) / 2;
+                if (!comp(*(b + (i - j - 1)), *(a + j))) {
+                    lo = j + 1;
+                } else {
+                    hi = j;
+                }
+            }
+            return lo;
+        }
+
+        template<typename Iter1, typename Iter2>
+        void merge_assign(Iter1 dst, Iter2 src, m_true_type) {
+            *dst = tinySTL::move(*src);
+        }
+
+        template<typename Iter1, typename Iter2>
+        void merge_assign(Iter1 dst, Iter2 src, m_false_type) {
+            *dst = *src;
+        }
+
+        /*
+         * 串行合并，Move 为 true 时移动元素而不是复制
+         */
+        template<bool Move, typename RandomIter1, typename RandomIter2, typename RandomIter3, typename Compared>
+        RandomIter3 merge_block(RandomIter1 first1, RandomIter1 last1, RandomIter2 first2, RandomIter2 last2,
+                                RandomIter3 result, Compared comp) {
+            const m_bool_constant<Move> move_tag;
+            while (first1 != last1 && first2 != last2) {
+                if (comp(*first2, *first1)) {
+                    merge_assign(result, first2, move_tag);
+                    ++first2;
+                } else {
+                    merge_assign(result, first1, move_tag);
+                    ++first1;
+                }
+                ++result;
+            }
+            for (; first1 != last1; ++first1, ++result) {
+                merge_assign(result, first1, move_tag);
+            }
+            for (; first2 != last2; ++first2, ++result) {
+                merge_assign(result, first2, move_tag);
+            }
+            return result;
+        }
+
+        /*
+         * 先求出所有块在两个输入中的起点，再并行合并各块；
+         * 移动元素时其他块可能还在二分查找，因此两步不能合在一起
+         */
+        template<bool Move, typename RandomIter1, typename RandomIter2, typename RandomIter3, typename Compared>
+        RandomIter3 parallel_merge(RandomIter1 first1, RandomIter1 last1, RandomIter2 first2, RandomIter2 last2,
+                                   RandomIter3 result, Compared comp) {
+            const size_t m = static_cast<size_t>(last1 - first1);
+            const size_t n = static_cast<size_t>(last2 - first2);
+            const size_t chunks = chunk_count(m + n, kGrainSize);
+            if (chunks == 1) {
+                return merge_block<Move>(first1, last1, first2, last2, result, comp);
+            }
+            tinySTL::vector<size_t> splits(chunks + 1, 0);
+            splits[chunks] = m;
+            run_tasks(chunks - 1, [&](size_t i) {
+                splits[i + 1] = merge_split(first1, m, first2, n, (m + n) * (i + 1) / chunks, comp);
+            });
+            run_tasks(chunks, [&](size_t i) {
+                const size_t begin = (m + n) * i / chunks, end = (m + n) * (i + 1) / chunks;
+                merge_block<Move>(first1 + splits[i], first1 + splits[i + 1], first2 + (begin - splits[i]),
+                                  first2 + (end - splits[i + 1]), result + begin, comp);
+            });
+            return result + (m + n);
+        }
+
+        /*
+         * 并行地把 [first, last) 移动到 result
+         */
+        template<typename RandomIter1, typename RandomIter2>
+        void parallel_move(RandomIter1 first, RandomIter1 last, RandomIter2 result) {
+            parallel_chunks(static_cast<size_t>(last - first), kGrainSize, [&](size_t begin, size_t end) {
+                tinySTL::move(first + begin, first + end, result + begin);
+            });
+        }
+
+        // =======================================================================================
+        /*
+         * 并行排序：先把区间切分为 2 的幂个块，用 chunk_sort 并行排序各块，再逐轮两两并行合并
+         * 合并在原区间与同样大小的临时缓冲区之间交替进行，申请不到缓冲区时逐轮使用 inplace_merge
+         * 合并总是把靠前的块作为第一个序列，因此 chunk_sort 稳定时整个排序也是稳定的
+         */
+        template<typename RandomIter, typename Compared, typename ChunkSort>
+        void parallel_sort(RandomIter first, RandomIter last, Compared comp, ChunkSort chunk_sort) {
+            typedef typename iterator_traits<RandomIter>::value_type value_type;
+            const size_t n = static_cast<size_t>(last - first);
+            thread_pool &pool = shared_pool();
+            size_t chunks = 1;
+            while (chunks < pool.concurrency() && n / (chunks * 2) >= kSortGrainSize) {
+                chunks *= 2;
+            }
+            if (chunks == 1) {
+                chunk_sort(first, last);
+                return;
+            }
+            tinySTL::vector<size_t> bounds(chunks + 1, 0);
+            for (size_t i = 0; i <= chunks; ++i) {
+                bounds[i] = n * i / chunks;
+            }
+            run_tasks(chunks, [&](size_t i) {
+                chunk_sort(first + bounds[i], first + bounds[i + 1]);
+            });
+            tinySTL::temporary_buffer<RandomIter, value_type> buf(first, last);
+            const bool buffered = static_cast<size_t>(buf.size()) == n;
+            value_type *buffer = buf.begin();
+            bool in_buffer = false;
+            for (size_t width = 1; width < chunks; width *= 2) {
+                for (size_t i = 0; i + width < chunks; i += width * 2) {
+                    const size_t lo = bounds[i], mid = bounds[i + width];
+                    const size_t hi = bounds[i + width * 2 < chunks ? i + width * 2 : chunks];
+                    if (!buffered) {
+                        tinySTL::inplace_merge(first + lo, first + mid, first + hi, comp);
+                    } else if (in_buffer) {
+                        parallel_merge<true>(buffer + lo, buffer + mid, buffer + mid, buffer + hi, first + lo, comp);
+                    } else {
+                        parallel_merge<true>(first + lo, first + mid, first + mid, first + hi, buffer + lo, comp);
+                    }
+                }
+                in_buffer = buffered && !in_buffer;
+            }
+            if (in_buffer) {
+                parallel_move(buffer, buffer + n, first);
+            }
+        }
+
+    }  // namespace execution_detail
+
+    // ===========================================================================================
+    // for_each, transform
+    // 各个 *_dispatch 的最后一个参数为 m_false_type 时是串行版本，为 m_true_type 时是并行版本
+
+    template<typename ForwardIter, typename Function>
+    void for_each_dispatch(ForwardIter first, ForwardIter last, Function func, m_false_type) {
+        tinySTL::for_each(first, last, func);
+    }
+
+    template<typename RandomIter, typename Function>
+    void for_each_dispatch(RandomIter first, RandomIter last, Function func, m_true_type) {
+        execution_detail::parallel_chunks(static_cast<size_t>(last - first), execution_detail::kGrainSize,
+                                          [&](size_t begin, size_t end) {
+                                              tinySTL::for_each(first + begin, first + end, func);
+                                          });
+    }
+
+    /*
+     * 对 [first, last) 中的每个元素调用 func，func 会被多个线程同时调用
+     */
+    template<typename ExecutionPolicy, typename ForwardIter, typename Function>
+    execution_detail::enable_if_policy_t<ExecutionPolicy, void>  // 返回值
+    for_each(ExecutionPolicy &&, ForwardIter first, ForwardIter last, Function func) {
+        tinySTL::for_each_dispatch(first, last, func,
+                                   execution_detail::use_parallel<ExecutionPolicy, ForwardIter>());
+    }
+
+    template<typename ForwardIter1, typename ForwardIter2, typename UnaryOperation>
+    ForwardIter2 transform_dispatch(ForwardIter1 first, ForwardIter1 last, ForwardIter2 result,
+                                    UnaryOperation unary_op, m_false_type) {
+        return tinySTL::transform(first, last, result, unary_op);
+    }
+
+    template<typename RandomIter1, typename RandomIter2, typename UnaryOperation>
+    RandomIter2 transform_dispatch(RandomIter1 first, RandomIter1 last, RandomIter2 result,
+                                   UnaryOperation unary_op, m_true_type) {
+        const size_t n = static_cast<size_t>(last - first);
+        execution_detail::parallel_chunks(n, execution_detail::kGrainSize, [&](size_t begin, size_t end) {
+            tinySTL::transform(first + begin, first + end, result + begin, unary_op);
+        });
+        return result + n;
+    }
+
+    template<typename ExecutionPolicy, typename ForwardIter1, typename ForwardIter2, typename UnaryOperation>
+    execution_detail::enable_if_policy_t<ExecutionPolicy, ForwardIter2>  // 返回值
+    transform(ExecutionPolicy &&, ForwardIter1 first, ForwardIter1 last, ForwardIter2 result,
+              UnaryOperation unary_op) {
+        return tinySTL::transform_dispatch(first, last, result, unary_op,
+                                           execution_detail::use_parallel<ExecutionPolicy, ForwardIter1,
+                                                   ForwardIter2>());
+    }
+
+    template<typename ForwardIter1, typename ForwardIter2, typename ForwardIter3, typename BinaryOperation>
+    ForwardIter3 transform_dispatch(ForwardIter1 first1, ForwardIter1 last1, ForwardIter2 first2,
+                                    ForwardIter3 result, BinaryOperation binary_op, m_false_type) {
+        return tinySTL::transform(first1, last1, first2, result, binary_op);
+    }
+
+    template<typename RandomIter1, typename RandomIter2, typename RandomIter3, typename BinaryOperation>
+    RandomIter3 transform_dispatch(RandomIter1 first1, RandomIter1 last1, RandomIter2 first2,
+                                   RandomIter3 result, BinaryOperation binary_op, m_true_type) {
+        const size_t n = static_cast<size_t>(last1 - first1);
+        execution_detail::parallel_chunks(n, execution_detail::kGrainSize, [&](size_t begin, size_t end) {
+            tinySTL::transform(first1 + begin, first1 + end, first2 + begin, result + begin, binary_op);
+        });
+        return result + n;
+    }
+
+    template<typename ExecutionPolicy, typename ForwardIter1, typename ForwardIter2, typename ForwardIter3,
+            typename BinaryOperation>
+    execution_detail::enable_if_policy_t<ExecutionPolicy, ForwardIter3>  // 返回值
+    transform(ExecutionPolicy &&, ForwardIter1 first1, ForwardIter1 last1, ForwardIter2 first2,
+              ForwardIter3 result, BinaryOperation binary_op) {
+        return tinySTL::transform_dispatch(first1, last1, first2, result, binary_op,
+                                           execution_detail::use_parallel<ExecutionPolicy, ForwardIter1,
+                                                   ForwardIter2, ForwardIter3>());
+    }
+
+    // ===========================================================================================
+    // reduce, accumulate, transform_reduce
+    // 每块从自己的第一个元素开始累积，各块的结果再按顺序与 init 合并，因此 binary_op 只需满足结合律
+
+    namespace execution_detail {
+
+        /*
+         * 区间是连续的算术类型并且 binary_op 为 tinySTL::plus<T> 时，块内使用 SIMD 求和：
+         * 整数的结果与顺序无关，总是可以向量化；浮点数要求执行策略允许向量化
+         */
+        template<typename ExecutionPolicy, typename Iter, typename T, typename BinaryOp>
+        struct use_simd_sum : public m_bool_constant<
+                (allow_unsequenced<ExecutionPolicy>::value || std::is_integral<T>::value)
+                && simd::is_simd_range<Iter, T>::value && std::is_same<BinaryOp, tinySTL::plus<T>>::value> {
+        };
+
+        /*
+         * 两个区间都是连续的算术类型，并且使用默认的加法与乘法时，块内使用 SIMD 点积
+         */
+        template<typename ExecutionPolicy, typename Iter1, typename Iter2, typename T,
+                typename BinaryOp1, typename BinaryOp2>
+        struct use_simd_dot : public m_bool_constant<
+                (allow_unsequenced<ExecutionPolicy>::value || std::is_integral<T>::value)
+                && simd::is_simd_range<Iter1, T>::value && simd::is_simd_range<Iter2, T>::value
+                && std::is_same<BinaryOp1, tinySTL::plus<T>>::value
+                && std::is_same<BinaryOp2, tinySTL::multiplies<T>>::value> {
+        };
+
+        template<typename Iter, typename T, typename BinaryOp>
+        T accumulate_block(Iter first, Iter last, T init, BinaryOp binary_op, m_false_type) {
+            return tinySTL::accumulate(first, last, tinySTL::move(init), binary_op);
+        }
+
+        template<typename Ptr, typename T, typename BinaryOp>
+        T accumulate_block(Ptr first, Ptr last, T init, BinaryOp, m_true_type) {
+            return simd::sum(first, static_cast<size_t>(last - first), init);
+        }
+
+        template<typename Iter1, typename Iter2, typename T, typename BinaryOp1, typename BinaryOp2>
+        T inner_product_block(Iter1 first1, Iter1 last1, Iter2 first2, T init, BinaryOp1 reduce_op,
+                              BinaryOp2 transform_op, m_false_type) {
+            return tinySTL::inner_product(first1, last1, first2, tinySTL::move(init), reduce_op, transform_op);
+        }
+
+        template<typename Ptr1, typename Ptr2, typename T, typename BinaryOp1, typename BinaryOp2>
+        T inner_product_block(Ptr1 first1, Ptr1 last1, Ptr2 first2, T init, BinaryOp1, BinaryOp2, m_true_type) {
+            return simd::dot(first1, first2, static_cast<size_t>(last1 - first1), init);
+        }
+
+        /*
+         * 把 [0, n) 切分为 chunks 块，并行求出每块的归约值 chunk_reduce(begin, end)，再按顺序与 init 合并
+         */
+        template<typename T, typename BinaryOp, typename ChunkReduce>
+        T reduce_chunks(size_t n, size_t chunks, T init, BinaryOp binary_op, const ChunkReduce &chunk_reduce) {
+            if (n == 0) {
+                return init;
+            }
+            if (chunks == 1) {
+                return binary_op(tinySTL::move(init), chunk_reduce(0, n));
+            }
+            tinySTL::vector<T> partial(chunks, init);
+            run_tasks(chunks, [&](size_t i) {
+                partial[i] = chunk_reduce(n * i / chunks, n * (i + 1) / chunks);
+            });
+            for (size_t i = 0; i < chunks; ++i) {
+                init = binary_op(tinySTL::move(init), partial[i]);
+            }
+            return init;
+        }
+
+    }  // namespace execution_detail
+
+    template<typename ForwardIter, typename T, typename BinaryOp, typename Vectorize, typename Deterministic>
+    T reduce_dispatch(ForwardIter first, ForwardIter last, T init, BinaryOp binary_op,
+                      m_false_type, Vectorize, Deterministic) {
+        return execution_detail::accumulate_block(first, last, init, binary_op, Vectorize());
+    }
+
+    template<typename RandomIter, typename T, typename BinaryOp, typename Vectorize, typename Deterministic>
+    T reduce_dispatch(RandomIter first, RandomIter last, T init, BinaryOp binary_op,
+                      m_true_type, Vectorize, Deterministic) {
+        const size_t n = static_cast<size_t>(last - first);
+        return execution_detail::reduce_chunks(
+                n, execution_detail::reduce_chunk_count(n, Deterministic()), init, binary_op,
+                [&](size_t b, size_t e) {
+                    RandomIter begin = first + b;
+                    T acc = *begin;
+                    return execution_detail::accumulate_block(++begin, first + e, tinySTL::move(acc), binary_op,
+                                                              Vectorize());
+                });
+    }
+
+    template<typename ExecutionPolicy, typename ForwardIter, typename T, typename BinaryOp>
+    execution_detail::enable_if_policy_t<ExecutionPolicy, T>  // 返回值
+    reduce(ExecutionPolicy &&, ForwardIter first, ForwardIter last, T init, BinaryOp binary_op) {
+        return tinySTL::reduce_dispatch(first, last, init, binary_op,
+                                        execution_detail::use_parallel<ExecutionPolicy, ForwardIter>(),
+                                        execution_detail::use_simd_sum<ExecutionPolicy, ForwardIter, T, BinaryOp>(),
+                                        execution_detail::is_deterministic<ExecutionPolicy>());
+    }
+
+    template<typename ExecutionPolicy, typename ForwardIter, typename T>
+    execution_detail::enable_if_policy_t<ExecutionPolicy, T>  // 返回值
+    reduce(ExecutionPolicy &&policy, ForwardIter first, ForwardIter last, T init) {
+        return tinySTL::reduce(policy, first, last, init, tinySTL::plus<T>());
+    }
+
+    template<typename ExecutionPolicy, typename ForwardIter>
+    execution_detail::enable_if_policy_t<ExecutionPolicy, typename iterator_traits<ForwardIter>::value_type>
+    reduce(ExecutionPolicy &&policy, ForwardIter first, ForwardIter last) {
+        typedef typename iterator_traits<ForwardIter>::value_type value_type;
+        return tinySTL::reduce(policy, first, last, value_type(), tinySTL::plus<value_type>());
+    }
+
+    template<typename ExecutionPolicy, typename ForwardIter, typename T>
+    execution_detail::enable_if_policy_t<ExecutionPolicy, T>  // 返回值
+    accumulate(ExecutionPolicy &&policy, ForwardIter first, ForwardIter last, T init) {
+        return tinySTL::reduce(policy, first, last, init, tinySTL::plus<T>());
+    }
+
+    template<typename ExecutionPolicy, typename ForwardIter, typename T, typename BinaryOp>
+    execution_detail::enable_if_policy_t<ExecutionPolicy, T>  // 返回值
+    accumulate(ExecutionPolicy &&policy, ForwardIter first, ForwardIter last, T init, BinaryOp binary_op) {
+        return tinySTL::reduce(policy, first, last, init, binary_op);
+    }
+
+    template<typename ForwardIter1, typename ForwardIter2, typename T, typename BinaryOp1, typename BinaryOp2,
+            typename Vectorize, typename Deterministic>
+    T transform_reduce_dispatch(ForwardIter1 first1, ForwardIter1 last1, ForwardIter2 first2, T init,
+                                BinaryOp1 reduce_op, BinaryOp2 transform_op, m_false_type, Vectorize, Deterministic) {
+        return execution_detail::inner_product_block(first1, last1, first2, init, reduce_op, transform_op,
+                                                     Vectorize());
+    }
+
+    template<typename RandomIter1, typename RandomIter2, typename T, typename BinaryOp1, typename BinaryOp2,
+            typename Vectorize, typename Deterministic>
+    T transform_reduce_dispatch(RandomIter1 first1, RandomIter1 last1, RandomIter2 first2, T init,
+                                BinaryOp1 reduce_op, BinaryOp2 transform_op, m_true_type, Vectorize, Deterministic) {
+        const size_t n = static_cast<size_t>(last1 - first1);
+        return execution_detail::reduce_chunks(
+                n, execution_detail::reduce_chunk_count(n, Deterministic()), init, reduce_op,
+                [&](size_t b, size_t e) {
+                    RandomIter1 begin1 = first1 + b;
+                    RandomIter2 begin2 = first2 + b;
+                    T acc = transform_op(*begin1, *begin2);
+                    return execution_detail::inner_product_block(++begin1, first1 + e, ++begin2, tinySTL::move(acc),
+                                                                 reduce_op, transform_op, Vectorize());
+                });
+    }
+
+    template<typename ExecutionPolicy, typename ForwardIter1, typename ForwardIter2, typename T,
+            typename BinaryOp1, typename BinaryOp2>
+    execution_detail::enable_if_policy_t<ExecutionPolicy, T>  // 返回值
+    transform_reduce(ExecutionPolicy &&, ForwardIter1 first1, ForwardIter1 last1, ForwardIter2 first2, T init,
+                     BinaryOp1 reduce_op, BinaryOp2 transform_op) {
+        return tinySTL::transform_reduce_dispatch(
+                first1, last1, first2, init, reduce_op, transform_op,
+                execution_detail::use_parallel<ExecutionPolicy, ForwardIter1, ForwardIter2>(),
+                execution_detail::use_simd_dot<ExecutionPolicy, ForwardIter1, ForwardIter2, T, BinaryOp1, BinaryOp2>(),
+                execution_detail::is_deterministic<ExecutionPolicy>());
+    }
+
+    template<typename ExecutionPolicy, typename ForwardIter1, typename ForwardIter2, typename T>
+    execution_detail::enable_if_policy_t<ExecutionPolicy, T>  // 返回值
+    transform_reduce(ExecutionPolicy &&policy, ForwardIter1 first1, ForwardIter1 last1, ForwardIter2 first2, T init) {
+        return tinySTL::transform_reduce(policy, first1, last1, first2, init, tinySTL::plus<T>(),
+                                         tinySTL::multiplies<T>());
+    }
+
+    template<typename ForwardIter, typename T, typename BinaryOp, typename UnaryOp, typename Deterministic>
+    T transform_reduce_dispatch(ForwardIter first, ForwardIter last, T init, BinaryOp reduce_op,
+                                UnaryOp transform_op, m_false_type, Deterministic) {
+        return tinySTL::transform_reduce(first, last, init, reduce_op, transform_op);
+    }
+
+    template<typename RandomIter, typename T, typename BinaryOp, typename UnaryOp, typename Deterministic>
+    T transform_reduce_dispatch(RandomIter first, RandomIter last, T init, BinaryOp reduce_op,
+                                UnaryOp transform_op, m_true_type, Deterministic) {
+        const size_t n = static_cast<size_t>(last - first);
+        return execution_detail::reduce_chunks(
+                n, execution_detail::reduce_chunk_count(n, Deterministic()), init, reduce_op,
+                [&](size_t b, size_t e) {
+                    RandomIter begin = first + b;
+                    T acc = transform_op(*begin);
+                    return tinySTL::transform_reduce(++begin, first + e, tinySTL::move(acc), reduce_op,
+                                                     transform_op);
+                });
+    }
+
+    template<typename ExecutionPolicy, typename ForwardIter, typename T, typename BinaryOp, typename UnaryOp>
+    execution_detail::enable_if_policy_t<ExecutionPolicy, T>  // 返回值
+    transform_reduce(ExecutionPolicy &&, ForwardIter first, ForwardIter last, T init,
+                     BinaryOp reduce_op, UnaryOp transform_op) {
+        return tinySTL::transform_reduce_dispatch(first, last, init, reduce_op, transform_op,
+                                                  execution_detail::use_parallel<ExecutionPolicy, ForwardIter>(),
+                                                  execution_detail::is_deterministic<ExecutionPolicy>());
+    }
+
+    // ===========================================================================================
+    // inclusive_scan, exclusive_scan
+    // 两遍的分块扫描：第一遍并行求出除最后一块外每块的归约值，按顺序合并为每块的初值，第二遍并行地在块内扫描。
+    // 输入读取两次、输出写入一次；binary_op 需要满足结合律，result 可以等于 first
+
+    namespace execution_detail {
+
+        /*
+         * 与 use_simd_sum 相同，并且要求输出也是连续的 T 区间
+         */
+        template<typename ExecutionPolicy, typename InputIter, typename OutputIter, typename T, typename BinaryOp>
+        struct use_simd_scan : public m_bool_constant<
+                use_simd_sum<ExecutionPolicy, InputIter, T, BinaryOp>::value
+                && simd::is_simd_range<OutputIter, T>::value> {
+        };
+
+        template<bool Exclusive, typename InputIter, typename OutputIter, typename T, typename BinaryOp>
+        OutputIter scan_block(InputIter first, InputIter last, OutputIter result, T init, BinaryOp binary_op,
+                              m_false_type) {
+            return Exclusive ? tinySTL::exclusive_scan(first, last, result, tinySTL::move(init), binary_op)
+                             : tinySTL::inclusive_scan(first, last, result, binary_op, tinySTL::move(init));
+        }
+
+        template<bool Exclusive, typename Ptr, typename T, typename BinaryOp>
+        T *scan_block(Ptr first, Ptr last, T *result, T init, BinaryOp, m_true_type) {
+            const size_t n = static_cast<size_t>(last - first);
+            return Exclusive ? simd::exclusive_scan(first, n, result, init)
+                             : simd::inclusive_scan(first, n, result, init);
+        }
+
+        template<bool Exclusive, typename RandomIter1, typename RandomIter2, typename T, typename BinaryOp,
+                typename Vectorize>
+        RandomIter2 blocked_scan(RandomIter1 first, RandomIter1 last, RandomIter2 result, T init,
+                                 BinaryOp binary_op, size_t chunks, Vectorize) {
+            const size_t n = static_cast<size_t>(last - first);
+            if (chunks <= 1) {
+                return scan_block<Exclusive>(first, last, result, init, binary_op, Vectorize());
+            }
+            tinySTL::vector<T> offset(chunks, init);
+            run_tasks(chunks - 1, [&](size_t i) {
+                RandomIter1 begin = first + n * i / chunks;
+                T acc = *begin;
+                offset[i + 1] = accumulate_block(++begin, first + n * (i + 1) / chunks, tinySTL::move(acc),
+                                                 binary_op, Vectorize());
+            });
+            for (size_t i = 1; i < chunks; ++i) {
+                offset[i] = binary_op(offset[i - 1], offset[i]);
+            }
+            run_tasks(chunks, [&](size_t i) {
+                const size_t begin = n * i / chunks;
+                scan_block<Exclusive>(first + begin, first + n * (i + 1) / chunks, result + begin, offset[i],
+                                      binary_op, Vectorize());
+            });
+            return result + n;
+        }
+
+    }  // namespace execution_detail
+
+    template<bool Exclusive, typename ForwardIter1, typename ForwardIter2, typename T, typename BinaryOp,
+            typename Vectorize, typename Deterministic>
+    ForwardIter2 scan_dispatch(ForwardIter1 first, ForwardIter1 last, ForwardIter2 result, T init,
+                               BinaryOp binary_op, m_false_type, Vectorize, Deterministic) {
+        return execution_detail::scan_block<Exclusive>(first, last, result, init, binary_op, Vectorize());
+    }
+
+    template<bool Exclusive, typename RandomIter1, typename RandomIter2, typename T, typename BinaryOp,
+            typename Vectorize, typename Deterministic>
+    RandomIter2 scan_dispatch(RandomIter1 first, RandomIter1 last, RandomIter2 result, T init,
+                              BinaryOp binary_op, m_true_type, Vectorize, Deterministic) {
+        const size_t n = static_cast<size_t>(last - first);
+        return execution_detail::blocked_scan<Exclusive>(first, last, result, init, binary_op,
+                                                         execution_detail::reduce_chunk_count(n, Deterministic()),
+                                                         Vectorize());
+    }
+
+    template<typename ExecutionPolicy, typename ForwardIter1, typename ForwardIter2, typename BinaryOp, typename T>
+    execution_detail::enable_if_policy_t<ExecutionPolicy, ForwardIter2>  // 返回值
+    inclusive_scan(ExecutionPolicy &&, ForwardIter1 first, ForwardIter1 last, ForwardIter2 result,
+                   BinaryOp binary_op, T init) {
+        return tinySTL::scan_dispatch<false>(
+                first, last, result, init, binary_op,
+                execution_detail::use_parallel<ExecutionPolicy, ForwardIter1, ForwardIter2>(),
+                execution_detail::use_simd_scan<ExecutionPolicy, ForwardIter1, ForwardIter2, T, BinaryOp>(),
+                execution_detail::is_deterministic<ExecutionPolicy>());
+    }
+
+    template<typename ExecutionPolicy, typename ForwardIter1, typename ForwardIter2, typename BinaryOp>
+    execution_detail::enable_if_policy_t<ExecutionPolicy, ForwardIter2>  // 返回值
+    inclusive_scan(ExecutionPolicy &&policy, ForwardIter1 first, ForwardIter1 last, ForwardIter2 result,
+                   BinaryOp binary_op) {
+        if (first == last) {
+            return result;
+        }
+        typename iterator_traits<ForwardIter1>::value_type init = *first;
+        *result = init;
+        return tinySTL::inclusive_scan(policy, ++first, last, ++result, binary_op, init);
+    }
+
+    template<typename ExecutionPolicy, typename ForwardIter1, typename ForwardIter2>
+    execution_detail::enable_if_policy_t<ExecutionPolicy, ForwardIter2>  // 返回值
+    inclusive_scan(ExecutionPolicy &&policy, ForwardIter1 first, ForwardIter1 last, ForwardIter2 result) {
+        return tinySTL::inclusive_scan(policy, first, last, result,
+                                       tinySTL::plus<typename iterator_traits<ForwardIter1>::value_type>());
+    }
+
+    template<typename ExecutionPolicy, typename ForwardIter1, typename ForwardIter2, typename T, typename BinaryOp>
+    execution_detail::enable_if_policy_t<ExecutionPolicy, ForwardIter2>  // 返回值
+    exclusive_scan(ExecutionPolicy &&, ForwardIter1 first, ForwardIter1 last, ForwardIter2 result, T init,
+                   BinaryOp binary_op) {
+        return tinySTL::scan_dispatch<true>(
+                first, last, result, init, binary_op,
+                execution_detail::use_parallel<ExecutionPolicy, ForwardIter1, ForwardIter2>(),
+                execution_detail::use_simd_scan<ExecutionPolicy, ForwardIter1, ForwardIter2, T, BinaryOp>(),
+                execution_detail::is_deterministic<ExecutionPolicy>());
+    }
+
+    template<typename ExecutionPolicy, typename ForwardIter1, typename ForwardIter2, typename T>
+    execution_detail::enable_if_policy_t<ExecutionPolicy, ForwardIter2>  // 返回值
+    exclusive_scan(ExecutionPolicy &&policy, ForwardIter1 first, ForwardIter1 last, ForwardIter2 result, T init) {
+        return tinySTL::exclusive_scan(policy, first, last, result, init, tinySTL::plus<T>());
+    }
+
+    // ===========================================================================================
+    // count, count_if
+
+    template<typename ForwardIter, typename UnaryPred>
+    size_t count_if_dispatch(ForwardIter first, ForwardIter last, UnaryPred unary_pred, m_false_type) {
+        return tinySTL::count_if(first, last, unary_pred);
+    }
+
+    template<typename RandomIter, typename UnaryPred>
+    size_t count_if_dispatch(RandomIter first, RandomIter last, UnaryPred unary_pred, m_true_type) {
+        std::atomic<size_t> total(0);
+        execution_detail::parallel_chunks(static_cast<size_t>(last - first), execution_detail::kGrainSize,
+                                          [&](size_t begin, size_t end) {
+                                              total += tinySTL::count_if(first + begin, first + end, unary_pred);
+                                          });
+        return total.load();
+    }
+
+    template<typename ExecutionPolicy, typename ForwardIter, typename UnaryPred>
+    execution_detail::enable_if_policy_t<ExecutionPolicy, size_t>  // 返回值
+    count_if(ExecutionPolicy &&, ForwardIter first, ForwardIter last, UnaryPred unary_pred) {
+        return tinySTL::count_if_dispatch(first, last, unary_pred,
+                                          execution_detail::use_parallel<ExecutionPolicy, ForwardIter>());
+    }
+
+    template<typename ExecutionPolicy, typename ForwardIter, typename T>
+    execution_detail::enable_if_policy_t<ExecutionPolicy, size_t>  // 返回值
+    count(ExecutionPolicy &&policy, ForwardIter first, ForwardIter last, const T &value) {
+        typedef typename iterator_traits<ForwardIter>::reference reference;
+        return tinySTL::count_if(policy, first, last, [&value](reference x) { return x == value; });
+    }
+
+    // ===========================================================================================
+    // find_if, find
+    // 各块记录已找到的最小位置，起点在它之后的块不再查找，块内每查找一小段检查一次
+
+    template<typename ForwardIter, typename UnaryPred>
+    ForwardIter find_if_dispatch(ForwardIter first, ForwardIter last, UnaryPred unary_pred, m_false_type) {
+        return tinySTL::find_if(first, last, unary_pred);
+    }
+
+    template<typename RandomIter, typename UnaryPred>
+    RandomIter find_if_dispatch(RandomIter first, RandomIter last, UnaryPred unary_pred, m_true_type) {
+        const size_t n = static_cast<size_t>(last - first);
+        std::atomic<size_t> found(n);
+        execution_detail::parallel_chunks(n, execution_detail::kGrainSize, [&](size_t begin, size_t end) {
+            const size_t step = 1024;
+            for (size_t i = begin; i < end && i < found.load(std::memory_order_relaxed); i += step) {
+                const size_t stop = end - i > step ? i + step : end;
+                const RandomIter hit = tinySTL::find_if(first + i, first + stop, unary_pred);
+                if (hit != first + stop) {
+                    const size_t pos = static_cast<size_t>(hit - first);
+                    size_t cur = found.load();
+                    while (pos < cur && !found.compare_exchange_weak(cur, pos)) {
+                    }
+                    return;
+                }
+            }
+        });
+        return first + found.load();
+    }
+
+    template<typename ExecutionPolicy, typename ForwardIter, typename UnaryPred>
+    execution_detail::enable_if_policy_t<ExecutionPolicy, ForwardIter>  // 返回值
+    find_if(ExecutionPolicy &&, ForwardIter first, ForwardIter last, UnaryPred unary_pred) {
+        return tinySTL::find_if_dispatch(first, last, unary_pred,
+                                         execution_detail::use_parallel<ExecutionPolicy, ForwardIter>());
+    }
+
+    template<typename ExecutionPolicy, typename ForwardIter, typename T>
+    execution_detail::enable_if_policy_t<ExecutionPolicy, ForwardIter>  // 返回值
+    find(ExecutionPolicy &&policy, ForwardIter first, ForwardIter last, const T &value) {
+        typedef typename iterator_traits<ForwardIter>::reference reference;
+        return tinySTL::find_if(policy, first, last, [&value](reference x) { return x == value; });
+    }
+
+    // ===========================================================================================
+    // fill, copy
+
+    template<typename ForwardIter, typename T>
+    void fill_dispatch(ForwardIter first, ForwardIter last, const T &value, m_false_type) {
+        tinySTL::fill(first, last, value);
+    }
+
+    template<typename RandomIter, typename T>
+    void fill_dispatch(RandomIter first, RandomIter last, const T &value, m_true_type) {
+        execution_detail::parallel_chunks(static_cast<size_t>(last - first), execution_detail::kGrainSize,
+                                          [&](size_t begin, size_t end) {
+                                              tinySTL::fill(first + begin, first + end, value);
+                                          });
+    }
+
+    template<typename ExecutionPolicy, typename ForwardIter, typename T>
+    execution_detail::enable_if_policy_t<ExecutionPolicy, void>  // 返回值
+    fill(ExecutionPolicy &&, ForwardIter first, ForwardIter last, const T &value) {
+        tinySTL::fill_dispatch(first, last, value, execution_detail::use_parallel<ExecutionPolicy, ForwardIter>());
+    }
+
+    template<typename ForwardIter1, typename ForwardIter2>
+    ForwardIter2 copy_dispatch(ForwardIter1 first, ForwardIter1 last, ForwardIter2 result, m_false_type) {
+        return tinySTL::copy(first, last, result);
+    }
+
+    template<typename RandomIter1, typename RandomIter2>
+    RandomIter2 copy_dispatch(RandomIter1 first, RandomIter1 last, RandomIter2 result, m_true_type) {
+        const size_t n = static_cast<size_t>(last - first);
+        execution_detail::parallel_chunks(n, execution_detail::kGrainSize, [&](size_t begin, size_t end) {
+            tinySTL::copy(first + begin, first + end, result + begin);
+        });
+        return result + n;
+    }
+
+    template<typename ExecutionPolicy, typename ForwardIter1, typename ForwardIter2>
+    execution_detail::enable_if_policy_t<ExecutionPolicy, ForwardIter2>  // 返回值
+    copy(ExecutionPolicy &&, ForwardIter1 first, ForwardIter1 last, ForwardIter2 result) {
+        return tinySTL::copy_dispatch(first, last, result,
+                                      execution_detail::use_parallel<ExecutionPolicy, ForwardIter1, ForwardIter2>());
+    }
+
+    // ===========================================================================================
+    // merge
+
+    template<typename ForwardIter1, typename ForwardIter2, typename ForwardIter3, typename Compared>
+    ForwardIter3 merge_dispatch(ForwardIter1 first1, ForwardIter1 last1, ForwardIter2 first2, ForwardIter2 last2,
+                                ForwardIter3 result, Compared comp, m_false_type) {
+        return tinySTL::merge(first1, last1, first2, last2, result, comp);
+    }
+
+    template<typename RandomIter1, typename RandomIter2, typename RandomIter3, typename Compared>
+    RandomIter3 merge_dispatch(RandomIter1 first1, RandomIter1 last1, RandomIter2 first2, RandomIter2 last2,
+                               RandomIter3 result, Compared comp, m_true_type) {
+        return execution_detail::parallel_merge<false>(first1, last1, first2, last2, result, comp);
+    }
+
+    template<typename ExecutionPolicy, typename ForwardIter1, typename ForwardIter2, typename ForwardIter3,
+            typename Compared>
+    execution_detail::enable_if_policy_t<ExecutionPolicy, ForwardIter3>  // 返回值
+    merge(ExecutionPolicy &&, ForwardIter1 first1, ForwardIter1 last1, ForwardIter2 first2, ForwardIter2 last2,
+          ForwardIter3 result, Compared comp) {
+        return tinySTL::merge_dispatch(first1, last1, first2, last2, result, comp,
+                                       execution_detail::use_parallel<ExecutionPolicy, ForwardIter1,
+                                               ForwardIter2, ForwardIter3>());
+    }
+
+    template<typename ExecutionPolicy, typename ForwardIter1, typename ForwardIter2, typename ForwardIter3>
+    execution_detail::enable_if_policy_t<ExecutionPolicy, ForwardIter3>  // 返回值
+    merge(ExecutionPolicy &&policy, ForwardIter1 first1, ForwardIter1 last1, ForwardIter2 first2, ForwardIter2 last2,
+          ForwardIter3 result) {
+        typedef typename iterator_traits<ForwardIter1>::value_type value_type;
+        return tinySTL::merge(policy, first1, last1, first2, last2, result, tinySTL::less<value_type>());
+    }
+
+    // ===========================================================================================
+    // multiway_merge
+    // 先用 multiseq_partition 求出输出中每块的起点在各序列中的位置，各块再独立地用败者树归并到输出的对应位置
+
+    template<typename SeqIter, typename OutputIter, typename Compared>
+    OutputIter multiway_merge_dispatch(SeqIter seqs_first, SeqIter seqs_last, OutputIter result, Compared comp,
+                                       m_false_type) {
+        return tinySTL::multiway_merge(seqs_first, seqs_last, result, comp);
+    }
+
+    template<typename SeqIter, typename RandomIter, typename Compared>
+    RandomIter multiway_merge_dispatch(SeqIter seqs_first, SeqIter seqs_last, RandomIter result, Compared comp,
+                                       m_true_type) {
+        typedef typename multiway_detail::seq_iterator<SeqIter>::type Iter;
+        typedef tinySTL::pair<Iter, Iter> seq_type;
+        tinySTL::vector<seq_type> seqs;
+        size_t total = 0;
+        for (; seqs_first != seqs_last; ++seqs_first) {
+            seqs.push_back(seq_type((*seqs_first).first, (*seqs_first).second));
+            total += static_cast<size_t>((*seqs_first).second - (*seqs_first).first);
+        }
+        const size_t k = seqs.size();
+        const size_t chunks = execution_detail::chunk_count(total, execution_detail::kGrainSize);
+        if (chunks == 1) {
+            return tinySTL::multiway_merge(seqs.begin(), seqs.end(), result, comp);
+        }
+        /* splits[t * k + i] 为第 t 块在序列 i 中的起点 */
+        tinySTL::vector<size_t> splits((chunks + 1) * k, 0);
+        for (size_t i = 0; i < k; ++i) {
+            splits[chunks * k + i] = static_cast<size_t>(seqs[i].second - seqs[i].first);
+        }
+        execution_detail::run_tasks(chunks - 1, [&](size_t t) {
+            tinySTL::multiseq_partition(seqs.begin(), seqs.end(), total * (t + 1) / chunks,
+                                        splits.begin() + (t + 1) * k, comp);
+        });
+        execution_detail::run_tasks(chunks, [&](size_t t) {
+            tinySTL::vector<seq_type> part(k);
+            for (size_t i = 0; i < k; ++i) {
+                part[i] = seq_type(seqs[i].first + splits[t * k + i], seqs[i].first + splits[(t + 1) * k + i]);
+            }
+            tinySTL::multiway_merge(part.begin(), part.end(), result + total * t / chunks, comp);
+        });
+        return result + total;
+    }
+
+    template<typename ExecutionPolicy, typename SeqIter, typename OutputIter, typename Compared>
+    execution_detail::enable_if_policy_t<ExecutionPolicy, OutputIter>  // 返回值
+    multiway_merge(ExecutionPolicy &&, SeqIter seqs_first, SeqIter seqs_last, OutputIter result, Compared comp) {
+        return tinySTL::multiway_merge_dispatch(
+                seqs_first, seqs_last, result, comp,
+                execution_detail::use_parallel<ExecutionPolicy,
+                        typename multiway_detail::seq_iterator<SeqIter>::type, OutputIter>());
+    }
+
+    template<typename ExecutionPolicy, typename SeqIter, typename OutputIter>
+    execution_detail::enable_if_policy_t<ExecutionPolicy, OutputIter>  // 返回值
+    multiway_merge(ExecutionPolicy &&policy, SeqIter seqs_first, SeqIter seqs_last, OutputIter result) {
+        return tinySTL::multiway_merge(policy, seqs_first, seqs_last, result, search_detail::less_than());
+    }
+
+    // ===========================================================================================
+    // sort, stable_sort, partial_sort
+
+    template<typename ExecutionPolicy, typename RandomIter, typename Compared>
+    execution_detail::enable_if_policy_t<ExecutionPolicy, void>  // 返回值
+    sort(ExecutionPolicy &&, RandomIter first, RandomIter last, Compared comp) {
+        if (execution_detail::use_parallel<ExecutionPolicy, RandomIter>::value) {
+            execution_detail::parallel_sort(first, last, comp, [comp](RandomIter b, RandomIter e) {
+                tinySTL::sort(b, e, comp);
+            });
+        } else {
+            tinySTL::sort(first, last, comp);
+        }
+    }
+
+    template<typename ExecutionPolicy, typename RandomIter>
+    execution_detail::enable_if_policy_t<ExecutionPolicy, void>  // 返回值
+    sort(ExecutionPolicy &&policy, RandomIter first, RandomIter last) {
+        typedef typename iterator_traits<RandomIter>::value_type value_type;
+        tinySTL::sort(policy, first, last, tinySTL::less<value_type>());
+    }
+
+    /*
+     * 各块并行地 stable_sort，再稳定地两两并行合并
+     */
+    template<typename ExecutionPolicy, typename RandomIter, typename Compared>
+    execution_detail::enable_if_policy_t<ExecutionPolicy, void>  // 返回值
+    stable_sort(ExecutionPolicy &&, RandomIter first, RandomIter last, Compared comp) {
+        if (execution_detail::use_parallel<ExecutionPolicy, RandomIter>::value) {
+            execution_detail::parallel_sort(first, last, comp, [comp](RandomIter b, RandomIter e) {
+                tinySTL::stable_sort(b, e, comp);
+            });
+        } else {
+            tinySTL::stable_sort(first, last, comp);
+        }
+    }
+
+    template<typename ExecutionPolicy, typename RandomIter>
+    execution_detail::enable_if_policy_t<ExecutionPolicy, void>  // 返回值
+    stable_sort(ExecutionPolicy &&policy, RandomIter first, RandomIter last) {
+        typedef typename iterator_traits<RandomIter>::value_type value_type;
+        tinySTL::stable_sort(policy, first, last, tinySTL::less<value_type>());
+    }
+
+    /*
+     * middle 之前的元素较少时，每块并行地选出自己最小的 k 个元素，集中到区间开头后再串行选出最终的 k 个；
+     * 否则先用 nth_element 划分，再并行排序前 k 个元素
+     */
+    template<typename ExecutionPolicy, typename RandomIter, typename Compared>
+    execution_detail::enable_if_policy_t<ExecutionPolicy, void>  // 返回值
+    partial_sort(ExecutionPolicy &&policy, RandomIter first, RandomIter middle, RandomIter last, Compared comp) {
+        const size_t n = static_cast<size_t>(last - first);
+        const size_t k = static_cast<size_t>(middle - first);
+        const size_t threads = execution_detail::shared_pool().concurrency();
+        if (!execution_detail::use_parallel<ExecutionPolicy, RandomIter>::value
+            || threads == 1 || n < execution_detail::kSortGrainSize * 2) {
+            tinySTL::partial_sort(first, middle, last, comp);
+            return;
+        }
+        if (k == 0) {
+            return;
+        }
+        // 每块的前 k 个位置集中到第一块中，要求 threads * k 不超过第一块的大小
+        if (k * threads <= n / threads) {
+            execution_detail::run_tasks(threads, [&](size_t i) {
+                RandomIter begin = first + n * i / threads;
+                RandomIter end = first + n * (i + 1) / threads;
+                tinySTL::partial_sort(begin, begin + k, end, comp);
+            });
+            for (size_t i = 1; i < threads; ++i) {
+                tinySTL::swap_ranges(first + n * i / threads, first + n * i / threads + k, first + i * k);
+            }
+            tinySTL::partial_sort(first, middle, first + threads * k, comp);
+            return;
+        }
+        tinySTL::nth_element(first, middle, last, comp);
+        tinySTL::sort(policy, first, middle, comp);
+    }
+
+    template<typename ExecutionPolicy, typename RandomIter>
+    execution_detail::enable_if_policy_t<ExecutionPolicy, void>  // 返回值
+    partial_sort(ExecutionPolicy &&policy, RandomIter first, RandomIter middle, RandomIter last) {
+        typedef typename iterator_traits<RandomIter>::value_type value_type;
+        tinySTL::partial_sort(policy, first, middle, last, tinySTL::less<value_type>());
+    }
+
+}  // namespace tinySTL
+
+#endif //TINYSTL_EXECUTION_H
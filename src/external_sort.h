@@ -0,0 +1,706 @@
+//
+// Created by cqupt1811 on 2022/5/31.
+//
+
+/*
+ * 这个头文件包含外部排序 external_sorter 与 external_sort，用于排序超过内存容量的数据
+ *
+ * 1. 生成顺串：读入记录直到用量达到内存预算 memory_budget，用 sort 排序后经过整块的写缓冲区顺序写入临时文件
+ * 2. 归并：每个顺串配一个预读缓冲区(内存预算在各路之间平分，但不小于 block_size)，用败者树做 k 路归并；
+ *    顺串数超过一次能归并的路数时，先分组归并成更长的顺串写回临时文件，再继续归并
+ * 数据能放进内存预算时不写临时文件，直接在内存中排序输出
+ *
+ * 记录可以是可平凡复制的定长类型(按字节写入临时文件)或 basic_string(写入长度与字符)
+ * external_sort()         从输入迭代器读入记录，把结果写到输出迭代器
+ * external_sort_records() 对二进制流中的定长记录排序
+ * external_sort_lines()   对文本流按行排序，输出的每一行都以换行符结尾
+ * 临时文件默认由 std::tmpfile() 创建，也可以通过 temp_dir 放到指定的目录(如容量更大的磁盘)，排序结束后自动删除
+ */
+
+#ifndef TINYSTL_EXTERNAL_SORT_H
+#define TINYSTL_EXTERNAL_SORT_H
+
+#include <atomic>  /* std::atomic 原子类型 */
+#include <chrono>  /* steady_clock，用于生成临时文件名 */
+#include <cstddef>  /* 定义了 size_t 等常用类型 */
+#include <cstdio>  /* FILE, fopen, fread, fwrite, tmpfile */
+#include <cstring>  /* memcpy */
+#include <istream>  /* basic_istream */
+#include <ostream>  /* basic_ostream */
+#include <type_traits>  /* std::is_trivially_copyable, std::decay */
+#include "algorithm.h"  /* 这个头文件包含了 tinySTL 的所有算法 */
+#include "astring.h"  /* 定义了 string, wstring, u16string, u32string 类型 */
+#include "vector.h"  /* 这个头文件包含一个模板类 vector */
+#include "exceptdef.h"  /* 此文件中定义了异常相关的宏 */
+
+/* 首先定义自己的命名空间 */
+namespace tinySTL {
+
+    /*
+     * 外部排序的参数
+     * memory_budget: 生成顺串时缓存记录、归并时预读缓冲区所用内存的上限(字节)
+     * block_size:    每次读写临时文件的最小字节数，也决定一次最多归并 memory_budget / block_size - 1 路
+     * temp_dir:      临时文件所在的目录，为 nullptr 时使用 std::tmpfile()
+     */
+    struct external_sort_options {
+        size_t memory_budget = static_cast<size_t>(256) << 20;
+        size_t block_size = static_cast<size_t>(1) << 20;
+        const char *temp_dir = nullptr;
+    };
+
+    namespace external_sort_detail {
+
+        /*
+         * 临时文件，析构时关闭并删除。关闭了 stdio 自身的缓冲，读写都经过下面整块的缓冲区
+         */
+        class spill_file {
+        public:
+            explicit spill_file(const char *dir) : fp_(nullptr) {
+                if (dir == nullptr) {
+                    fp_ = std::tmpfile();
+                } else {
+                    static std::atomic<unsigned long> counter(0);
+                    const auto stamp = static_cast<unsigned long long>(
+                            std::chrono::steady_clock::now().time_since_epoch().count());
+                    /* "x" 保证不会打开已经存在的文件，名字冲突时换一个名字重试 */
+                    for (int attempt = 0; fp_ == nullptr && attempt < 16; ++attempt) {
+                        char name[64];
+                        std::snprintf(name, sizeof(name), "/tinystl-sort-%llx-%lu.tmp", stamp, counter++);
+                        path_ = dir;
+                        path_ += name;
+                        fp_ = std::fopen(path_.c_str(), "w+bx");
+                    }
+                }
+                THROW_RUNTIME_ERROR_IF(fp_ == nullptr, "external_sort: cannot create a temporary file");
+                std::setvbuf(fp_, nullptr, _IONBF, 0);
+            }
+
+            spill_file(const spill_file &) = delete;
+
+            spill_file &operator=(const spill_file &) = delete;
+
+            ~spill_file() {
+                std::fclose(fp_);
+                if (!path_.empty()) {
+                    std::remove(path_.c_str());
+                }
+            }
+
+            std::FILE *get() const {
+                return fp_;
+            }
+
+            /*
+             * 写完之后回到文件开头准备读取
+             */
+            void rewind() {
+                THROW_RUNTIME_ERROR_IF(std::fseek(fp_, 0, SEEK_SET) != 0,
+                                       "external_sort: cannot rewind a temporary file");
+            }
+
+        private:
+            std::FILE *fp_;
+            tinySTL::string path_;
+        };
+
+        /*
+         * 一组顺串对应的临时文件，负责释放它们，保证发生异常时不会遗留临时文件
+         */
+        class spill_list {
+        public:
+            spill_list() = default;
+
+            spill_list(const spill_list &) = delete;
+
+            spill_list &operator=(const spill_list &) = delete;
+
+            ~spill_list() {
+                clear();
+            }
+
+            size_t size() const {
+                return files_.size();
+            }
+
+            bool empty() const {
+                return files_.empty();
+            }
+
+            spill_file &operator[](size_t i) const {
+                return *files_[i];
+            }
+
+            spill_file &create(const char *dir) {
+                files_.push_back(nullptr);
+                files_.back() = new spill_file(dir);
+                return *files_.back();
+            }
+
+            /*
+             * 把 other 的第 i 个文件移到本组的末尾
+             */
+            void take(spill_list &other, size_t i) {
+                files_.push_back(other.files_[i]);
+                other.files_[i] = nullptr;
+            }
+
+            void release(size_t i) {
+                delete files_[i];
+                files_[i] = nullptr;
+            }
+
+            void clear() {
+                for (size_t i = 0; i < files_.size(); ++i) {
+                    delete files_[i];
+                }
+                files_.clear();
+            }
+
+            void swap(spill_list &rhs) {
+                files_.swap(rhs.files_);
+            }
+
+        private:
+            tinySTL::vector<spill_file *> files_;
+        };
+
+        /*
+         * 写缓冲区：攒满一整块再调用一次 fwrite，超过一块的数据直接写入
+         */
+        class spill_writer {
+        public:
+            spill_writer(std::FILE *fp, size_t block) : fp_(fp), buf_(block > 0 ? block : 1), used_(0) {
+            }
+
+            void put(const void *p, size_t n) {
+                if (n > buf_.size() - used_) {
+                    flush();
+                    if (n >= buf_.size()) {
+                        write(p, n);
+                        return;
+                    }
+                }
+                std::memcpy(buf_.data() + used_, p, n);
+                used_ += n;
+            }
+
+            void flush() {
+                write(buf_.data(), used_);
+                used_ = 0;
+            }
+
+        private:
+            void write(const void *p, size_t n) {
+                THROW_RUNTIME_ERROR_IF(n != 0 && std::fwrite(p, 1, n, fp_) != n,
+                                       "external_sort: write to a temporary file failed");
+            }
+
+            std::FILE *fp_;
+            tinySTL::vector<char> buf_;
+            size_t used_;
+        };
+
+        /*
+         * 预读缓冲区：每次用一次 fread 读入一整块
+         */
+        class spill_reader {
+        public:
+            spill_reader(std::FILE *fp, size_t block) : fp_(fp), buf_(block > 0 ? block : 1), pos_(0), end_(0) {
+            }
+
+            /*
+             * 读入 n 个字节；文件已经读完时返回 false，读到一半时文件结束说明临时文件已损坏，抛出异常
+             */
+            bool get(void *p, size_t n) {
+                char *out = static_cast<char *>(p);
+                size_t got = 0;
+                while (got < n) {
+                    if (pos_ == end_ && !refill()) {
+                        THROW_RUNTIME_ERROR_IF(got != 0, "external_sort: truncated temporary file");
+                        return false;
+                    }
+                    const size_t m = tinySTL::min(n - got, end_ - pos_);
+                    std::memcpy(out + got, buf_.data() + pos_, m);
+                    pos_ += m;
+                    got += m;
+                }
+                return true;
+            }
+
+        private:
+            bool refill() {
+                end_ = std::fread(buf_.data(), 1, buf_.size(), fp_);
+                pos_ = 0;
+                THROW_RUNTIME_ERROR_IF(end_ == 0 && std::ferror(fp_),
+                                       "external_sort: read from a temporary file failed");
+                return end_ != 0;
+            }
+
+            std::FILE *fp_;
+            tinySTL::vector<char> buf_;
+            size_t pos_;
+            size_t end_;
+        };
+
+        /*
+         * 记录在临时文件中的编码，footprint 为记录在内存中大致占用的字节数
+         * 没有定义的情况(既不能平凡复制也不是 basic_string)不能进行外部排序
+         */
+        template<typename T, bool = std::is_trivially_copyable<T>::value>
+        struct record_codec;
+
+        template<typename T>
+        struct record_codec<T, true> {
+            static size_t footprint(const T &) {
+                return sizeof(T);
+            }
+
+            static void write(spill_writer &out, const T &x) {
+                out.put(&x, sizeof(T));
+            }
+
+            static bool read(spill_reader &in, T &x) {
+                return in.get(&x, sizeof(T));
+            }
+        };
+
+        template<typename CharType, typename CharTraits>
+        struct record_codec<tinySTL::basic_string<CharType, CharTraits>, false> {
+            typedef tinySTL::basic_string<CharType, CharTraits> string_type;
+
+            static size_t footprint(const string_type &x) {
+                return sizeof(string_type) + (x.capacity() + 1) * sizeof(CharType);
+            }
+
+            static void write(spill_writer &out, const string_type &x) {
+                const size_t n = x.size();
+                out.put(&n, sizeof(n));
+                if (n != 0) {
+                    out.put(x.data(), n * sizeof(CharType));
+                }
+            }
+
+            /*
+             * 读入时复用 x 已有的容量
+             */
+            static bool read(spill_reader &in, string_type &x) {
+                size_t n = 0;
+                if (!in.get(&n, sizeof(n))) {
+                    return false;
+                }
+                x.resize(n);
+                THROW_RUNTIME_ERROR_IF(n != 0 && !in.get(&x[0], n * sizeof(CharType)),
+                                       "external_sort: truncated temporary file");
+                return true;
+            }
+        };
+
+        /*
+         * 按顺序读出一个顺串，value() 为当前记录
+         */
+        template<typename T>
+        class run_reader {
+        public:
+            run_reader(spill_file &file, size_t block) : in_(file.get(), block), value_(), valid_(false) {
+                file.rewind();
+                next();
+            }
+
+            bool valid() const {
+                return valid_;
+            }
+
+            const T &value() const {
+                return value_;
+            }
+
+            void next() {
+                valid_ = record_codec<T>::read(in_, value_);
+            }
+
+        private:
+            spill_reader in_;
+            T value_;
+            bool valid_;
+        };
+
+        /*
+         * 败者树使用的迭代器，读完的顺串与默认构造的迭代器相等。多个副本共享同一个 run_reader，只支持前置 ++
+         */
+        template<typename T>
+        class run_iterator {
+        public:
+            run_iterator() : r_(nullptr) {
+            }
+
+            explicit run_iterator(run_reader<T> *r) : r_(r->valid() ? r : nullptr) {
+            }
+
+            const T &operator*() const {
+                return r_->value();
+            }
+
+            run_iterator &operator++() {
+                r_->next();
+                if (!r_->valid()) {
+                    r_ = nullptr;
+                }
+                return *this;
+            }
+
+            friend bool operator==(const run_iterator &lhs, const run_iterator &rhs) {
+                return lhs.r_ == rhs.r_;
+            }
+
+            friend bool operator!=(const run_iterator &lhs, const run_iterator &rhs) {
+                return lhs.r_ != rhs.r_;
+            }
+
+        private:
+            run_reader<T> *r_;
+        };
+
+        /*
+         * 把记录写入临时文件的输出迭代器，用于中间轮次的归并
+         */
+        template<typename T>
+        class spill_inserter {
+        public:
+            explicit spill_inserter(spill_writer *out) : out_(out) {
+            }
+
+            spill_inserter &operator=(const T &x) {
+                record_codec<T>::write(*out_, x);
+                return *this;
+            }
+
+            spill_inserter &operator*() {
+                return *this;
+            }
+
+            spill_inserter &operator++() {
+                return *this;
+            }
+
+            spill_inserter &operator++(int) {
+                return *this;
+            }
+
+        private:
+            spill_writer *out_;
+        };
+
+        /*
+         * 把一行写入文本流的输出迭代器，每行后面补一个换行符
+         */
+        template<typename CharType, typename Traits>
+        class line_writer {
+        public:
+            explicit line_writer(std::basic_ostream<CharType, Traits> *os) : os_(os), newline_(os->widen('\n')) {
+            }
+
+            template<typename Str>
+            line_writer &operator=(const Str &line) {
+                if (!line.empty()) {
+                    os_->write(line.data(), static_cast<std::streamsize>(line.size()));
+                }
+                os_->put(newline_);
+                return *this;
+            }
+
+            line_writer &operator*() {
+                return *this;
+            }
+
+            line_writer &operator++() {
+                return *this;
+            }
+
+            line_writer &operator++(int) {
+                return *this;
+            }
+
+        private:
+            std::basic_ostream<CharType, Traits> *os_;
+            CharType newline_;
+        };
+
+        /*
+         * 把定长记录按字节写入二进制流的输出迭代器，流自身的缓冲区负责合并成整块写入
+         */
+        template<typename T>
+        class record_writer {
+        public:
+            explicit record_writer(std::ostream *os) : os_(os) {
+            }
+
+            record_writer &operator=(const T &x) {
+                os_->write(reinterpret_cast<const char *>(&x), sizeof(T));
+                return *this;
+            }
+
+            record_writer &operator*() {
+                return *this;
+            }
+
+            record_writer &operator++() {
+                return *this;
+            }
+
+            record_writer &operator++(int) {
+                return *this;
+            }
+
+        private:
+            std::ostream *os_;
+        };
+
+    }  // namespace external_sort_detail
+
+    // =============================================================================================
+
+    /*
+     * 模板类 external_sorter
+     * 逐个 push 记录，最后调用一次 finish 按 comp 的顺序输出全部记录；T 需要可以默认构造
+     * 缓存的记录达到内存预算时排序并写出一个顺串，finish 时归并所有顺串
+     */
+    template<typename T, typename Compared = search_detail::less_than>
+    class external_sorter {
+    public:
+        typedef T value_type;
+        typedef external_sort_detail::record_codec<T> codec;
+
+        explicit external_sorter(Compared comp = Compared(),
+                                 const external_sort_options &options = external_sort_options())
+                : comp_(comp), options_(options), bytes_(0) {
+        }
+
+        external_sorter(const external_sorter &) = delete;
+
+        external_sorter &operator=(const external_sorter &) = delete;
+
+        void push(const T &x) {
+            reserve_one();
+            bytes_ += codec::footprint(x);
+            buf_.push_back(x);
+            if (bytes_ >= options_.memory_budget) {
+                spill();
+            }
+        }
+
+        void push(T &&x) {
+            reserve_one();
+            bytes_ += codec::footprint(x);
+            buf_.push_back(tinySTL::move(x));
+            if (bytes_ >= options_.memory_budget) {
+                spill();
+            }
+        }
+
+        /*
+         * 已经写入临时文件的顺串个数
+         */
+        size_t run_count() const {
+            return runs_.size();
+        }
+
+        /*
+         * 输出排序结果，返回一个迭代器指向输出结果的尾部；之后 external_sorter 回到空的状态，可以重新使用
+         */
+        template<typename OutputIter>
+        OutputIter finish(OutputIter result) {
+            if (runs_.empty()) {
+                tinySTL::sort(buf_.begin(), buf_.end(), comp_);
+                for (auto it = buf_.begin(); it != buf_.end(); ++it) {
+                    *result = tinySTL::move(*it);
+                    ++result;
+                }
+                reset();
+                return result;
+            }
+            if (!buf_.empty()) {
+                spill();
+            }
+            reset();
+            const size_t ways = max_ways();
+            while (runs_.size() > ways) {
+                external_sort_detail::spill_list next;
+                for (size_t i = 0; i < runs_.size(); i += ways) {
+                    const size_t j = tinySTL::min(i + ways, runs_.size());
+                    if (j - i == 1) {
+                        next.take(runs_, i);
+                        continue;
+                    }
+                    external_sort_detail::spill_writer out(next.create(options_.temp_dir).get(),
+                                                           options_.block_size);
+                    merge_runs(i, j, external_sort_detail::spill_inserter<T>(&out));
+                    out.flush();
+                    for (size_t r = i; r < j; ++r) {
+                        runs_.release(r);
+                    }
+                }
+                runs_.swap(next);
+            }
+            result = merge_runs(0, runs_.size(), result);
+            runs_.clear();
+            return result;
+        }
+
+    private:
+        /*
+         * 按倍数扩充缓存，但容量不超过内存预算能容纳的记录数，避免最后一次扩充使内存翻倍
+         */
+        void reserve_one() {
+            if (buf_.size() == buf_.capacity()) {
+                const size_t limit = options_.memory_budget / sizeof(T) + 1;
+                const size_t grow = tinySTL::min(tinySTL::max(2 * buf_.size(), static_cast<size_t>(16)), limit);
+                buf_.reserve(tinySTL::max(grow, buf_.size() + 1));
+            }
+        }
+
+        /*
+         * 排序缓存的记录，写出一个顺串
+         */
+        void spill() {
+            tinySTL::sort(buf_.begin(), buf_.end(), comp_);
+            external_sort_detail::spill_writer out(runs_.create(options_.temp_dir).get(), options_.block_size);
+            for (auto it = buf_.begin(); it != buf_.end(); ++it) {
+                codec::write(out, *it);
+            }
+            out.flush();
+            buf_.clear();
+            bytes_ = 0;
+        }
+
+        void reset() {
+            tinySTL::vector<T>().swap(buf_);
+            bytes_ = 0;
+        }
+
+        /*
+         * 一次最多归并的路数：每一路与输出各占一块缓冲区
+         */
+        size_t max_ways() const {
+            const size_t block = options_.block_size > 0 ? options_.block_size : 1;
+            return tinySTL::max(options_.memory_budget / block, static_cast<size_t>(3)) - 1;
+        }
+
+        /*
+         * 用败者树归并第 [first, last) 个顺串
+         */
+        template<typename OutputIter>
+        OutputIter merge_runs(size_t first, size_t last, OutputIter result) {
+            typedef external_sort_detail::run_iterator<T> run_iter;
+            const size_t k = last - first;
+            const size_t block = tinySTL::max(options_.block_size, options_.memory_budget / (k + 1));
+            tinySTL::vector<external_sort_detail::run_reader<T>> readers;
+            readers.reserve(k);
+            multiway_detail::loser_tree<run_iter, Compared> tree(k, comp_);
+            for (size_t i = first; i < last; ++i) {
+                readers.emplace_back(runs_[i], block);
+                tree.add(run_iter(&readers.back()), run_iter());
+            }
+            tree.build();
+            for (; !tree.empty(); tree.pop()) {
+                *result = *tree.top();
+                ++result;
+            }
+            return result;
+        }
+
+        Compared comp_;
+        external_sort_options options_;
+        tinySTL::vector<T> buf_;
+        size_t bytes_;  // 缓存记录的 footprint 之和
+        external_sort_detail::spill_list runs_;
+    };
+
+    // =============================================================================================
+
+    /*
+     * external_sort 函数
+     * 把 [first, last) 中的记录排序后写到以 result 为起始的区间，返回一个迭代器指向输出结果的尾部
+     * [first, last) 只需要是单遍的输入区间，例如 istream_iterator
+     */
+    template<typename InputIter, typename OutputIter, typename Compared>
+    OutputIter external_sort(InputIter first, InputIter last, OutputIter result, Compared comp,
+                             const external_sort_options &options = external_sort_options()) {
+        typedef typename std::decay<decltype(*first)>::type value_type;
+        external_sorter<value_type, Compared> sorter(comp, options);
+        for (; first != last; ++first) {
+            sorter.push(*first);
+        }
+        return sorter.finish(result);
+    }
+
+    template<typename InputIter, typename OutputIter>
+    OutputIter external_sort(InputIter first, InputIter last, OutputIter result) {
+        return tinySTL::external_sort(first, last, result, search_detail::less_than());
+    }
+
+    /*
+     * external_sort_records 函数
+     * 对二进制流 in 中连续存放的定长记录 T 排序，写到 out；输入的长度不是 sizeof(T) 的整数倍时抛出异常
+     */
+    template<typename T, typename Compared>
+    std::ostream &  // 返回值
+    external_sort_records(std::istream &in, std::ostream &out, Compared comp,
+                          const external_sort_options &options = external_sort_options()) {
+        static_assert(std::is_trivially_copyable<T>::value, "external_sort_records needs trivially copyable records");
+        external_sorter<T, Compared> sorter(comp, options);
+        tinySTL::vector<char> block(tinySTL::max(options.block_size / sizeof(T), static_cast<size_t>(1)) * sizeof(T));
+        size_t carry = 0;  // 上一块末尾不完整的记录已经移到 block 开头的字节数
+        while (in) {
+            in.read(block.data() + carry, static_cast<std::streamsize>(block.size() - carry));
+            const size_t n = carry + static_cast<size_t>(in.gcount());
+            const size_t whole = n / sizeof(T) * sizeof(T);
+            for (size_t pos = 0; pos < whole; pos += sizeof(T)) {
+                T record;
+                std::memcpy(&record, block.data() + pos, sizeof(T));
+                sorter.push(record);
+            }
+            carry = n - whole;
+            std::memmove(block.data(), block.data() + whole, carry);
+        }
+        THROW_RUNTIME_ERROR_IF(carry != 0, "external_sort_records: input is not a whole number of records");
+        sorter.finish(external_sort_detail::record_writer<T>(&out));
+        return out;
+    }
+
+    template<typename T>
+    std::ostream &  // 返回值
+    external_sort_records(std::istream &in, std::ostream &out) {
+        return tinySTL::external_sort_records<T>(in, out, search_detail::less_than());
+    }
+
+    /*
+     * external_sort_lines 函数
+     * 对文本流 in 的各行排序，写到 out，每一行都以换行符结尾
+     * 各行保存为 tinySTL::basic_string<CharType>，无论流的 Traits 是什么，默认的比较都按
+     * tinySTL::char_traits<CharType> 进行；需要按其他规则比较时传入 comp
+     */
+    template<typename CharType, typename Traits, typename Compared>
+    std::basic_ostream<CharType, Traits> &  // 返回值
+    external_sort_lines(std::basic_istream<CharType, Traits> &in, std::basic_ostream<CharType, Traits> &out,
+                        Compared comp, const external_sort_options &options = external_sort_options()) {
+        typedef tinySTL::basic_string<CharType> string_type;
+        external_sorter<string_type, Compared> sorter(comp, options);
+        const CharType newline = in.widen('\n');
+        /* 复制而不是移动：存入的副本容量恰好等于长度，line 的缓冲区可以在下一次读入时复用 */
+        string_type line;
+        while (tinySTL::stream_getline(in, line, newline)) {
+            sorter.push(line);
+        }
+        sorter.finish(external_sort_detail::line_writer<CharType, Traits>(&out));
+        return out;
+    }
+
+    template<typename CharType, typename Traits>
+    std::basic_ostream<CharType, Traits> &  // 返回值
+    external_sort_lines(std::basic_istream<CharType, Traits> &in, std::basic_ostream<CharType, Traits> &out) {
+        return tinySTL::external_sort_lines(in, out, search_detail::less_than());
+    }
+
+}  // namespace tinySTL
+
+#endif //TINYSTL_EXTERNAL_SORT_H
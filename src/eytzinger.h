@@ -0,0 +1,392 @@
+//
+// Created by cqupt1811 on 2022/5/28.
+//
+
+/*
+ * 这个头文件包含一个模板类 eytzinger_index
+ * 把有序序列按 Eytzinger(二叉堆/BFS)顺序重新排列，用于大量的静态查找
+ *
+ * 下标从 1 开始，结点 k 的左右孩子为 2k 与 2k + 1，查找路径上前几层的结点集中在数组开头，
+ * 总是留在缓存中；结点 k 往下第 4 层的 16 个后代在数组中连续存放，查找时可以提前把它们预取进来
+ * 数组按 64 字节对齐，使这些后代恰好落在同一个缓存行中
+ * 查找结果为元素在原有序序列中的下标(rank)，由结点编号直接算出，不需要额外的访存，查找失败时为 size()
+ */
+
+#ifndef TINYSTL_EYTZINGER_H
+#define TINYSTL_EYTZINGER_H
+
+#include <cstdint>  /* uintptr_t */
+#include "vector.h"  /* 这个头文件包含一个模板类 vector */
+#include "algo.h"  /* 这个头文件包含了 tinySTL 的一系列算法，以及预取宏 TINYSTL_PREFETCH */
+#include "functional.h"  /* 这个头文件包含了 tinySTL 的函数对象与哈希函数 */
+
+/* 首先定义自己的命名空间 */
+namespace tinySTL {
+
+    /*
+     * 模板类 eytzinger_index
+     * 参数 T 代表元素类型，参数 Compared 代表比较方式，构造时传入的序列必须按 Compared 有序
+     */
+    template<typename T, typename Compared = tinySTL::less<T>>
+    class eytzinger_index {
+    public:
+        /*
+         * 定义类中使用的类型别名
+         */
+        typedef T value_type;
+        typedef Compared value_compare;
+        typedef size_t size_type;
+
+    private:
+        /*
+         * 缓存行大小，以及一个缓存行能容纳的元素个数(取 2 的幂)
+         * 一次预取覆盖结点往下 log2(prefetch_stride) 层的全部后代
+         */
+        static constexpr size_type cache_line = 64;
+
+        static constexpr size_type stride_of(size_type n) {
+            return n <= 1 ? 1 : 2 * stride_of(n / 2);
+        }
+
+        static constexpr size_type prefetch_stride = stride_of(sizeof(T) < cache_line ? cache_line / sizeof(T) : 1);
+
+        /*
+         * 元素大小整除缓存行时才能让每组后代对齐到缓存行，此时在数组开头多留出一个缓存行用于调整
+         */
+        static constexpr bool can_align = cache_line % sizeof(T) == 0 && alignof(T) == sizeof(T);
+
+        static constexpr size_type align_pad = can_align ? cache_line / sizeof(T) : 0;
+
+        /*
+         * lower_bound_many 中同时推进的查询个数
+         */
+        static constexpr size_type batch_size = 16;
+
+        /*
+         * 结点 k 保存在 storage_[offset() + k] 中，k 从 1 开始
+         */
+        tinySTL::vector<T> storage_;
+        size_type size_;
+        size_type height_;  // 树的层数
+        value_compare comp_;
+
+    public:
+        /*
+         * 构造、复制、移动函数
+         */
+        eytzinger_index() : storage_(), size_(0), height_(0), comp_() {
+        }
+
+        /*
+         * 由有序区间 [first, last) 构造
+         */
+        template<typename ForwardIter>
+        eytzinger_index(ForwardIter first, ForwardIter last, const value_compare &comp = value_compare());
+
+        explicit eytzinger_index(const tinySTL::vector<T> &sorted, const value_compare &comp = value_compare())
+                : eytzinger_index(sorted.begin(), sorted.end(), comp) {
+        }
+
+        /*
+         * 复制后新数组的对齐位置可能不同，需要把结点整体平移到新的位置
+         */
+        eytzinger_index(const eytzinger_index &rhs)
+                : storage_(rhs.storage_), size_(rhs.size_), height_(rhs.height_), comp_(rhs.comp_) {
+            realign(rhs.offset());
+        }
+
+        /*
+         * 移动时数组的地址不变，对齐位置也不变
+         */
+        eytzinger_index(eytzinger_index &&rhs) noexcept
+                : storage_(tinySTL::move(rhs.storage_)), size_(rhs.size_), height_(rhs.height_), comp_(rhs.comp_) {
+            rhs.size_ = 0;
+            rhs.height_ = 0;
+        }
+
+        eytzinger_index &operator=(const eytzinger_index &rhs);
+
+        eytzinger_index &operator=(eytzinger_index &&rhs) noexcept;
+
+    public:
+        /*
+         * 容量相关操作
+         */
+
+        size_type size() const noexcept {
+            return size_;
+        }
+
+        bool empty() const noexcept {
+            return size_ == 0;
+        }
+
+        value_compare value_comp() const {
+            return comp_;
+        }
+
+        /*
+         * 查找相关操作，返回值均为原有序序列中的下标
+         */
+
+        /*
+         * 第一个不小于 value 的元素的下标，没有则返回 size()
+         */
+        size_type lower_bound(const T &value) const {
+            return rank_of(lower_bound_node(value));
+        }
+
+        /*
+         * 第一个大于 value 的元素的下标，没有则返回 size()
+         */
+        size_type upper_bound(const T &value) const;
+
+        /*
+         * 是否存在与 value 等价的元素
+         */
+        bool contains(const T &value) const {
+            const size_type k = lower_bound_node(value);
+            return k != 0 && !comp_(value, tree()[k]);
+        }
+
+        /*
+         * 对 [first, last) 中的每个值求 lower_bound，结果依次写入 result，返回 result 的尾后位置
+         * 查询每 16 个一组逐层同步推进，各查询的访存互不依赖，可以同时等待缓存未命中
+         */
+        template<typename ForwardIter, typename OutputIter>
+        OutputIter lower_bound_many(ForwardIter first, ForwardIter last, OutputIter result) const;
+
+    private:
+        /*
+         * 私有的辅助函数
+         */
+
+        /* 结点 0 在 storage_ 中的位置，使 tree() + prefetch_stride * k 对齐到缓存行 */
+        size_type offset() const noexcept {
+            if (!can_align || storage_.empty()) {
+                return 0;
+            }
+            const uintptr_t addr = reinterpret_cast<uintptr_t>(storage_.data());
+            return ((cache_line - addr % cache_line) % cache_line) / sizeof(T);
+        }
+
+        const T *tree() const noexcept {
+            return storage_.data() + offset();
+        }
+
+        /* 复制得到的 storage_ 中结点 0 位于 old_offset 处，平移到当前的对齐位置 */
+        void realign(size_type old_offset);
+
+        /* 按中序遍历把有序序列依次放到以 k 为根的子树中 */
+        template<typename ForwardIter>
+        void build(T *tree, ForwardIter &cur, size_type k);
+
+        /* 返回第一个不小于 value 的结点，没有则返回 0 */
+        size_type lower_bound_node(const T &value) const;
+
+        /* 结点 k 在有序序列中的下标 */
+        size_type rank_of(size_type k) const noexcept;
+
+        /* 在数组范围内预取结点 k 往下若干层的后代 */
+        void prefetch_descendants(const T *tree, size_type k) const noexcept {
+            if (k * prefetch_stride <= size_) {
+                TINYSTL_PREFETCH(tree + k * prefetch_stride);
+            }
+        }
+
+        /*
+         * 查找路径中每向右走一步就在 k 的末尾添加一个 1，最后一次向左走的结点即为答案，
+         * 去掉末尾连续的 1 以及再前面的一个 0 就得到该结点，从未向左走时得到 0
+         */
+        static size_type last_left_turn(size_type k) noexcept {
+#if defined(__GNUC__) || defined(__clang__)
+            return k >> (__builtin_ctzll(~static_cast<unsigned long long>(k)) + 1);
+#else
+            while (k & 1) {
+                k >>= 1;
+            }
+            return k >> 1;
+#endif
+        }
+
+        /* floor(log2(k))，k 不为 0 */
+        static size_type floor_log2(size_type k) noexcept {
+#if defined(__GNUC__) || defined(__clang__)
+            return static_cast<size_type>(63 - __builtin_clzll(static_cast<unsigned long long>(k)));
+#else
+            size_type r = 0;
+            while (k >>= 1) {
+                ++r;
+            }
+            return r;
+#endif
+        }
+    };
+
+    /*
+     * 由有序区间 [first, last) 构造
+     */
+    template<typename T, typename Compared>
+    template<typename ForwardIter>
+    eytzinger_index<T, Compared>::eytzinger_index(ForwardIter first, ForwardIter last, const value_compare &comp)
+            :storage_(), size_(0), height_(0), comp_(comp) {
+        size_ = static_cast<size_type>(tinySTL::distance(first, last));
+        if (size_ == 0) {
+            return;
+        }
+        height_ = floor_log2(size_) + 1;
+        storage_.assign(size_ + 1 + align_pad, *first);
+        T *tree = storage_.data() + offset();
+        build(tree, first, 1);
+    }
+
+    /*
+     * 复制赋值运算符
+     */
+    template<typename T, typename Compared>
+    eytzinger_index<T, Compared> &  // 返回值
+    eytzinger_index<T, Compared>::operator=(const eytzinger_index &rhs) {
+        if (this != &rhs) {
+            storage_ = rhs.storage_;
+            size_ = rhs.size_;
+            height_ = rhs.height_;
+            comp_ = rhs.comp_;
+            realign(rhs.offset());
+        }
+        return *this;
+    }
+
+    /*
+     * 移动赋值运算符
+     */
+    template<typename T, typename Compared>
+    eytzinger_index<T, Compared> &  // 返回值
+    eytzinger_index<T, Compared>::operator=(eytzinger_index &&rhs) noexcept {
+        storage_ = tinySTL::move(rhs.storage_);
+        size_ = rhs.size_;
+        height_ = rhs.height_;
+        comp_ = rhs.comp_;
+        rhs.size_ = 0;
+        rhs.height_ = 0;
+        return *this;
+    }
+
+    /*
+     * 第一个大于 value 的元素的下标
+     */
+    template<typename T, typename Compared>
+    typename eytzinger_index<T, Compared>::size_type  // 返回值
+    eytzinger_index<T, Compared>::upper_bound(const T &value) const {
+        const T *t = tree();
+        size_type k = 1;
+        while (k <= size_) {
+            prefetch_descendants(t, k);
+            k = 2 * k + (comp_(value, t[k]) ? 0 : 1);
+        }
+        return rank_of(last_left_turn(k));
+    }
+
+    /*
+     * 批量求 lower_bound
+     * 前 height_ - 1 层是满的，所有查询在这些层上都不会越界，只有最后一层需要判断
+     */
+    template<typename T, typename Compared>
+    template<typename ForwardIter, typename OutputIter>
+    OutputIter  // 返回值
+    eytzinger_index<T, Compared>::lower_bound_many(ForwardIter first, ForwardIter last, OutputIter result) const {
+        const T *t = tree();
+        const size_type full_levels = height_ == 0 ? 0 : height_ - 1;
+        size_type node[batch_size];
+        ForwardIter query[batch_size];
+        while (first != last) {
+            size_type m = 0;
+            for (; m < batch_size && first != last; ++m, ++first) {
+                query[m] = first;
+                node[m] = 1;
+            }
+            for (size_type level = 0; level < full_levels; ++level) {
+                for (size_type i = 0; i < m; ++i) {
+                    prefetch_descendants(t, node[i]);
+                    node[i] = 2 * node[i] + (comp_(t[node[i]], *query[i]) ? 1 : 0);
+                }
+            }
+            for (size_type i = 0; i < m; ++i, ++result) {
+                if (node[i] <= size_) {
+                    node[i] = 2 * node[i] + (comp_(t[node[i]], *query[i]) ? 1 : 0);
+                }
+                *result = rank_of(last_left_turn(node[i]));
+            }
+        }
+        return result;
+    }
+
+    /*
+     * 把结点从 old_offset 处平移到当前的对齐位置
+     */
+    template<typename T, typename Compared>
+    void eytzinger_index<T, Compared>::realign(size_type old_offset) {
+        const size_type new_offset = offset();
+        if (storage_.empty() || new_offset == old_offset) {
+            return;
+        }
+        auto first = storage_.begin() + old_offset;
+        auto last = first + (size_ + 1);
+        if (new_offset < old_offset) {
+            tinySTL::copy(first, last, storage_.begin() + new_offset);
+        } else {
+            tinySTL::copy_backward(first, last, storage_.begin() + new_offset + (size_ + 1));
+        }
+    }
+
+    /*
+     * 中序遍历以 k 为根的子树，依次取出有序序列中的元素
+     */
+    template<typename T, typename Compared>
+    template<typename ForwardIter>
+    void eytzinger_index<T, Compared>::build(T *tree, ForwardIter &cur, size_type k) {
+        if (k > size_) {
+            return;
+        }
+        build(tree, cur, 2 * k);
+        tree[k] = *cur;
+        ++cur;
+        build(tree, cur, 2 * k + 1);
+    }
+
+    /*
+     * 返回第一个不小于 value 的结点，没有则返回 0
+     */
+    template<typename T, typename Compared>
+    typename eytzinger_index<T, Compared>::size_type  // 返回值
+    eytzinger_index<T, Compared>::lower_bound_node(const T &value) const {
+        const T *t = tree();
+        size_type k = 1;
+        while (k <= size_) {
+            prefetch_descendants(t, k);
+            k = 2 * k + (comp_(t[k], value) ? 1 : 0);
+        }
+        return last_left_turn(k);
+    }
+
+    /*
+     * 结点 k 在有序序列中的下标
+     * 先按 height_ 层的满二叉树求中序下标：第 d 层第 j 个结点为 (2j + 1) * 2^(height_ - 1 - d) - 1，
+     * 满树中最后一层的结点恰好是中序下标为偶数的结点，再减去排在它前面但实际不存在的最后一层结点
+     */
+    template<typename T, typename Compared>
+    typename eytzinger_index<T, Compared>::size_type  // 返回值
+    eytzinger_index<T, Compared>::rank_of(size_type k) const noexcept {
+        if (k == 0) {
+            return size_;
+        }
+        const size_type d = floor_log2(k);
+        const size_type j = k - (static_cast<size_type>(1) << d);
+        const size_type full_rank = ((2 * j + 1) << (height_ - 1 - d)) - 1;
+        const size_type leaves_before = (full_rank + 1) >> 1;
+        const size_type last_level = size_ - ((static_cast<size_type>(1) << (height_ - 1)) - 1);
+        return full_rank - (leaves_before > last_level ? leaves_before - last_level : 0);
+    }
+
+}  // namespace tinySTL
+
+#endif //TINYSTL_EYTZINGER_H
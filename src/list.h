@@ -200,6 +200,11 @@ namespace tinySTL {
 
         }
 
+        /*
+         * 编译器自动生成拷贝赋值函数
+         */
+        list_iterator &operator=(const list_iterator &rhs) = default;
+
         /*
          * 操作符 * 重载
          * 返回节点中保存的值的引用
@@ -0,0 +1,1024 @@
+//
+// Created by cqupt1811 on 2022/5/22.
+//
+
+/*
+ * 这个头文件包含一个模板类 rope
+ * 用于大字符串的拼接与编辑
+ *
+ * rope 是一棵持久化的 AVL 树，叶子节点保存不可变的字符块，内部节点只记录左右子树与长度
+ * 所有节点都带有引用计数，拷贝 rope 或者取子串时只增加引用计数，不复制字符
+ * 拼接、子串、插入、删除的复杂度都是 O(log n)，逐块遍历可以不经复制直接输出
+ */
+
+#ifndef TINYSTL_ROPE_H
+#define TINYSTL_ROPE_H
+
+#include <atomic>  /* std::atomic 原子类型，用于节点的引用计数 */
+#include <iostream>  /* c++的io库 */
+#include "astring.h"  /* 定义了 string, wstring, u16string, u32string 类型 */
+#include "vector.h"  /* 这个头文件包含一个模板类 vector */
+#include "memory.h"  /* 这个头文件负责更高级的动态内存管理,包含一些基本函数、空间配置器、未初始化的储存空间管理，以及一个模板类 auto_ptr */
+#include "utils.h"  /* 这个文件包含一些通用工具，包括 move, forward, swap 等函数，以及 pair 等 */
+#include "exceptdef.h"  /* 此文件中定义了异常相关的宏 */
+
+/* 首先定义自己的命名空间 */
+namespace tinySTL {
+
+    /*
+     * rope 节点的种类
+     * flat 为拥有字符的叶子节点，substring 为引用某个 flat 节点一部分的叶子节点，concat 为内部节点
+     */
+    enum class rope_tag : unsigned char {
+        flat, substring, concat
+    };
+
+    /*
+     * rope 节点的公共部分
+     * refs 为引用计数，size 为子树中的字符数，height 为子树高度(叶子为 0)
+     */
+    struct rope_node_base {
+        std::atomic<size_t> refs;
+        size_t size;
+        rope_tag tag;
+        unsigned char height;
+
+        rope_node_base(size_t n, rope_tag t, unsigned char h) : refs(1), size(n), tag(t), height(h) {
+        }
+    };
+
+    /*
+     * 拥有字符的叶子节点
+     */
+    template<typename CharType, typename CharTraits>
+    struct rope_flat : public rope_node_base {
+        basic_string<CharType, CharTraits> str;
+
+        explicit rope_flat(basic_string<CharType, CharTraits> &&s)
+                : rope_node_base(s.size(), rope_tag::flat, 0), str(tinySTL::move(s)) {
+        }
+    };
+
+    /*
+     * 引用 flat 节点中一段字符的叶子节点
+     * data 指向 base 中的字符，base 被引用期间不会被修改
+     */
+    template<typename CharType>
+    struct rope_substring : public rope_node_base {
+        rope_node_base *base;
+        const CharType *data;
+
+        rope_substring(rope_node_base *b, const CharType *d, size_t n)
+                : rope_node_base(n, rope_tag::substring, 0), base(b), data(d) {
+        }
+    };
+
+    /*
+     * 内部节点，左右子树按顺序拼接
+     */
+    struct rope_concat : public rope_node_base {
+        rope_node_base *left;
+        rope_node_base *right;
+
+        rope_concat(rope_node_base *l, rope_node_base *r)
+                : rope_node_base(l->size + r->size, rope_tag::concat,
+                                 static_cast<unsigned char>((l->height > r->height ? l->height : r->height) + 1)),
+                  left(l), right(r) {
+        }
+    };
+
+    // ==============================================================================================
+
+    /*
+     * 模板类 rope
+     * 参数 CharType 代表字符类型，参数 CharTraits 代表字符萃取器
+     */
+    template<typename CharType, typename CharTraits = tinySTL::char_traits<CharType>>
+    class rope {
+    public:
+        /*
+         * 定义类中使用的类型别名
+         */
+        typedef CharTraits traits_type;
+        typedef CharType value_type;
+        typedef size_t size_type;
+        typedef ptrdiff_t difference_type;
+        typedef basic_string<CharType, CharTraits> string_type;
+        typedef basic_string_view<CharType, CharTraits> view_type;
+
+        /*
+         * 查找失败或表示"直到末尾"时使用的值
+         */
+        static constexpr size_type npos = static_cast<size_type>(-1);
+
+        /*
+         * 两个相邻的叶子总长度不超过该值时合并为一个 flat 叶子，
+         * 避免由大量小片段拼接时产生过多的节点
+         */
+        static constexpr size_type flat_limit = 4096 / sizeof(CharType) > 64 ? 4096 / sizeof(CharType) : 64;
+
+        /*
+         * 子串长度不超过该值时直接复制字符，否则引用原来的 flat 节点
+         */
+        static constexpr size_type substring_copy_limit = 64;
+
+    private:
+        typedef rope_node_base node_base;
+        typedef node_base *node_ptr;
+        typedef rope_flat<CharType, CharTraits> flat_node;
+        typedef rope_substring<CharType> substring_node;
+        typedef rope_concat concat_node;
+
+        typedef tinySTL::allocator<flat_node> flat_allocator;
+        typedef tinySTL::allocator<substring_node> substring_allocator;
+        typedef tinySTL::allocator<concat_node> concat_allocator;
+
+        /*
+         * 根节点，空 rope 的根节点为 nullptr
+         */
+        node_ptr root_;
+
+    public:
+        /*
+         * 逐块遍历的迭代器，每个元素是一个叶子节点中字符的视图
+         */
+        class chunk_iterator {
+        public:
+            typedef tinySTL::forward_iterator_tag iterator_category;
+            typedef view_type value_type;
+            typedef ptrdiff_t difference_type;
+            typedef const view_type *pointer;
+            typedef const view_type &reference;
+
+            chunk_iterator() : stack_(), cur_() {
+            }
+
+            explicit chunk_iterator(node_ptr root) : stack_(), cur_() {
+                if (root) {
+                    descend(root);
+                }
+            }
+
+            reference operator*() const {
+                return cur_;
+            }
+
+            pointer operator->() const {
+                return &cur_;
+            }
+
+            chunk_iterator &operator++() {
+                if (stack_.empty()) {
+                    cur_ = view_type();
+                } else {
+                    node_ptr next = stack_.back();
+                    stack_.pop_back();
+                    descend(next);
+                }
+                return *this;
+            }
+
+            chunk_iterator operator++(int) {
+                chunk_iterator temp = *this;
+                ++*this;
+                return temp;
+            }
+
+            /* 所有的 end 迭代器都相等 */
+            bool operator==(const chunk_iterator &rhs) const {
+                return cur_.data() == rhs.cur_.data() && stack_.size() == rhs.stack_.size();
+            }
+
+            bool operator!=(const chunk_iterator &rhs) const {
+                return !(*this == rhs);
+            }
+
+        private:
+            /* 沿左子树走到最左边的叶子，右子树依次压栈 */
+            void descend(node_ptr node) {
+                while (node->tag == rope_tag::concat) {
+                    stack_.push_back(static_cast<concat_node *>(node)->right);
+                    node = static_cast<concat_node *>(node)->left;
+                }
+                cur_ = view_type(leaf_data(node), node->size);
+            }
+
+            tinySTL::vector<node_ptr> stack_;
+            view_type cur_;
+        };
+
+    public:
+        /*
+         * 构造、复制、移动、析构函数
+         */
+        rope() noexcept: root_(nullptr) {
+        }
+
+        rope(const CharType *s) : root_(nullptr) {
+            size_type n = traits_type::length(s);
+            if (n != 0) {
+                root_ = make_flat(s, n);
+            }
+        }
+
+        rope(const CharType *s, size_type count) : root_(nullptr) {
+            if (count != 0) {
+                root_ = make_flat(s, count);
+            }
+        }
+
+        explicit rope(view_type v) : rope(v.data(), v.size()) {
+        }
+
+        rope(const string_type &str) : rope(str.begin(), str.size()) {
+        }
+
+        /* 直接接管 str 的缓冲区作为一个叶子，不复制字符 */
+        rope(string_type &&str) : root_(nullptr) {
+            if (!str.empty()) {
+                root_ = make_flat(tinySTL::move(str));
+            }
+        }
+
+        rope(size_type count, CharType ch) : root_(nullptr) {
+            if (count != 0) {
+                root_ = make_flat(string_type(count, ch));
+            }
+        }
+
+        rope(const rope &rhs) noexcept: root_(ref(rhs.root_)) {
+        }
+
+        rope(rope &&rhs) noexcept: root_(rhs.root_) {
+            rhs.root_ = nullptr;
+        }
+
+        rope &operator=(const rope &rhs) noexcept {
+            node_ptr old = root_;
+            root_ = ref(rhs.root_);
+            unref(old);
+            return *this;
+        }
+
+        rope &operator=(rope &&rhs) noexcept {
+            if (this != &rhs) {
+                unref(root_);
+                root_ = rhs.root_;
+                rhs.root_ = nullptr;
+            }
+            return *this;
+        }
+
+        ~rope() {
+            unref(root_);
+        }
+
+    public:
+        /*
+         * 容量相关函数
+         */
+        bool empty() const noexcept {
+            return root_ == nullptr;
+        }
+
+        size_type size() const noexcept {
+            return root_ ? root_->size : 0;
+        }
+
+        size_type length() const noexcept {
+            return size();
+        }
+
+        /*
+         * 树的高度，叶子为 0
+         */
+        size_type height() const noexcept {
+            return root_ ? root_->height : 0;
+        }
+
+        /*
+         * 访问元素相关操作，O(log n)
+         */
+        CharType operator[](size_type n) const {
+            TINYSTL_DEBUG(n < size());
+            node_ptr node = root_;
+            while (node->tag == rope_tag::concat) {
+                concat_node *c = static_cast<concat_node *>(node);
+                if (n < c->left->size) {
+                    node = c->left;
+                } else {
+                    n -= c->left->size;
+                    node = c->right;
+                }
+            }
+            return leaf_data(node)[n];
+        }
+
+        CharType at(size_type n) const {
+            THROW_OUT_OF_RANGE_IF(n >= size(), "rope<Char, Traits>::at() subscript out of range");
+            return (*this)[n];
+        }
+
+        CharType front() const {
+            TINYSTL_DEBUG(!empty());
+            return (*this)[0];
+        }
+
+        CharType back() const {
+            TINYSTL_DEBUG(!empty());
+            return (*this)[size() - 1];
+        }
+
+        /*
+         * 逐块遍历相关操作
+         */
+        chunk_iterator chunk_begin() const {
+            return chunk_iterator(root_);
+        }
+
+        chunk_iterator chunk_end() const {
+            return chunk_iterator();
+        }
+
+        /*
+         * 按顺序对每个叶子调用 f(const CharType *, size_type)
+         */
+        template<typename Function>
+        void for_each_chunk(Function f) const {
+            if (root_) {
+                for_each_chunk(root_, f);
+            }
+        }
+
+        /*
+         * 修改容器相关操作
+         */
+
+        /*
+         * 在末尾拼接，O(log n)
+         */
+        rope &append(const rope &r) {
+            node_ptr node = ref(r.root_);
+            root_ = join(release(), node);
+            return *this;
+        }
+
+        rope &append(const CharType *s, size_type count) {
+            if (count != 0) {
+                node_ptr node = make_flat(s, count);
+                root_ = join(release(), node);
+            }
+            return *this;
+        }
+
+        rope &append(const CharType *s) {
+            return append(s, traits_type::length(s));
+        }
+
+        rope &append(view_type v) {
+            return append(v.data(), v.size());
+        }
+
+        rope &append(const string_type &str) {
+            return append(str.begin(), str.size());
+        }
+
+        rope &append(string_type &&str) {
+            if (!str.empty()) {
+                node_ptr node = make_flat(tinySTL::move(str));
+                root_ = join(release(), node);
+            }
+            return *this;
+        }
+
+        rope &push_back(CharType ch) {
+            return append(&ch, 1);
+        }
+
+        /*
+         * 重载 += 操作符
+         */
+        rope &operator+=(const rope &r) {
+            return append(r);
+        }
+
+        rope &operator+=(const CharType *s) {
+            return append(s);
+        }
+
+        rope &operator+=(view_type v) {
+            return append(v);
+        }
+
+        rope &operator+=(const string_type &str) {
+            return append(str);
+        }
+
+        rope &operator+=(string_type &&str) {
+            return append(tinySTL::move(str));
+        }
+
+        rope &operator+=(CharType ch) {
+            return push_back(ch);
+        }
+
+        /*
+         * 在开头拼接，O(log n)
+         */
+        rope &prepend(const rope &r) {
+            node_ptr node = ref(r.root_);
+            root_ = join(node, release());
+            return *this;
+        }
+
+        /*
+         * 返回 [pos, pos + count) 的子串，与原 rope 共享字符，O(log n)
+         */
+        rope substr(size_type pos = 0, size_type count = npos) const;
+
+        /*
+         * 在 pos 处插入 r，O(log n)
+         */
+        rope &insert(size_type pos, const rope &r);
+
+        rope &insert(size_type pos, const CharType *s, size_type count) {
+            return insert(pos, rope(s, count));
+        }
+
+        rope &insert(size_type pos, const CharType *s) {
+            return insert(pos, rope(s));
+        }
+
+        /*
+         * 删除 [pos, pos + count)，O(log n)
+         */
+        rope &erase(size_type pos, size_type count = npos);
+
+        /*
+         * 把 [pos, pos + count) 替换为 r，O(log n)
+         */
+        rope &replace(size_type pos, size_type count, const rope &r);
+
+        void pop_back() {
+            TINYSTL_DEBUG(!empty());
+            erase(size() - 1, 1);
+        }
+
+        void clear() noexcept {
+            unref(root_);
+            root_ = nullptr;
+        }
+
+        void swap(rope &rhs) noexcept {
+            tinySTL::swap(root_, rhs.root_);
+        }
+
+        /*
+         * 转换相关操作
+         */
+
+        /*
+         * 把所有字符复制到一个 basic_string 中
+         */
+        string_type str() const;
+
+        /*
+         * 从 pos 开始复制最多 count 个字符到 dest，返回复制的字符数
+         */
+        size_type copy(CharType *dest, size_type count, size_type pos = 0) const;
+
+        /*
+         * 比较操作
+         */
+        int compare(const rope &rhs) const;
+
+        /*
+         * 重载 << 操作符，逐块输出，设置了宽度且需要补齐时先拼接成一个字符串
+         */
+        template<typename Traits>
+        friend std::basic_ostream<CharType, Traits> &
+        operator<<(std::basic_ostream<CharType, Traits> &os, const rope &r) {
+            if (os.width() > 0 && static_cast<size_type>(os.width()) > r.size()) {
+                return os << r.str();
+            }
+            os.width(0);
+            for (chunk_iterator it = r.chunk_begin(), last = r.chunk_end(); it != last; ++it) {
+                tinySTL::stream_write(os, (*it).data(), (*it).size());
+            }
+            return os;
+        }
+
+    private:
+        /*
+         * 私有的辅助函数
+         * 除特别说明外，参数中的节点指针的引用由函数接管，返回的节点指针由调用者持有
+         */
+
+        static const CharType *leaf_data(node_ptr node) noexcept {
+            return node->tag == rope_tag::flat ? static_cast<flat_node *>(node)->str.begin()
+                                               : static_cast<substring_node *>(node)->data;
+        }
+
+        /* 交出根节点的引用，rope 变为空，用于修改操作中途抛出异常时不留下悬空的根节点 */
+        node_ptr release() noexcept {
+            node_ptr r = root_;
+            root_ = nullptr;
+            return r;
+        }
+
+        static bool is_leaf(node_ptr node) noexcept {
+            return node->tag != rope_tag::concat;
+        }
+
+        static node_ptr ref(node_ptr node) noexcept {
+            if (node) {
+                node->refs.fetch_add(1, std::memory_order_relaxed);
+            }
+            return node;
+        }
+
+        static void unref(node_ptr node) noexcept;
+
+        static node_ptr make_flat(string_type &&str);
+
+        static node_ptr make_flat(const CharType *s, size_type count) {
+            return make_flat(string_type(s, count));
+        }
+
+        static node_ptr make_concat(node_ptr left, node_ptr right);
+
+        /* 取叶子 leaf 中 [pos, pos + count) 的部分，leaf 的引用不被接管 */
+        static node_ptr make_substring(node_ptr leaf, size_type pos, size_type count);
+
+        /* 拼接两个叶子，若 left 是唯一持有的 flat 节点就直接在其后追加 */
+        static node_ptr merge_leaves(node_ptr left, node_ptr right);
+
+        /* 拼接两棵树 */
+        static node_ptr join(node_ptr left, node_ptr right);
+
+        /* 把 node 从 pos 处分为两棵树，node 的引用不被接管 */
+        static void split(node_ptr node, size_type pos, node_ptr &left, node_ptr &right);
+
+        template<typename Function>
+        static void for_each_chunk(node_ptr node, Function &f) {
+            while (node->tag == rope_tag::concat) {
+                for_each_chunk(static_cast<concat_node *>(node)->left, f);
+                node = static_cast<concat_node *>(node)->right;
+            }
+            f(leaf_data(node), node->size);
+        }
+
+        /* 取出内部节点的左右子树并释放该节点 */
+        static void take_children(node_ptr node, node_ptr &left, node_ptr &right) {
+            left = ref(static_cast<concat_node *>(node)->left);
+            right = ref(static_cast<concat_node *>(node)->right);
+            unref(node);
+        }
+    };
+
+    template<typename CharType, typename CharTraits>
+    constexpr typename rope<CharType, CharTraits>::size_type rope<CharType, CharTraits>::npos;
+
+    template<typename CharType, typename CharTraits>
+    constexpr typename rope<CharType, CharTraits>::size_type rope<CharType, CharTraits>::flat_limit;
+
+    template<typename CharType, typename CharTraits>
+    constexpr typename rope<CharType, CharTraits>::size_type rope<CharType, CharTraits>::substring_copy_limit;
+
+    // =====================================================================================
+
+    /*
+     * 返回 [pos, pos + count) 的子串
+     */
+    template<typename CharType, typename CharTraits>
+    rope<CharType, CharTraits> rope<CharType, CharTraits>::substr(size_type pos, size_type count) const {
+        THROW_OUT_OF_RANGE_IF(pos > size(), "rope<Char, Traits>::substr() pos out of range");
+        count = tinySTL::min(count, size() - pos);
+        rope result;
+        if (count == 0) {
+            return result;
+        }
+        node_ptr left, rest, mid, right;
+        split(root_, pos, left, rest);
+        unref(left);
+        split(rest, count, mid, right);
+        unref(rest);
+        unref(right);
+        result.root_ = mid;
+        return result;
+    }
+
+    /*
+     * 在 pos 处插入 r
+     */
+    template<typename CharType, typename CharTraits>
+    rope<CharType, CharTraits> &rope<CharType, CharTraits>::insert(size_type pos, const rope &r) {
+        THROW_OUT_OF_RANGE_IF(pos > size(), "rope<Char, Traits>::insert() pos out of range");
+        if (r.empty()) {
+            return *this;
+        }
+        node_ptr rn = ref(r.root_);  // r 可能就是 *this，先持有它的根节点再修改
+        node_ptr left, right;
+        split(root_, pos, left, right);
+        unref(release());
+        root_ = join(join(left, rn), right);
+        return *this;
+    }
+
+    /*
+     * 删除 [pos, pos + count)
+     */
+    template<typename CharType, typename CharTraits>
+    rope<CharType, CharTraits> &rope<CharType, CharTraits>::erase(size_type pos, size_type count) {
+        THROW_OUT_OF_RANGE_IF(pos > size(), "rope<Char, Traits>::erase() pos out of range");
+        return replace(pos, count, rope());
+    }
+
+    /*
+     * 把 [pos, pos + count) 替换为 r
+     */
+    template<typename CharType, typename CharTraits>
+    rope<CharType, CharTraits> &
+    rope<CharType, CharTraits>::replace(size_type pos, size_type count, const rope &r) {
+        THROW_OUT_OF_RANGE_IF(pos > size(), "rope<Char, Traits>::replace() pos out of range");
+        count = tinySTL::min(count, size() - pos);
+        node_ptr rn = ref(r.root_);  // r 可能就是 *this，先持有它的根节点再修改
+        node_ptr left, rest, mid, right;
+        split(root_, pos, left, rest);
+        split(rest, count, mid, right);
+        unref(rest);
+        unref(mid);
+        unref(release());
+        root_ = join(join(left, rn), right);
+        return *this;
+    }
+
+    /*
+     * 把所有字符复制到一个 basic_string 中
+     */
+    template<typename CharType, typename CharTraits>
+    typename rope<CharType, CharTraits>::string_type  // 返回值
+    rope<CharType, CharTraits>::str() const {
+        string_type result;
+        result.reserve(size());
+        for_each_chunk([&result](const CharType *s, size_type n) {
+            result.append(s, n);
+        });
+        return result;
+    }
+
+    /*
+     * 从 pos 开始复制最多 count 个字符到 dest
+     */
+    template<typename CharType, typename CharTraits>
+    typename rope<CharType, CharTraits>::size_type  // 返回值
+    rope<CharType, CharTraits>::copy(CharType *dest, size_type count, size_type pos) const {
+        THROW_OUT_OF_RANGE_IF(pos > size(), "rope<Char, Traits>::copy() pos out of range");
+        count = tinySTL::min(count, size() - pos);
+        size_type copied = 0;
+        for (chunk_iterator it = chunk_begin(), last = chunk_end(); it != last && copied < count; ++it) {
+            view_type chunk = *it;
+            if (pos >= chunk.size()) {
+                pos -= chunk.size();
+                continue;
+            }
+            const size_type n = tinySTL::min(chunk.size() - pos, count - copied);
+            traits_type::copy(dest + copied, chunk.data() + pos, n);
+            copied += n;
+            pos = 0;
+        }
+        return copied;
+    }
+
+    /*
+     * 逐块比较两个 rope
+     */
+    template<typename CharType, typename CharTraits>
+    int rope<CharType, CharTraits>::compare(const rope &rhs) const {
+        if (root_ == rhs.root_) {
+            return 0;
+        }
+        chunk_iterator i1 = chunk_begin(), i2 = rhs.chunk_begin(), last = chunk_end();
+        view_type c1, c2;
+        while (true) {
+            if (c1.empty()) {
+                if (i1 == last) {
+                    break;
+                }
+                c1 = *i1++;
+            }
+            if (c2.empty()) {
+                if (i2 == last) {
+                    break;
+                }
+                c2 = *i2++;
+            }
+            const size_type n = tinySTL::min(c1.size(), c2.size());
+            const int r = traits_type::compare(c1.data(), c2.data(), n);
+            if (r != 0) {
+                return r;
+            }
+            c1.remove_prefix(n);
+            c2.remove_prefix(n);
+        }
+        const bool end1 = c1.empty() && i1 == last;
+        const bool end2 = c2.empty() && i2 == last;
+        return end1 ? (end2 ? 0 : -1) : 1;
+    }
+
+    /*
+     * 释放一个引用，引用计数为 0 时销毁节点
+     */
+    template<typename CharType, typename CharTraits>
+    void rope<CharType, CharTraits>::unref(node_ptr node) noexcept {
+        while (node && node->refs.fetch_sub(1, std::memory_order_acq_rel) == 1) {
+            node_ptr next = nullptr;
+            switch (node->tag) {
+                case rope_tag::flat: {
+                    flat_node *f = static_cast<flat_node *>(node);
+                    flat_allocator::destroy(f);
+                    flat_allocator::deallocate(f);
+                    break;
+                }
+                case rope_tag::substring: {
+                    substring_node *s = static_cast<substring_node *>(node);
+                    next = s->base;
+                    substring_allocator::destroy(s);
+                    substring_allocator::deallocate(s);
+                    break;
+                }
+                case rope_tag::concat: {
+                    concat_node *c = static_cast<concat_node *>(node);
+                    /* 左子树递归释放，右子树在循环中释放，递归深度不超过树高 */
+                    unref(c->left);
+                    next = c->right;
+                    concat_allocator::destroy(c);
+                    concat_allocator::deallocate(c);
+                    break;
+                }
+            }
+            node = next;
+        }
+    }
+
+    /*
+     * 创建 flat 叶子，接管 str 的缓冲区
+     */
+    template<typename CharType, typename CharTraits>
+    typename rope<CharType, CharTraits>::node_ptr  // 返回值
+    rope<CharType, CharTraits>::make_flat(string_type &&str) {
+        flat_node *node = flat_allocator::allocate(1);
+        try {
+            flat_allocator::construct(node, tinySTL::move(str));
+        }
+        catch (...) {
+            flat_allocator::deallocate(node);
+            throw;
+        }
+        return node;
+    }
+
+    /*
+     * 创建内部节点
+     */
+    template<typename CharType, typename CharTraits>
+    typename rope<CharType, CharTraits>::node_ptr  // 返回值
+    rope<CharType, CharTraits>::make_concat(node_ptr left, node_ptr right) {
+        concat_node *node;
+        try {
+            node = concat_allocator::allocate(1);
+        }
+        catch (...) {
+            unref(left);
+            unref(right);
+            throw;
+        }
+        concat_allocator::construct(node, left, right);
+        return node;
+    }
+
+    /*
+     * 取叶子中的一段，较短的直接复制，较长的引用原来的 flat 节点
+     */
+    template<typename CharType, typename CharTraits>
+    typename rope<CharType, CharTraits>::node_ptr  // 返回值
+    rope<CharType, CharTraits>::make_substring(node_ptr leaf, size_type pos, size_type count) {
+        if (pos == 0 && count == leaf->size) {
+            return ref(leaf);
+        }
+        const CharType *data = leaf_data(leaf) + pos;
+        if (count <= substring_copy_limit) {
+            return make_flat(data, count);
+        }
+        node_ptr base = leaf->tag == rope_tag::flat ? leaf : static_cast<substring_node *>(leaf)->base;
+        substring_node *node = substring_allocator::allocate(1);
+        substring_allocator::construct(node, ref(base), data, count);
+        return node;
+    }
+
+    /*
+     * 拼接两个叶子
+     * left 是 flat 节点并且只被这里持有时，没有其他节点能看到它，可以直接在其后追加
+     */
+    template<typename CharType, typename CharTraits>
+    typename rope<CharType, CharTraits>::node_ptr  // 返回值
+    rope<CharType, CharTraits>::merge_leaves(node_ptr left, node_ptr right) {
+        if (left->tag == rope_tag::flat && left->refs.load(std::memory_order_acquire) == 1) {
+            flat_node *f = static_cast<flat_node *>(left);
+            try {
+                f->str.append(leaf_data(right), right->size);
+            }
+            catch (...) {
+                unref(left);
+                unref(right);
+                throw;
+            }
+            f->size = f->str.size();
+            unref(right);
+            return left;
+        }
+        string_type str;
+        try {
+            str.reserve(left->size + right->size);
+            str.append(leaf_data(left), left->size);
+            str.append(leaf_data(right), right->size);
+        }
+        catch (...) {
+            unref(left);
+            unref(right);
+            throw;
+        }
+        unref(left);
+        unref(right);
+        return make_flat(tinySTL::move(str));
+    }
+
+    /*
+     * 拼接两棵 AVL 树，复杂度为两棵树高度之差
+     * 较高的一棵沿着靠近另一棵的一侧下降，直到高度相差不超过 1，回溯时通过旋转恢复平衡
+     * 较短的叶子会一直下降到对侧最边上的叶子并与之合并
+     */
+    template<typename CharType, typename CharTraits>
+    typename rope<CharType, CharTraits>::node_ptr  // 返回值
+    rope<CharType, CharTraits>::join(node_ptr left, node_ptr right) {
+        if (left == nullptr) {
+            return right;
+        }
+        if (right == nullptr) {
+            return left;
+        }
+        const bool left_leaf = is_leaf(left), right_leaf = is_leaf(right);
+        if (left_leaf && right_leaf) {
+            if (left->size + right->size <= flat_limit) {
+                return merge_leaves(left, right);
+            }
+            return make_concat(left, right);
+        }
+        if (left->height > right->height + 1 ||
+            (left->height > right->height && right_leaf && right->size <= flat_limit)) {
+            /* 沿左树的右侧下降 */
+            node_ptr ll, lr;
+            take_children(left, ll, lr);
+            node_ptr t = join(lr, right);
+            if (t->height <= ll->height + 1) {
+                return make_concat(ll, t);
+            }
+            /* t 比 ll 高 2，需要旋转 */
+            node_ptr tl, tr;
+            take_children(t, tl, tr);
+            if (tr->height >= tl->height) {
+                return make_concat(make_concat(ll, tl), tr);
+            }
+            node_ptr x, y;
+            take_children(tl, x, y);
+            return make_concat(make_concat(ll, x), make_concat(y, tr));
+        }
+        if (right->height > left->height + 1 ||
+            (right->height > left->height && left_leaf && left->size <= flat_limit)) {
+            /* 沿右树的左侧下降 */
+            node_ptr rl, rr;
+            take_children(right, rl, rr);
+            node_ptr t = join(left, rl);
+            if (t->height <= rr->height + 1) {
+                return make_concat(t, rr);
+            }
+            node_ptr tl, tr;
+            take_children(t, tl, tr);
+            if (tl->height >= tr->height) {
+                return make_concat(tl, make_concat(tr, rr));
+            }
+            node_ptr x, y;
+            take_children(tr, x, y);
+            return make_concat(make_concat(tl, x), make_concat(y, rr));
+        }
+        return make_concat(left, right);
+    }
+
+    /*
+     * 把 node 从 pos 处分为两棵树
+     * 沿着到 pos 的路径下降，回溯时把路径两侧的子树依次拼接起来，总复杂度为 O(log n)
+     */
+    template<typename CharType, typename CharTraits>
+    void rope<CharType, CharTraits>::split(node_ptr node, size_type pos, node_ptr &left, node_ptr &right) {
+        if (node == nullptr || pos == 0) {
+            left = nullptr;
+            right = ref(node);
+            return;
+        }
+        if (pos >= node->size) {
+            left = ref(node);
+            right = nullptr;
+            return;
+        }
+        if (is_leaf(node)) {
+            left = make_substring(node, 0, pos);
+            try {
+                right = make_substring(node, pos, node->size - pos);
+            }
+            catch (...) {
+                unref(left);
+                throw;
+            }
+            return;
+        }
+        concat_node *c = static_cast<concat_node *>(node);
+        const size_type left_size = c->left->size;
+        if (pos < left_size) {
+            node_ptr r;
+            split(c->left, pos, left, r);
+            right = join(r, ref(c->right));
+        } else {
+            node_ptr l;
+            split(c->right, pos - left_size, l, right);
+            left = join(ref(c->left), l);
+        }
+    }
+
+    // =====================================================================================
+
+    /*
+     * 重载比较操作符
+     */
+    template<typename CharType, typename CharTraits>
+    bool operator==(const rope<CharType, CharTraits> &lhs, const rope<CharType, CharTraits> &rhs) {
+        return lhs.size() == rhs.size() && lhs.compare(rhs) == 0;
+    }
+
+    template<typename CharType, typename CharTraits>
+    bool operator!=(const rope<CharType, CharTraits> &lhs, const rope<CharType, CharTraits> &rhs) {
+        return !(lhs == rhs);
+    }
+
+    template<typename CharType, typename CharTraits>
+    bool operator<(const rope<CharType, CharTraits> &lhs, const rope<CharType, CharTraits> &rhs) {
+        return lhs.compare(rhs) < 0;
+    }
+
+    template<typename CharType, typename CharTraits>
+    bool operator>(const rope<CharType, CharTraits> &lhs, const rope<CharType, CharTraits> &rhs) {
+        return rhs < lhs;
+    }
+
+    template<typename CharType, typename CharTraits>
+    bool operator<=(const rope<CharType, CharTraits> &lhs, const rope<CharType, CharTraits> &rhs) {
+        return !(rhs < lhs);
+    }
+
+    template<typename CharType, typename CharTraits>
+    bool operator>=(const rope<CharType, CharTraits> &lhs, const rope<CharType, CharTraits> &rhs) {
+        return !(lhs < rhs);
+    }
+
+    /*
+     * 重载 + 操作符
+     */
+    template<typename CharType, typename CharTraits>
+    rope<CharType, CharTraits> operator+(const rope<CharType, CharTraits> &lhs, const rope<CharType, CharTraits> &rhs) {
+        rope<CharType, CharTraits> temp(lhs);
+        temp.append(rhs);
+        return temp;
+    }
+
+    template<typename CharType, typename CharTraits>
+    rope<CharType, CharTraits> operator+(rope<CharType, CharTraits> &&lhs, const rope<CharType, CharTraits> &rhs) {
+        lhs.append(rhs);
+        return tinySTL::move(lhs);
+    }
+
+    /*
+     * 重载 tinySTL 的 swap
+     */
+    template<typename CharType, typename CharTraits>
+    void swap(rope<CharType, CharTraits> &lhs, rope<CharType, CharTraits> &rhs) noexcept {
+        lhs.swap(rhs);
+    }
+
+    /*
+     * 为rope类定义一系列别名
+     */
+    using crope = tinySTL::rope<char>;
+    using wrope = tinySTL::rope<wchar_t>;
+
+}  // namespace tinySTL
+
+#endif //TINYSTL_ROPE_H
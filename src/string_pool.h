@@ -0,0 +1,425 @@
+//
+// Created by cqupt1811 on 2022/5/22.
+//
+
+/*
+ * 这个头文件包含一个模板类 basic_string_pool 与一个类 atom
+ * 用于字符串驻留(interning)
+ *
+ * 相同内容的字符串在池中只保存一份，驻留后得到一个 32 位的 atom，
+ * 两个 atom 的比较与求 hash 都是 O(1) 的整数操作
+ * 字符保存在按块分配的内存区(arena)中，地址在池的生命周期内保持不变
+ * 由 atom 取回字符串不需要加锁；查找与驻留使用读写锁，已存在的字符串只需要读锁
+ */
+
+#ifndef TINYSTL_STRING_POOL_H
+#define TINYSTL_STRING_POOL_H
+
+#include <atomic>  /* std::atomic 原子类型 */
+#include <cstdint>  /* 定长整数类型 uint32_t 等 */
+#include <mutex>  /* std::unique_lock */
+#include <shared_mutex>  /* std::shared_timed_mutex 读写锁，std::shared_lock */
+#include "astring.h"  /* 定义了 string, wstring, u16string, u32string 类型 */
+#include "unordered_map.h"  /* 这个头文件包含两个模板类 unordered_map 和 unordered_multimap */
+#include "vector.h"  /* 这个头文件包含一个模板类 vector */
+#include "exceptdef.h"  /* 此文件中定义了异常相关的宏 */
+
+/* 首先定义自己的命名空间 */
+namespace tinySTL {
+
+    /*
+     * 类 atom
+     * 驻留后的字符串句柄，只有来自同一个池的 atom 之间的比较才有意义
+     */
+    struct atom {
+        typedef uint32_t id_type;
+
+        /*
+         * 无效的 id，默认构造的 atom 以及查找失败时返回的 atom 使用该值
+         */
+        static constexpr id_type invalid_id = static_cast<id_type>(-1);
+
+        id_type id;
+
+        constexpr atom() noexcept: id(invalid_id) {
+        }
+
+        constexpr explicit atom(id_type i) noexcept: id(i) {
+        }
+
+        constexpr bool valid() const noexcept {
+            return id != invalid_id;
+        }
+    };
+
+    /*
+     * 重载比较操作符
+     */
+    inline constexpr bool operator==(atom lhs, atom rhs) noexcept {
+        return lhs.id == rhs.id;
+    }
+
+    inline constexpr bool operator!=(atom lhs, atom rhs) noexcept {
+        return lhs.id != rhs.id;
+    }
+
+    inline constexpr bool operator<(atom lhs, atom rhs) noexcept {
+        return lhs.id < rhs.id;
+    }
+
+    /*
+     * 为atom类定义hash函数 模板全特化
+     */
+    template<>
+    struct hash<atom> {
+        size_t operator()(atom a) const noexcept {
+            return static_cast<size_t>(a.id);
+        }
+    };
+
+    // ==============================================================================================
+
+    /*
+     * 模板类 basic_string_pool
+     * 参数 CharType 代表字符类型，参数 CharTraits 代表字符萃取器
+     */
+    template<typename CharType, typename CharTraits = tinySTL::char_traits<CharType>>
+    class basic_string_pool {
+    public:
+        /*
+         * 定义类中使用的类型别名
+         */
+        typedef CharTraits traits_type;
+        typedef CharType value_type;
+        typedef size_t size_type;
+        typedef basic_string<CharType, CharTraits> string_type;
+        typedef basic_string_view<CharType, CharTraits> view_type;
+        typedef atom::id_type id_type;
+
+    private:
+        /*
+         * 每个 id 对应的字符串，指向 arena 中的字符
+         */
+        struct entry {
+            const CharType *data;
+            size_type size;
+        };
+
+        typedef tinySTL::allocator<CharType> char_allocator;
+        typedef tinySTL::allocator<entry> entry_allocator;
+
+        /*
+         * 字符串 -> id 的映射，键指向 arena 中的字符
+         */
+        typedef tinySTL::unordered_map<view_type, id_type> map_type;
+
+        /*
+         * arena 中每一块的默认大小
+         */
+        static constexpr size_type block_size = 65536 / sizeof(CharType);
+
+        /*
+         * entry 按页保存，第 k 页容纳 (first_page_size << k) 个 entry，
+         * 页一旦分配就不再移动，所以按 id 读取时不需要加锁
+         */
+        static constexpr size_type first_page_bits = 10;
+        static constexpr size_type first_page_size = static_cast<size_type>(1) << first_page_bits;
+        static constexpr size_type page_count = 33 - first_page_bits;
+
+        map_type map_;
+        std::atomic<entry *> pages_[page_count];
+        std::atomic<size_type> size_;
+
+        tinySTL::vector<CharType *> blocks_;
+        CharType *cur_;
+        size_type left_;
+        size_type bytes_;
+
+        mutable std::shared_timed_mutex mutex_;
+
+    public:
+        /*
+         * 构造、析构函数，池中保存了指向自身 arena 的指针，不允许复制与移动
+         */
+        basic_string_pool() : map_(), size_(0), blocks_(), cur_(nullptr), left_(0), bytes_(0) {
+            for (size_type i = 0; i < page_count; ++i) {
+                pages_[i].store(nullptr, std::memory_order_relaxed);
+            }
+        }
+
+        basic_string_pool(const basic_string_pool &) = delete;
+
+        basic_string_pool &operator=(const basic_string_pool &) = delete;
+
+        ~basic_string_pool();
+
+    public:
+        /*
+         * 驻留相关操作
+         */
+
+        /*
+         * 驻留字符串 s，返回其 atom；相同内容多次驻留得到相同的 atom
+         */
+        atom intern(view_type s);
+
+        atom intern(const CharType *s) {
+            return intern(view_type(s));
+        }
+
+        atom intern(const string_type &s) {
+            return intern(view_type(s.begin(), s.size()));
+        }
+
+        /*
+         * 批量驻留 [first, last) 中的字符串，结果依次写入 out
+         * 已存在的字符串在一次读锁中全部查出，新字符串在一次写锁中全部插入
+         */
+        template<typename InputIter, typename OutputIter>
+        OutputIter intern_bulk(InputIter first, InputIter last, OutputIter out);
+
+        /*
+         * 查找字符串 s，不存在时返回无效的 atom，不会插入
+         */
+        atom find(view_type s) const {
+            std::shared_lock<std::shared_timed_mutex> lock(mutex_);
+            auto it = map_.find(s);
+            return it == map_.end() ? atom() : atom(it->second);
+        }
+
+        /*
+         * 由 atom 取回字符串，不加锁，a 必须来自本池
+         */
+        view_type view(atom a) const noexcept {
+            const entry &e = get_entry(a.id);
+            return view_type(e.data, e.size);
+        }
+
+        /*
+         * 由 atom 取回以空字符结尾的字符串，不加锁
+         */
+        const CharType *c_str(atom a) const noexcept {
+            return get_entry(a.id).data;
+        }
+
+        size_type length(atom a) const noexcept {
+            return get_entry(a.id).size;
+        }
+
+        /*
+         * 容量相关操作
+         */
+
+        /*
+         * 已驻留的字符串个数
+         */
+        size_type size() const noexcept {
+            return size_.load(std::memory_order_acquire);
+        }
+
+        bool empty() const noexcept {
+            return size() == 0;
+        }
+
+        /*
+         * arena 占用的字节数
+         */
+        size_type arena_bytes() const {
+            std::shared_lock<std::shared_timed_mutex> lock(mutex_);
+            return bytes_;
+        }
+
+        /*
+         * 预留可容纳 count 个字符串的空间
+         */
+        void reserve(size_type count) {
+            std::unique_lock<std::shared_timed_mutex> lock(mutex_);
+            map_.reserve(count);
+        }
+
+    private:
+        /*
+         * 私有的辅助函数
+         */
+
+        /* 计算 id 所在的页与页内偏移 */
+        static void locate(id_type id, size_type &page, size_type &offset) noexcept {
+            const uint64_t x = static_cast<uint64_t>(id) + first_page_size;
+            page = static_cast<size_type>(63 - __builtin_clzll(x)) - first_page_bits;
+            offset = static_cast<size_type>(x - (static_cast<uint64_t>(first_page_size) << page));
+        }
+
+        const entry &get_entry(id_type id) const noexcept {
+            TINYSTL_DEBUG(id < size());
+            size_type page, offset;
+            locate(id, page, offset);
+            return pages_[page].load(std::memory_order_acquire)[offset];
+        }
+
+        /* 在 arena 中保存一份以空字符结尾的 s，返回其地址 */
+        const CharType *store(view_type s);
+
+        /* 在持有写锁时插入一个新的字符串 */
+        atom insert_locked(view_type s);
+    };
+
+    template<typename CharType, typename CharTraits>
+    constexpr typename basic_string_pool<CharType, CharTraits>::size_type
+            basic_string_pool<CharType, CharTraits>::block_size;
+
+    template<typename CharType, typename CharTraits>
+    constexpr typename basic_string_pool<CharType, CharTraits>::size_type
+            basic_string_pool<CharType, CharTraits>::first_page_bits;
+
+    template<typename CharType, typename CharTraits>
+    constexpr typename basic_string_pool<CharType, CharTraits>::size_type
+            basic_string_pool<CharType, CharTraits>::first_page_size;
+
+    template<typename CharType, typename CharTraits>
+    constexpr typename basic_string_pool<CharType, CharTraits>::size_type
+            basic_string_pool<CharType, CharTraits>::page_count;
+
+    // =====================================================================================
+
+    /*
+     * 析构函数，释放所有的页与 arena
+     */
+    template<typename CharType, typename CharTraits>
+    basic_string_pool<CharType, CharTraits>::~basic_string_pool() {
+        for (size_type i = 0; i < page_count; ++i) {
+            entry_allocator::deallocate(pages_[i].load(std::memory_order_relaxed));
+        }
+        for (CharType *block : blocks_) {
+            char_allocator::deallocate(block);
+        }
+    }
+
+    /*
+     * 驻留字符串 s
+     * 先在读锁下查找，未找到时再加写锁，加锁后需要重新查找一次
+     */
+    template<typename CharType, typename CharTraits>
+    atom basic_string_pool<CharType, CharTraits>::intern(view_type s) {
+        {
+            std::shared_lock<std::shared_timed_mutex> lock(mutex_);
+            auto it = map_.find(s);
+            if (it != map_.end()) {
+                return atom(it->second);
+            }
+        }
+        std::unique_lock<std::shared_timed_mutex> lock(mutex_);
+        auto it = map_.find(s);
+        if (it != map_.end()) {
+            return atom(it->second);
+        }
+        return insert_locked(s);
+    }
+
+    /*
+     * 批量驻留
+     */
+    template<typename CharType, typename CharTraits>
+    template<typename InputIter, typename OutputIter>
+    OutputIter basic_string_pool<CharType, CharTraits>::intern_bulk(InputIter first, InputIter last, OutputIter out) {
+        tinySTL::vector<view_type> keys;
+        for (; first != last; ++first) {
+            keys.push_back(view_type(*first));
+        }
+        tinySTL::vector<atom> result(keys.size());
+        tinySTL::vector<size_type> missing;
+        {
+            std::shared_lock<std::shared_timed_mutex> lock(mutex_);
+            for (size_type i = 0; i < keys.size(); ++i) {
+                auto it = map_.find(keys[i]);
+                if (it != map_.end()) {
+                    result[i] = atom(it->second);
+                } else {
+                    missing.push_back(i);
+                }
+            }
+        }
+        if (!missing.empty()) {
+            std::unique_lock<std::shared_timed_mutex> lock(mutex_);
+            map_.reserve(map_.size() + missing.size());
+            for (size_type i : missing) {
+                auto it = map_.find(keys[i]);
+                result[i] = it != map_.end() ? atom(it->second) : insert_locked(keys[i]);
+            }
+        }
+        for (size_type i = 0; i < result.size(); ++i, ++out) {
+            *out = result[i];
+        }
+        return out;
+    }
+
+    /*
+     * 在 arena 中保存一份以空字符结尾的 s
+     * 当前块剩余空间不足时申请新块，过长的字符串单独占用一块
+     */
+    template<typename CharType, typename CharTraits>
+    const CharType *basic_string_pool<CharType, CharTraits>::store(view_type s) {
+        const size_type need = s.size() + 1;
+        if (need > left_) {
+            const size_type n = need > block_size / 4 ? need : block_size;
+            CharType *block = char_allocator::allocate(n);
+            try {
+                blocks_.push_back(block);
+            }
+            catch (...) {
+                char_allocator::deallocate(block);
+                throw;
+            }
+            bytes_ += n * sizeof(CharType);
+            if (n != block_size) {
+                /* 单独占用一块，不改变当前块 */
+                traits_type::copy(block, s.data(), s.size());
+                block[s.size()] = CharType();
+                return block;
+            }
+            cur_ = block;
+            left_ = n;
+        }
+        CharType *p = cur_;
+        if (!s.empty()) {
+            traits_type::copy(p, s.data(), s.size());
+        }
+        p[s.size()] = CharType();
+        cur_ += need;
+        left_ -= need;
+        return p;
+    }
+
+    /*
+     * 插入一个新的字符串
+     * 先写入 entry，再发布新的 size_，按 id 读取的线程总能看到完整的 entry
+     */
+    template<typename CharType, typename CharTraits>
+    atom basic_string_pool<CharType, CharTraits>::insert_locked(view_type s) {
+        const size_type n = size_.load(std::memory_order_relaxed);
+        THROW_LENGTH_ERROR_IF(n >= static_cast<size_type>(atom::invalid_id),
+                              "basic_string_pool<Char, Traits> too many strings");
+        const id_type id = static_cast<id_type>(n);
+        size_type page, offset;
+        locate(id, page, offset);
+        entry *entries = pages_[page].load(std::memory_order_relaxed);
+        if (entries == nullptr) {
+            entries = entry_allocator::allocate(first_page_size << page);
+            pages_[page].store(entries, std::memory_order_release);
+        }
+        const CharType *data = store(s);
+        map_.emplace(view_type(data, s.size()), id);
+        entries[offset].data = data;
+        entries[offset].size = s.size();
+        size_.store(n + 1, std::memory_order_release);
+        return atom(id);
+    }
+
+    /*
+     * 为basic_string_pool类定义一系列别名
+     */
+    using string_pool = tinySTL::basic_string_pool<char>;
+    using wstring_pool = tinySTL::basic_string_pool<wchar_t>;
+
+}  // namespace tinySTL
+
+#endif //TINYSTL_STRING_POOL_H
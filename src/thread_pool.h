@@ -0,0 +1,599 @@
+//
+// Created by cqupt1811 on 2022/5/26.
+//
+
+/*
+ * 这个头文件包含一个基于工作窃取(work stealing)的线程池 thread_pool，以及建立在它之上的
+ * 任务组 task_group 与两个并行原语 parallel_for、parallel_invoke
+ *
+ * 每个工作线程拥有一个 Chase-Lev 双端队列 work_stealing_deque：
+ * 本线程从底部压入、弹出任务(后进先出，缓存友好)，其他线程从顶部窃取(先进先出，窃取到的通常是较大的任务)
+ * 不属于线程池的线程提交的任务放入一个由互斥量保护的注入队列
+ * task_group::wait 在等待期间会执行队列中的任务，因此在任务内部再次 spawn/wait(分治递归)不会死锁
+ * 线程数默认为 std::thread::hardware_concurrency()，可以用环境变量 TINYSTL_NUM_THREADS 指定
+ */
+
+#ifndef TINYSTL_THREAD_POOL_H
+#define TINYSTL_THREAD_POOL_H
+
+#include <cstddef>  /* 定义了 size_t, ptrdiff_t 等常用类型 */
+#include <cstdlib>  /* getenv, strtoul */
+#include <atomic>  /* std::atomic 原子类型 */
+#include <condition_variable>  /* std::condition_variable */
+#include <exception>  /* std::exception_ptr */
+#include <mutex>  /* std::mutex, std::unique_lock */
+#include <thread>  /* std::thread */
+#include "utils.h"  /* 这个文件包含一些通用工具，包括 move, forward, swap 等函数，以及 pair 等 */
+#include "deque.h"  /* 这个头文件包含一个模板类 deque */
+#include "vector.h"  /* 这个头文件包含一个模板类 vector */
+
+/* 首先定义自己的命名空间 */
+namespace tinySTL {
+
+    // ===========================================================================================
+    /*
+     * 模板类 work_stealing_deque
+     * Chase-Lev 无锁双端队列，T 需要是可平凡复制的类型(通常为指针)，T() 表示队列为空
+     * push、pop 只能由拥有者线程调用，steal 可以由任意线程调用
+     * 环形数组写满时容量翻倍，旧数组可能仍在被窃取者读取，因此保留到队列析构时才释放
+     * 下标的读写全部使用 seq_cst 原子操作代替内存栅栏，语义相同，也便于 ThreadSanitizer 检查
+     */
+    template<typename T>
+    class work_stealing_deque {
+    private:
+        struct ring {
+            size_t mask;
+            std::atomic<T> *slots;
+
+            explicit ring(size_t capacity) : mask(capacity - 1), slots(new std::atomic<T>[capacity]) {
+            }
+
+            ~ring() {
+                delete[] slots;
+            }
+
+            T get(ptrdiff_t i) const noexcept {
+                return slots[static_cast<size_t>(i) & mask].load(std::memory_order_relaxed);
+            }
+
+            void put(ptrdiff_t i, T value) noexcept {
+                slots[static_cast<size_t>(i) & mask].store(value, std::memory_order_relaxed);
+            }
+        };
+
+        std::atomic<ptrdiff_t> top_;
+        std::atomic<ptrdiff_t> bottom_;
+        std::atomic<ring *> array_;
+        tinySTL::vector<ring *> rings_;  // 分配过的所有数组，析构时统一释放
+
+    public:
+        explicit work_stealing_deque(size_t capacity = 256);
+
+        work_stealing_deque(const work_stealing_deque &) = delete;
+
+        work_stealing_deque &operator=(const work_stealing_deque &) = delete;
+
+        ~work_stealing_deque() {
+            for (ring *r : rings_) {
+                delete r;
+            }
+        }
+
+        /*
+         * 队列中元素个数的近似值
+         */
+        size_t size() const noexcept {
+            const ptrdiff_t n = bottom_.load(std::memory_order_relaxed) - top_.load(std::memory_order_relaxed);
+            return n > 0 ? static_cast<size_t>(n) : 0;
+        }
+
+        bool empty() const noexcept {
+            return size() == 0;
+        }
+
+        void push(T value);
+
+        T pop() noexcept;
+
+        T steal() noexcept;
+    };
+
+    template<typename T>
+    work_stealing_deque<T>::work_stealing_deque(size_t capacity) : top_(0), bottom_(0), array_(nullptr), rings_() {
+        size_t n = 16;
+        while (n < capacity) {
+            n <<= 1;
+        }
+        rings_.push_back(new ring(n));
+        array_.store(rings_.back(), std::memory_order_relaxed);
+    }
+
+    /*
+     * 拥有者从底部压入元素
+     */
+    template<typename T>
+    void work_stealing_deque<T>::push(T value) {
+        const ptrdiff_t b = bottom_.load(std::memory_order_relaxed);
+        const ptrdiff_t t = top_.load(std::memory_order_acquire);
+        ring *a = array_.load(std::memory_order_relaxed);
+        if (static_cast<size_t>(b - t) > a->mask) {
+            ring *bigger = new ring((a->mask + 1) * 2);
+            for (ptrdiff_t i = t; i < b; ++i) {
+                bigger->put(i, a->get(i));
+            }
+            rings_.push_back(bigger);
+            array_.store(bigger, std::memory_order_release);
+            a = bigger;
+        }
+        a->put(b, value);
+        bottom_.store(b + 1, std::memory_order_release);
+    }
+
+    /*
+     * 拥有者从底部弹出元素，队列为空或最后一个元素被窃取时返回 T()
+     */
+    template<typename T>
+    T work_stealing_deque<T>::pop() noexcept {
+        const ptrdiff_t b = bottom_.load(std::memory_order_relaxed) - 1;
+        ring *a = array_.load(std::memory_order_relaxed);
+        bottom_.store(b, std::memory_order_seq_cst);
+        ptrdiff_t t = top_.load(std::memory_order_seq_cst);
+        if (t > b) {
+            bottom_.store(b + 1, std::memory_order_relaxed);
+            return T();
+        }
+        T value = a->get(b);
+        if (t == b) {
+            // 只剩最后一个元素，与窃取者竞争
+            if (!top_.compare_exchange_strong(t, t + 1, std::memory_order_seq_cst, std::memory_order_relaxed)) {
+                value = T();
+            }
+            bottom_.store(b + 1, std::memory_order_relaxed);
+        }
+        return value;
+    }
+
+    /*
+     * 从顶部窃取元素，队列为空或与其他线程竞争失败时返回 T()
+     */
+    template<typename T>
+    T work_stealing_deque<T>::steal() noexcept {
+        ptrdiff_t t = top_.load(std::memory_order_seq_cst);
+        const ptrdiff_t b = bottom_.load(std::memory_order_seq_cst);
+        if (t >= b) {
+            return T();
+        }
+        ring *a = array_.load(std::memory_order_acquire);
+        T value = a->get(t);
+        if (!top_.compare_exchange_strong(t, t + 1, std::memory_order_seq_cst, std::memory_order_relaxed)) {
+            return T();
+        }
+        return value;
+    }
+
+    class task_group;
+
+    namespace thread_pool_detail {
+
+        /*
+         * 任务的基类，执行完成后由执行者释放
+         */
+        struct task_base {
+            task_group *group;
+
+            explicit task_base(task_group *g) noexcept: group(g) {
+            }
+
+            virtual ~task_base() = default;
+
+            virtual void execute() = 0;
+        };
+
+        template<typename Function>
+        struct task_impl : public task_base {
+            Function func;
+
+            task_impl(task_group *g, Function &&f) : task_base(g), func(tinySTL::move(f)) {
+            }
+
+            task_impl(task_group *g, const Function &f) : task_base(g), func(f) {
+            }
+
+            void execute() override {
+                func();
+            }
+        };
+
+    }  // namespace thread_pool_detail
+
+    // ===========================================================================================
+    /*
+     * 类 thread_pool
+     * 工作窃取线程池，通过 task_group 提交任务
+     * 空闲的工作线程先自旋尝试窃取，若干轮后仍然没有任务就在条件变量上睡眠，提交任务时被唤醒
+     */
+    class thread_pool {
+        friend class task_group;
+
+    private:
+        typedef thread_pool_detail::task_base task_base;
+
+        /*
+         * 当前线程所属的线程池与编号，不属于任何线程池时 pool 为空
+         */
+        struct worker_context {
+            thread_pool *pool;
+            size_t index;
+        };
+
+        tinySTL::vector<work_stealing_deque<task_base *> *> queues_;
+        tinySTL::vector<std::thread> workers_;
+        tinySTL::deque<task_base *> injected_;  // 外部线程提交的任务
+        std::atomic<size_t> injected_size_;
+        std::mutex mutex_;  // 保护 injected_ 与睡眠
+        std::condition_variable cv_;
+        std::atomic<size_t> epoch_;  // 每提交一个任务加一，睡眠前后比较以免错过唤醒
+        std::atomic<size_t> sleepers_;
+        bool stop_;
+
+    public:
+        /*
+         * 创建 workers 个工作线程，调用 task_group::wait 的线程也参与执行，总并发度为 workers + 1
+         */
+        explicit thread_pool(size_t workers = default_workers());
+
+        thread_pool(const thread_pool &) = delete;
+
+        thread_pool &operator=(const thread_pool &) = delete;
+
+        ~thread_pool();
+
+        /*
+         * 工作线程数
+         */
+        size_t size() const noexcept {
+            return workers_.size();
+        }
+
+        /*
+         * 参与计算的线程数，包括等待任务的调用线程
+         */
+        size_t concurrency() const noexcept {
+            return workers_.size() + 1;
+        }
+
+        /*
+         * 默认的工作线程数：TINYSTL_NUM_THREADS 或 hardware_concurrency，减去调用线程
+         */
+        static size_t default_workers() {
+            const char *env = std::getenv("TINYSTL_NUM_THREADS");
+            size_t threads = env != nullptr ? static_cast<size_t>(std::strtoul(env, nullptr, 10)) : 0;
+            if (threads == 0) {
+                threads = std::thread::hardware_concurrency();
+            }
+            return threads > 1 ? threads - 1 : 0;
+        }
+
+    private:
+        static worker_context &current() noexcept {
+            static thread_local worker_context context{nullptr, 0};
+            return context;
+        }
+
+        void submit(task_base *task);
+
+        task_base *find_task();
+
+        static void execute(task_base *task);
+
+        void worker_loop(size_t index);
+    };
+
+    // ===========================================================================================
+    /*
+     * 类 task_group
+     * 一组任务，spawn 提交任务，wait 等待组内所有任务(包括任务中再 spawn 的任务)完成
+     * 任务抛出的异常会被保存，wait 时重新抛出第一个异常
+     * 析构时若仍有未完成的任务会先等待，但不会抛出异常
+     */
+    class task_group {
+        friend class thread_pool;
+
+    private:
+        thread_pool *pool_;
+        std::atomic<size_t> pending_;
+        std::mutex error_mutex_;
+        std::exception_ptr error_;
+
+    public:
+        explicit task_group(thread_pool &pool) : pool_(&pool), pending_(0), error_mutex_(), error_() {
+        }
+
+        task_group(const task_group &) = delete;
+
+        task_group &operator=(const task_group &) = delete;
+
+        ~task_group() {
+            wait_all();
+        }
+
+        thread_pool &pool() const noexcept {
+            return *pool_;
+        }
+
+        template<typename Function>
+        void spawn(Function &&func);
+
+        void wait();
+
+    private:
+        void wait_all() noexcept;
+
+        void set_error(std::exception_ptr error) noexcept {
+            std::lock_guard<std::mutex> lock(error_mutex_);
+            if (!error_) {
+                error_ = tinySTL::move(error);
+            }
+        }
+    };
+
+    // ===========================================================================================
+    // thread_pool 成员函数
+
+    inline thread_pool::thread_pool(size_t workers)
+            : queues_(), workers_(), injected_(), injected_size_(0), mutex_(), cv_(),
+              epoch_(0), sleepers_(0), stop_(false) {
+        queues_.reserve(workers);
+        for (size_t i = 0; i < workers; ++i) {
+            queues_.push_back(new work_stealing_deque<task_base *>());
+        }
+        workers_.reserve(workers);
+        for (size_t i = 0; i < workers; ++i) {
+            workers_.emplace_back([this, i] { worker_loop(i); });
+        }
+    }
+
+    inline thread_pool::~thread_pool() {
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            stop_ = true;
+        }
+        cv_.notify_all();
+        for (std::thread &t : workers_) {
+            t.join();
+        }
+        for (work_stealing_deque<task_base *> *q : queues_) {
+            delete q;
+        }
+    }
+
+    /*
+     * 工作线程把任务压入自己的队列，其他线程放入注入队列，有线程在睡眠时唤醒一个
+     */
+    inline void thread_pool::submit(task_base *task) {
+        worker_context &ctx = current();
+        if (ctx.pool == this) {
+            queues_[ctx.index]->push(task);
+        } else {
+            std::lock_guard<std::mutex> lock(mutex_);
+            injected_.push_back(task);
+            injected_size_.fetch_add(1);
+        }
+        epoch_.fetch_add(1);
+        if (sleepers_.load() != 0) {
+            {
+                std::lock_guard<std::mutex> lock(mutex_);
+            }
+            cv_.notify_one();
+        }
+    }
+
+    /*
+     * 依次尝试：自己的队列、注入队列、从其他工作线程的队列窃取
+     */
+    inline thread_pool::task_base *thread_pool::find_task() {
+        worker_context &ctx = current();
+        const bool own = ctx.pool == this;
+        task_base *task = nullptr;
+        if (own) {
+            task = queues_[ctx.index]->pop();
+            if (task != nullptr) {
+                return task;
+            }
+        }
+        if (injected_size_.load() != 0) {
+            std::lock_guard<std::mutex> lock(mutex_);
+            if (!injected_.empty()) {
+                task = injected_.front();
+                injected_.pop_front();
+                injected_size_.fetch_sub(1);
+                return task;
+            }
+        }
+        const size_t n = queues_.size();
+        const size_t start = own ? ctx.index + 1 : 0;
+        for (size_t i = 0; i < n; ++i) {
+            const size_t victim = (start + i) % n;
+            if (own && victim == ctx.index) {
+                continue;
+            }
+            task = queues_[victim]->steal();
+            if (task != nullptr) {
+                return task;
+            }
+        }
+        return nullptr;
+    }
+
+    /*
+     * 执行并释放任务，最后才减少任务组的计数：计数归零后任务组随时可能被析构
+     */
+    inline void thread_pool::execute(task_base *task) {
+        task_group *group = task->group;
+        try {
+            task->execute();
+        }
+        catch (...) {
+            group->set_error(std::current_exception());
+        }
+        delete task;
+        group->pending_.fetch_sub(1, std::memory_order_acq_rel);
+    }
+
+    inline void thread_pool::worker_loop(size_t index) {
+        current() = worker_context{this, index};
+        size_t idle = 0;
+        for (;;) {
+            const size_t epoch = epoch_.load();
+            task_base *task = find_task();
+            if (task != nullptr) {
+                execute(task);
+                idle = 0;
+                continue;
+            }
+            if (++idle < 64) {
+                std::this_thread::yield();
+                continue;
+            }
+            std::unique_lock<std::mutex> lock(mutex_);
+            if (stop_) {
+                return;
+            }
+            sleepers_.fetch_add(1);
+            cv_.wait(lock, [this, epoch] { return stop_ || epoch_.load() != epoch; });
+            sleepers_.fetch_sub(1);
+            idle = 0;
+        }
+    }
+
+    // ===========================================================================================
+    // task_group 成员函数
+
+    template<typename Function>
+    void task_group::spawn(Function &&func) {
+        typedef thread_pool_detail::task_impl<typename std::decay<Function>::type> task_type;
+        task_type *task = new task_type(this, tinySTL::forward<Function>(func));
+        pending_.fetch_add(1, std::memory_order_relaxed);
+        pool_->submit(task);
+    }
+
+    /*
+     * 等待期间执行线程池中的任务(不限于本组)，没有可执行的任务时让出处理器
+     */
+    inline void task_group::wait() {
+        wait_all();
+        std::exception_ptr error;
+        {
+            std::lock_guard<std::mutex> lock(error_mutex_);
+            error = tinySTL::move(error_);
+            error_ = nullptr;
+        }
+        if (error) {
+            std::rethrow_exception(error);
+        }
+    }
+
+    inline void task_group::wait_all() noexcept {
+        while (pending_.load(std::memory_order_acquire) != 0) {
+            thread_pool_detail::task_base *task = pool_->find_task();
+            if (task != nullptr) {
+                thread_pool::execute(task);
+            } else {
+                std::this_thread::yield();
+            }
+        }
+    }
+
+    // ===========================================================================================
+    /*
+     * 全局共享的线程池，第一次使用时创建
+     */
+    inline thread_pool &default_thread_pool() {
+        static thread_pool pool;
+        return pool;
+    }
+
+    namespace thread_pool_detail {
+
+        /*
+         * 不断把区间一分为二，右半部分作为新任务提交，左半部分继续切分，直到不超过 grain 个元素
+         * 被窃取的右半部分会在窃取者中继续切分，因此任务能迅速扩散到所有线程
+         */
+        template<typename Index, typename Function>
+        void parallel_for_split(task_group &group, Index first, Index last, size_t grain, const Function &func) {
+            while (static_cast<size_t>(last - first) > grain) {
+                const Index mid = first + (last - first) / 2;
+                group.spawn([&group, mid, last, grain, &func] {
+                    parallel_for_split(group, mid, last, grain, func);
+                });
+                last = mid;
+            }
+            func(first, last);
+        }
+
+        template<typename Function>
+        void spawn_invoke(task_group &group, Function &func) {
+            group.spawn([&func] { func(); });
+        }
+
+    }  // namespace thread_pool_detail
+
+    /*
+     * 把 [first, last) 切分为不超过 grain 个元素的小块，并行执行 func(begin, end)
+     * Index 可以是整数或随机访问迭代器
+     */
+    template<typename Index, typename Function>
+    void parallel_for(thread_pool &pool, Index first, Index last, size_t grain, const Function &func) {
+        if (!(first < last)) {
+            return;
+        }
+        if (grain == 0) {
+            grain = 1;
+        }
+        if (pool.concurrency() == 1 || static_cast<size_t>(last - first) <= grain) {
+            func(first, last);
+            return;
+        }
+        task_group group(pool);
+        thread_pool_detail::parallel_for_split(group, first, last, grain, func);
+        group.wait();
+    }
+
+    template<typename Index, typename Function>
+    void parallel_for(Index first, Index last, size_t grain, const Function &func) {
+        tinySTL::parallel_for(default_thread_pool(), first, last, grain, func);
+    }
+
+    /*
+     * 并行执行若干个函数对象，全部完成后返回；当前线程执行第一个，其余的提交给线程池
+     */
+    template<typename Function>
+    void parallel_invoke(thread_pool &, Function &&func) {
+        func();
+    }
+
+    template<typename Function, typename... Functions>
+    void parallel_invoke(thread_pool &pool, Function &&func, Functions &&... funcs) {
+        if (pool.concurrency() == 1) {
+            func();
+            int unused[] = {0, (funcs(), 0)...};
+            (void) unused;
+            return;
+        }
+        task_group group(pool);
+        int unused[] = {0, (thread_pool_detail::spawn_invoke(group, funcs), 0)...};
+        (void) unused;
+        func();
+        group.wait();
+    }
+
+    template<typename Function, typename... Functions>
+    typename std::enable_if<!std::is_same<typename std::decay<Function>::type, thread_pool>::value>::type  // 返回值
+    parallel_invoke(Function &&func, Functions &&... funcs) {
+        tinySTL::parallel_invoke(default_thread_pool(), tinySTL::forward<Function>(func),
+                                 tinySTL::forward<Functions>(funcs)...);
+    }
+
+}  // namespace tinySTL
+
+#endif //TINYSTL_THREAD_POOL_H
@@ -45,7 +45,7 @@ namespace tinySTL {
     // ==============================================================================================
     template<typename T>
     class vector {
-        static_assert(!std::is_same<bool, T>::value, "vector<bool> is abandoned in tinySTL");
+        static_assert(!std::is_same<bool, T>::value, "vector<bool> is abandoned in tinySTL, use dynamic_bitset instead");
     public:
         /*
          * vector类中的类型别名
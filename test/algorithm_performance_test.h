@@ -1,11 +1,19 @@
 ﻿#ifndef MYTINYSTL_ALGORITHM_PERFORMANCE_TEST_H_
 #define MYTINYSTL_ALGORITHM_PERFORMANCE_TEST_H_
 
-// 仅仅针对 sort, binary_search 做了性能测试
+// 仅仅针对 sort, binary_search 做了性能测试，sort 额外对比了几乎有序的输入、stable_sort、radix_sort 与 execution::par 的并行版本，
+// binary_search 额外对比了 eytzinger_index 与批量查找 lower_bound_many，
+// 另外对比了 double 数组上 min_element、minmax_element、count、accumulate、inclusive_scan 等线性扫描(SIMD 内核)的速度，
+// 以及长度相近(SIMD 内核)与相差悬殊(指数查找)的两个序列上 set_intersection 的速度，
+// nth_element、取前 1/10 的 partial_sort(随机与逆序输入)与流式 top_k 的速度
 
 #include <algorithm>
+#include <chrono>
+#include <numeric>
 
 #include "algorithm.h"
+#include "execution.h"
+#include "eytzinger.h"
 #include "test.h"
 
 namespace tinySTL {
@@ -32,6 +40,7 @@ namespace tinySTL {
     delete []arr;                                              \
 } while(0)
 
+// 在 count 个有序元素上做 count 次查找，结果写入 volatile 变量，避免查找被编译器优化掉
 #define FUN_TEST2(mode, fun, count) do {                      \
     std::string fun_name = #fun;                               \
     srand((int)time(0));                                       \
@@ -39,9 +48,12 @@ namespace tinySTL {
     clock_t start, end;                                        \
     int *arr = new int[count];                                 \
     for(size_t i = 0; i < count; ++i)  *(arr + i) = rand();    \
+    std::sort(arr, arr + count);                               \
+    volatile bool found;                                       \
     start = clock();                                           \
     for(size_t i = 0; i < count; ++i)                          \
-        mode::fun(arr, arr + count, rand());                   \
+        found = mode::fun(arr, arr + count, rand());           \
+    (void) found;                                              \
     end = clock();                                             \
     int n = static_cast<int>(static_cast<double>(end - start)  \
         / CLOCKS_PER_SEC * 1000);                              \
@@ -52,6 +64,174 @@ namespace tinySTL {
     delete []arr;                                              \
 } while(0)
 
+// 在 count 个有序元素上做 count 次查找，建立 eytzinger_index 的时间不计入
+#define FUN_TEST_EYTZINGER(count) do {                        \
+    srand((int)time(0));                                       \
+    char buf[10];                                              \
+    clock_t start, end;                                        \
+    tinySTL::vector<int> arr(count);                           \
+    for(size_t i = 0; i < count; ++i)  arr[i] = rand();        \
+    tinySTL::sort(arr.begin(), arr.end());                     \
+    tinySTL::eytzinger_index<int> index(arr);                  \
+    volatile bool found;                                       \
+    start = clock();                                           \
+    for(size_t i = 0; i < count; ++i)                          \
+        found = index.contains(rand());                        \
+    (void) found;                                              \
+    end = clock();                                             \
+    int n = static_cast<int>(static_cast<double>(end - start)  \
+        / CLOCKS_PER_SEC * 1000);                              \
+    std::snprintf(buf, sizeof(buf), "%d", n);                  \
+    std::string t = buf;                                       \
+    t += "ms   |";                                             \
+    std::cout << std::setw(WIDE) << t;                         \
+} while(0)
+
+// 在 count 个有序元素上用 lower_bound_many 一次完成 count 次查找，生成查询的时间不计入
+#define FUN_TEST_MANY(count) do {                             \
+    srand((int)time(0));                                       \
+    char buf[10];                                              \
+    clock_t start, end;                                        \
+    tinySTL::vector<int> arr(count), query(count);             \
+    tinySTL::vector<int *> pos(count);                         \
+    for(size_t i = 0; i < count; ++i)  arr[i] = rand();        \
+    for(size_t i = 0; i < count; ++i)  query[i] = rand();      \
+    tinySTL::sort(arr.begin(), arr.end());                     \
+    start = clock();                                           \
+    tinySTL::lower_bound_many(arr.begin(), arr.end(),          \
+        query.begin(), query.end(), pos.begin());              \
+    end = clock();                                             \
+    int n = static_cast<int>(static_cast<double>(end - start)  \
+        / CLOCKS_PER_SEC * 1000);                              \
+    std::snprintf(buf, sizeof(buf), "%d", n);                  \
+    std::string t = buf;                                       \
+    t += "ms   |";                                             \
+    std::cout << std::setw(WIDE) << t;                         \
+} while(0)
+
+// 几乎有序的输入：每 100 个元素中约有 1 个随机值
+#define FUN_TEST3(mode, fun, count) do {                      \
+    srand((int)time(0));                                       \
+    char buf[10];                                              \
+    clock_t start, end;                                        \
+    int *arr = new int[count];                                 \
+    for(size_t i = 0; i < count; ++i)                          \
+        *(arr + i) = rand() % 100 == 0 ? rand() : (int)i;      \
+    start = clock();                                           \
+    mode::fun(arr, arr + count);                               \
+    end = clock();                                             \
+    int n = static_cast<int>(static_cast<double>(end - start)  \
+        / CLOCKS_PER_SEC * 1000);                              \
+    std::snprintf(buf, sizeof(buf), "%d", n);                  \
+    std::string t = buf;                                       \
+    t += "ms   |";                                             \
+    std::cout << std::setw(WIDE) << t;                         \
+    delete []arr;                                              \
+} while(0)
+
+// 并行版本的 clock() 会累加所有线程的 CPU 时间，因此改用墙上时间计时
+#define FUN_TEST_PAR(mode, fun, len) do {                     \
+    srand((int)time(0));                                       \
+    char buf[10];                                              \
+    int *arr = new int[len];                                   \
+    for(size_t i = 0; i < len; ++i)  *(arr + i) = rand();      \
+    auto start = std::chrono::steady_clock::now();             \
+    mode::fun(mode::execution::par, arr, arr + len);           \
+    auto end = std::chrono::steady_clock::now();               \
+    int n = static_cast<int>(std::chrono::duration_cast<       \
+        std::chrono::milliseconds>(end - start).count());      \
+    std::snprintf(buf, sizeof(buf), "%d", n);                  \
+    std::string t = buf;                                       \
+    t += "ms   |";                                             \
+    std::cout << std::setw(WIDE) << t;                         \
+    delete []arr;                                              \
+} while(0)
+
+// 在 count 个随机 double 上重复执行 10 次扫描 expr，结果写入 volatile 变量
+#define FUN_TEST_SCAN(expr, count) do {                       \
+    srand((int)time(0));                                       \
+    char buf[10];                                              \
+    clock_t start, end;                                        \
+    double *arr = new double[count];                           \
+    for(size_t i = 0; i < count; ++i)                          \
+        *(arr + i) = static_cast<double>(rand() % 1000000);    \
+    volatile double sink;                                      \
+    start = clock();                                           \
+    for(int r = 0; r < 10; ++r)                                \
+        sink = static_cast<double>(expr);                      \
+    (void) sink;                                               \
+    end = clock();                                             \
+    int n = static_cast<int>(static_cast<double>(end - start)  \
+        / CLOCKS_PER_SEC * 1000);                              \
+    std::snprintf(buf, sizeof(buf), "%d", n);                  \
+    std::string t = buf;                                       \
+    t += "ms   |";                                             \
+    std::cout << std::setw(WIDE) << t;                         \
+    delete []arr;                                              \
+} while(0)
+
+#define FUN_TEST_SCAN_ROW(expr) do {                          \
+    { const size_t len = LEN1; FUN_TEST_SCAN(expr, len); }     \
+    { const size_t len = LEN2; FUN_TEST_SCAN(expr, len); }     \
+    { const size_t len = LEN3; FUN_TEST_SCAN(expr, len); }     \
+} while(0)
+
+// 在长度为 count 与 count / ratio 的两个严格递增的 unsigned 序列上重复执行 10 次 set_intersection
+#define FUN_TEST_SET(mode, count, ratio) do {                 \
+    srand((int)time(0));                                       \
+    char buf[10];                                              \
+    clock_t start, end;                                        \
+    const size_t m = count / ratio;                            \
+    unsigned *a = new unsigned[count];                         \
+    unsigned *b = new unsigned[m];                             \
+    unsigned *out = new unsigned[m];                           \
+    unsigned x = 0, y = 0;                                     \
+    for(size_t i = 0; i < count; ++i)                          \
+        *(a + i) = x += static_cast<unsigned>(rand() % 4 + 1); \
+    for(size_t i = 0; i < m; ++i)                              \
+        *(b + i) = y += static_cast<unsigned>(                 \
+            (rand() % 4 + 1) * ratio);                         \
+    start = clock();                                           \
+    for(int r = 0; r < 10; ++r)                                \
+        mode::set_intersection(a, a + count, b, b + m, out);   \
+    end = clock();                                             \
+    int n = static_cast<int>(static_cast<double>(end - start)  \
+        / CLOCKS_PER_SEC * 1000);                              \
+    std::snprintf(buf, sizeof(buf), "%d", n);                  \
+    std::string t = buf;                                       \
+    t += "ms   |";                                             \
+    std::cout << std::setw(WIDE) << t;                         \
+    delete []a;                                                \
+    delete []b;                                                \
+    delete []out;                                              \
+} while(0)
+
+// 在 count 个 int 上执行一次 expr，pattern 为 0 时是随机数，否则为逆序
+#define FUN_TEST_SELECT(expr, count, pattern) do {            \
+    srand((int)time(0));                                       \
+    char buf[10];                                              \
+    clock_t start, end;                                        \
+    int *arr = new int[count];                                 \
+    for(size_t i = 0; i < count; ++i)                          \
+        *(arr + i) = pattern ? static_cast<int>(count - i) : rand(); \
+    start = clock();                                           \
+    expr;                                                      \
+    end = clock();                                             \
+    int n = static_cast<int>(static_cast<double>(end - start)  \
+        / CLOCKS_PER_SEC * 1000);                              \
+    std::snprintf(buf, sizeof(buf), "%d", n);                  \
+    std::string t = buf;                                       \
+    t += "ms   |";                                             \
+    std::cout << std::setw(WIDE) << t;                         \
+    delete []arr;                                              \
+} while(0)
+
+#define FUN_TEST_SELECT_ROW(expr, pattern) do {               \
+    { const size_t len = LEN1; FUN_TEST_SELECT(expr, len, pattern); } \
+    { const size_t len = LEN2; FUN_TEST_SELECT(expr, len, pattern); } \
+    { const size_t len = LEN3; FUN_TEST_SELECT(expr, len, pattern); } \
+} while(0)
+
             void binary_search_test() {
                 std::cout << "[------------------- function : binary_search ------------------]" << std::endl;
                 std::cout << "| orders of magnitude |";
@@ -64,6 +244,14 @@ namespace tinySTL {
                 FUN_TEST2(tinySTL, binary_search, LEN1);
                 FUN_TEST2(tinySTL, binary_search, LEN2);
                 FUN_TEST2(tinySTL, binary_search, LEN3);
+                std::cout << std::endl << "|  tinySTL eytzinger  |";
+                FUN_TEST_EYTZINGER(LEN1);
+                FUN_TEST_EYTZINGER(LEN2);
+                FUN_TEST_EYTZINGER(LEN3);
+                std::cout << std::endl << "|   tinySTL batched   |";
+                FUN_TEST_MANY(LEN1);
+                FUN_TEST_MANY(LEN2);
+                FUN_TEST_MANY(LEN3);
                 std::cout << std::endl;
             }
 
@@ -79,6 +267,110 @@ namespace tinySTL {
                 FUN_TEST1(tinySTL, sort, LEN1);
                 FUN_TEST1(tinySTL, sort, LEN2);
                 FUN_TEST1(tinySTL, sort, LEN3);
+                std::cout << std::endl << "|    tinySTL radix    |";
+                FUN_TEST1(tinySTL, radix_sort, LEN1);
+                FUN_TEST1(tinySTL, radix_sort, LEN2);
+                FUN_TEST1(tinySTL, radix_sort, LEN3);
+                std::cout << std::endl << "|     tinySTL par     |";
+                FUN_TEST_PAR(tinySTL, sort, LEN1);
+                FUN_TEST_PAR(tinySTL, sort, LEN2);
+                FUN_TEST_PAR(tinySTL, sort, LEN3);
+                std::cout << std::endl;
+            }
+
+            void nearly_sorted_sort_test() {
+                std::cout << "[---------------- function : sort (nearly sorted) ---------------]" << std::endl;
+                std::cout << "| orders of magnitude |";
+                TEST_LEN(LEN1, LEN2, LEN3, WIDE);
+                std::cout << "|         std         |";
+                FUN_TEST3(std, sort, LEN1);
+                FUN_TEST3(std, sort, LEN2);
+                FUN_TEST3(std, sort, LEN3);
+                std::cout << std::endl << "|        tinySTL        |";
+                FUN_TEST3(tinySTL, sort, LEN1);
+                FUN_TEST3(tinySTL, sort, LEN2);
+                FUN_TEST3(tinySTL, sort, LEN3);
+                std::cout << std::endl << "|     std stable      |";
+                FUN_TEST3(std, stable_sort, LEN1);
+                FUN_TEST3(std, stable_sort, LEN2);
+                FUN_TEST3(std, stable_sort, LEN3);
+                std::cout << std::endl << "|   tinySTL stable    |";
+                FUN_TEST3(tinySTL, stable_sort, LEN1);
+                FUN_TEST3(tinySTL, stable_sort, LEN2);
+                FUN_TEST3(tinySTL, stable_sort, LEN3);
+                std::cout << std::endl;
+            }
+
+            void scan_test() {
+                std::cout << "[------------- function : scan (double, 10 passes) -------------]" << std::endl;
+                std::cout << "| orders of magnitude |";
+                TEST_LEN(LEN1, LEN2, LEN3, WIDE);
+                std::cout << "|   std min_element   |";
+                FUN_TEST_SCAN_ROW(std::min_element(arr, arr + len) - arr);
+                std::cout << std::endl << "| tinySTL min_element |";
+                FUN_TEST_SCAN_ROW(tinySTL::min_element(arr, arr + len) - arr);
+                std::cout << std::endl << "|     std minmax      |";
+                FUN_TEST_SCAN_ROW(std::minmax_element(arr, arr + len).second - arr);
+                std::cout << std::endl << "|   tinySTL minmax    |";
+                FUN_TEST_SCAN_ROW(tinySTL::minmax_element(arr, arr + len).second - arr);
+                std::cout << std::endl << "|      std count      |";
+                FUN_TEST_SCAN_ROW(std::count(arr, arr + len, 5.0));
+                std::cout << std::endl << "|    tinySTL count    |";
+                FUN_TEST_SCAN_ROW(tinySTL::count(arr, arr + len, 5.0));
+                std::cout << std::endl << "|   std accumulate    |";
+                FUN_TEST_SCAN_ROW(std::accumulate(arr, arr + len, 0.0));
+                std::cout << std::endl << "| tinySTL reduce unseq|";
+                FUN_TEST_SCAN_ROW(tinySTL::reduce(tinySTL::execution::unseq, arr, arr + len, 0.0));
+                std::cout << std::endl << "|   std partial_sum   |";
+                FUN_TEST_SCAN_ROW(*(std::partial_sum(arr, arr + len, arr) - 1));
+                std::cout << std::endl << "|  tinySTL scan unseq |";
+                FUN_TEST_SCAN_ROW(*(tinySTL::inclusive_scan(tinySTL::execution::unseq, arr, arr + len, arr) - 1));
+                std::cout << std::endl;
+            }
+
+            void set_intersection_test() {
+                std::cout << "[------------ function : set_intersection (10 passes) -----------]" << std::endl;
+                std::cout << "| orders of magnitude |";
+                TEST_LEN(LEN1, LEN2, LEN3, WIDE);
+                std::cout << "|   std   n : n       |";
+                FUN_TEST_SET(std, LEN1, 1);
+                FUN_TEST_SET(std, LEN2, 1);
+                FUN_TEST_SET(std, LEN3, 1);
+                std::cout << std::endl << "| tinySTL n : n (simd)|";
+                FUN_TEST_SET(tinySTL, LEN1, 1);
+                FUN_TEST_SET(tinySTL, LEN2, 1);
+                FUN_TEST_SET(tinySTL, LEN3, 1);
+                std::cout << std::endl << "|   std   n : n/1000  |";
+                FUN_TEST_SET(std, LEN1, 1000);
+                FUN_TEST_SET(std, LEN2, 1000);
+                FUN_TEST_SET(std, LEN3, 1000);
+                std::cout << std::endl << "| tinySTL n : n/1000  |";
+                FUN_TEST_SET(tinySTL, LEN1, 1000);
+                FUN_TEST_SET(tinySTL, LEN2, 1000);
+                FUN_TEST_SET(tinySTL, LEN3, 1000);
+                std::cout << std::endl;
+            }
+
+            void select_test() {
+                std::cout << "[------------- function : nth_element, partial_sort -------------]" << std::endl;
+                std::cout << "| orders of magnitude |";
+                TEST_LEN(LEN1, LEN2, LEN3, WIDE);
+                std::cout << "|   std nth_element   |";
+                FUN_TEST_SELECT_ROW(std::nth_element(arr, arr + len / 2, arr + len), 0);
+                std::cout << std::endl << "| tinySTL nth_element |";
+                FUN_TEST_SELECT_ROW(tinySTL::nth_element(arr, arr + len / 2, arr + len), 0);
+                std::cout << std::endl << "|  std partial_sort   |";
+                FUN_TEST_SELECT_ROW(std::partial_sort(arr, arr + len / 10, arr + len), 0);
+                std::cout << std::endl << "|tinySTL partial_sort |";
+                FUN_TEST_SELECT_ROW(tinySTL::partial_sort(arr, arr + len / 10, arr + len), 0);
+                std::cout << std::endl << "| std partial (desc)  |";
+                FUN_TEST_SELECT_ROW(std::partial_sort(arr, arr + len / 10, arr + len), 1);
+                std::cout << std::endl << "|tinySTL partial(desc)|";
+                FUN_TEST_SELECT_ROW(tinySTL::partial_sort(arr, arr + len / 10, arr + len), 1);
+                std::cout << std::endl << "| std top 1000 (heap) |";
+                FUN_TEST_SELECT_ROW(std::partial_sort(arr, arr + 1000, arr + len, std::greater<int>()), 0);
+                std::cout << std::endl << "| tinySTL top_k 1000  |";
+                FUN_TEST_SELECT_ROW({ tinySTL::top_k<int> top(1000); top.push(arr, arr + len); top.sorted(); }, 0);
                 std::cout << std::endl;
             }
 
@@ -88,7 +380,11 @@ namespace tinySTL {
                 std::cout << "[===============================================================]" << std::endl;
                 std::cout << "[--------------- Run algorithm performance test ----------------]" << std::endl;
                 sort_test();
+                nearly_sorted_sort_test();
                 binary_search_test();
+                scan_test();
+                set_intersection_test();
+                select_test();
                 std::cout << "[--------------- End algorithm performance test ----------------]" << std::endl;
                 std::cout << "[===============================================================]" << std::endl;
 #endif // PERFORMANCE_TEST_ON
@@ -1,13 +1,21 @@
 ﻿#ifndef MYTINYSTL_ALGORITHM_TEST_H_
 #define MYTINYSTL_ALGORITHM_TEST_H_
 
-// 算法测试: 包含了 tinySTL 的 81 个算法测试
+// 算法测试: 包含了 tinySTL 的 81 个算法测试，以及带执行策略的并行算法测试
 
 #include <algorithm>
+#include <cmath>
 #include <functional>
+#include <limits>
 #include <numeric>
+#include <string>
+#include <vector>
 
 #include "algorithm.h"
+#include "astring.h"
+#include "eytzinger.h"
+#include "execution.h"
+#include "list.h"
 #include "vector.h"
 #include "test.h"
 
@@ -363,6 +371,58 @@ namespace tinySTL {
                 EXPECT_CON_EQ(exp, act);
             }
 
+            // 长度为 n、m 的两个有序序列上的四种集合运算与 set_intersection_size，与 std 的结果比较
+            template<class T>
+            bool set_ops_check(size_t n, size_t m, int range, bool unique) {
+                std::vector<T> a(n), b(m);
+                for (auto &x: a) x = static_cast<T>(rand() % range);
+                for (auto &x: b) x = static_cast<T>(rand() % range);
+                std::sort(a.begin(), a.end());
+                std::sort(b.begin(), b.end());
+                if (unique) {
+                    a.erase(std::unique(a.begin(), a.end()), a.end());
+                    b.erase(std::unique(b.begin(), b.end()), b.end());
+                }
+                std::vector<T> exp(a.size() + b.size()), act(a.size() + b.size());
+                bool ok = true;
+                auto e = std::set_intersection(a.begin(), a.end(), b.begin(), b.end(), exp.begin());
+                auto r = tinySTL::set_intersection(a.data(), a.data() + a.size(), b.data(), b.data() + b.size(),
+                                                   act.data());
+                ok = ok && std::equal(exp.begin(), e, act.data(), r) && r - act.data() == e - exp.begin();
+                ok = ok && tinySTL::set_intersection_size(a.data(), a.data() + a.size(), b.data(),
+                                                          b.data() + b.size()) == static_cast<size_t>(e - exp.begin());
+                e = std::set_union(a.begin(), a.end(), b.begin(), b.end(), exp.begin());
+                r = tinySTL::set_union(a.data(), a.data() + a.size(), b.data(), b.data() + b.size(), act.data());
+                ok = ok && std::equal(exp.begin(), e, act.data(), r) && r - act.data() == e - exp.begin();
+                e = std::set_difference(b.begin(), b.end(), a.begin(), a.end(), exp.begin());
+                r = tinySTL::set_difference(b.data(), b.data() + b.size(), a.data(), a.data() + a.size(), act.data());
+                ok = ok && std::equal(exp.begin(), e, act.data(), r) && r - act.data() == e - exp.begin();
+                e = std::set_symmetric_difference(a.begin(), a.end(), b.begin(), b.end(), exp.begin());
+                r = tinySTL::set_symmetric_difference(a.data(), a.data() + a.size(), b.data(), b.data() + b.size(),
+                                                      act.data());
+                ok = ok && std::equal(exp.begin(), e, act.data(), r) && r - act.data() == e - exp.begin();
+                return ok;
+            }
+
+            // 长度相差 16 倍以上时使用指数查找，4 字节与 8 字节整数长度相近的交集使用 SIMD 内核
+            TEST(set_gallop_simd_test) {
+                EXPECT_TRUE(set_ops_check<unsigned>(1000, 1000, 3000, true));
+                EXPECT_TRUE(set_ops_check<unsigned>(1000, 1000, 3000, false));
+                EXPECT_TRUE(set_ops_check<unsigned long long>(777, 1200, 2000, true));
+                EXPECT_TRUE(set_ops_check<long long>(500, 600, 100, false));
+                EXPECT_TRUE(set_ops_check<int>(100000, 50, 1000000, true));
+                EXPECT_TRUE(set_ops_check<int>(30, 100000, 1000, false));
+                EXPECT_TRUE(set_ops_check<double>(20000, 100, 5000, false));
+                EXPECT_TRUE(set_ops_check<short>(0, 100, 1000, false));
+                tinySTL::list<int> l1{1, 3, 5, 7, 9};
+                tinySTL::vector<int> v1{9, 7, 6, 5, 3, 1};
+                int act[5] = {0};
+                int exp[5] = {9, 7, 5, 3, 1};
+                EXPECT_EQ(5, tinySTL::set_intersection_size(l1.begin(), l1.end(), v1.rbegin(), v1.rend()));
+                tinySTL::set_intersection(v1.begin(), v1.end(), exp, exp + 5, act, std::greater<int>());
+                EXPECT_CON_EQ(exp, act);
+            }
+
 // numeric test
             TEST(accumulate_test) {
                 int arr1[] = {1, 2, 3, 4, 5};
@@ -422,6 +482,41 @@ namespace tinySTL {
                 EXPECT_CON_EQ(exp2, act2);
             }
 
+            TEST(scan_reduce_test) {
+                int arr1[] = {1, 2, 3, 4, 5, 6, 7, 8, 9};
+                int exp1[9], act1[9];
+                std::partial_sum(arr1, arr1 + 9, exp1);
+                tinySTL::inclusive_scan(arr1, arr1 + 9, act1);
+                EXPECT_CON_EQ(exp1, act1);
+                std::partial_sum(arr1, arr1 + 9, exp1, std::multiplies<int>());
+                tinySTL::inclusive_scan(arr1, arr1 + 9, act1, std::multiplies<int>());
+                EXPECT_CON_EQ(exp1, act1);
+                tinySTL::exclusive_scan(arr1, arr1 + 9, act1, 10);
+                EXPECT_EQ(10, act1[0]);
+                EXPECT_EQ(46, act1[8]);
+                EXPECT_EQ(45, tinySTL::reduce(arr1, arr1 + 9));
+                EXPECT_EQ(50, tinySTL::reduce(arr1, arr1 + 9, 5));
+                EXPECT_EQ(285, tinySTL::transform_reduce(arr1, arr1 + 9, arr1, 0));
+                EXPECT_EQ(90, tinySTL::transform_reduce(arr1, arr1 + 9, 0, std::plus<int>(),
+                                                        [](int x) { return 2 * x; }));
+                // 连续的整数区间使用 SIMD 内核，长度覆盖向量宽度的各种余数；result 可以等于 first
+                for (size_t n: {0, 1, 7, 16, 33, 100, 1000}) {
+                    std::vector<int> v(n), exp(n), act(n);
+                    for (auto &x: v) x = rand() % 2001 - 1000;
+                    std::partial_sum(v.begin(), v.end(), exp.begin());
+                    tinySTL::inclusive_scan(v.data(), v.data() + n, act.data());
+                    EXPECT_TRUE(exp == act);
+                    for (size_t i = 0; i < n; ++i) exp[i] -= v[i] - 3;
+                    tinySTL::exclusive_scan(v.data(), v.data() + n, v.data(), 3);
+                    EXPECT_TRUE(exp == v);
+                }
+                std::vector<unsigned long long> v2(1000), exp2(1000), act2(1000);
+                for (auto &x: v2) x = static_cast<unsigned long long>(rand()) << 40;
+                std::partial_sum(v2.begin(), v2.end(), exp2.begin());
+                tinySTL::inclusive_scan(v2.data(), v2.data() + v2.size(), act2.data());
+                EXPECT_TRUE(exp2 == act2);
+            }
+
 // algo test
             TEST(adjacent_find_test) {
                 int arr1[] = {1, 2, 3, 3, 4};
@@ -627,6 +722,164 @@ namespace tinySTL {
                           tinySTL::lower_bound(arr1, arr1 + 7, 5, std::less<int>()));
             }
 
+            TEST(branchless_bound_test) {
+                // 各种长度(含奇偶、2 的幂附近)与重复元素下，逐个比较每个查询的结果下标
+                std::vector<int> exp, act;
+                for (int n = 0; n <= 70; ++n) {
+                    std::vector<int> v(static_cast<size_t>(n));
+                    for (int i = 0; i < n; ++i) v[i] = i / 2 * 2;
+                    const int *b = v.data(), *e = v.data() + n;
+                    for (int x = -1; x <= n + 1; ++x) {
+                        exp.push_back(static_cast<int>(std::lower_bound(b, e, x) - b));
+                        act.push_back(static_cast<int>(tinySTL::lower_bound(b, e, x) - b));
+                        exp.push_back(static_cast<int>(std::upper_bound(b, e, x) - b));
+                        act.push_back(static_cast<int>(tinySTL::upper_bound(b, e, x) - b));
+                        exp.push_back(static_cast<int>(std::upper_bound(b, e, x, std::less<int>()) - b));
+                        act.push_back(static_cast<int>(tinySTL::upper_bound(b, e, x, std::less<int>()) - b));
+                        exp.push_back(std::binary_search(b, e, x));
+                        act.push_back(tinySTL::binary_search(b, e, x));
+                    }
+                }
+                EXPECT_CON_EQ(exp, act);
+            }
+
+            TEST(lower_bound_many_test) {
+                std::vector<int> v(1000);
+                for (auto &x: v) x = rand() % 5000;
+                std::sort(v.begin(), v.end());
+                std::vector<int> queries(3001);
+                for (auto &q: queries) q = rand() % 5200 - 100;
+                std::vector<int> exp, act;
+                std::vector<const int *> pos(queries.size());
+                tinySTL::lower_bound_many(v.data(), v.data() + v.size(), queries.data(),
+                                          queries.data() + queries.size(), pos.data());
+                for (size_t i = 0; i < queries.size(); ++i) {
+                    exp.push_back(static_cast<int>(std::lower_bound(v.begin(), v.end(), queries[i]) - v.begin()));
+                    act.push_back(static_cast<int>(pos[i] - v.data()));
+                }
+                EXPECT_CON_EQ(exp, act);
+                std::reverse(v.begin(), v.end());
+                tinySTL::lower_bound_many(v.data(), v.data() + v.size(), queries.data(),
+                                          queries.data() + queries.size(), pos.data(), std::greater<int>());
+                exp.clear();
+                act.clear();
+                for (size_t i = 0; i < queries.size(); ++i) {
+                    exp.push_back(static_cast<int>(std::lower_bound(v.begin(), v.end(), queries[i],
+                                                                    std::greater<int>()) - v.begin()));
+                    act.push_back(static_cast<int>(pos[i] - v.data()));
+                }
+                EXPECT_CON_EQ(exp, act);
+            }
+
+            TEST(eytzinger_index_test) {
+                std::vector<int> exp, act;
+                for (int n = 0; n <= 70; ++n) {
+                    tinySTL::vector<int> v;
+                    for (int i = 0; i < n; ++i) v.push_back(i / 2 * 2);
+                    tinySTL::eytzinger_index<int> index(v);
+                    std::vector<int> queries;
+                    for (int x = -1; x <= n + 1; ++x) queries.push_back(x);
+                    std::vector<size_t> many(queries.size());
+                    index.lower_bound_many(queries.begin(), queries.end(), many.begin());
+                    for (size_t i = 0; i < queries.size(); ++i) {
+                        const int x = queries[i];
+                        exp.push_back(static_cast<int>(std::lower_bound(v.begin(), v.end(), x) - v.begin()));
+                        act.push_back(static_cast<int>(index.lower_bound(x)));
+                        exp.push_back(static_cast<int>(std::lower_bound(v.begin(), v.end(), x) - v.begin()));
+                        act.push_back(static_cast<int>(many[i]));
+                        exp.push_back(static_cast<int>(std::upper_bound(v.begin(), v.end(), x) - v.begin()));
+                        act.push_back(static_cast<int>(index.upper_bound(x)));
+                        exp.push_back(std::binary_search(v.begin(), v.end(), x));
+                        act.push_back(index.contains(x));
+                    }
+                }
+                EXPECT_CON_EQ(exp, act);
+                tinySTL::vector<int> v(1000);
+                for (size_t i = 0; i < v.size(); ++i) v[i] = static_cast<int>(i * 3);
+                tinySTL::eytzinger_index<int> index(v);
+                tinySTL::eytzinger_index<int> copy(index), assigned;
+                assigned = copy;
+                tinySTL::eytzinger_index<int> moved(tinySTL::move(copy));
+                EXPECT_EQ(index.lower_bound(1499), assigned.lower_bound(1499));
+                EXPECT_EQ(index.lower_bound(1499), moved.lower_bound(1499));
+                EXPECT_EQ(500u, moved.lower_bound(1499));
+                EXPECT_TRUE(copy.empty());
+                tinySTL::eytzinger_index<int> empty;
+                EXPECT_TRUE(empty.empty());
+                EXPECT_EQ(0u, empty.lower_bound(1));
+            }
+
+            // 连续的算术类型区间走 SIMD 内核，与标准库逐个比较；长度覆盖不足一个向量、块的边界与尾部
+            template<typename T>
+            void simd_scan_check(size_t n, int range, tinySTL::vector<int> &exp, tinySTL::vector<int> &act) {
+                tinySTL::vector<T> v(n + 1);
+                for (size_t i = 0; i < v.size(); ++i) v[i] = static_cast<T>((i * 7919 + n) % range);
+                const T *first = v.data() + 1, *last = v.data() + n + 1;
+                const T value = n == 0 ? T(1) : first[n / 2];
+                auto pred = [](T x) { return x < T(3); };
+                auto e = std::minmax_element(first, last);
+                auto a = tinySTL::minmax_element(first, last);
+                exp.push_back(static_cast<int>(std::find(first, last, value) - first));
+                act.push_back(static_cast<int>(tinySTL::find(first, last, value) - first));
+                exp.push_back(static_cast<int>(std::count(first, last, value)));
+                act.push_back(static_cast<int>(tinySTL::count(first, last, value)));
+                exp.push_back(static_cast<int>(std::count_if(first, last, pred)));
+                act.push_back(static_cast<int>(tinySTL::count_if(first, last, pred)));
+                exp.push_back(static_cast<int>(std::min_element(first, last) - first));
+                act.push_back(static_cast<int>(tinySTL::min_element(first, last) - first));
+                exp.push_back(static_cast<int>(std::max_element(first, last) - first));
+                act.push_back(static_cast<int>(tinySTL::max_element(first, last) - first));
+                exp.push_back(static_cast<int>((e.first - first) * 3 + (e.second - first)));
+                act.push_back(static_cast<int>((a.first - first) * 3 + (a.second - first)));
+                exp.push_back(static_cast<int>(std::accumulate(first, last, T(1))));
+                act.push_back(static_cast<int>(tinySTL::accumulate(first, last, T(1))));
+                exp.push_back(static_cast<int>(std::inner_product(first, last, first, T(0))));
+                act.push_back(static_cast<int>(tinySTL::inner_product(first, last, first, T(0))));
+            }
+
+            TEST(simd_scan_test) {
+                tinySTL::vector<int> exp, act;
+                const size_t lens[] = {0, 1, 15, 16, 17, 63, 64, 65, 2047, 2048, 2049, 5000, 70001};
+                for (size_t n : lens) {
+                    simd_scan_check<unsigned char>(n, 251, exp, act);
+                    simd_scan_check<short>(n, 30011, exp, act);
+                    simd_scan_check<int>(n, 1000003, exp, act);
+                    simd_scan_check<unsigned long long>(n, 1000003, exp, act);
+                    simd_scan_check<float>(n, 1009, exp, act);
+                    simd_scan_check<double>(n, 1000003, exp, act);
+                }
+                EXPECT_CON_EQ(exp, act);
+                // NaN 使 operator< 不再是严格弱序，结果需要与逐个比较的循环相同；-0.0 与 0.0 相等
+                std::vector<double> d(5000);
+                for (size_t i = 0; i < d.size(); ++i) d[i] = static_cast<double>((i * 31) % 4999);
+                d[3000] = std::numeric_limits<double>::quiet_NaN();
+                const double *d1 = d.data(), *d2 = d.data() + d.size();
+                EXPECT_TRUE(std::min_element(d1, d2) == tinySTL::min_element(d1, d2));
+                EXPECT_TRUE(std::max_element(d1, d2) == tinySTL::max_element(d1, d2));
+                EXPECT_TRUE(tinySTL::minmax_element(d1, d2, std::less<double>()) == tinySTL::minmax_element(d1, d2));
+                std::vector<double> z(3000, 1.0);
+                z[10] = -0.0;
+                z[20] = 0.0;
+                EXPECT_TRUE(z.data() + 10 == tinySTL::min_element(z.data(), z.data() + 3000));
+                EXPECT_TRUE(z.data() + 2999 == tinySTL::minmax_element(z.data(), z.data() + 3000).second);
+                EXPECT_TRUE(z.data() + 10 == tinySTL::find(z.data(), z.data() + 3000, 0.0));
+            }
+
+            TEST(minmax_element_test) {
+                int arr1[] = {3, 1, 4, 1, 5, 9, 2, 6, 5, 3, 9};
+                tinySTL::list<int> l1(arr1, arr1 + 11);
+                auto p1 = tinySTL::minmax_element(arr1, arr1 + 11);
+                auto p2 = tinySTL::minmax_element(arr1, arr1 + 11, std::greater<int>());
+                auto p3 = tinySTL::minmax_element(l1.begin(), l1.end());
+                EXPECT_TRUE(arr1 + 1 == p1.first);
+                EXPECT_TRUE(arr1 + 10 == p1.second);
+                EXPECT_TRUE(arr1 + 5 == p2.first);
+                EXPECT_TRUE(arr1 + 3 == p2.second);
+                EXPECT_EQ(1, *p3.first);
+                EXPECT_EQ(9, *p3.second);
+                EXPECT_TRUE(tinySTL::minmax_element(arr1, arr1).first == arr1);
+            }
+
             TEST(max_elememt_test) {
                 int arr1[] = {1, 2, 3, 4, 5, 4, 3, 2, 1};
                 double arr2[] = {1.0, 2.2, 6.6, 8.8, 8.81, 2.4};
@@ -657,6 +910,56 @@ namespace tinySTL {
                 EXPECT_CON_EQ(exp, act);
             }
 
+            // 元素为 关键字 * 1000000 + 序列号 * 10000 + 位置，只按关键字比较，用于检查多路归并的稳定性
+            bool by_key(long long a, long long b) { return a / 1000000 < b / 1000000; }
+
+            tinySTL::vector<tinySTL::vector<long long>> make_runs(size_t k, size_t max_len, int range) {
+                tinySTL::vector<tinySTL::vector<long long>> runs(k);
+                for (size_t i = 0; i < k; ++i) {
+                    std::vector<long long> keys(static_cast<size_t>(rand()) % (max_len + 1));
+                    for (auto &x: keys) x = rand() % range;
+                    std::sort(keys.begin(), keys.end());
+                    for (size_t j = 0; j < keys.size(); ++j)
+                        runs[i].push_back(keys[j] * 1000000 + static_cast<long long>(i * 10000 + j % 10000));
+                }
+                return runs;
+            }
+
+            TEST(multiway_merge_test) {
+                for (size_t k: {0, 1, 2, 3, 5, 64}) {
+                    auto runs = make_runs(k, 300, 100);
+                    tinySTL::vector<tinySTL::pair<const long long *, const long long *>> seqs;
+                    std::vector<long long> exp;
+                    for (auto &r: runs) {
+                        seqs.push_back(tinySTL::make_pair(r.data(), r.data() + r.size()));
+                        exp.insert(exp.end(), r.begin(), r.end());
+                    }
+                    std::stable_sort(exp.begin(), exp.end(), by_key);
+                    tinySTL::vector<long long> act(exp.size());
+                    EXPECT_TRUE(tinySTL::multiway_merge(seqs.begin(), seqs.end(), act.begin(), by_key) == act.end());
+                    EXPECT_CON_EQ(exp, act);
+                    // 前 rank 个元素恰好由各序列切分位置之前的元素组成
+                    tinySTL::vector<size_t> split(k);
+                    for (size_t rank: {static_cast<size_t>(0), exp.size() / 3, exp.size() / 2, exp.size()}) {
+                        tinySTL::multiseq_partition(seqs.begin(), seqs.end(), rank, split.begin(), by_key);
+                        auto prefix = seqs;
+                        for (size_t i = 0; i < k; ++i) prefix[i].second = prefix[i].first + split[i];
+                        tinySTL::vector<long long> head(rank);
+                        tinySTL::multiway_merge(prefix.begin(), prefix.end(), head.begin(), by_key);
+                        EXPECT_TRUE(std::equal(head.begin(), head.end(), exp.begin()));
+                    }
+                }
+                tinySTL::list<int> l1{1, 4, 7}, l2{2, 5, 8}, l3{3, 6, 9};
+                typedef tinySTL::list<int>::iterator list_iter;
+                tinySTL::pair<list_iter, list_iter> lists[] = {tinySTL::make_pair(l1.begin(), l1.end()),
+                                                                tinySTL::make_pair(l2.begin(), l2.end()),
+                                                                tinySTL::make_pair(l3.begin(), l3.end())};
+                int exp2[] = {1, 2, 3, 4, 5, 6, 7, 8, 9};
+                int act2[9];
+                tinySTL::multiway_merge(lists, lists + 3, act2);
+                EXPECT_CON_EQ(exp2, act2);
+            }
+
             TEST(min_elememt_test) {
                 int arr1[] = {2, 4, 8, 1, 6, 5, 8, 9, 3};
                 double arr2[] = {1.5, 2.2, 1.4, 1.33, 1.333, 2.33};
@@ -749,6 +1052,57 @@ namespace tinySTL {
                 EXPECT_TRUE(arr4_right_greater);
             }
 
+            // McIlroy 的对抗性比较函数：元素的值在比较时才确定，使基于快速划分的选择算法尽可能退化
+            struct adversary {
+                std::vector<int> *val;
+                int *nsolid;
+                int *candidate;
+                long *ncmp;
+                int gas;
+
+                bool operator()(int x, int y) const {
+                    ++*ncmp;
+                    if ((*val)[x] == gas && (*val)[y] == gas) {
+                        (*val)[x == *candidate ? x : y] = (*nsolid)++;
+                    }
+                    if ((*val)[x] == gas) *candidate = x;
+                    else if ((*val)[y] == gas) *candidate = y;
+                    return (*val)[x] < (*val)[y];
+                }
+            };
+
+            TEST(introselect_test) {
+                for (int pattern = 0; pattern < 5; ++pattern) {
+                    const int n = 20000;
+                    std::vector<int> v(n);
+                    for (int i = 0; i < n; ++i) {
+                        v[i] = pattern == 0 ? rand() : pattern == 1 ? rand() % 8 : pattern == 2 ? i
+                             : pattern == 3 ? n - i : (i < n / 2 ? i : n - i);
+                    }
+                    std::vector<int> sorted(v);
+                    std::sort(sorted.begin(), sorted.end());
+                    for (int nth: {0, 1, n / 3, n / 2, n - 1}) {
+                        std::vector<int> w(v);
+                        tinySTL::nth_element(w.data(), w.data() + nth, w.data() + n);
+                        EXPECT_EQ(sorted[nth], w[nth]);
+                        EXPECT_TRUE(*std::max_element(w.begin(), w.begin() + nth + 1) == w[nth]);
+                        EXPECT_TRUE(*std::min_element(w.begin() + nth, w.end()) == w[nth]);
+                        tinySTL::nth_element(w.data(), w.data() + nth, w.data() + n, std::greater<int>());
+                        EXPECT_EQ(sorted[n - 1 - nth], w[nth]);
+                    }
+                }
+                // 对抗性输入下比较次数仍然是线性的
+                for (int n: {10000, 100000}) {
+                    std::vector<int> val(n, n - 1), ids(n);
+                    int nsolid = 0, candidate = 0;
+                    long ncmp = 0;
+                    for (int i = 0; i < n; ++i) ids[i] = i;
+                    tinySTL::nth_element(ids.data(), ids.data() + n / 2, ids.data() + n,
+                                         adversary{&val, &nsolid, &candidate, &ncmp, n - 1});
+                    EXPECT_TRUE(ncmp < 20L * n);
+                }
+            }
+
             TEST(partial_sort_test) {
                 int arr1[] = {3, 2, 1, 9, 8, 7, 6, 5, 4};
                 int arr2[] = {3, 2, 1, 9, 8, 7, 6, 5, 4};
@@ -762,6 +1116,73 @@ namespace tinySTL {
                 EXPECT_CON_EQ(arr3, arr4);
             }
 
+            TEST(adaptive_partial_sort_test) {
+                for (int pattern = 0; pattern < 4; ++pattern) {
+                    const int n = 100000;
+                    std::vector<int> v(n);
+                    for (int i = 0; i < n; ++i) {
+                        v[i] = pattern == 0 ? rand() : pattern == 1 ? rand() % 16 : pattern == 2 ? i : n - i;
+                    }
+                    for (int k: {0, 1, 100, 150, n / 10, n}) {
+                        std::vector<int> exp(v), act(v);
+                        std::partial_sort(exp.begin(), exp.begin() + k, exp.end(), std::greater<int>());
+                        tinySTL::partial_sort(act.data(), act.data() + k, act.data() + n, std::greater<int>());
+                        EXPECT_TRUE(std::equal(exp.begin(), exp.begin() + k, act.begin()));
+                        std::sort(act.begin(), act.end());
+                        std::sort(exp.begin(), exp.end());
+                        EXPECT_CON_EQ(exp, act);
+                    }
+                }
+            }
+
+            // 没有默认构造函数的元素类型
+            struct scored {
+                explicit scored(int s) : score(s) {}
+
+                int score;
+            };
+
+            bool higher_score(const scored &a, const scored &b) {
+                return a.score > b.score;
+            }
+
+            TEST(top_k_test) {
+                std::vector<int> v(100000);
+                for (auto &x: v) x = rand() % 5000;
+                std::vector<int> exp(v);
+                std::partial_sort(exp.begin(), exp.begin() + 100, exp.end(), std::greater<int>());
+                exp.resize(100);
+                tinySTL::top_k<int> top(100);
+                top.push(v.begin(), v.begin() + 50000);
+                for (size_t i = 50000; i < v.size(); ++i) top.push(v[i]);
+                EXPECT_EQ(100, top.size());
+                EXPECT_CON_EQ(exp, top.sorted());
+                // 取出结果后可以继续加入元素
+                top.push(100000);
+                EXPECT_EQ(100000, top.sorted()[0]);
+                EXPECT_EQ(exp[98], top.sorted()[99]);
+                // 元素个数不足 k 个、k 为 0、使用 less 保留最小的 k 个
+                tinySTL::top_k<int> few(10);
+                few.push(3);
+                few.push(1);
+                few.push(2);
+                int few_exp[] = {3, 2, 1};
+                EXPECT_CON_EQ(few_exp, few.sorted());
+                tinySTL::top_k<int> none(0);
+                none.push(v.begin(), v.end());
+                EXPECT_TRUE(none.empty());
+                tinySTL::top_k<int, std::less<int>> smallest(5);
+                smallest.push(v.begin(), v.end());
+                std::sort(v.begin(), v.end());
+                EXPECT_TRUE(std::equal(v.begin(), v.begin() + 5, smallest.sorted().begin()));
+                smallest.clear();
+                EXPECT_TRUE(smallest.empty());
+                tinySTL::top_k<scored, bool (*)(const scored &, const scored &)> best(3, higher_score);
+                for (int i = 0; i < 100; ++i) best.push(scored(i * 37 % 101));
+                EXPECT_EQ(100, best.sorted()[0].score);
+                EXPECT_EQ(98, best.sorted()[2].score);
+            }
+
             TEST(partial_sort_copy_test) {
                 int arr1[] = {3, 2, 1, 9, 8, 7, 6, 5, 4};
                 int arr2[] = {1, 2, 3, 4, 5, 6, 7, 8, 9};
@@ -829,6 +1250,49 @@ namespace tinySTL {
                 EXPECT_CON_NE(arr1, arr2);
             }
 
+            TEST(radix_sort_test) {
+                std::vector<int> exp1;
+                std::vector<double> exp2;
+                std::vector<std::pair<long long, int>> exp3;
+                std::vector<std::string> exp4;
+                for (int i = 0; i < 100000; ++i) {
+                    exp1.push_back(rand() - RAND_MAX / 2);
+                    exp2.push_back((rand() - RAND_MAX / 2) / 7.0);
+                    exp3.push_back(std::make_pair(static_cast<long long>(rand() % 1000) - 500, i));
+                }
+                for (int i = 0; i < 5000; ++i) {
+                    exp4.push_back(std::to_string(rand() % 100000) + (i % 3 == 0 ? "" : "key"));
+                }
+                tinySTL::vector<int> act1(exp1.data(), exp1.data() + exp1.size());
+                tinySTL::vector<double> act2(exp2.data(), exp2.data() + exp2.size());
+                tinySTL::vector<std::pair<long long, int>> act3(exp3.data(), exp3.data() + exp3.size());
+                tinySTL::vector<tinySTL::string> act4;
+                for (auto &s : exp4) {
+                    act4.push_back(tinySTL::string(s.c_str()));
+                }
+                std::sort(exp1.begin(), exp1.end());
+                std::sort(exp2.begin(), exp2.end());
+                std::stable_sort(exp3.begin(), exp3.end(), [](const std::pair<long long, int> &a,
+                                                             const std::pair<long long, int> &b) {
+                    return a.first < b.first;
+                });
+                std::sort(exp4.begin(), exp4.end());
+                tinySTL::radix_sort(act1.begin(), act1.end());
+                tinySTL::radix_sort(act2.begin(), act2.end());
+                // 按关键字排序是稳定的
+                tinySTL::radix_sort(act3.begin(), act3.end(), [](const std::pair<long long, int> &p) {
+                    return p.first;
+                });
+                tinySTL::radix_sort(act4.begin(), act4.end());
+                EXPECT_CON_EQ(exp1, act1);
+                EXPECT_CON_EQ(exp2, act2);
+                EXPECT_TRUE(std::equal(exp3.begin(), exp3.end(), act3.begin()));
+                EXPECT_TRUE(std::equal(exp4.begin(), exp4.end(), act4.begin(),
+                                       [](const std::string &a, const tinySTL::string &b) {
+                                           return a == b.c_str();
+                                       }));
+            }
+
             TEST(remove_test) {
                 std::vector<int> v1{1, 2, 3, 4, 5, 6, 6, 6};
                 std::vector<int> v2(v1);
@@ -1018,6 +1482,55 @@ namespace tinySTL {
                 EXPECT_CON_EQ(arr5, arr6);
             }
 
+            TEST(sort_pattern_test) {
+                // 覆盖已排序、逆序、大量重复、锯齿、几乎有序等模式，以及无分支划分与普通划分两条路径
+                const int n = 5000;
+                std::vector<int> exp[6];
+                for (int i = 0; i < n; ++i) {
+                    exp[0].push_back(i);
+                    exp[1].push_back(n - i);
+                    exp[2].push_back(rand() % 4);
+                    exp[3].push_back(i % 100);
+                    exp[4].push_back(i % 97 == 0 ? rand() : i);
+                    exp[5].push_back(rand());
+                }
+                for (auto &e : exp) {
+                    tinySTL::vector<int> act1(e.data(), e.data() + e.size());
+                    tinySTL::vector<int> act2(act1);
+                    std::sort(e.begin(), e.end());
+                    tinySTL::sort(act1.begin(), act1.end());
+                    tinySTL::sort(act2.begin(), act2.end(), [](int a, int b) { return a < b; });
+                    EXPECT_CON_EQ(e, act1);
+                    EXPECT_CON_EQ(e, act2);
+                }
+            }
+
+            TEST(stable_sort_test) {
+                // 元素为 key * 1000000 + 原下标，只按 key 比较，结果与 std::stable_sort 逐个相等说明相等元素保持了原有次序
+                auto by_key = [](long long a, long long b) { return a / 1000000 < b / 1000000; };
+                const int n = 5000;
+                std::vector<long long> exp[6];
+                for (int i = 0; i < n; ++i) {
+                    exp[0].push_back(i / 3 * 1000000LL + i);
+                    exp[1].push_back((n - i) / 3 * 1000000LL + i);
+                    exp[2].push_back(rand() % 4 * 1000000LL + i);
+                    exp[3].push_back(i % 100 * 1000000LL + i);
+                    exp[4].push_back((i % 97 == 0 ? rand() % n : i) * 1000000LL + i);
+                    exp[5].push_back(rand() % n * 1000000LL + i);
+                }
+                for (auto &e : exp) {
+                    tinySTL::vector<long long> act(e.data(), e.data() + e.size());
+                    std::stable_sort(e.begin(), e.end(), by_key);
+                    tinySTL::stable_sort(act.begin(), act.end(), by_key);
+                    EXPECT_CON_EQ(e, act);
+                }
+                int arr1[] = {5, 1, 4, 2, 3, 3, 2, 4, 1, 5};
+                int arr2[] = {5, 1, 4, 2, 3, 3, 2, 4, 1, 5};
+                std::stable_sort(arr1, arr1 + 10);
+                tinySTL::stable_sort(arr2, arr2 + 10);
+                EXPECT_CON_EQ(arr1, arr2);
+            }
+
             TEST(swap_ranges_test) {
                 int arr1[] = {4, 5, 6, 1, 2, 3};
                 int arr2[] = {4, 5, 6, 1, 2, 3};
@@ -1084,6 +1597,165 @@ namespace tinySTL {
                           tinySTL::upper_bound(arr1, arr1 + 9, 7, std::less<int>()));
             }
 
+            // 以下为带执行策略的并行版本，数据量需大于分块粒度才会真正走并行路径
+            TEST(parallel_sort_test) {
+                std::vector<int> v1(100000);
+                for (auto &x: v1) x = rand() % 1000;
+                tinySTL::vector<int> v2(v1.data(), v1.data() + v1.size()), v3(v2), v4(v2);
+                std::sort(v1.begin(), v1.end());
+                tinySTL::sort(tinySTL::execution::par, v2.begin(), v2.end());
+                tinySTL::sort(v3.begin(), v3.end());
+                EXPECT_CON_EQ(v1, v2);
+                EXPECT_CON_EQ(v1, v3);
+                std::sort(v1.begin(), v1.end(), std::greater<int>());
+                tinySTL::sort(tinySTL::execution::par_unseq, v4.begin(), v4.end(), std::greater<int>());
+                EXPECT_CON_EQ(v1, v4);
+            }
+
+            TEST(parallel_stable_sort_test) {
+                auto by_key = [](long long a, long long b) { return a / 1000000 < b / 1000000; };
+                std::vector<long long> v1(100000);
+                for (size_t i = 0; i < v1.size(); ++i) v1[i] = rand() % 1000 * 1000000LL + static_cast<long long>(i);
+                tinySTL::vector<long long> v2(v1.data(), v1.data() + v1.size());
+                std::stable_sort(v1.begin(), v1.end(), by_key);
+                tinySTL::stable_sort(tinySTL::execution::par, v2.begin(), v2.end(), by_key);
+                EXPECT_CON_EQ(v1, v2);
+            }
+
+            TEST(parallel_partial_sort_test) {
+                std::vector<int> v1(100000);
+                for (auto &x: v1) x = rand();
+                tinySTL::vector<int> v2(v1.data(), v1.data() + v1.size()), v3(v2);
+                std::sort(v1.begin(), v1.end());
+                tinySTL::partial_sort(tinySTL::execution::par, v2.begin(), v2.begin() + 100, v2.end());
+                EXPECT_TRUE(std::equal(v1.begin(), v1.begin() + 100, v2.begin()));
+                tinySTL::partial_sort(tinySTL::execution::par, v3.begin(), v3.begin() + 60000, v3.end());
+                EXPECT_TRUE(std::equal(v1.begin(), v1.begin() + 60000, v3.begin()));
+            }
+
+            TEST(parallel_reduce_test) {
+                tinySTL::vector<long long> v1(100000);
+                for (size_t i = 0; i < v1.size(); ++i) v1[i] = static_cast<long long>(i % 977);
+                EXPECT_EQ(std::accumulate(v1.begin(), v1.end(), 0LL),
+                          tinySTL::reduce(tinySTL::execution::par, v1.begin(), v1.end()));
+                EXPECT_EQ(std::accumulate(v1.begin(), v1.end(), 5LL),
+                          tinySTL::accumulate(tinySTL::execution::par, v1.begin(), v1.end(), 5LL));
+                EXPECT_EQ(static_cast<size_t>(std::count(v1.begin(), v1.end(), 3LL)),
+                          tinySTL::count(tinySTL::execution::par, v1.begin(), v1.end(), 3LL));
+                // unseq、par_unseq 对连续的算术类型区间使用 SIMD 求和，整数的结果不变，浮点数只有舍入误差
+                EXPECT_EQ(std::accumulate(v1.begin(), v1.end(), 0LL),
+                          tinySTL::reduce(tinySTL::execution::unseq, v1.begin(), v1.end()));
+                EXPECT_EQ(std::accumulate(v1.begin(), v1.end(), 7LL),
+                          tinySTL::reduce(tinySTL::execution::par_unseq, v1.begin(), v1.end(), 7LL));
+                tinySTL::vector<double> v2(100000);
+                for (size_t i = 0; i < v2.size(); ++i) v2[i] = 1.0 / static_cast<double>(i + 1);
+                const double sum = std::accumulate(v2.begin(), v2.end(), 0.0);
+                EXPECT_TRUE(std::abs(sum - tinySTL::accumulate(tinySTL::execution::unseq, v2.begin(), v2.end(), 0.0))
+                            < 1e-9);
+                EXPECT_TRUE(std::abs(sum - tinySTL::reduce(tinySTL::execution::par_unseq, v2.begin(), v2.end()))
+                            < 1e-9);
+                // 非随机访问迭代器退化为顺序执行
+                tinySTL::list<int> l1{1, 2, 3, 4, 5};
+                EXPECT_EQ(15, tinySTL::reduce(tinySTL::execution::par, l1.begin(), l1.end(), 0));
+            }
+
+            TEST(parallel_scan_test) {
+                tinySTL::vector<long long> v1(100000);
+                for (auto &x: v1) x = rand() % 2001 - 1000;
+                std::vector<long long> exp(v1.size());
+                tinySTL::vector<long long> act(v1.size());
+                std::partial_sum(v1.begin(), v1.end(), exp.begin());
+                tinySTL::inclusive_scan(tinySTL::execution::par, v1.begin(), v1.end(), act.begin());
+                EXPECT_CON_EQ(exp, act);
+                tinySTL::inclusive_scan(tinySTL::execution::par_unseq, v1.begin(), v1.end(), act.begin());
+                EXPECT_CON_EQ(exp, act);
+                for (size_t i = 0; i < exp.size(); ++i) exp[i] -= v1[i] - 5;
+                act = v1;
+                tinySTL::exclusive_scan(tinySTL::execution::par, act.begin(), act.end(), act.begin(), 5LL);
+                EXPECT_CON_EQ(exp, act);
+                EXPECT_EQ(std::inner_product(v1.begin(), v1.end(), v1.begin(), 0LL),
+                          tinySTL::transform_reduce(tinySTL::execution::par_unseq, v1.begin(), v1.end(),
+                                                    v1.begin(), 0LL));
+                EXPECT_EQ(std::accumulate(v1.begin(), v1.end(), 0LL) * 3,
+                          tinySTL::transform_reduce(tinySTL::execution::par, v1.begin(), v1.end(), 0LL,
+                                                    std::plus<long long>(), [](long long x) { return 3 * x; }));
+                // deterministic(par) 把 200000 个元素均分为 ceil(200000 / 65536) = 4 块，
+                // 浮点数的结果与下面按同样方式串行计算的逐位相同，与线程数无关
+                tinySTL::vector<double> v2(200000);
+                for (size_t i = 0; i < v2.size(); ++i) v2[i] = 1.0 / static_cast<double>(rand() % 1000 + 1);
+                std::vector<double> exp2(v2.size());
+                tinySTL::vector<double> act2(v2.size());
+                double total = 0.5;
+                for (size_t b = 0; b < v2.size(); b += 50000) {
+                    const size_t e = b + 50000;
+                    double part = v2[b], run = total;
+                    for (size_t i = b + 1; i < e; ++i) part += v2[i];
+                    for (size_t i = b; i < e; ++i) exp2[i] = run += v2[i];
+                    total += part;
+                }
+                const auto det = tinySTL::execution::deterministic(tinySTL::execution::par);
+                EXPECT_TRUE(total == tinySTL::reduce(det, v2.begin(), v2.end(), 0.5));
+                tinySTL::inclusive_scan(det, v2.begin(), v2.end(), act2.begin(), tinySTL::plus<double>(), 0.5);
+                EXPECT_CON_EQ(exp2, act2);
+                const auto det_unseq = tinySTL::execution::deterministic(tinySTL::execution::par_unseq);
+                const double sum = tinySTL::reduce(det_unseq, v2.begin(), v2.end());
+                EXPECT_TRUE(sum == tinySTL::reduce(det_unseq, v2.begin(), v2.end()));
+                EXPECT_TRUE(std::abs(sum + 0.5 - total) < 1e-9);
+                // 非随机访问迭代器退化为顺序执行
+                tinySTL::list<int> l1{1, 2, 3, 4, 5};
+                tinySTL::vector<int> act3(5);
+                tinySTL::inclusive_scan(tinySTL::execution::par, l1.begin(), l1.end(), act3.begin());
+                EXPECT_EQ(15, act3[4]);
+            }
+
+            TEST(parallel_find_test) {
+                tinySTL::vector<int> v1(100000);
+                for (size_t i = 0; i < v1.size(); ++i) v1[i] = static_cast<int>(i);
+                v1[70000] = -1;
+                v1[90000] = -1;
+                EXPECT_EQ(std::find(v1.begin(), v1.end(), -1) - v1.begin(),
+                          tinySTL::find(tinySTL::execution::par, v1.begin(), v1.end(), -1) - v1.begin());
+                EXPECT_EQ(std::find(v1.begin(), v1.end(), -2) - v1.begin(),
+                          tinySTL::find(tinySTL::execution::par, v1.begin(), v1.end(), -2) - v1.begin());
+                EXPECT_EQ(std::find_if(v1.begin(), v1.end(), is_odd) - v1.begin(),
+                          tinySTL::find_if(tinySTL::execution::seq, v1.begin(), v1.end(), is_odd) - v1.begin());
+            }
+
+            TEST(parallel_transform_merge_test) {
+                tinySTL::vector<int> v1(100000), v2(80000);
+                for (auto &x: v1) x = rand() % 5000;
+                for (auto &x: v2) x = rand() % 5000;
+                std::vector<int> exp(v1.size());
+                tinySTL::vector<int> act(v1.size());
+                std::transform(v1.begin(), v1.end(), exp.begin(), unary_op);
+                tinySTL::transform(tinySTL::execution::par, v1.begin(), v1.end(), act.begin(), unary_op);
+                EXPECT_CON_EQ(exp, act);
+                std::sort(v1.begin(), v1.end());
+                std::sort(v2.begin(), v2.end());
+                std::vector<int> exp2(v1.size() + v2.size());
+                tinySTL::vector<int> act2(v1.size() + v2.size());
+                std::merge(v1.begin(), v1.end(), v2.begin(), v2.end(), exp2.begin());
+                tinySTL::merge(tinySTL::execution::par, v1.begin(), v1.end(), v2.begin(), v2.end(), act2.begin());
+                EXPECT_CON_EQ(exp2, act2);
+            }
+
+            TEST(parallel_multiway_merge_test) {
+                auto runs = make_runs(64, 6000, 5000);
+                tinySTL::vector<tinySTL::pair<long long *, long long *>> seqs;
+                std::vector<long long> exp;
+                for (auto &r: runs) {
+                    seqs.push_back(tinySTL::make_pair(r.begin(), r.end()));
+                    exp.insert(exp.end(), r.begin(), r.end());
+                }
+                std::stable_sort(exp.begin(), exp.end(), by_key);
+                tinySTL::vector<long long> act(exp.size());
+                tinySTL::multiway_merge(tinySTL::execution::par, seqs.begin(), seqs.end(), act.begin(), by_key);
+                EXPECT_CON_EQ(exp, act);
+                std::sort(exp.begin(), exp.end());
+                tinySTL::multiway_merge(tinySTL::execution::par, seqs.begin(), seqs.end(), act.begin());
+                EXPECT_CON_EQ(exp, act);
+            }
+
         } // namespace algorithm_test
 
 #ifdef _MSC_VER
@@ -0,0 +1,113 @@
+#ifndef MYTINYSTL_DYNAMIC_BITSET_TEST_H_
+#define MYTINYSTL_DYNAMIC_BITSET_TEST_H_
+
+/*
+ * dynamic_bitset test : 测试 dynamic_bitset 的接口与 push_back 的性能
+ */
+
+#include <vector>
+
+#include "dynamic_bitset.h"  /* 这个头文件包含一个类 dynamic_bitset */
+#include "test.h"  /* 一个简单的单元测试框架，定义了两个类 TestCase 和 UnitTest，以及一系列用于测试的宏 */
+
+namespace tinySTL
+{
+    namespace test
+    {
+        namespace dynamic_bitset_test
+        {
+
+            void dynamic_bitset_test()
+            {
+                std::cout << "[===============================================================]\n";
+                std::cout << "[------------- Run container test : dynamic_bitset -------------]\n";
+                std::cout << "[-------------------------- API test ---------------------------]\n";
+                tinySTL::dynamic_bitset b1;
+                tinySTL::dynamic_bitset b2(10);
+                tinySTL::dynamic_bitset b3(70, true);
+                tinySTL::dynamic_bitset b4(b3);
+                tinySTL::dynamic_bitset b5(std::move(b4));
+                tinySTL::dynamic_bitset b6;
+                b6 = b2;
+
+                STR_FUN_AFTER(b1, b1.push_back(true));
+                STR_FUN_AFTER(b1, b1.push_back(false));
+                STR_FUN_AFTER(b1, b1.push_back(true));
+                STR_FUN_AFTER(b1, b1.resize(8, true));
+                STR_FUN_AFTER(b1, b1.pop_back());
+                STR_FUN_AFTER(b1, b1.flip(0));
+                STR_FUN_AFTER(b1, b1.set(1));
+                STR_FUN_AFTER(b1, b1.reset(2));
+                STR_FUN_AFTER(b1, b1[3] = false);
+                FUN_VALUE(b1[4]);
+                FUN_VALUE(b1.test(5));
+                FUN_VALUE(b1.size());
+                FUN_VALUE(b1.count());
+                FUN_VALUE(b1.find_first());
+                FUN_VALUE(b1.find_next(1));
+                FUN_VALUE(b1.find_next(6));
+                std::cout << std::boolalpha;
+                FUN_VALUE(b1.empty());
+                FUN_VALUE(b1.any());
+                FUN_VALUE(b1.all());
+                FUN_VALUE(b2.none());
+                FUN_VALUE(b3.all());
+                std::cout << std::noboolalpha;
+                STR_FUN_AFTER(b3, b3.reset(0));
+                STR_FUN_AFTER(b3, b3 <<= 3);
+                STR_FUN_AFTER(b3, b3 >>= 66);
+                FUN_VALUE(b5.count());
+                STR_FUN_AFTER(b5, b5 >>= 64);
+                FUN_VALUE(b5.count());
+                STR_FUN_AFTER(b5, b5 <<= 65);
+                FUN_VALUE(b5.count());
+                FUN_VALUE(b5.find_first());
+                STR_FUN_AFTER(b2, b2.set());
+                STR_FUN_AFTER(b6, b6.set(1).set(3).set(9));
+                STR_FUN_AFTER(b2, b2 &= b6);
+                STR_FUN_AFTER(b2, b2 ^= ~b6);
+                STR_FUN_AFTER(b2, b2 |= b6);
+                std::cout << std::boolalpha;
+                FUN_VALUE((b2 == b6));
+                FUN_VALUE(b2.intersects(b6));
+                std::cout << std::noboolalpha;
+                STR_FUN_AFTER(b2, b2.swap(b1));
+                STR_FUN_AFTER(b2, b2.clear());
+                FUN_VALUE(b2.size());
+                PASSED;
+#if PERFORMANCE_TEST_ON
+                std::cout << "[--------------------- Performance Testing ---------------------]\n";
+                std::cout << "|---------------------|-------------|-------------|-------------|\n";
+                std::cout << "|      push_back      |";
+#if LARGER_TEST_DATA_ON
+                TEST_LEN(LEN1 _LL, LEN2 _LL, LEN3 _LL, WIDE);
+                std::cout << "|         std         |";
+                FUN_TEST_FORMAT1(std::vector<bool>, push_back, rand() & 1, LEN1 _LL);
+                FUN_TEST_FORMAT1(std::vector<bool>, push_back, rand() & 1, LEN2 _LL);
+                FUN_TEST_FORMAT1(std::vector<bool>, push_back, rand() & 1, LEN3 _LL);
+                std::cout << "\n|        tinySTL        |";
+                FUN_TEST_FORMAT1(tinySTL::dynamic_bitset, push_back, rand() & 1, LEN1 _LL);
+                FUN_TEST_FORMAT1(tinySTL::dynamic_bitset, push_back, rand() & 1, LEN2 _LL);
+                FUN_TEST_FORMAT1(tinySTL::dynamic_bitset, push_back, rand() & 1, LEN3 _LL);
+#else
+                TEST_LEN(LEN1 _L, LEN2 _L, LEN3 _L, WIDE);
+                std::cout << "|         std         |";
+                FUN_TEST_FORMAT1(std::vector<bool>, push_back, rand() & 1, LEN1 _L);
+                FUN_TEST_FORMAT1(std::vector<bool>, push_back, rand() & 1, LEN2 _L);
+                FUN_TEST_FORMAT1(std::vector<bool>, push_back, rand() & 1, LEN3 _L);
+                std::cout << "\n|        tinySTL        |";
+                FUN_TEST_FORMAT1(tinySTL::dynamic_bitset, push_back, rand() & 1, LEN1 _L);
+                FUN_TEST_FORMAT1(tinySTL::dynamic_bitset, push_back, rand() & 1, LEN2 _L);
+                FUN_TEST_FORMAT1(tinySTL::dynamic_bitset, push_back, rand() & 1, LEN3 _L);
+#endif
+                std::cout << "\n";
+                std::cout << "|---------------------|-------------|-------------|-------------|\n";
+                PASSED;
+#endif
+                std::cout << "[------------- End container test : dynamic_bitset -------------]\n";
+            }
+
+        } // namespace dynamic_bitset_test
+    } // namespace test
+} // namespace tinySTL
+#endif // !MYTINYSTL_DYNAMIC_BITSET_TEST_H_
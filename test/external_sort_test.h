@@ -0,0 +1,191 @@
+#ifndef MYTINYSTL_EXTERNAL_SORT_TEST_H_
+#define MYTINYSTL_EXTERNAL_SORT_TEST_H_
+
+/*
+ * external_sort test : 测试 external_sorter、external_sort、external_sort_records、external_sort_lines 的接口
+ * 用很小的内存预算强制写出多个顺串(以及多轮归并)，结果与 std::sort / std::stable_sort 比较
+ */
+
+#include <algorithm>
+#include <chrono>
+#include <cstdint>
+#include <cstring>
+#include <iterator>
+#include <sstream>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+#include "external_sort.h"  /* 这个头文件包含外部排序 external_sorter 与 external_sort */
+#include "test.h"  /* 一个简单的单元测试框架，定义了两个类 TestCase 和 UnitTest，以及一系列用于测试的宏 */
+
+namespace tinySTL
+{
+    namespace test
+    {
+        namespace external_sort_test
+        {
+
+            // 定长记录：只按 key 排序，value 记录原来的位置
+            struct record
+            {
+                uint32_t key;
+                uint32_t value;
+            };
+
+            bool record_less(const record &a, const record &b)
+            {
+                return a.key < b.key;
+            }
+
+// 对 len 个随机数排序，external_sort 的内存预算为 1MB，记录墙上时间
+#define EXTERNAL_SORT_TEST(mode, len) do {                   \
+  std::vector<int> v(len), out;                              \
+  out.reserve(len);                                          \
+  srand((int)time(0));                                       \
+  for (size_t i = 0; i < len; ++i) v[i] = rand();            \
+  tinySTL::external_sort_options opt;                        \
+  opt.memory_budget = 1 << 20;                               \
+  opt.block_size = 64 << 10;                                 \
+  auto start = std::chrono::steady_clock::now();             \
+  if (mode) tinySTL::external_sort(v.begin(), v.end(),       \
+      std::back_inserter(out), std::less<int>(), opt);       \
+  else std::sort(v.begin(), v.end());                        \
+  auto end = std::chrono::steady_clock::now();               \
+  int n = static_cast<int>(std::chrono::duration_cast<       \
+      std::chrono::milliseconds>(end - start).count());      \
+  char buf[16];                                              \
+  std::snprintf(buf, sizeof(buf), "%d", n);                  \
+  std::string t = buf;                                       \
+  t += "ms    |";                                            \
+  std::cout << std::setw(WIDE) << t;                         \
+} while(0)
+
+            void external_sort_test()
+            {
+                std::cout << "[===============================================================]\n";
+                std::cout << "[------------- Run container test : external_sort --------------]\n";
+                std::cout << "[-------------------------- API test ---------------------------]\n";
+                tinySTL::external_sort_options opt;
+                opt.memory_budget = 64 << 10;
+                opt.block_size = 4 << 10;
+
+                // 整数：一轮归并
+                std::vector<int> v(200000);
+                for (auto &x : v) x = rand();
+                std::vector<int> exp(v), act;
+                std::sort(exp.begin(), exp.end());
+                tinySTL::external_sort(v.begin(), v.end(), std::back_inserter(act), std::less<int>(), opt);
+                std::cout << std::boolalpha;
+                FUN_VALUE((act == exp));
+
+                // 只能同时归并 3 路，需要多轮归并
+                tinySTL::external_sort_options narrow = opt;
+                narrow.memory_budget = 16 << 10;
+                tinySTL::external_sorter<int, std::greater<int>> desc(std::greater<int>(), narrow);
+                for (auto x : v) desc.push(x);
+                FUN_VALUE(desc.run_count());
+                act.clear();
+                desc.finish(std::back_inserter(act));
+                FUN_VALUE((act == std::vector<int>(exp.rbegin(), exp.rend())));
+
+                // 放得进内存预算时不写临时文件
+                tinySTL::external_sorter<int> small(search_detail::less_than(), opt);
+                for (int i = 100; i > 0; --i) small.push(i);
+                FUN_VALUE(small.run_count());
+                act.clear();
+                small.finish(std::back_inserter(act));
+                FUN_VALUE(std::is_sorted(act.begin(), act.end()));
+
+                // 字符串
+                tinySTL::external_sorter<tinySTL::string> words(search_detail::less_than(), opt);
+                std::vector<std::string> sexp;
+                for (int i = 0; i < 20000; ++i)
+                {
+                    std::string w(static_cast<size_t>(rand() % 40), 'a');
+                    for (auto &c : w) c = static_cast<char>('a' + rand() % 26);
+                    sexp.push_back(w);
+                    words.push(tinySTL::string(w.c_str()));
+                }
+                std::sort(sexp.begin(), sexp.end());
+                std::vector<std::string> sact;
+                std::vector<tinySTL::string> sorted;
+                words.finish(std::back_inserter(sorted));
+                for (auto &w : sorted) sact.push_back(std::string(w.data(), w.size()));
+                FUN_VALUE((sact == sexp));
+
+                // 文本流按行排序：空行与末尾没有换行符的一行
+                std::istringstream text("pear\n\napple\nfig\nbanana\napple");
+                std::ostringstream sorted_text;
+                tinySTL::external_sort_lines(text, sorted_text);
+                FUN_VALUE((sorted_text.str() == "\napple\napple\nbanana\nfig\npear\n"));
+                std::string lines;
+                for (int i = 0; i < 30000; ++i) lines += std::to_string(rand() % 100000) + "\n";
+                std::istringstream many(lines);
+                std::ostringstream many_sorted;
+                tinySTL::external_sort_lines(many, many_sorted, search_detail::less_than(), opt);
+                std::vector<std::string> lexp, lact;
+                std::istringstream a(lines), b(many_sorted.str());
+                for (std::string s; std::getline(a, s);) lexp.push_back(s);
+                for (std::string s; std::getline(b, s);) lact.push_back(s);
+                std::sort(lexp.begin(), lexp.end());
+                FUN_VALUE((lact == lexp));
+
+                // 二进制流中的定长记录
+                std::vector<record> recs(50000);
+                for (size_t i = 0; i < recs.size(); ++i) recs[i] = {static_cast<uint32_t>(rand() % 1000),
+                                                                     static_cast<uint32_t>(i)};
+                std::string bytes(reinterpret_cast<const char *>(recs.data()), recs.size() * sizeof(record));
+                std::istringstream bin(bytes);
+                std::ostringstream bout;
+                tinySTL::external_sort_records<record>(bin, bout, record_less, opt);
+                std::stable_sort(recs.begin(), recs.end(), record_less);
+                const std::string out = bout.str();
+                bool keys_sorted = out.size() == bytes.size();
+                for (size_t i = 0; keys_sorted && i < recs.size(); ++i)
+                {
+                    record r;
+                    std::memcpy(&r, out.data() + i * sizeof(record), sizeof(record));
+                    keys_sorted = r.key == recs[i].key;
+                }
+                FUN_VALUE(keys_sorted);
+                std::istringstream partial(bytes.substr(0, sizeof(record) + 3));
+                std::ostringstream ignored;
+                bool caught = false;
+                try
+                {
+                    tinySTL::external_sort_records<record>(partial, ignored, record_less, opt);
+                }
+                catch (const std::runtime_error &)
+                {
+                    caught = true;
+                }
+                FUN_VALUE(caught);
+                std::cout << std::noboolalpha;
+                PASSED;
+#if PERFORMANCE_TEST_ON
+                std::cout << "[--------------------- Performance Testing ---------------------]\n";
+                std::cout << "|---------------------|-------------|-------------|-------------|\n";
+                std::cout << "|        sort         |";
+                TEST_LEN(LEN1, LEN2, LEN3, WIDE);
+                std::cout << "|    std in memory    |";
+                EXTERNAL_SORT_TEST(false, LEN1);
+                EXTERNAL_SORT_TEST(false, LEN2);
+                EXTERNAL_SORT_TEST(false, LEN3);
+                std::cout << "\n|  tinySTL 1MB budget |";
+                EXTERNAL_SORT_TEST(true, LEN1);
+                EXTERNAL_SORT_TEST(true, LEN2);
+                EXTERNAL_SORT_TEST(true, LEN3);
+                std::cout << "\n";
+                std::cout << "|---------------------|-------------|-------------|-------------|\n";
+                PASSED;
+#endif
+                std::cout << "[------------- End container test : external_sort --------------]\n";
+            }
+
+#undef EXTERNAL_SORT_TEST
+
+        } // namespace external_sort_test
+    } // namespace test
+} // namespace tinySTL
+#endif // !MYTINYSTL_EXTERNAL_SORT_TEST_H_
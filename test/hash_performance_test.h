@@ -0,0 +1,88 @@
+//
+// Created by cqupt1811 on 2022/5/15.
+//
+
+#ifndef TINYSTL_HASH_PERFORMANCE_TEST_H
+#define TINYSTL_HASH_PERFORMANCE_TEST_H
+
+// 字节 hash 函数的吞吐测试：FNV-1a 与 wyhash 在不同键长下的比较
+
+#include "functional.h"
+#include "test.h"
+
+namespace tinySTL {
+    namespace test {
+        namespace hash_performance_test {
+
+// 对长度为 len 的键反复求 hash，共处理 total 字节，输出吞吐(MB/s)
+#define HASH_FUN_TEST(fun, len, total) do {                            \
+    const size_t buf_size = 1 << 16;                                    \
+    unsigned char *buf = new unsigned char[buf_size + (len)];           \
+    srand((int)time(0));                                                \
+    for (size_t i = 0; i < buf_size + (len); ++i)                       \
+        buf[i] = static_cast<unsigned char>(rand());                    \
+    size_t rounds = (total) / (len);                                    \
+    size_t sink = 0;                                                    \
+    clock_t start = clock();                                            \
+    for (size_t i = 0; i < rounds; ++i)                                 \
+        sink += fun(buf + ((i * 64) & (buf_size - 1)), (len));          \
+    clock_t end = clock();                                              \
+    volatile size_t keep = sink;                                        \
+    (void) keep;                                                        \
+    double sec = static_cast<double>(end - start) / CLOCKS_PER_SEC;     \
+    char out[24];                                                       \
+    std::snprintf(out, sizeof(out), "%.0f", sec > 0 ?                   \
+        static_cast<double>(rounds * (len)) / sec / (1 << 20) : 0.0);   \
+    std::string t = out;                                                \
+    t += "MB/s|";                                                       \
+    std::cout << std::setw(WIDE) << t;                                  \
+    delete []buf;                                                       \
+} while(0)
+
+#define HASH_ROW(fun, total) do {                                       \
+    HASH_FUN_TEST(fun, 4, total);                                       \
+    HASH_FUN_TEST(fun, 16, total);                                      \
+    HASH_FUN_TEST(fun, 64, total);                                      \
+    HASH_FUN_TEST(fun, 256, total);                                     \
+    HASH_FUN_TEST(fun, 1024, total);                                    \
+    HASH_FUN_TEST(fun, 4096, total);                                    \
+} while(0)
+
+            inline size_t wyhash_fun(const unsigned char *p, size_t n) {
+                return static_cast<size_t>(tinySTL::wyhash_bytes(p, n));
+            }
+
+            void byte_hash_test() {
+                const size_t total = LEN3 * 16;
+                std::cout << "[------------------ function : byte hash (MB/s) ----------------------------------------------]"
+                          << std::endl;
+                std::cout << "|   key length   |";
+                std::cout << std::setw(WIDE) << "4   |" << std::setw(WIDE) << "16   |"
+                          << std::setw(WIDE) << "64   |" << std::setw(WIDE) << "256   |"
+                          << std::setw(WIDE) << "1024   |" << std::setw(WIDE) << "4096   |" << std::endl;
+                std::cout << "|     fnv1a      |";
+                HASH_ROW(tinySTL::fnv1a_bytes, total);
+                std::cout << std::endl << "|     wyhash     |";
+                HASH_ROW(wyhash_fun, total);
+                std::cout << std::endl;
+            }
+
+#undef HASH_ROW
+#undef HASH_FUN_TEST
+
+            void hash_performance_test() {
+
+#if PERFORMANCE_TEST_ON
+                std::cout << "[===============================================================]" << std::endl;
+                std::cout << "[------------------ Run hash performance test ------------------]" << std::endl;
+                byte_hash_test();
+                std::cout << "[------------------ End hash performance test ------------------]" << std::endl;
+                std::cout << "[===============================================================]" << std::endl;
+#endif // PERFORMANCE_TEST_ON
+
+            }
+
+        } // namespace hash_performance_test
+    } // namespace test
+} // namespace tinySTL
+#endif //TINYSTL_HASH_PERFORMANCE_TEST_H
@@ -0,0 +1,126 @@
+#ifndef MYTINYSTL_ROPE_TEST_H_
+#define MYTINYSTL_ROPE_TEST_H_
+
+/*
+ * rope test : 测试 rope 的接口与在中间插入的性能
+ */
+
+#include <string>
+
+#include "rope.h"  /* 这个头文件包含一个模板类 rope */
+#include "test.h"  /* 一个简单的单元测试框架，定义了两个类 TestCase 和 UnitTest，以及一系列用于测试的宏 */
+
+namespace tinySTL
+{
+    namespace test
+    {
+        namespace rope_test
+        {
+
+// 每次在中间插入一段 64 个字符的片段
+#define ROPE_INSERT_TEST(mode, count) do {                   \
+  clock_t start, end;                                        \
+  mode c;                                                    \
+  char buf[10];                                              \
+  const char *frag =                                         \
+    "0123456789abcdefghijklmnopqrstuvwxyz0123456789abcdefghijklmnopqr"; \
+  start = clock();                                           \
+  for (size_t i = 0; i < count; ++i)                         \
+    c.insert(c.size() / 2, frag);                            \
+  end = clock();                                             \
+  int n = static_cast<int>(static_cast<double>(end - start)  \
+      / CLOCKS_PER_SEC * 1000);                              \
+  std::snprintf(buf, sizeof(buf), "%d", n);                  \
+  std::string t = buf;                                       \
+  t += "ms    |";                                            \
+  std::cout << std::setw(WIDE) << t;                         \
+} while(0)
+
+            void rope_test()
+            {
+                std::cout << "[===============================================================]\n";
+                std::cout << "[------------------ Run container test : rope ------------------]\n";
+                std::cout << "[-------------------------- API test ---------------------------]\n";
+                tinySTL::crope r1;
+                tinySTL::crope r2("hello");
+                tinySTL::crope r3("world wide web", 5);
+                tinySTL::crope r4(tinySTL::string("tiny"));
+                tinySTL::crope r5(3, 'x');
+                tinySTL::crope r6(r2);
+                tinySTL::crope r7(std::move(r6));
+                tinySTL::crope r8;
+                r8 = r3;
+
+                STR_FUN_AFTER(r1, r1.append(r2));
+                STR_FUN_AFTER(r1, r1 += ", ");
+                STR_FUN_AFTER(r1, r1 += r3);
+                STR_FUN_AFTER(r1, r1.push_back('!'));
+                STR_FUN_AFTER(r1, r1.prepend(r4));
+                STR_FUN_AFTER(r1, r1.insert(4, " "));
+                STR_FUN_AFTER(r1, r1.insert(r1.size(), r5));
+                STR_FUN_AFTER(r1, r1.erase(0, 5));
+                STR_FUN_AFTER(r1, r1.replace(7, 5, tinySTL::crope("rope")));
+                STR_FUN_AFTER(r1, r1.pop_back());
+                STR_COUT(r1.substr(7, 4));
+                STR_COUT(r1.substr(3));
+                STR_COUT((r2 + r8));
+                FUN_VALUE(r1[0]);
+                FUN_VALUE(r1.at(7));
+                FUN_VALUE(r1.front());
+                FUN_VALUE(r1.back());
+                FUN_VALUE(r1.size());
+                FUN_VALUE(r1.str());
+                std::cout << std::boolalpha;
+                FUN_VALUE(r1.empty());
+                FUN_VALUE((r7 == r2));
+                FUN_VALUE((r2 < r8));
+                std::cout << std::noboolalpha;
+                FUN_VALUE(r2.compare(r8));
+                tinySTL::crope big;
+                for (int i = 0; i < 10000; ++i)
+                    big += "fragment;";
+                FUN_VALUE(big.size());
+                FUN_VALUE(big.height());
+                FUN_VALUE(big.substr(big.size() - 18));
+                size_t chunks = 0;
+                for (auto it = big.chunk_begin(); it != big.chunk_end(); ++it)
+                    ++chunks;
+                FUN_VALUE(chunks);
+                // 插入、替换为自身
+                tinySTL::crope self("hello world");
+                STR_FUN_AFTER(self, self.insert(5, self));
+                tinySTL::crope self2("abcdef");
+                STR_FUN_AFTER(self2, self2.replace(1, 2, self2));
+                std::cout << std::boolalpha;
+                FUN_VALUE((self == tinySTL::crope("hellohello world world")));
+                FUN_VALUE((self2 == tinySTL::crope("aabcdefdef")));
+                std::cout << std::noboolalpha;
+                STR_FUN_AFTER(r2, r2.swap(r8));
+                STR_FUN_AFTER(r2, r2.clear());
+                PASSED;
+#if PERFORMANCE_TEST_ON
+                std::cout << "[--------------------- Performance Testing ---------------------]\n";
+                std::cout << "|---------------------|-------------|-------------|-------------|\n";
+                std::cout << "|    insert middle    |";
+                TEST_LEN(LEN1 / 100, LEN1 / 20, LEN1 / 5, WIDE);
+                std::cout << "|         std         |";
+                ROPE_INSERT_TEST(std::string, LEN1 / 100);
+                ROPE_INSERT_TEST(std::string, LEN1 / 20);
+                ROPE_INSERT_TEST(std::string, LEN1 / 5);
+                std::cout << "\n|        tinySTL        |";
+                ROPE_INSERT_TEST(tinySTL::crope, LEN1 / 100);
+                ROPE_INSERT_TEST(tinySTL::crope, LEN1 / 20);
+                ROPE_INSERT_TEST(tinySTL::crope, LEN1 / 5);
+                std::cout << "\n";
+                std::cout << "|---------------------|-------------|-------------|-------------|\n";
+                PASSED;
+#endif
+                std::cout << "[------------------ End container test : rope ------------------]\n";
+            }
+
+#undef ROPE_INSERT_TEST
+
+        } // namespace rope_test
+    } // namespace test
+} // namespace tinySTL
+#endif // !MYTINYSTL_ROPE_TEST_H_
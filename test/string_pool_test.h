@@ -0,0 +1,145 @@
+#ifndef MYTINYSTL_STRING_POOL_TEST_H_
+#define MYTINYSTL_STRING_POOL_TEST_H_
+
+/*
+ * string_pool test : 测试 string_pool 的接口、多线程并发驻留，以及重复字符串驻留的性能
+ */
+
+#include <string>
+#include <thread>
+#include <unordered_set>
+#include <vector>
+
+#include "string_pool.h"  /* 这个头文件包含一个模板类 basic_string_pool 与一个类 atom */
+#include "test.h"  /* 一个简单的单元测试框架，定义了两个类 TestCase 和 UnitTest，以及一系列用于测试的宏 */
+
+namespace tinySTL
+{
+    namespace test
+    {
+        namespace string_pool_test
+        {
+
+// 反复驻留 count 个只有 1000 种取值的标签
+#define POOL_INTERN_TEST(mode, fun, count) do {              \
+  clock_t start, end;                                        \
+  mode c;                                                    \
+  char buf[32];                                              \
+  start = clock();                                           \
+  for (size_t i = 0; i < count; ++i) {                       \
+    std::snprintf(buf, sizeof(buf), "label.%d", (int)(i % 1000)); \
+    c.fun(buf);                                              \
+  }                                                          \
+  end = clock();                                             \
+  int n = static_cast<int>(static_cast<double>(end - start)  \
+      / CLOCKS_PER_SEC * 1000);                              \
+  std::snprintf(buf, sizeof(buf), "%d", n);                  \
+  std::string t = buf;                                       \
+  t += "ms    |";                                            \
+  std::cout << std::setw(WIDE) << t;                         \
+} while(0)
+
+            void string_pool_test()
+            {
+                std::cout << "[===============================================================]\n";
+                std::cout << "[--------------- Run container test : string_pool --------------]\n";
+                std::cout << "[-------------------------- API test ---------------------------]\n";
+                tinySTL::string_pool pool;
+                tinySTL::atom a1 = pool.intern("cpu.usage");
+                tinySTL::atom a2 = pool.intern(tinySTL::string("cpu.usage"));
+                tinySTL::atom a3 = pool.intern(tinySTL::string_view("mem.free"));
+                tinySTL::atom a4 = pool.find("mem.free");
+                tinySTL::atom a5 = pool.find("disk.io");
+                const char *labels[] = {"host", "region", "host", "cpu.usage"};
+                tinySTL::atom bulk[4];
+                pool.intern_bulk(labels, labels + 4, bulk);
+
+                FUN_VALUE(a1.id);
+                FUN_VALUE(a3.id);
+                std::cout << std::boolalpha;
+                FUN_VALUE((a1 == a2));
+                FUN_VALUE((a1 != a3));
+                FUN_VALUE((a3 == a4));
+                FUN_VALUE(a5.valid());
+                FUN_VALUE((bulk[0] == bulk[2]));
+                FUN_VALUE((bulk[3] == a1));
+                std::cout << std::noboolalpha;
+                FUN_VALUE(bulk[1].id);
+                FUN_VALUE(pool.view(a3));
+                FUN_VALUE(pool.c_str(bulk[1]));
+                FUN_VALUE(pool.length(a1));
+                FUN_VALUE(pool.size());
+                FUN_VALUE(tinySTL::hash<tinySTL::atom>()(a3));
+
+                // 多个线程驻留有重叠的字符串，同时查找已经驻留的字符串
+                const int threads = 4, per_thread = 3000, distinct = 5000;
+                tinySTL::string_pool shared;
+                std::vector<std::vector<tinySTL::atom>> got(threads);
+                std::vector<int> lookup_errors(threads, 0);
+                std::vector<std::thread> workers;
+                for (int t = 0; t < threads; ++t) {
+                    workers.emplace_back([&, t]() {
+                        for (int i = 0; i < per_thread; ++i) {
+                            const std::string s = "tag." + std::to_string((t * 1000 + i * 7) % distinct);
+                            const tinySTL::atom a = shared.intern(s.c_str());
+                            got[t].push_back(a);
+                            if (shared.find(s.c_str()) != a ||
+                                shared.view(a) != tinySTL::string_view(s.data(), s.size())) {
+                                ++lookup_errors[t];
+                            }
+                        }
+                    });
+                }
+                for (auto &w : workers) w.join();
+                std::vector<tinySTL::atom> by_key(distinct);
+                std::unordered_set<std::string> keys;
+                bool same_atom = true;
+                int errors = 0;
+                for (int t = 0; t < threads; ++t) {
+                    errors += lookup_errors[t];
+                    for (int i = 0; i < per_thread; ++i) {
+                        const int key = (t * 1000 + i * 7) % distinct;
+                        keys.insert("tag." + std::to_string(key));
+                        if (!by_key[key].valid()) {
+                            by_key[key] = got[t][i];
+                        }
+                        same_atom = same_atom && by_key[key] == got[t][i];
+                    }
+                }
+                std::unordered_set<tinySTL::atom::id_type> ids;
+                for (const auto &a : by_key) {
+                    if (a.valid()) ids.insert(a.id);
+                }
+                std::cout << std::boolalpha;
+                FUN_VALUE(same_atom);
+                FUN_VALUE((errors == 0));
+                FUN_VALUE((ids.size() == keys.size()));
+                FUN_VALUE((shared.size() == keys.size()));
+                std::cout << std::noboolalpha;
+                PASSED;
+#if PERFORMANCE_TEST_ON
+                std::cout << "[--------------------- Performance Testing ---------------------]\n";
+                std::cout << "|---------------------|-------------|-------------|-------------|\n";
+                std::cout << "|       intern        |";
+                TEST_LEN(LEN1, LEN2, LEN3, WIDE);
+                std::cout << "|         std         |";
+                POOL_INTERN_TEST(std::unordered_set<std::string>, insert, LEN1);
+                POOL_INTERN_TEST(std::unordered_set<std::string>, insert, LEN2);
+                POOL_INTERN_TEST(std::unordered_set<std::string>, insert, LEN3);
+                std::cout << "\n|        tinySTL        |";
+                POOL_INTERN_TEST(tinySTL::string_pool, intern, LEN1);
+                POOL_INTERN_TEST(tinySTL::string_pool, intern, LEN2);
+                POOL_INTERN_TEST(tinySTL::string_pool, intern, LEN3);
+                std::cout << "\n";
+                std::cout << "|---------------------|-------------|-------------|-------------|\n";
+                PASSED;
+#endif
+                std::cout << "[--------------- End container test : string_pool --------------]\n";
+            }
+
+#undef POOL_INTERN_TEST
+
+        } // namespace string_pool_test
+    } // namespace test
+} // namespace tinySTL
+#endif // !MYTINYSTL_STRING_POOL_TEST_H_
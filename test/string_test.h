@@ -1,9 +1,16 @@
 ﻿#ifndef MYTINYSTL_STRING_TEST_H_
 #define MYTINYSTL_STRING_TEST_H_
 
-// string test : 测试 string 的接口和 insert 的性能
+// string test : 测试 string 与 string_view 的接口、数值转换与切分，以及 append、getline、to_chars、split 的性能
 
+#include <codecvt>
+#include <cstdio>
+#include <fstream>
+#include <locale>
+#include <sstream>
+#include <streambuf>
 #include <string>
+#include <vector>
 
 #include "astring.h"
 #include "test.h"
@@ -12,6 +19,285 @@ namespace tinySTL {
     namespace test {
         namespace string_test {
 
+// 逐行读取 lines 行的临时文件，统计读到的字符数
+#define GETLINE_TEST(mode, lines) do {                          \
+  const char *path = "tinystl_getline_test.txt";                \
+  make_line_file(path, lines);                                  \
+  clock_t start, end;                                           \
+  size_t total = 0;                                             \
+  char buf[16];                                                 \
+  start = clock();                                              \
+  {                                                             \
+    std::ifstream in(path);                                     \
+    mode line;                                                  \
+    while (getline(in, line))                                   \
+      total += line.size();                                     \
+  }                                                             \
+  end = clock();                                                \
+  std::remove(path);                                            \
+  volatile size_t keep = total;                                 \
+  (void) keep;                                                  \
+  int n = static_cast<int>(static_cast<double>(end - start)     \
+      / CLOCKS_PER_SEC * 1000);                                 \
+  std::snprintf(buf, sizeof(buf), "%d", n);                     \
+  std::string t = buf;                                          \
+  t += "ms    |";                                               \
+  std::cout << std::setw(WIDE) << t;                            \
+} while(0)
+
+            /*
+             * 生成 lines 行长度在 16 ~ 143 之间的日志样式文本
+             */
+            inline void make_line_file(const char *path, size_t lines) {
+                std::ofstream out(path);
+                std::string line;
+                for (size_t i = 0; i < lines; ++i) {
+                    line.assign(16 + i * 2654435761u % 128, 'a' + static_cast<char>(i % 26));
+                    out << line << '\n';
+                }
+            }
+
+            /*
+             * find_*_of 的朴素实现，查找范围为 [pos, size())，找不到时返回 npos
+             */
+            template<typename Str>
+            size_t naive_find_of(const Str &str, const Str &set, size_t pos, bool last, bool member) {
+                size_t result = Str::npos;
+                for (size_t i = pos; i < str.size(); ++i) {
+                    bool in = false;
+                    for (size_t j = 0; j < set.size(); ++j) {
+                        in = in || set[j] == str[i];
+                    }
+                    if (in == member) {
+                        result = i;
+                        if (!last) {
+                            break;
+                        }
+                    }
+                }
+                return result;
+            }
+
+            /*
+             * 位图分类的 find_*_of 与朴素实现比较：长度跨过 32 字节的 AVX2 分块，字符包括 >= 0x80 的字节，
+             * 字符集合包括空集合，pos 包括 size() 以及超过 size() 的位置
+             */
+            TEST(find_of_test) {
+                const char alphabet[] = {'a', 'b', 'c', ' ', ',', '\0', '\x7f', '\x80', '\xa5', '\xff'};
+                const size_t lens[] = {0, 1, 7, 31, 32, 33, 63, 64, 65, 100, 257};
+                std::vector<size_t> exp[4], act[4];
+                unsigned seed = 12345;
+                auto next = [&seed]() {
+                    seed = seed * 1103515245u + 12345u;
+                    return (seed >> 16) % sizeof(alphabet);
+                };
+                for (size_t len : lens) {
+                    for (size_t set_len = 0; set_len <= 4; ++set_len) {
+                        tinySTL::string str, set;
+                        for (size_t i = 0; i < len; ++i) str.push_back(alphabet[next()]);
+                        for (size_t i = 0; i < set_len; ++i) set.push_back(alphabet[next()]);
+                        const size_t poss[] = {0, 1, len / 2, len == 0 ? 0 : len - 1, len, len + 1, len + 100};
+                        for (size_t pos : poss) {
+                            exp[0].push_back(naive_find_of(str, set, pos, false, true));
+                            exp[1].push_back(naive_find_of(str, set, pos, false, false));
+                            exp[2].push_back(naive_find_of(str, set, pos, true, true));
+                            exp[3].push_back(naive_find_of(str, set, pos, true, false));
+                            act[0].push_back(str.find_first_of(set, pos));
+                            act[1].push_back(str.find_first_not_of(set, pos));
+                            act[2].push_back(str.find_last_of(set, pos));
+                            act[3].push_back(str.find_last_not_of(set, pos));
+                        }
+                    }
+                }
+                EXPECT_CON_EQ(exp[0], act[0]);
+                EXPECT_CON_EQ(exp[1], act[1]);
+                EXPECT_CON_EQ(exp[2], act[2]);
+                EXPECT_CON_EQ(exp[3], act[3]);
+
+                // 40 个字符，命中位置在第二个 32 字节分块中
+                tinySTL::string str(40, 'x');
+                str[35] = '\xe9';
+                str[38] = ',';
+                tinySTL::string high("\xe9\xff");
+                EXPECT_EQ(35u, str.find_first_of(high));
+                EXPECT_EQ(38u, str.find_first_of(",\xe9", 36));
+                EXPECT_EQ(35u, str.find_last_of(high));
+                EXPECT_EQ(35u, str.find_first_not_of("x"));
+                EXPECT_EQ(39u, str.find_last_not_of("\xe9,"));
+                EXPECT_EQ(tinySTL::string::npos, str.find_first_of(""));
+                EXPECT_EQ(tinySTL::string::npos, str.find_last_of(""));
+                EXPECT_EQ(3u, str.find_first_not_of("", 3));
+                EXPECT_EQ(39u, str.find_last_not_of(""));
+                EXPECT_EQ(tinySTL::string::npos, str.find_first_of("x", str.size()));
+                EXPECT_EQ(tinySTL::string::npos, str.find_first_not_of(",", str.size() + 1));
+                EXPECT_EQ(tinySTL::string::npos, str.find_last_of("x", str.size()));
+                EXPECT_EQ(tinySTL::string::npos, str.find_last_not_of(",", str.size() + 1));
+
+                // 宽字符：集合中的字符 >= 256 时不使用位图
+                tinySTL::wstring wstr(50, L'a');
+                wstr[40] = static_cast<wchar_t>(0x4e2d);
+                wstr[45] = static_cast<wchar_t>(0x0161);
+                EXPECT_EQ(40u, wstr.find_first_of(L"\x4e2d\x0161"));
+                EXPECT_EQ(45u, wstr.find_last_of(L"\x4e2d\x0161"));
+                EXPECT_EQ(45u, wstr.find_last_not_of(L"a"));
+                EXPECT_EQ(tinySTL::wstring::npos, wstr.find_first_of(L"\x0100", 41));
+            }
+
+            /*
+             * 空字符串作为查找目标：basic_string 与 basic_string_view 的所有 find 重载都在 pos <= size() 时返回 pos
+             */
+            TEST(empty_needle_find_test) {
+                const tinySTL::string str("abc");
+                const tinySTL::string_view view(str);
+                const tinySTL::string empty_str;
+                const tinySTL::string_view empty_view;
+                const size_t npos = tinySTL::string::npos;
+                const size_t poss[] = {0, 1, 3, 4, npos};
+                for (size_t pos : poss) {
+                    const size_t exp = pos <= str.size() ? pos : npos;
+                    EXPECT_EQ(exp, str.find("", pos));
+                    EXPECT_EQ(exp, str.find("xyz", pos, 0));
+                    EXPECT_EQ(exp, str.find(empty_str, pos));
+                    EXPECT_EQ(exp, str.find(empty_view, pos));
+                    EXPECT_EQ(exp, view.find("", pos));
+                    EXPECT_EQ(exp, view.find("xyz", pos, 0));
+                    EXPECT_EQ(exp, view.find(empty_view, pos));
+                }
+                EXPECT_EQ(0u, empty_str.find(""));
+                EXPECT_EQ(0u, empty_view.find(""));
+                EXPECT_EQ(npos, empty_str.find("", 1));
+            }
+
+            /*
+             * 每次只向读缓冲区提供 chunk 个字符的 streambuf，chunk 为 0 时没有读缓冲区，只能逐个字符读取
+             */
+            class chunked_buf : public std::streambuf {
+            public:
+                chunked_buf(const std::string &text, size_t chunk) : text_(text), chunk_(chunk), next_(0) {
+                    setg(nullptr, nullptr, nullptr);
+                }
+
+            protected:
+                int_type underflow() override {
+                    if (next_ == text_.size()) {
+                        return traits_type::eof();
+                    }
+                    if (chunk_ == 0) {
+                        return traits_type::to_int_type(text_[next_]);
+                    }
+                    char *p = &text_[next_];
+                    const size_t n = std::min(chunk_, text_.size() - next_);
+                    next_ += n;
+                    setg(p, p, p + n);
+                    return traits_type::to_int_type(*p);
+                }
+
+                int_type uflow() override {
+                    if (chunk_ != 0) {
+                        return std::streambuf::uflow();
+                    }
+                    if (next_ == text_.size()) {
+                        return traits_type::eof();
+                    }
+                    return traits_type::to_int_type(text_[next_++]);
+                }
+
+            private:
+                std::string text_;
+                size_t chunk_;
+                size_t next_;
+            };
+
+            inline std::string to_std(const tinySTL::string &s) {
+                return std::string(s.data(), s.size());
+            }
+
+            /*
+             * 通过 streambuf 批量读写的 operator>>、getline 与 operator<<，结果与 std::string 比较
+             */
+            TEST(string_stream_io_test) {
+                // operator>>：前导空白、width() 限制、最后一个单词之后直接是文件尾
+                std::istringstream words(" \t\n hello  world\tfoo");
+                tinySTL::string w;
+                words >> w;
+                EXPECT_EQ(std::string("hello"), to_std(w));
+                words >> w;
+                EXPECT_EQ(std::string("world"), to_std(w));
+                words >> w;
+                EXPECT_EQ(std::string("foo"), to_std(w));
+                EXPECT_TRUE(words.eof() && !words.fail());
+                words >> w;
+                EXPECT_TRUE(words.fail());
+                std::istringstream limited("abcdefg hi");
+                limited >> std::setw(3) >> w;
+                EXPECT_EQ(std::string("abc"), to_std(w));
+                EXPECT_EQ(0, limited.width());
+                limited >> w;
+                EXPECT_EQ(std::string("defg"), to_std(w));
+                std::istringstream blank("   ");
+                blank >> w;
+                EXPECT_TRUE(blank.fail() && blank.eof());
+
+                // getline：自定义分隔符，空的最后一行
+                std::istringstream fields("a;b;;c;");
+                std::vector<std::string> got;
+                while (tinySTL::getline(fields, w, ';')) got.push_back(to_std(w));
+                const std::vector<std::string> exp_fields = {"a", "b", "", "c"};
+                EXPECT_CON_EQ(exp_fields, got);
+                std::istringstream lines("x\n\ny");
+                got.clear();
+                while (tinySTL::getline(lines, w)) got.push_back(to_std(w));
+                const std::vector<std::string> exp_lines = {"x", "", "y"};
+                EXPECT_CON_EQ(exp_lines, got);
+                std::istringstream empty_last("x\n\n");
+                got.clear();
+                while (tinySTL::getline(empty_last, w)) got.push_back(to_std(w));
+                const std::vector<std::string> exp_empty_last = {"x", ""};
+                EXPECT_CON_EQ(exp_empty_last, got);
+
+                // 比读缓冲区长的行与单词，以及没有读缓冲区的 streambuf
+                std::string text;
+                for (int i = 0; i < 3000; ++i) {
+                    text += static_cast<char>('a' + i % 26);
+                    if (i % 97 == 0) text += ' ';
+                    if (i % 501 == 0) text += '\n';
+                }
+                text += std::string(20000, 'z') + "\n\n  tail";
+                const size_t chunks[] = {0, 1, 7, 4096};
+                for (size_t chunk : chunks) {
+                    std::istringstream exp_in(text);
+                    chunked_buf buf(text, chunk);
+                    std::istream act_in(&buf);
+                    std::vector<std::string> exp, act;
+                    for (std::string line; std::getline(exp_in, line);) exp.push_back(line);
+                    while (tinySTL::getline(act_in, w)) act.push_back(to_std(w));
+                    EXPECT_CON_EQ(exp, act);
+                    EXPECT_TRUE(act_in.eof());
+                    std::istringstream exp_words(text);
+                    chunked_buf buf2(text, chunk);
+                    std::istream act_words(&buf2);
+                    exp.clear();
+                    act.clear();
+                    for (std::string word; exp_words >> word;) exp.push_back(word);
+                    while (act_words >> w) act.push_back(to_std(w));
+                    EXPECT_CON_EQ(exp, act);
+                }
+
+                // operator<<：setw、left/right 与 fill
+                std::ostringstream exp_out, act_out;
+                const std::string ss("abc");
+                const tinySTL::string ts("abc");
+                exp_out << std::setw(7) << ss << '|' << std::left << std::setfill('*') << std::setw(6) << ss
+                        << '|' << std::right << std::setw(5) << ss << '|' << std::setw(2) << ss << '|' << ss;
+                act_out << std::setw(7) << ts << '|' << std::left << std::setfill('*') << std::setw(6) << ts
+                        << '|' << std::right << std::setw(5) << ts << '|' << std::setw(2) << ts << '|' << ts;
+                EXPECT_EQ(exp_out.str(), act_out.str());
+                std::ostringstream view_out;
+                view_out << std::setfill('.') << std::left << std::setw(6) << tinySTL::string_view(ts);
+                EXPECT_EQ(std::string("abc..."), view_out.str());
+                EXPECT_EQ(0, view_out.width());
+            }
+
             void string_test() {
                 std::cout << "[===============================================================]" << std::endl;
                 std::cout << "[----------------- Run container test : string -----------------]" << std::endl;
@@ -123,6 +409,7 @@ namespace tinySTL {
                 FUN_VALUE(str.rfind("bc", 10));
                 FUN_VALUE(str.rfind(str3));
                 FUN_VALUE(str.rfind(str3, 3));
+                FUN_VALUE(str.rfind("bcx", 10, 2));
                 FUN_VALUE(str.find_first_of('g'));
                 FUN_VALUE(str.find_first_of('k'));
                 FUN_VALUE(str.find_first_of("bca"));
@@ -159,6 +446,19 @@ namespace tinySTL {
                 FUN_VALUE(str.count('a', 2));
                 FUN_VALUE(str.count('d', 10));
 
+                tinySTL::wstring wstr(L"abcdefghijklmnopqrstuvwxyz0123456789");
+                tinySTL::u16string u16str(u"abcdefghijklmnopqrstuvwxyz0123456789");
+                tinySTL::u32string u32str(U"abcdefghijklmnopqrstuvwxyz0123456789");
+                FUN_VALUE(wstr.size());
+                FUN_VALUE(wstr.find(L'9'));
+                FUN_VALUE(wstr.find(L'#'));
+                FUN_VALUE(u16str.size());
+                FUN_VALUE(u16str.find(u'z', 3));
+                FUN_VALUE(u16str.compare(u"abcdefghijklmnopqrstuvwxyz0123456780"));
+                FUN_VALUE(u32str.size());
+                FUN_VALUE(u32str.find(U'a', 1));
+                FUN_VALUE(u32str.compare(U"abcdefghijklmnopqrstuvwxyz0123456789"));
+
                 STR_FUN_AFTER(str, str.swap(str3));
                 FUN_VALUE(str.size());
                 FUN_VALUE(str.length());
@@ -190,6 +490,18 @@ namespace tinySTL {
 #else
                 CON_TEST_P1(string, append, "s", LEN1 _L, LEN2 _L, LEN3 _L);
 #endif
+                std::cout << std::endl;
+                std::cout << "|---------------------|-------------|-------------|-------------|" << std::endl;
+                std::cout << "|       getline       |";
+                TEST_LEN(LEN1, LEN2, LEN3, WIDE);
+                std::cout << "|         std         |";
+                GETLINE_TEST(std::string, LEN1);
+                GETLINE_TEST(std::string, LEN2);
+                GETLINE_TEST(std::string, LEN3);
+                std::cout << std::endl << "|        tinySTL        |";
+                GETLINE_TEST(tinySTL::string, LEN1);
+                GETLINE_TEST(tinySTL::string, LEN2);
+                GETLINE_TEST(tinySTL::string, LEN3);
                 std::cout << std::endl;
                 std::cout << "|---------------------|-------------|-------------|-------------|" << std::endl;
                 PASSED;
@@ -197,6 +509,408 @@ namespace tinySTL {
                 std::cout << "[----------------- End container test : string -----------------]" << std::endl;
             }
 
+            void string_view_test() {
+                std::cout << "[===============================================================]" << std::endl;
+                std::cout << "[-------------- Run container test : string_view ---------------]" << std::endl;
+                std::cout << "[-------------------------- API test ---------------------------]" << std::endl;
+                tinySTL::string str("name,age,city;alice,30,paris");
+                tinySTL::string_view sv1;
+                tinySTL::string_view sv2("abcdefg");
+                tinySTL::string_view sv3("abcdefg", 3);
+                tinySTL::string_view sv4(str);
+                tinySTL::string_view sv5(sv4);
+
+                STR_COUT(sv2);
+                STR_COUT(sv3);
+                STR_COUT(sv5);
+                std::cout << std::boolalpha;
+                FUN_VALUE(sv1.empty());
+                FUN_VALUE(sv2.starts_with("abc"));
+                FUN_VALUE(sv2.ends_with('g'));
+                FUN_VALUE((sv4 == str));
+                FUN_VALUE((sv2 < sv3));
+                std::cout << std::noboolalpha;
+                FUN_VALUE(sv2.size());
+                FUN_VALUE(sv2.front());
+                FUN_VALUE(sv2.back());
+                FUN_VALUE(sv2[3]);
+                FUN_VALUE(sv2.at(4));
+                FUN_VALUE(sv4.substr(5, 3));
+                FUN_VALUE(sv4.substr(sv4.find(';') + 1));
+                FUN_VALUE(sv4.find("city"));
+                FUN_VALUE(sv4.find(',', 5));
+                FUN_VALUE(sv4.rfind(','));
+                FUN_VALUE(sv4.rfind("age", 3));
+                FUN_VALUE(sv4.find_first_of(";,"));
+                FUN_VALUE(sv4.find_first_not_of("name"));
+                FUN_VALUE(sv4.find_last_of(";,", 10));
+                FUN_VALUE(sv4.find_last_not_of("sirap"));
+                FUN_VALUE(sv2.compare(sv3));
+                FUN_VALUE(sv3.compare("abc"));
+                FUN_VALUE(sv2.compare(0, 3, sv3));
+                STR_FUN_AFTER(sv5, sv5.remove_prefix(5));
+                STR_FUN_AFTER(sv5, sv5.remove_suffix(6));
+                STR_FUN_AFTER(sv2, sv2.swap(sv3));
+
+                tinySTL::string str1(sv5);
+                STR_COUT(str1);
+                tinySTL::string from_empty(sv1);  // 默认构造的视图 data() 为空指针
+                from_empty.append(sv1);
+                FUN_VALUE(from_empty.size());
+                FUN_VALUE(from_empty.compare(sv1));
+                std::cout << std::boolalpha;
+                FUN_VALUE((tinySTL::hash<tinySTL::string_view>()(sv5) == tinySTL::hash<tinySTL::string>()(str1)));
+                std::cout << std::noboolalpha;
+                STR_FUN_AFTER(str1, str1.append(sv2));
+                STR_FUN_AFTER(str1, str1 += sv5.substr(0, 3));
+                STR_FUN_AFTER(str1, str1.replace(0, 3, sv2));
+                FUN_VALUE(str1.find(sv2, 1));
+                FUN_VALUE(str1.find(tinySTL::string_view(""), 1));
+                FUN_VALUE(tinySTL::string_view(str1).find(tinySTL::string_view(""), 1));
+                std::cout << std::boolalpha;
+                FUN_VALUE((str1.find(tinySTL::string_view(""), 1) ==
+                           tinySTL::string_view(str1).find(tinySTL::string_view(""), 1)));
+                FUN_VALUE((str1.find(tinySTL::string_view(""), str1.size() + 1) == tinySTL::string::npos));
+                FUN_VALUE((sv2 == "abc"));
+                FUN_VALUE(("abc" == sv2));
+                FUN_VALUE((sv2 != "abd"));
+                FUN_VALUE((sv2 < "abd" && "abd" > sv2));
+                FUN_VALUE((sv2 <= "abc" && "abc" >= sv2));
+                std::cout << std::noboolalpha;
+                FUN_VALUE(str1.compare(sv3));
+                FUN_VALUE(str1.compare(0, 3, sv2));
+                PASSED;
+                std::cout << "[-------------- End container test : string_view ---------------]" << std::endl;
+            }
+
+// 把 count 个数值格式化到同一个缓冲区，conv(out, value(i)) 返回写入的长度
+#define TO_CHARS_TEST(conv, value, count) do {                  \
+  clock_t start, end;                                           \
+  size_t total = 0;                                             \
+  char out[64], buf[16];                                        \
+  start = clock();                                              \
+  for (size_t i = 0; i < count; ++i)                            \
+    total += conv(out, value(i));                               \
+  end = clock();                                                \
+  volatile size_t keep = total;                                 \
+  (void) keep;                                                  \
+  int n = static_cast<int>(static_cast<double>(end - start)     \
+      / CLOCKS_PER_SEC * 1000);                                 \
+  std::snprintf(buf, sizeof(buf), "%d", n);                     \
+  std::string t = buf;                                          \
+  t += "ms    |";                                               \
+  std::cout << std::setw(WIDE) << t;                            \
+} while(0)
+
+            inline long long int_value(size_t i) {
+                return static_cast<long long>(i * 2654435761u % 1000000007) - 500000000;
+            }
+
+            inline double double_value(size_t i) {
+                return static_cast<double>(int_value(i)) / 1024.0 + 0.1;
+            }
+
+            inline size_t snprintf_int(char *out, long long v) {
+                return static_cast<size_t>(std::snprintf(out, 64, "%lld", v));
+            }
+
+            // %.17g 总能往返，但不一定是最短的
+            inline size_t snprintf_double(char *out, double v) {
+                return static_cast<size_t>(std::snprintf(out, 64, "%.17g", v));
+            }
+
+            template<typename Value>
+            inline size_t to_chars_value(char *out, Value v) {
+                return static_cast<size_t>(tinySTL::to_chars(out, out + 64, v).ptr - out);
+            }
+
+            void string_conversion_test() {
+                std::cout << "[===============================================================]" << std::endl;
+                std::cout << "[----------- Run container test : string conversion ------------]" << std::endl;
+                std::cout << "[-------------------------- API test ---------------------------]" << std::endl;
+                char buf[64];
+                tinySTL::to_chars_result res = tinySTL::to_chars(buf, buf + sizeof(buf), -1234567);
+                FUN_VALUE(std::string(buf, res.ptr));
+                res = tinySTL::to_chars(buf, buf + sizeof(buf), 255u, 16);
+                FUN_VALUE(std::string(buf, res.ptr));
+                res = tinySTL::to_chars(buf, buf + sizeof(buf), 0.3);
+                FUN_VALUE(std::string(buf, res.ptr));
+                res = tinySTL::to_chars(buf, buf + sizeof(buf), 1e-7);
+                FUN_VALUE(std::string(buf, res.ptr));
+                res = tinySTL::to_chars(buf, buf + 3, 123456);
+                std::cout << std::boolalpha;
+                FUN_VALUE((res.ec == std::errc::value_too_large));
+                std::cout << std::noboolalpha;
+                int iv = 0;
+                const char *digits = "42abc";
+                tinySTL::from_chars_result fres = tinySTL::from_chars(digits, digits + 5, iv);
+                FUN_VALUE(iv);
+                FUN_VALUE(fres.ptr - digits);
+                FUN_VALUE(tinySTL::to_string(2022));
+                FUN_VALUE(tinySTL::to_string(-9223372036854775807LL - 1));
+                FUN_VALUE(tinySTL::to_string(18446744073709551615ULL));
+                FUN_VALUE(tinySTL::to_string(0.1));
+                FUN_VALUE(tinySTL::to_string(1.0 / 3));
+                FUN_VALUE(tinySTL::to_string(1e300));
+                FUN_VALUE(tinySTL::to_string(1.5f));
+                FUN_VALUE(tinySTL::to_string(-0.0));
+                size_t idx = 0;
+                FUN_VALUE(tinySTL::stoi(tinySTL::string("  -17kg"), &idx));
+                FUN_VALUE(idx);
+                FUN_VALUE(tinySTL::stol(tinySTL::string("0x1f"), nullptr, 16));
+                FUN_VALUE(tinySTL::stoll(tinySTL::string("0777"), nullptr, 0));
+                FUN_VALUE(tinySTL::stoul(tinySTL::string("4294967295")));
+                FUN_VALUE(tinySTL::stoull(tinySTL::string("18446744073709551615")));
+                FUN_VALUE(tinySTL::stod(tinySTL::string("3.25e2")));
+                FUN_VALUE(tinySTL::stof(tinySTL::string("0.5")));
+                std::cout << std::boolalpha;
+                FUN_VALUE((tinySTL::stod(tinySTL::to_string(0.1)) == 0.1));
+                std::cout << std::noboolalpha;
+                PASSED;
+#if PERFORMANCE_TEST_ON
+                std::cout << "[--------------------- Performance Testing ---------------------]" << std::endl;
+                std::cout << "|---------------------|-------------|-------------|-------------|" << std::endl;
+                std::cout << "|   to_chars(int)     |";
+                TEST_LEN(LEN1, LEN2, LEN3, WIDE);
+                std::cout << "|      snprintf       |";
+                TO_CHARS_TEST(snprintf_int, int_value, LEN1);
+                TO_CHARS_TEST(snprintf_int, int_value, LEN2);
+                TO_CHARS_TEST(snprintf_int, int_value, LEN3);
+                std::cout << std::endl << "|        tinySTL        |";
+                TO_CHARS_TEST(to_chars_value<long long>, int_value, LEN1);
+                TO_CHARS_TEST(to_chars_value<long long>, int_value, LEN2);
+                TO_CHARS_TEST(to_chars_value<long long>, int_value, LEN3);
+                std::cout << std::endl;
+                std::cout << "|---------------------|-------------|-------------|-------------|" << std::endl;
+                std::cout << "|  to_chars(double)   |";
+                TEST_LEN(LEN1, LEN2, LEN3, WIDE);
+                std::cout << "|   snprintf(%.17g)   |";
+                TO_CHARS_TEST(snprintf_double, double_value, LEN1);
+                TO_CHARS_TEST(snprintf_double, double_value, LEN2);
+                TO_CHARS_TEST(snprintf_double, double_value, LEN3);
+                std::cout << std::endl << "|        tinySTL        |";
+                TO_CHARS_TEST(to_chars_value<double>, double_value, LEN1);
+                TO_CHARS_TEST(to_chars_value<double>, double_value, LEN2);
+                TO_CHARS_TEST(to_chars_value<double>, double_value, LEN3);
+                std::cout << std::endl;
+                std::cout << "|---------------------|-------------|-------------|-------------|" << std::endl;
+                PASSED;
+#endif
+                std::cout << "[----------- End container test : string conversion ------------]" << std::endl;
+            }
+
+// 把一段 UTF-8 文本转换为 UTF-16，conv(text) 返回结果的长度
+#define UTF_CONVERT_TEST(conv, text) do {                       \
+  clock_t start, end;                                           \
+  char buf[16];                                                 \
+  start = clock();                                              \
+  volatile size_t keep = conv(text);                            \
+  end = clock();                                                \
+  (void) keep;                                                  \
+  int n = static_cast<int>(static_cast<double>(end - start)     \
+      / CLOCKS_PER_SEC * 1000);                                 \
+  std::snprintf(buf, sizeof(buf), "%d", n);                     \
+  std::string t = buf;                                          \
+  t += "ms    |";                                               \
+  std::cout << std::setw(WIDE) << t;                            \
+} while(0)
+
+            // 长度约为 bytes 的混合文本：大部分是 ASCII，夹杂 2、3、4 字节的字符
+            inline std::string make_utf8_text(size_t bytes) {
+                const char *pieces[] = {"tinySTL string ", "caf\xC3\xA9 ", "\xE4\xB8\xAD\xE6\x96\x87 ",
+                                        "emoji \xF0\x9F\x98\x80 ", "plain ascii words "};
+                std::string text;
+                text.reserve(bytes + 32);
+                for (size_t i = 0; text.size() < bytes; ++i)
+                    text += pieces[i * 2654435761u % 5];
+                return text;
+            }
+
+            inline size_t codecvt_utf8_to_utf16(const std::string &text) {
+                std::wstring_convert<std::codecvt_utf8_utf16<char16_t>, char16_t> conv;
+                return conv.from_bytes(text).size();
+            }
+
+            inline size_t tinystl_utf8_to_utf16(const std::string &text) {
+                return tinySTL::utf8_to_utf16(tinySTL::string_view(text.data(), text.size())).size();
+            }
+
+            void utf_test() {
+                std::cout << "[===============================================================]" << std::endl;
+                std::cout << "[------------------- Run container test : utf ------------------]" << std::endl;
+                std::cout << "[-------------------------- API test ---------------------------]" << std::endl;
+                const char text[] = "tiny\xE4\xB8\xAD\xE6\x96\x87 caf\xC3\xA9 \xF0\x9F\x98\x80!";
+                const size_t len = sizeof(text) - 1;
+                const char bad[] = "abc\xE4\xB8 def";
+                std::cout << std::boolalpha;
+                FUN_VALUE(tinySTL::utf8_validate(text, len));
+                FUN_VALUE(tinySTL::utf8_validate(bad, sizeof(bad) - 1));
+                std::cout << std::noboolalpha;
+                FUN_VALUE(tinySTL::utf8_find_invalid(bad, sizeof(bad) - 1));
+                FUN_VALUE(tinySTL::utf16_length_from_utf8(text, len));
+                FUN_VALUE(tinySTL::utf32_length_from_utf8(text, len));
+                tinySTL::u16string u16 = tinySTL::utf8_to_utf16(tinySTL::string_view(text, len));
+                tinySTL::u32string u32 = tinySTL::utf8_to_utf32(tinySTL::string_view(text, len));
+                FUN_VALUE(u16.size());
+                FUN_VALUE(u32.size());
+                FUN_VALUE(static_cast<unsigned>(u16[4]));
+                FUN_VALUE(static_cast<unsigned>(u32[u32.size() - 2]));
+                FUN_VALUE(tinySTL::utf8_length_from_utf16(u16.data(), u16.size()));
+                FUN_VALUE(tinySTL::utf8_length_from_utf32(u32.data(), u32.size()));
+                tinySTL::string back = tinySTL::utf16_to_utf8(tinySTL::u16string_view(u16.data(), u16.size()));
+                std::cout << std::boolalpha;
+                FUN_VALUE((back == tinySTL::string(text)));
+                FUN_VALUE((tinySTL::utf32_to_utf16(tinySTL::u32string_view(u32.data(), u32.size())) == u16));
+                FUN_VALUE((tinySTL::utf16_to_utf32(tinySTL::u16string_view(u16.data(), u16.size())) == u32));
+                FUN_VALUE((tinySTL::utf32_to_utf8(tinySTL::u32string_view(u32.data(), u32.size())) == back));
+                std::cout << std::noboolalpha;
+                const char16_t lone[] = {u'a', static_cast<char16_t>(0xD800), u'b'};
+                FUN_VALUE(tinySTL::utf16_find_invalid(lone, 3));
+                try {
+                    tinySTL::utf8_to_utf16(tinySTL::string_view(bad, sizeof(bad) - 1));
+                }
+                catch (const std::runtime_error &e) {
+                    FUN_VALUE(e.what());
+                }
+                PASSED;
+#if PERFORMANCE_TEST_ON
+                std::cout << "[--------------------- Performance Testing ---------------------]" << std::endl;
+                std::cout << "|---------------------|-------------|-------------|-------------|" << std::endl;
+                std::cout << "|    utf8 -> utf16    |";
+                TEST_LEN(LEN1, LEN2, LEN3, WIDE);
+                const std::string text1 = make_utf8_text(LEN1);
+                const std::string text2 = make_utf8_text(LEN2);
+                const std::string text3 = make_utf8_text(LEN3);
+                std::cout << "|   std::codecvt      |";
+                UTF_CONVERT_TEST(codecvt_utf8_to_utf16, text1);
+                UTF_CONVERT_TEST(codecvt_utf8_to_utf16, text2);
+                UTF_CONVERT_TEST(codecvt_utf8_to_utf16, text3);
+                std::cout << std::endl << "|        tinySTL        |";
+                UTF_CONVERT_TEST(tinystl_utf8_to_utf16, text1);
+                UTF_CONVERT_TEST(tinystl_utf8_to_utf16, text2);
+                UTF_CONVERT_TEST(tinystl_utf8_to_utf16, text3);
+                std::cout << std::endl;
+                std::cout << "|---------------------|-------------|-------------|-------------|" << std::endl;
+                PASSED;
+#endif
+                std::cout << "[------------------- End container test : utf ------------------]" << std::endl;
+            }
+
+// 把 count 行 CSV 逐行切分为字段，split_line(line, fields) 返回字段个数
+#define SPLIT_TEST(split_line, lines, count) do {               \
+  clock_t start, end;                                           \
+  char buf[16];                                                 \
+  size_t total = 0;                                             \
+  start = clock();                                              \
+  for (size_t i = 0; i < count; ++i)                            \
+    total += split_line(lines[i % lines.size()]);               \
+  end = clock();                                                \
+  volatile size_t keep = total;                                 \
+  (void) keep;                                                  \
+  int n = static_cast<int>(static_cast<double>(end - start)     \
+      / CLOCKS_PER_SEC * 1000);                                 \
+  std::snprintf(buf, sizeof(buf), "%d", n);                     \
+  std::string t = buf;                                          \
+  t += "ms    |";                                               \
+  std::cout << std::setw(WIDE) << t;                            \
+} while(0)
+
+            // 每行 8 个长度不一的字段
+            inline std::vector<std::string> make_csv_lines(size_t lines) {
+                std::vector<std::string> result;
+                for (size_t i = 0; i < lines; ++i) {
+                    std::string line;
+                    for (size_t f = 0; f < 8; ++f) {
+                        if (f != 0)
+                            line += ',';
+                        line.append(1 + (i * 7 + f * 13) % 24, static_cast<char>('a' + (i + f) % 26));
+                    }
+                    result.push_back(line);
+                }
+                return result;
+            }
+
+            // 常见的写法：每个字段构造一个 std::string
+            inline size_t std_split_line(const std::string &line) {
+                std::vector<std::string> fields;
+                size_t first = 0;
+                for (;;) {
+                    const size_t pos = line.find(',', first);
+                    if (pos == std::string::npos) {
+                        fields.push_back(line.substr(first));
+                        break;
+                    }
+                    fields.push_back(line.substr(first, pos - first));
+                    first = pos + 1;
+                }
+                return fields.size();
+            }
+
+            inline size_t tinystl_split_line(const std::string &line) {
+                tinySTL::string_view fields[16];
+                return tinySTL::split_n(tinySTL::string_view(line.data(), line.size()), ',', fields);
+            }
+
+            void split_test() {
+                std::cout << "[===============================================================]" << std::endl;
+                std::cout << "[------------------ Run container test : split -----------------]" << std::endl;
+                std::cout << "[-------------------------- API test ---------------------------]" << std::endl;
+                tinySTL::string csv("id,name,,price,");
+                tinySTL::string text("  the quick\tbrown  fox\n");
+                tinySTL::string path("usr::local::lib");
+                for (tinySTL::string_view field : tinySTL::split(csv, ','))
+                    std::cout << " [" << field << "]";
+                std::cout << std::endl;
+                for (tinySTL::string_view field : tinySTL::split(path, "::"))
+                    std::cout << " [" << field << "]";
+                std::cout << std::endl;
+                for (tinySTL::string_view word : tinySTL::tokenize(text, " \t\n"))
+                    std::cout << " [" << word << "]";
+                std::cout << std::endl;
+                tinySTL::string_view fields[3];
+                size_t n = tinySTL::split_n(csv, ',', fields);
+                FUN_VALUE(n);
+                FUN_VALUE(fields[0]);
+                FUN_VALUE(fields[2]);
+                n = tinySTL::split_n(path, "::", fields);
+                FUN_VALUE(n);
+                FUN_VALUE(fields[1]);
+                size_t count = 0;
+                for (tinySTL::string_view field : tinySTL::split(tinySTL::string_view(""), ','))
+                    count += field.size() + 1;
+                FUN_VALUE(count);
+                std::cout << std::boolalpha;
+                FUN_VALUE((fields[0].data() == path.data()));
+                FUN_VALUE((tinySTL::tokenize(tinySTL::string_view(" , "), " ,").begin()
+                           == tinySTL::tokenize(tinySTL::string_view(" , "), " ,").end()));
+                std::cout << std::noboolalpha;
+                PASSED;
+#if PERFORMANCE_TEST_ON
+                std::cout << "[--------------------- Performance Testing ---------------------]" << std::endl;
+                std::cout << "|---------------------|-------------|-------------|-------------|" << std::endl;
+                std::cout << "|   split csv lines   |";
+                TEST_LEN(LEN1 / 10, LEN2 / 10, LEN3 / 10, WIDE);
+                const std::vector<std::string> lines = make_csv_lines(1024);
+                std::cout << "|         std         |";
+                SPLIT_TEST(std_split_line, lines, LEN1 / 10);
+                SPLIT_TEST(std_split_line, lines, LEN2 / 10);
+                SPLIT_TEST(std_split_line, lines, LEN3 / 10);
+                std::cout << std::endl << "|        tinySTL        |";
+                SPLIT_TEST(tinystl_split_line, lines, LEN1 / 10);
+                SPLIT_TEST(tinystl_split_line, lines, LEN2 / 10);
+                SPLIT_TEST(tinystl_split_line, lines, LEN3 / 10);
+                std::cout << std::endl;
+                std::cout << "|---------------------|-------------|-------------|-------------|" << std::endl;
+                PASSED;
+#endif
+                std::cout << "[------------------ End container test : split -----------------]" << std::endl;
+            }
+
+#undef SPLIT_TEST
+#undef UTF_CONVERT_TEST
+#undef TO_CHARS_TEST
+#undef GETLINE_TEST
+
         } // namespace string_test
     } // namespace test
 } // namespace tinySTL
@@ -0,0 +1,159 @@
+#ifndef MYTINYSTL_THREAD_POOL_TEST_H_
+#define MYTINYSTL_THREAD_POOL_TEST_H_
+
+/*
+ * thread_pool test : 测试 thread_pool、task_group、parallel_for、parallel_invoke 的接口
+ * 以及分治递归(fork-join 快速排序)在不同线程数下的扩展性
+ */
+
+#include <atomic>
+#include <chrono>
+#include <stdexcept>
+
+#include "thread_pool.h"  /* 这个头文件包含工作窃取线程池 thread_pool 与 parallel_for 等并行原语 */
+#include "algorithm.h"  /* 这个头文件包含了 tinySTL 的所有算法 */
+#include "vector.h"  /* 这个头文件包含一个模板类 vector */
+#include "test.h"  /* 一个简单的单元测试框架，定义了两个类 TestCase 和 UnitTest，以及一系列用于测试的宏 */
+
+namespace tinySTL
+{
+    namespace test
+    {
+        namespace thread_pool_test
+        {
+
+            // 分治递归求斐波那契数，每一层都通过 parallel_invoke 分叉
+            long fork_join_fib(tinySTL::thread_pool &pool, int n)
+            {
+                if (n < 20)
+                {
+                    long a = 0, b = 1;
+                    for (int i = 0; i < n; ++i)
+                    {
+                        long c = a + b;
+                        a = b;
+                        b = c;
+                    }
+                    return a;
+                }
+                long x = 0, y = 0;
+                tinySTL::parallel_invoke(pool, [&] { x = fork_join_fib(pool, n - 1); },
+                                         [&] { y = fork_join_fib(pool, n - 2); });
+                return x + y;
+            }
+
+            // 并行快速排序：划分后两半各自作为任务递归，区间较小或深度耗尽时改用串行 sort
+            template <class RandomIter>
+            void fork_join_sort(tinySTL::thread_pool &pool, RandomIter first, RandomIter last, int depth)
+            {
+                if (last - first <= 8192 || depth == 0)
+                {
+                    tinySTL::sort(first, last);
+                    return;
+                }
+                auto pivot = tinySTL::median(*first, *(first + (last - first) / 2), *(last - 1));
+                RandomIter cut = tinySTL::unchecked_partition(first, last, pivot);
+                tinySTL::parallel_invoke(pool, [&] { fork_join_sort(pool, first, cut, depth - 1); },
+                                         [&] { fork_join_sort(pool, cut, last, depth - 1); });
+            }
+
+// 用 threads 个线程(含调用线程)对 len 个随机数做 fork-join 排序，记录墙上时间
+#define FORK_JOIN_SORT_TEST(threads, len) do {               \
+  tinySTL::thread_pool pool(threads - 1);                    \
+  tinySTL::vector<int> v(len);                               \
+  srand((int)time(0));                                       \
+  for (size_t i = 0; i < len; ++i) v[i] = rand();            \
+  auto start = std::chrono::steady_clock::now();             \
+  fork_join_sort(pool, v.begin(), v.end(), 32);              \
+  auto end = std::chrono::steady_clock::now();               \
+  int n = static_cast<int>(std::chrono::duration_cast<       \
+      std::chrono::milliseconds>(end - start).count());      \
+  char buf[32];                                              \
+  std::snprintf(buf, sizeof(buf), "%d", n);                  \
+  std::string t = buf;                                       \
+  t += "ms    |";                                            \
+  std::cout << std::setw(WIDE) << t;                         \
+} while(0)
+
+            void thread_pool_test()
+            {
+                std::cout << "[===============================================================]\n";
+                std::cout << "[--------------- Run container test : thread_pool --------------]\n";
+                std::cout << "[-------------------------- API test ---------------------------]\n";
+                tinySTL::thread_pool pool(3);
+                tinySTL::vector<int> v(100000, 1);
+                std::atomic<long> sum(0);
+                tinySTL::parallel_for(pool, v.begin(), v.end(), 1000,
+                                      [&](tinySTL::vector<int>::iterator b, tinySTL::vector<int>::iterator e) {
+                                          long s = 0;
+                                          for (; b != e; ++b) s += *b;
+                                          sum += s;
+                                      });
+                std::atomic<int> tasks(0);
+                {
+                    tinySTL::task_group g(pool);
+                    for (int i = 0; i < 100; ++i)
+                        g.spawn([&] { ++tasks; });
+                    g.wait();
+                }
+                bool caught = false;
+                try
+                {
+                    tinySTL::parallel_for(pool, 0, 1000, 10, [](int b, int e) {
+                        if (b <= 500 && 500 < e) throw std::runtime_error("task failed");
+                    });
+                }
+                catch (const std::runtime_error &)
+                {
+                    caught = true;
+                }
+
+                FUN_VALUE(pool.size());
+                FUN_VALUE(pool.concurrency());
+                FUN_VALUE(sum.load());
+                FUN_VALUE(tasks.load());
+                FUN_VALUE(fork_join_fib(pool, 30));
+                std::cout << std::boolalpha;
+                FUN_VALUE(caught);
+                std::cout << std::noboolalpha;
+                fork_join_sort(pool, v.begin(), v.end(), 32);
+                for (size_t i = 0; i < v.size(); ++i) v[i] = static_cast<int>((i * 7919) % v.size());
+                fork_join_sort(pool, v.begin(), v.end(), 32);
+                std::cout << std::boolalpha;
+                FUN_VALUE(tinySTL::is_sorted(v.begin(), v.end()));
+                std::cout << std::noboolalpha;
+                PASSED;
+#if PERFORMANCE_TEST_ON
+                std::cout << "[--------------------- Performance Testing ---------------------]\n";
+                std::cout << "|---------------------|-------------|-------------|-------------|\n";
+                std::cout << "|   fork-join sort    |";
+                TEST_LEN(LEN1, LEN2, LEN3, WIDE);
+                std::cout << "|      1 thread       |";
+                FORK_JOIN_SORT_TEST(1, LEN1);
+                FORK_JOIN_SORT_TEST(1, LEN2);
+                FORK_JOIN_SORT_TEST(1, LEN3);
+                std::cout << "\n|      2 threads      |";
+                FORK_JOIN_SORT_TEST(2, LEN1);
+                FORK_JOIN_SORT_TEST(2, LEN2);
+                FORK_JOIN_SORT_TEST(2, LEN3);
+                std::cout << "\n|      4 threads      |";
+                FORK_JOIN_SORT_TEST(4, LEN1);
+                FORK_JOIN_SORT_TEST(4, LEN2);
+                FORK_JOIN_SORT_TEST(4, LEN3);
+                std::cout << "\n|      8 threads      |";
+                FORK_JOIN_SORT_TEST(8, LEN1);
+                FORK_JOIN_SORT_TEST(8, LEN2);
+                FORK_JOIN_SORT_TEST(8, LEN3);
+                std::cout << "\n";
+                std::cout << "|---------------------|-------------|-------------|-------------|\n";
+                PASSED;
+#endif
+                std::cout << "[--------------- End container test : thread_pool --------------]\n";
+            }
+
+#undef FORK_JOIN_SORT_TEST
+
+        } // namespace thread_pool_test
+    } // namespace test
+} // namespace tinySTL
+#endif // !MYTINYSTL_THREAD_POOL_TEST_H_
@@ -87,6 +87,13 @@ namespace tinySTL {
                 FUN_VALUE(um1.max_load_factor());
                 MAP_FUN_AFTER(um1, um1.max_load_factor(1.5f));
                 FUN_VALUE(um1.max_load_factor());
+                tinySTL::unordered_map<tinySTL::pair<int, int>, int> um15;
+                for (int i = 0; i < 64; ++i)
+                    um15[tinySTL::pair<int, int>(i / 8, i % 8)] = i;
+                FUN_VALUE(um15.size());
+                FUN_VALUE((um15.count(tinySTL::pair<int, int>(3, 5))));
+                FUN_VALUE((um15[tinySTL::pair<int, int>(7, 1)]));
+                FUN_VALUE((tinySTL::hash_values(1, 2) != tinySTL::hash_values(2, 1)));
                 PASSED;
 #if PERFORMANCE_TEST_ON
                 std::cout << "[--------------------- Performance Testing ---------------------]" << std::endl;